@@ -0,0 +1,163 @@
+/**
+ * @file JsonParserBenchmark.cpp
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Measures the decoding of large exchange payloads the way the system decodes them.
+ * The REST payloads, a depth snapshot of 5000 levels per side and 1000 klines, are parsed into a Json::Value tree as
+ * the exchange library does, their numbers read by std::stod or in place like getOrderBook and the kline refresh
+ * do. A depth diff of 1000 levels per side is decoded through a tree and by parseDepthUpdate, as the stream handler
+ * does. Decoding reuses its output, and the heap allocations made per decoding are counted by replacing operator
+ * new.
+ * Usage: json_parser_benchmark [iterations]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "JsonParser.h"
+#include "MarketData.h"
+
+using namespace ats;
+
+namespace {
+    std::atomic<uint64_t> allocations{0};
+}
+
+void *operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    std::string depthPayload(size_t levels) {
+        std::string body = R"({"lastUpdateId":1027024,"bids":[)";
+        for (size_t i = 0; i < levels; i++)
+            body += (i ? "," : "") + std::string("[\"") + std::to_string(30000 - i * 0.01) + "\",\"" +
+                    std::to_string(0.001 * (i % 97 + 1)) + "\"]";
+        body += R"(],"asks":[)";
+        for (size_t i = 0; i < levels; i++)
+            body += (i ? "," : "") + std::string("[\"") + std::to_string(30000.01 + i * 0.01) + "\",\"" +
+                    std::to_string(0.002 * (i % 89 + 1)) + "\"]";
+        return body + "]}";
+    }
+
+    std::string depthUpdatePayload(size_t levels) {
+        std::string body = R"({"e":"depthUpdate","E":123456789,"s":"BTCUSDT","U":157,"u":160,"b":[)";
+        for (size_t i = 0; i < levels; i++)
+            body += (i ? "," : "") + std::string("[\"") + std::to_string(30000 - i * 0.01) + "\",\"" +
+                    std::to_string(0.001 * (i % 97)) + "\"]";
+        body += R"(],"a":[)";
+        for (size_t i = 0; i < levels; i++)
+            body += (i ? "," : "") + std::string("[\"") + std::to_string(30000.01 + i * 0.01) + "\",\"" +
+                    std::to_string(0.002 * (i % 89)) + "\"]";
+        return body + "]}";
+    }
+
+    std::string klinesPayload(size_t count) {
+        std::string body = "[";
+        for (size_t i = 0; i < count; i++) {
+            int64_t open = 1499040000000 + int64_t(i) * 60000;
+            body += (i ? ",[" : "[") + std::to_string(open) + ",\"" + std::to_string(100 + i * 0.01) + "\",\"" +
+                    std::to_string(101 + i * 0.01) + "\",\"" + std::to_string(99 + i * 0.01) + "\",\"" +
+                    std::to_string(100.5 + i * 0.01) + "\",\"" + std::to_string(1000 + i) + "\"," +
+                    std::to_string(open + 59999) + ",\"2434.19055334\",308,\"1756.87402397\",\"28.46694368\",\"0\"]";
+        }
+        return body + "]";
+    }
+
+    Json::Value parseTree(const std::string &body) {
+        Json::Value root;
+        Json::CharReaderBuilder builder;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        reader->parse(body.data(), body.data() + body.size(), &root, nullptr);
+        return root;
+    }
+
+    void treeDepth(const std::string &body, OrderBook &book, bool inPlace) {
+        Json::Value root = parseTree(body);
+        book.bid.clear();
+        book.bidVol.clear();
+        book.ask.clear();
+        book.askVol.clear();
+        book.lastUpdateId = root["lastUpdateId"].asInt64();
+        for (const Json::Value &bid: root["bids"]) {
+            book.bid.push_back(inPlace ? jsonDoubleStrict(bid[0]) : std::stod(bid[0].asString()));
+            book.bidVol.push_back(inPlace ? jsonDoubleStrict(bid[1]) : std::stod(bid[1].asString()));
+        }
+        for (const Json::Value &ask: root["asks"]) {
+            book.ask.push_back(inPlace ? jsonDoubleStrict(ask[0]) : std::stod(ask[0].asString()));
+            book.askVol.push_back(inPlace ? jsonDoubleStrict(ask[1]) : std::stod(ask[1].asString()));
+        }
+    }
+
+    void treeDepthUpdate(const std::string &body, DepthUpdate &update) {
+        Json::Value root = parseTree(body);
+        update.bids.clear();
+        update.asks.clear();
+        update.firstUpdateId = root["U"].asInt64();
+        update.finalUpdateId = root["u"].asInt64();
+        for (const Json::Value &bid: root["b"])
+            update.bids.emplace_back(jsonDoubleStrict(bid[0]), jsonDoubleStrict(bid[1]));
+        for (const Json::Value &ask: root["a"])
+            update.asks.emplace_back(jsonDoubleStrict(ask[0]), jsonDoubleStrict(ask[1]));
+    }
+
+    void treeKlines(const std::string &body, Klines &klines, bool inPlace) {
+        Json::Value root = parseTree(body);
+        klines.clear();
+        for (const Json::Value &k: root) {
+            auto number = [&](const Json::Value &v) { return inPlace ? jsonDouble(v) : std::stod(v.asString()); };
+            klines.push_back(time_t(k[0].asInt64() / 1000), number(k[1]), number(k[2]), number(k[3]), number(k[4]),
+                             number(k[5]));
+        }
+    }
+
+    template<typename Decode>
+    void measure(const char *name, const std::string &body, int iterations, Decode &&decode) {
+        decode(); // sizes the outputs
+        uint64_t before = allocations.load();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            decode();
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+                    iterations;
+        double perDecode = double(allocations.load() - before) / iterations;
+        std::printf("%-30s %10.1f %10.1f %12.0f\n", name, us, body.size() / us, perDecode);
+    }
+}
+
+int main(int argc, char const *argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+    std::string depth = depthPayload(5000), klines = klinesPayload(1000), diff = depthUpdatePayload(1000);
+    std::printf("mean of %d decodings\n", iterations);
+    std::printf("%-30s %10s %10s %12s\n", "decoder", "us", "MB/s", "allocations");
+
+    OrderBook book;
+    std::printf("depth snapshot, 2 x 5000 levels, %zu bytes\n", depth.size());
+    measure("Json::Value + stod", depth, iterations, [&]() { treeDepth(depth, book, false); });
+    measure("Json::Value + jsonDoubleStrict", depth, iterations, [&]() { treeDepth(depth, book, true); });
+
+    Klines bars;
+    std::printf("klines, 1000 bars, %zu bytes\n", klines.size());
+    measure("Json::Value + stod", klines, iterations, [&]() { treeKlines(klines, bars, false); });
+    measure("Json::Value + jsonDouble", klines, iterations, [&]() { treeKlines(klines, bars, true); });
+
+    DepthUpdate update;
+    std::printf("depth diff, 2 x 1000 levels, %zu bytes\n", diff.size());
+    measure("Json::Value + jsonDoubleStrict", diff, iterations, [&]() { treeDepthUpdate(diff, update); });
+    measure("parseDepthUpdate", diff, iterations, [&]() { parseDepthUpdate(diff, update); });
+    return 0;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file MarketDataBenchmark.cpp
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Measures the duration of a MarketData REST refresh cycle against the number of subscribed symbols.
+ * Requests go to a local mock server answering each one after a fixed latency, over a new loopback connection
+ * like a REST call. Each configuration is run with prices fetched per symbol or in one request, and with
+ * several fetch parallelisms.
+ * Usage: market_data_benchmark [latency_ms] [cycles]
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "MarketData.h"
+#include "OrderManager.h"
+#include "../tests/StubExchangeManager.h"
+
+using namespace ats;
+
+namespace {
+    /**
+     * @brief Line-based mock of the exchange REST API, one request per connection.
+     */
+    class MockServer {
+    private:
+        int mListener{-1};
+        int mLatencyMs;
+        std::atomic<bool> mRunning{true};
+        std::thread mAcceptThread;
+        std::mutex mMutex;
+        std::vector<std::thread> mHandlers;
+        std::vector<std::string> mSymbols;
+
+    public:
+        MockServer(int latencyMs, std::vector<std::string> symbols) : mLatencyMs(latencyMs),
+                                                                      mSymbols(std::move(symbols)) {
+            mListener = ::socket(AF_INET, SOCK_STREAM, 0);
+            int one = 1;
+            ::setsockopt(mListener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            ::bind(mListener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            ::listen(mListener, 256);
+            mAcceptThread = std::thread(&MockServer::acceptLoop, this);
+        }
+
+        ~MockServer() {
+            mRunning = false;
+            ::shutdown(mListener, SHUT_RDWR);
+            ::close(mListener);
+            mAcceptThread.join();
+            for (auto &handler: mHandlers)
+                handler.join();
+        }
+
+        uint16_t port() const {
+            sockaddr_in addr{};
+            socklen_t length = sizeof(addr);
+            ::getsockname(mListener, reinterpret_cast<sockaddr *>(&addr), &length);
+            return ntohs(addr.sin_port);
+        }
+
+    private:
+        void acceptLoop() {
+            while (mRunning) {
+                int client = ::accept(mListener, nullptr, nullptr);
+                if (client < 0)
+                    continue;
+                std::lock_guard<std::mutex> lock(mMutex);
+                mHandlers.emplace_back(&MockServer::handle, this, client);
+            }
+        }
+
+        void handle(int client) {
+            std::string request;
+            char c;
+            while (::recv(client, &c, 1, 0) == 1 && c != '\n')
+                request += c;
+            std::this_thread::sleep_for(std::chrono::milliseconds(mLatencyMs));
+            std::string response = respond(request);
+            ::send(client, response.data(), response.size(), MSG_NOSIGNAL);
+            ::close(client);
+        }
+
+        std::string respond(const std::string &request) {
+            std::istringstream in(request);
+            std::string endpoint, symbol;
+            in >> endpoint >> symbol;
+            if (endpoint == "prices") {
+                std::string body = "[";
+                for (size_t i = 0; i < mSymbols.size(); i++)
+                    body += (i ? "," : "") + std::string("{\"symbol\":\"") + mSymbols[i] + "\",\"price\":\"100.5\"}";
+                return body + "]";
+            }
+            if (endpoint == "price")
+                return "{\"price\":\"100.5\"}";
+            if (endpoint == "depth")
+                return R"({"lastUpdateId":1,"bids":[["100.25","1.5"],["100","2"]],"asks":[["100.75","0.5"]]})";
+            return R"([[1700000000000,"100","101","99.5","100.5","12"]])";
+        }
+    };
+
+    /**
+     * @brief ExchangeManager sending market data requests to the mock server.
+     */
+    class LocalExchangeManager : public StubExchangeManager {
+    private:
+        uint16_t mPort;
+        bool mBatchedPrices;
+
+    public:
+        LocalExchangeManager(OrderManager &oms, uint16_t port, bool batchedPrices) :
+                StubExchangeManager(oms), mPort(port), mBatchedPrices(batchedPrices) {}
+
+        void getKlines(Json::Value &result, std::string symbol, std::string, time_t, time_t, int) override {
+            result = request("klines " + symbol);
+        }
+
+        double getPrice(std::string symbol) override {
+            return std::stod(request("price " + symbol)["price"].asString());
+        }
+
+        std::map<std::string, double> getPrices(const std::vector<std::string> &symbols) override {
+            if (!mBatchedPrices)
+                return ExchangeManager::getPrices(symbols);
+            std::map<std::string, double> prices;
+            for (auto &ticker: request("prices"))
+                prices[ticker["symbol"].asString()] = std::stod(ticker["price"].asString());
+            return prices;
+        }
+
+        OrderBook getOrderBook(std::string symbol) override {
+            Json::Value result = request("depth " + symbol);
+            std::vector<double> bids, bidVol, asks, askVol;
+            for (auto &bid: result["bids"]) {
+                bids.push_back(std::stod(bid[0].asString()));
+                bidVol.push_back(std::stod(bid[1].asString()));
+            }
+            for (auto &ask: result["asks"]) {
+                asks.push_back(std::stod(ask[0].asString()));
+                askVol.push_back(std::stod(ask[1].asString()));
+            }
+            OrderBook book(bids, bidVol, asks, askVol);
+            book.lastUpdateId = result["lastUpdateId"].asUInt64();
+            return book;
+        }
+
+    private:
+        Json::Value request(const std::string &line) {
+            int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(mPort);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            std::string body;
+            if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0) {
+                std::string message = line + "\n";
+                ::send(fd, message.data(), message.size(), MSG_NOSIGNAL);
+                char buffer[4096];
+                ssize_t n;
+                while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)
+                    body.append(buffer, n);
+            }
+            ::close(fd);
+            Json::Value result;
+            Json::CharReaderBuilder builder;
+            std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+            reader->parse(body.data(), body.data() + body.size(), &result, nullptr);
+            return result;
+        }
+    };
+}
+
+int main(int argc, char const *argv[]) {
+    int latencyMs = argc > 1 ? std::atoi(argv[1]) : 20;
+    int cycles = argc > 2 ? std::atoi(argv[2]) : 3;
+    std::printf("refresh cycle duration (ms), %d ms per request, mean of %d cycles\n", latencyMs, cycles);
+    std::printf("%8s %8s %12s %12s\n", "symbols", "fetchers", "per-symbol", "batched");
+    for (size_t count: {10, 50, 100, 200}) {
+        std::vector<std::string> symbols;
+        for (size_t i = 0; i < count; i++)
+            symbols.push_back("SYM" + std::to_string(i) + "USDT");
+        MockServer server(latencyMs, symbols);
+        for (size_t parallelism: {1, 8, 32}) {
+            double durations[2];
+            for (bool batched: {false, true}) {
+                OrderManager oms;
+                LocalExchangeManager ems(oms, server.port(), batched);
+                MarketData md(ems, 3600);
+                for (const std::string &symbol: symbols)
+                    md.subscribe(symbol);
+                md.setFetchParallelism(parallelism);
+                md.refresh(); // first cycle fetches the kline history and warms up the pool
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < cycles; i++)
+                    md.refresh();
+                durations[batched] = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count() / cycles;
+            }
+            std::printf("%8zu %8zu %12.1f %12.1f\n", count, parallelism, durations[0], durations[1]);
+        }
+    }
+    return 0;
+}
@@ -30,35 +30,34 @@ private:
     std::map<std::string, double> mBalances;
     std::string mHedgeSymbol;
     std::vector<double> mHedgePrices;
-    time_t mLastOrder{0};
-    time_t mDataFetch{0};
+    int64_t mNextOrder{0};
+    int64_t mNextFetch{0};
 public:
     ~MMStrategy() {
-        mOrderManager.cancelAllOrders();
         stop();
+        mOrderManager.cancelAllOrders();
     }
 
     virtual void updatePrice() override {
         double currentPrice = mData.getPrice(mSymbol);
         double hedgePrice = mData.getPrice(mHedgeSymbol);
-        time_t new_t;
-        time(&new_t);
-        if (difftime(new_t, mDataFetch) > 1) {
+        int64_t now = mData.getClock().now();
+        if (now >= mNextFetch) {
             mPrices.push_back(currentPrice);
             mHedgePrices.push_back(hedgePrice);
-            time(&mDataFetch);
+            mNextFetch = now + NANOS_PER_SECOND;
         }
     }
 
     virtual double getSignal() override {
         updatePrice();
-        auto ob1 = mData.getOrderBook(mSymbol);
-        auto ob2 = mData.getOrderBook(mHedgeSymbol);
-        if (ob1.bid.empty() || ob2.bid.empty() || ob1.ask.empty() || ob2.ask.empty())
+        BBO bbo1, bbo2;
+        if (!mData.getBBO(mSymbol, bbo1) || !mData.getBBO(mHedgeSymbol, bbo2) || !bbo1.bidPrice || !bbo2.bidPrice ||
+            !bbo1.askPrice || !bbo2.askPrice)
             return 0;
-        if (ob1.bid[0] > ob2.ask[0])
+        if (bbo1.bidPrice > bbo2.askPrice)
             return 1;
-        else if (ob2.bid[0] > ob1.ask[0])
+        else if (bbo2.bidPrice > bbo1.askPrice)
             return -1;
         return 0;
     }
@@ -68,9 +67,8 @@ public:
     }
 
     virtual void buy() override {
-        time_t curTime(0);
-        time(&curTime);
-        if (difftime(curTime, mLastOrder) < 5)
+        int64_t now = mData.getClock().now();
+        if (now < mNextOrder)
             return;
         updateBalance();
         double quantity = floor(mBalances["BTC"]*0.01 * 1e6) / 1e6;
@@ -81,24 +79,23 @@ public:
         quantity = std::min(quantity, ob1.bidVol[0]);
         double price = ob1.bid[0];
         if (price*quantity < 10) return;
-        mOrderManager.setLastOrderQty(-1);
         Order order = Order(0, LIMIT, SELL, mSymbol,
                                         quantity,
-                                        price, 0, 0, 0, 0, "IOC", 0);
-        mOrderManager.createOrder(order);
-        while (mOrderManager.getLastOrderQty() == -1) continue;
-        double qty = mOrderManager.getLastOrderQty();
-        mOrderManager.setLastOrderQty(-1);
-        order = Order(0, LIMIT, BUY, mHedgeSymbol, qty, ob2.ask[0], 0, 0, 0, 0, "GTC", 0);
-        if (qty > 1e-7)
-            mOrderManager.createOrder(order);
-        time(&mLastOrder);
+                                        price, 0, 0, 0, 0, IOC, 0);
+        double hedgePrice = ob2.ask[0];
+        // Hedge as soon as the first leg is acknowledged, from the EMS thread
+        mOrderManager.submitOrder(order, [this, hedgePrice](const ExecutionReport &report) {
+            if (report.executedQty <= 1e-7)
+                return;
+            Order hedge = Order(0, LIMIT, BUY, mHedgeSymbol, report.executedQty, hedgePrice, 0, 0, 0, 0, GTC, 0);
+            mOrderManager.submitOrder(hedge);
+        });
+        mNextOrder = now + 5 * NANOS_PER_SECOND;
     }
 
     virtual void sell() override {
-        time_t curTime(0);
-        time(&curTime);
-        if (difftime(curTime, mLastOrder) < 5)
+        int64_t now = mData.getClock().now();
+        if (now < mNextOrder)
             return;
         updateBalance();
         double quantity = floor(mBalances["BTC"]*0.01 * 1e6) / 1e6;
@@ -109,18 +106,18 @@ public:
         quantity = std::min(quantity, ob1.bidVol[0]);
         double price = ob1.ask[0];
         if (price*quantity < 10) return;
-        mOrderManager.setLastOrderQty(-1);
         Order order = Order(0, LIMIT, BUY, mSymbol,
                                         quantity,
-                                        price, 0, 0, 0, 0, "IOC", 0);
-        mOrderManager.createOrder(order);
-        while (mOrderManager.getLastOrderQty() == -1) continue;
-        double qty = mOrderManager.getLastOrderQty();
-        mOrderManager.setLastOrderQty(-1);
-        order = Order(0, LIMIT, SELL, mHedgeSymbol, qty, ob2.bid[0], 0, 0, 0, 0, "GTC", 0);
-        if (qty > 1e-7)
-            mOrderManager.createOrder(order);
-        time(&mLastOrder);
+                                        price, 0, 0, 0, 0, IOC, 0);
+        double hedgePrice = ob2.bid[0];
+        // Hedge as soon as the first leg is acknowledged, from the EMS thread
+        mOrderManager.submitOrder(order, [this, hedgePrice](const ExecutionReport &report) {
+            if (report.executedQty <= 1e-7)
+                return;
+            Order hedge = Order(0, LIMIT, SELL, mHedgeSymbol, report.executedQty, hedgePrice, 0, 0, 0, 0, GTC, 0);
+            mOrderManager.submitOrder(hedge);
+        });
+        mNextOrder = now + 5 * NANOS_PER_SECOND;
     }
 };
 
@@ -131,6 +128,7 @@ int main(int argc, char const *argv[]) {
     BinanceExchangeManager ems(oms, 1, 1);
     MarketData md({"BTCUSDT", "BTCBUSD"}, ems, 1);
     MMStrategy strat("BTCBUSD", md, oms, "BTCUSDT");
+    strat.start();
     ImBinance app("ImBinance", 1280, 800, argc, argv, ems);
     app.Run();
     return 0;
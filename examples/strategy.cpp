@@ -27,21 +27,20 @@ public:
 
 private:
     std::map<std::string, double> mBalances;
-    time_t mLastOrder{0};
-    time_t mDataFetch{0};
+    int64_t mNextOrder{0};
+    int64_t mNextFetch{0};
 public:
     ~ExampleStrategy() {
-        mOrderManager.cancelAllOrders();
         stop();
+        mOrderManager.cancelAllOrders();
     }
 
     virtual void updatePrice() override {
         double currentPrice = mData.getPrice(mSymbol);
-        time_t new_t;
-        time(&new_t);
-        if (difftime(new_t, mDataFetch) > 1) {
+        int64_t now = mData.getClock().now();
+        if (now >= mNextFetch) {
             mPrices.push_back(currentPrice);
-            time(&mDataFetch);
+            mNextFetch = now + NANOS_PER_SECOND;
         }
     }
 
@@ -72,29 +71,27 @@ public:
     }
 
     virtual void buy() override {
-        time_t curTime(0);
-        time(&curTime);
-        if (difftime(curTime, mLastOrder) < 15)
+        int64_t now = mData.getClock().now();
+        if (now < mNextOrder)
             return;
         updateBalance();
         Order order = Order(0, LIMIT, BUY, mSymbol,
                                         floor(mData.getQtyForPrice(mSymbol, 0.01 * mBalances["USDT"]) * 1e6) / 1e6,
-                                        mPrices.back(), 0, 0, 0, 0, "GTC", 0);
-        mOrderManager.createOrder(order);
-        time(&mLastOrder);
+                                        mPrices.back(), 0, 0, 0, 0, GTC, 0);
+        mOrderManager.submitOrder(order);
+        mNextOrder = now + 15 * NANOS_PER_SECOND;
     }
 
     virtual void sell() override {
-        time_t curTime(0);
-        time(&curTime);
-        if (difftime(curTime, mLastOrder) < 15)
+        int64_t now = mData.getClock().now();
+        if (now < mNextOrder)
             return;
         updateBalance();
         Order order = Order(0, LIMIT, SELL, mSymbol,
                                   floor(mData.getQtyForPrice(mSymbol, 0.01 * mBalances["USDT"]) * 1e6) / 1e6,
-                                  mPrices.back(), 0, 0, 0, 0, "GTC", 0);
-        mOrderManager.createOrder(order);
-        time(&mLastOrder);
+                                  mPrices.back(), 0, 0, 0, 0, GTC, 0);
+        mOrderManager.submitOrder(order);
+        mNextOrder = now + 15 * NANOS_PER_SECOND;
     }
 };
 
@@ -105,6 +102,7 @@ int main(int argc, char const *argv[]) {
     BinanceExchangeManager ems(oms, 1);
     MarketData md({"BTCUSDT", "ETHUSDT"}, ems);
     ExampleStrategy strat("BTCUSDT", md, oms, md.getPrices("BTCUSDT"));
+    strat.start();
     ImBinance app("ImBinance", 1280, 800, argc, argv, ems);
     app.Run();
     return 0;
@@ -0,0 +1,59 @@
+/**
+ * @file AtomicSnapshot.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the AtomicSnapshot class template, a slot publishing immutable reference-counted values.
+ * A writer builds a new value and swaps it in, readers take a reference to the current one: readers never wait
+ * for the writer and a value stays alive as long as a reader holds it.
+*/
+
+#ifndef ATS_ATOMICSNAPSHOT_H
+#define ATS_ATOMICSNAPSHOT_H
+
+#include <atomic>
+#include <memory>
+
+namespace ats {
+
+    /**
+     * @brief Publishes immutable values of type T to any number of readers.
+     * @tparam T The published type.
+     */
+    template<typename T>
+    class AtomicSnapshot {
+    private:
+        std::shared_ptr<const T> mValue; ///< Current value, only accessed through the atomic shared_ptr functions
+
+    public:
+        AtomicSnapshot() = default;
+
+        /**
+         * @brief Constructs a slot holding an initial value.
+         * @param value The initial value.
+         */
+        explicit AtomicSnapshot(std::shared_ptr<const T> value) : mValue(std::move(value)) {}
+
+        AtomicSnapshot(const AtomicSnapshot &) = delete;
+
+        AtomicSnapshot &operator=(const AtomicSnapshot &) = delete;
+
+        /**
+         * @brief Returns the current value.
+         * @return The value, nullptr if none was published.
+         */
+        std::shared_ptr<const T> load() const {
+            return std::atomic_load_explicit(&mValue, std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Publishes a new value, the previous one is freed when its last reader releases it.
+         * @param value The new value.
+         */
+        void store(std::shared_ptr<const T> value) {
+            std::atomic_store_explicit(&mValue, std::move(value), std::memory_order_release);
+        }
+    };
+
+} // ats
+
+#endif //ATS_ATOMICSNAPSHOT_H
@@ -0,0 +1,100 @@
+/**
+ * @file BBOTable.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the BBOTable class, the best bid and offer of every symbol indexed by SymbolId.
+ * Each record sits in its own cache line behind a SeqLock: the book updater writes it and strategy threads read
+ * it without taking any lock. Records are allocated in chunks of symbols on first use.
+*/
+
+#ifndef ATS_BBOTABLE_H
+#define ATS_BBOTABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include "Clock.h"
+#include "SeqLock.h"
+#include "Symbol.h"
+
+namespace ats {
+
+    /**
+     * @brief Best bid and offer of a symbol.
+     */
+    struct BBO {
+        double bidPrice = 0; /**< Best bid price, 0 if there is no bid */
+        double bidQty = 0; /**< Quantity at the best bid */
+        double askPrice = 0; /**< Best ask price, 0 if there is no ask */
+        double askQty = 0; /**< Quantity at the best ask */
+        uint64_t updateId = 0; /**< Exchange update id of the book the BBO was taken from */
+        int64_t time = 0; /**< Time of the last change, in nanoseconds since epoch, 0 if never set */
+
+        /**
+         * @brief Checks if the price levels of two BBOs are the same.
+         * @param other The other BBO.
+         * @return true if prices and quantities are equal.
+         */
+        bool sameLevels(const BBO &other) const {
+            return bidPrice == other.bidPrice && bidQty == other.bidQty && askPrice == other.askPrice &&
+                   askQty == other.askQty;
+        }
+    };
+
+    /**
+     * @brief Per-symbol BBO records with a single writer.
+     */
+    class BBOTable {
+    private:
+        static constexpr size_t CHUNK_SIZE = 256; ///< Symbols per lazily allocated chunk
+
+        std::atomic<SeqLock<BBO> *> mChunks[MAX_SYMBOLS / CHUNK_SIZE]; ///< Records of each chunk of symbols
+        Clock &mClock; ///< The clock the BBOs are timestamped with
+
+    public:
+        /**
+         * @brief Constructs an empty table.
+         * @param clock The clock the BBOs are timestamped with, on its wall time.
+         */
+        explicit BBOTable(Clock &clock = realClock());
+
+        /**
+         * @brief Frees the records.
+         */
+        ~BBOTable();
+
+        BBOTable(const BBOTable &) = delete;
+
+        BBOTable &operator=(const BBOTable &) = delete;
+
+        /**
+         * @brief Publishes the BBO of a symbol if its levels changed, writer only.
+         * @param symbol The interned symbol.
+         * @param bbo The BBO, its time is set to now when it differs from the current one.
+         * @return true if the record was updated.
+         */
+        bool update(SymbolId symbol, BBO bbo);
+
+        /**
+         * @brief Forgets the BBO of a symbol, writer only.
+         * @param symbol The interned symbol.
+         */
+        void clear(SymbolId symbol);
+
+        /**
+         * @brief Reads the BBO of a symbol, lock-free.
+         * @param symbol The interned symbol.
+         * @param bbo Receives the BBO.
+         * @return false if no BBO was published for the symbol.
+         */
+        bool get(SymbolId symbol, BBO &bbo) const;
+
+    private:
+        /**
+         * @brief Returns the record of a symbol, allocating its chunk if needed, writer only.
+         */
+        SeqLock<BBO> &record(SymbolId symbol);
+    };
+
+} // ats
+
+#endif //ATS_BBOTABLE_H
@@ -16,7 +16,10 @@
 #define ATS_BINANCEEXCHANGEMANAGER_H
 
 #include "ExchangeManager.h"
+#include "Clock.h"
 #include "thread"
+#include <atomic>
+#include <memory>
 #include "binance.h"
 #include "json/json.h"
 #include "binance_logger.h"
@@ -30,14 +33,37 @@ namespace ats {
      */
     class BinanceExchangeManager : public ExchangeManager {
     private:
+        /**
+         * @brief A connection used by the thread draining one OrderManager shard.
+         */
+        struct ShardSession {
+            Server server; ///< Binance server object.
+            Account account; ///< Binance account object.
+
+            ShardSession(bool isSimulation, const std::string &apiKey, const std::string &secretKey);
+        };
+
+        /**
+         * @brief A connection used by one market data request at a time.
+         */
+        struct MarketSession {
+            Server server; ///< Binance server object.
+            Market market; ///< Binance market object.
+
+            explicit MarketSession(bool isSimulation);
+        };
+
         Server mServer; ///< Binance server object.
         Market mMarket; ///< Binance market object.
         Account mAccount; ///< Binance account object.
         bool mIsSimulation; ///< Flag to indicate if it is in simulation mode or not.
-        bool mRunning; ///< Flag to indicate if the exchange manager thread is running or not.
-        std::thread mExchangeManagerThread; ///< Thread for running the exchange manager.
-        std::map<long, long> omsToEmsId, emsToOmsId; ///< Maps to track order IDs between OMS and EMS.
+        std::atomic<bool> mRunning{false}; ///< Flag to indicate if the exchange manager threads are running or not.
+        std::vector<std::thread> mExchangeManagerThreads; ///< One thread per OrderManager shard.
+        std::vector<std::unique_ptr<ShardSession>> mSessions; ///< One connection per OrderManager shard.
         time_t mUpdateInterval; ///< Open orders update interval.
+        Clock &mClock; ///< The clock timing the open orders updates.
+        std::mutex mMarketMutex; ///< Protects mMarketSessions.
+        std::vector<std::unique_ptr<MarketSession>> mMarketSessions; ///< Idle connections for concurrent market data requests.
 
     public:
         /**
@@ -48,9 +74,10 @@ namespace ats {
          * @param updateInterval Open orders update period.
          * @param api_key The API key for the Binance exchange account.
          * @param secret_key The secret key for the Binance exchange account.
+         * @param clock The clock timing the open orders updates.
          */
         explicit BinanceExchangeManager(OrderManager &orderManager, bool isSimulation = true, time_t updateInterval=1, std::string apiKey = "",
-                                        std::string secretKey = "");
+                                        std::string secretKey = "", Clock &clock = realClock());
 
         /**
          * @brief Destructor for BinanceExchangeManager class.
@@ -58,17 +85,19 @@ namespace ats {
         ~BinanceExchangeManager();
 
         /**
-         * @brief Start the BinanceExchangeManager thread.
+         * @brief Start one BinanceExchangeManager thread per OrderManager shard.
          */
         void start();
 
         /**
-         * @brief The BinanceExchangeManager processing function.
+         * @brief The BinanceExchangeManager processing function, draining a single OrderManager shard.
+         *
+         * @param shard index of the shard.
          */
-        void run();
+        void run(size_t shard = 0);
 
         /**
-         * @brief Stop the BinanceExchangeManager thread.
+         * @brief Stop the BinanceExchangeManager threads.
          */
         void stop();
 
@@ -86,12 +115,33 @@ namespace ats {
          */
         bool isSimulation();
 
+        /**
+         * @brief Load the exchange filters of every symbol into the OMS pre-trade checks
+         *
+         */
+         void loadSymbolFilters();
+
+        /**
+         * @brief Converts the filters of a symbol from the exchangeInfo response.
+         *
+         * @param result The JSON object describing the symbol.
+         * @return The symbol filters.
+         */
+         SymbolFilters jsonToSymbolFilters(Json::Value &result);
+
         /**
          * @brief Update open orders on the local OMS
          *
          */
          void updateOpenOrders();
 
+        /**
+         * @brief Update open orders of a single shard on the local OMS
+         *
+         * @param shard index of the shard.
+         */
+         void updateOpenOrders(size_t shard);
+
         /**
          * @brief Send an order to the Binance exchange.
          *
@@ -109,7 +159,7 @@ namespace ats {
         void modifyOrder(Order &oldOrder, Order &newOrder) override;
 
         /**
-         * @brief Cancel an existing order on the Binance exchange.
+         * @brief Cancel an existing order on the Binance exchange, removing it from the OMS once canceled.
          *
          * @param orderId The orderId of the order to cancel.
          * @param symbol The symbol of the order to cancel.
@@ -139,6 +189,14 @@ namespace ats {
          */
         std::vector<Order> getOpenOrders(std::string symbol="") override;
 
+        /**
+         * @brief Gets all open orders for the current user, with their executed quantity.
+         *
+         * @param symbol The symbol to retrieve the orders for, all open orders if omitted.
+         * @return A vector of all open orders.
+         */
+        std::vector<OrderState> getOpenOrderStates(std::string symbol="");
+
         /**
          * @brief Gets the trade history for the specified symbol.
          *
@@ -147,6 +205,16 @@ namespace ats {
          */
         std::vector<Trade> getTradeHistory(std::string symbol) override;
 
+        /**
+         * @brief Gets the trades for the specified symbol from a trade ID on, with a single request.
+         *
+         * @param symbol The symbol to get the trades for.
+         * @param fromId The ID of the first trade, the most recent trades if negative.
+         * @param limit The maximum number of trades, at most 1000.
+         * @return The trades, in increasing ID.
+         */
+        std::vector<Trade> getTradesFrom(std::string symbol, long fromId, int limit) override;
+
         /**
          * @brief Gets the current price for the specified symbol.
          *
@@ -155,6 +223,14 @@ namespace ats {
          */
         double getPrice(std::string symbol) override;
 
+        /**
+         * @brief Gets the current prices of several symbols with a single request for all symbols.
+         *
+         * @param symbols The symbols to get the prices for.
+         * @return The price of each symbol listed by the exchange.
+         */
+        std::map<std::string,double> getPrices(const std::vector<std::string> &symbols) override;
+
         /**
          * @brief Gets Klines for a symbol
          *
@@ -175,6 +251,14 @@ namespace ats {
          */
         Order jsonToOrder(Json::Value &result);
 
+        /**
+         * @brief Converts a JSON object to an OrderState (order and executed quantity).
+         *
+         * @param result The JSON object to convert.
+         * @return An OrderState created from the JSON object.
+         */
+        OrderState jsonToOrderState(Json::Value &result);
+
         /**
          * @brief Converts a JSON object to a Trade object.
          *
@@ -204,6 +288,33 @@ namespace ats {
         * @return The bid and ask vectors.
         */
         virtual OrderBook getOrderBook(std::string symbol) override;
+
+    private:
+        /**
+         * @brief Get the account of the shard handling a symbol.
+         */
+        Account &accountFor(const std::string &symbol);
+
+        /**
+         * @brief Runs a market data request on an idle connection, opening one if all are busy.
+         * Market data requests may come from several threads at once and a connection serves one at a time.
+         */
+        template<typename Request>
+        void withMarket(Request &&request) {
+            std::unique_ptr<MarketSession> session;
+            {
+                std::lock_guard<std::mutex> lock(mMarketMutex);
+                if (!mMarketSessions.empty()) {
+                    session = std::move(mMarketSessions.back());
+                    mMarketSessions.pop_back();
+                }
+            }
+            if (!session)
+                session = std::make_unique<MarketSession>(mIsSimulation);
+            request(session->market);
+            std::lock_guard<std::mutex> lock(mMarketMutex);
+            mMarketSessions.push_back(std::move(session));
+        }
     };
 
 } // ats
@@ -0,0 +1,154 @@
+/**
+ * @file Clock.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the Clock interface timing the schedulers and throttles, and its real and simulated versions.
+ * Times are monotonic nanoseconds from an arbitrary origin. The real clock follows std::chrono::steady_clock, the
+ * simulated one only moves when advanced, so a backtest or a replay runs its loops as fast as it advances time,
+ * and the threads waiting on it are woken when their deadline is reached. Timestamps read as dates (prices, book
+ * changes, journal records) come from epochNow(), the wall time of the same clock.
+*/
+
+#ifndef ATS_CLOCK_H
+#define ATS_CLOCK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ats {
+
+    constexpr int64_t NANOS_PER_MILLI = 1000000; ///< Nanoseconds in a millisecond
+    constexpr int64_t NANOS_PER_SECOND = 1000000000; ///< Nanoseconds in a second
+
+    /**
+     * @brief A monotonic nanosecond clock, thread-safe.
+     */
+    class Clock {
+    public:
+        virtual ~Clock() = default;
+
+        /**
+         * @brief Returns the current time.
+         * @return The time in nanoseconds.
+         */
+        virtual int64_t now() = 0;
+
+        /**
+         * @brief Returns the current wall time.
+         * @return The time in nanoseconds since the epoch.
+         */
+        virtual int64_t epochNow() = 0;
+
+        /**
+         * @brief Blocks until a time is reached.
+         * @param time The time in nanoseconds.
+         */
+        virtual void sleepUntil(int64_t time) = 0;
+
+        /**
+         * @brief Waits on a condition variable until a predicate holds or a time is reached.
+         * The lock may be released while waiting, the predicate is only checked while it is held.
+         * @param lock The lock of the condition, held.
+         * @param condition The condition variable, notified when the predicate may hold.
+         * @param time The time in nanoseconds, no timeout if negative.
+         * @param done The predicate.
+         */
+        virtual void waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &condition,
+                               int64_t time, const std::function<bool()> &done) = 0;
+
+        /**
+         * @brief Returns the current time in milliseconds.
+         * @return now() in milliseconds.
+         */
+        int64_t nowMs();
+
+        /**
+         * @brief Returns the current wall time in milliseconds.
+         * @return epochNow() in milliseconds.
+         */
+        int64_t epochMs();
+
+        /**
+         * @brief Blocks for a duration.
+         * @param duration The duration in nanoseconds.
+         */
+        void sleepFor(int64_t duration);
+    };
+
+    /**
+     * @brief Returns the process-wide real clock.
+     * @return The clock.
+     */
+    Clock &realClock();
+
+    /**
+     * @brief The clock of std::chrono::steady_clock.
+     */
+    class RealClock : public Clock {
+    public:
+        int64_t now() override;
+
+        /**
+         * @brief Returns the time of std::chrono::system_clock.
+         */
+        int64_t epochNow() override;
+
+        void sleepUntil(int64_t time) override;
+
+        void waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &condition, int64_t time,
+                       const std::function<bool()> &done) override;
+    };
+
+    /**
+     * @brief A clock moved forward by advance() or set().
+     */
+    class SimulatedClock : public Clock {
+    private:
+        std::atomic<int64_t> mNow; ///< The current time
+        const int64_t mEpoch; ///< Wall time of the time 0, in nanoseconds since the epoch
+        std::mutex mMutex; ///< A mutex protecting the waiters, never locked while holding a waiter's lock
+        std::condition_variable mAdvanced; ///< Notified when the time moves, for sleepUntil
+        std::vector<std::pair<std::mutex *, std::condition_variable *>> mWaiters; ///< Conditions in waitUntil
+
+    public:
+        /**
+         * @brief Constructs a clock.
+         * @param start The initial time in nanoseconds.
+         * @param epoch Wall time of the time 0 in nanoseconds since the epoch, so by default the simulated time is
+         * a time since the epoch.
+         */
+        explicit SimulatedClock(int64_t start = 0, int64_t epoch = 0);
+
+        int64_t now() override;
+
+        /**
+         * @brief Returns the simulated time offset by the epoch.
+         */
+        int64_t epochNow() override;
+
+        void sleepUntil(int64_t time) override;
+
+        void waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &condition, int64_t time,
+                       const std::function<bool()> &done) override;
+
+        /**
+         * @brief Moves the time forward, waking the threads waiting on the clock.
+         * @param duration The duration in nanoseconds, ignored if negative.
+         */
+        void advance(int64_t duration);
+
+        /**
+         * @brief Moves the time forward to a time, waking the threads waiting on the clock.
+         * @param time The time in nanoseconds, ignored if it is in the past.
+         */
+        void set(int64_t time);
+    };
+
+} // ats
+
+#endif //ATS_CLOCK_H
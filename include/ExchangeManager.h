@@ -20,6 +20,9 @@
 #include "json/json.h"
 
 namespace ats {
+    typedef std::function<void(const Order &, const ExecutionReport &)> ExecutionListener; ///< Observes the execution reports of an EMS
+    typedef std::function<void(long orderId, SymbolId symbol, bool canceled)> CancelListener; ///< Observes the cancels sent by an EMS
+
     /**
      * @brief The ExchangeManager class is an abstract class that defines the interface for managing orders on an exchange.
      *
@@ -27,6 +30,25 @@ namespace ats {
     class ExchangeManager {
     protected:
         OrderManager &mOrderManager; /**< A reference to the OrderManager the EMS will be retrieving orders from */
+        ExecutionListener mExecutionListener; /**< Observes the reports of sent orders, set before any is sent */
+        CancelListener mCancelListener; /**< Observes the outcome of sent cancels, set before any is sent */
+
+        /**
+         * @brief Reports the outcome of a sent order to the execution listener, then to the OrderManager.
+         *
+         * @param order The order as sent.
+         * @param report The execution report.
+         */
+        void reportExecution(const Order &order, const ExecutionReport &report);
+
+        /**
+         * @brief Reports the outcome of a cancel to the cancel listener, then removes a canceled order from the OrderManager.
+         *
+         * @param orderId The OMS id of the order.
+         * @param symbol The symbol of the order.
+         * @param canceled Whether the exchange canceled the order.
+         */
+        void reportCancel(long orderId, SymbolId symbol, bool canceled);
 
     public:
 
@@ -42,6 +64,27 @@ namespace ats {
          */
         virtual ~ExchangeManager() = default;
 
+        /**
+         * @brief Returns the OrderManager the EMS retrieves orders from.
+         *
+         * @return A reference to the OrderManager.
+         */
+        OrderManager &getOrderManager();
+
+        /**
+         * @brief Sets the listener observing the execution reports, before any order is sent.
+         *
+         * @param listener The listener, nullptr to disable.
+         */
+        void setExecutionListener(ExecutionListener listener);
+
+        /**
+         * @brief Sets the listener observing the outcome of the cancels, before any cancel is sent.
+         *
+         * @param listener The listener, nullptr to disable.
+         */
+        void setCancelListener(CancelListener listener);
+
         /**
          * @brief Sends an order to the exchange.
          *
@@ -89,6 +132,17 @@ namespace ats {
          */
         virtual std::vector<Trade> getTradeHistory(std::string symbol) = 0;
 
+        /**
+         * @brief Retrieves the trades of a symbol from a trade ID on, in increasing ID.
+         * The default implementation filters the result of getTradeHistory.
+         *
+         * @param symbol The symbol to retrieve the trades for.
+         * @param fromId The ID of the first trade, the most recent trades if negative.
+         * @param limit The maximum number of trades.
+         * @return The trades.
+         */
+        virtual std::vector<Trade> getTradesFrom(std::string symbol, long fromId, int limit);
+
         /**
          * @brief Retrieves user balances.
          *
@@ -116,6 +170,15 @@ namespace ats {
          */
         virtual double getPrice(std::string symbol) = 0;
 
+        /**
+         * @brief Retrieves the current prices of several symbols, in as few requests as the exchange allows.
+         * The default implementation requests each symbol with getPrice.
+         *
+         * @param symbols The symbols to retrieve the prices for.
+         * @return The price of each symbol found.
+         */
+        virtual std::map<std::string,double> getPrices(const std::vector<std::string> &symbols);
+
         /**
          * @brief Retrieves the order book.
          *
@@ -0,0 +1,219 @@
+/**
+ * @file ExchangeRecording.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the binary format of the exchange recordings written by RecordingExchangeManager and played back by
+ * ReplayExchangeManager.
+ * A recording is a file of records, one per response of the exchange, each holding the time it was received, the
+ * call that returned it, the arguments identifying its stream (e.g. the symbol, interval, range and limit of klines)
+ * and the response itself, encoded field by field in native byte order. The execution report of an order is
+ * preceded by the side, type, quantity and price of the order, so that a replay only acknowledges the same order.
+ * The cancels of a symbol are recorded in the order they were sent, with whether the exchange canceled the order.
+*/
+
+#ifndef ATS_EXCHANGERECORDING_H
+#define ATS_EXCHANGERECORDING_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "ExecutionReport.h"
+#include "OrderManager.h"
+#include "Trade.h"
+#include "json/json.h"
+
+namespace ats {
+
+    /**
+     * @enum RecordedCall
+     * @brief Enum for the ExchangeManager calls whose responses are recorded.
+     */
+    enum RecordedCall : uint8_t {
+        CALL_SEND_ORDER,    /**< Execution report of a sent order */
+        CALL_ORDER_STATUS,  /**< getOrderStatus */
+        CALL_OPEN_ORDERS,   /**< getOpenOrders */
+        CALL_TRADE_HISTORY, /**< getTradeHistory */
+        CALL_TRADES_FROM,   /**< getTradesFrom */
+        CALL_BALANCES,      /**< getBalances */
+        CALL_KLINES,        /**< getKlines */
+        CALL_PRICE,         /**< getPrice */
+        CALL_PRICES,        /**< getPrices */
+        CALL_ORDER_BOOK,    /**< getOrderBook */
+        CALL_CANCEL_ORDER,  /**< Outcome of a sent cancel */
+        RCCOUNT             /**< Number of recorded calls */
+    };
+
+    /**
+     * @brief Converts RecordedCall enum value to string.
+     * @param c The RecordedCall enum value to convert.
+     * @return A string representation of the RecordedCall value.
+     */
+    std::string RecordedCallToString(RecordedCall c);
+
+    /**
+     * @brief Returns the key of a klines request, a history, a refresh and a page of a gap being distinct streams.
+     * @param symbol The symbol.
+     * @param interval The interval.
+     * @param start_date Start of the requested range, 0 for none.
+     * @param end_date End of the requested range, 0 for none.
+     * @param limit Maximum number of klines requested.
+     * @return The key.
+     */
+    std::string klinesRecordKey(const std::string &symbol, const std::string &interval, time_t start_date,
+                                time_t end_date, int limit);
+
+    /**
+     * @brief Returns the key of a trades request.
+     * @param symbol The symbol.
+     * @param fromId First trade id requested, -1 for the most recent trades.
+     * @param limit Maximum number of trades requested.
+     * @return The key.
+     */
+    std::string tradesRecordKey(const std::string &symbol, long fromId, int limit);
+
+    /**
+     * @brief Returns the key of the prices of several symbols.
+     * @param symbols The symbols.
+     * @return The key.
+     */
+    std::string pricesRecordKey(const std::vector<std::string> &symbols);
+
+    /**
+     * @brief A response of the exchange.
+     */
+    struct ExchangeRecord {
+        int64_t time = 0; /**< Time the response was received on the recording clock, in nanoseconds */
+        RecordedCall call = CALL_PRICE; /**< The call that returned the response */
+        std::string key; /**< The arguments identifying the stream of responses, e.g. the symbol */
+        std::string payload; /**< The encoded response */
+    };
+
+    /**
+     * @brief Encodes a response field by field.
+     */
+    class PayloadWriter {
+    private:
+        std::string mData; ///< Encoded fields
+
+    public:
+        template<typename T>
+        PayloadWriter &put(const T &value) {
+            static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only scalars are copied as is");
+            mData.append(reinterpret_cast<const char *>(&value), sizeof(T));
+            return *this;
+        }
+
+        PayloadWriter &put(const std::string &value);
+        PayloadWriter &put(const std::vector<double> &values);
+        PayloadWriter &put(const std::map<std::string, double> &values);
+        PayloadWriter &put(const std::vector<Order> &orders);
+        PayloadWriter &put(const std::vector<Trade> &trades);
+        PayloadWriter &put(const OrderBook &book);
+        PayloadWriter &put(const ExecutionReport &report);
+        PayloadWriter &put(const Json::Value &json);
+
+        /**
+         * @brief Returns the encoded fields.
+         */
+        const std::string &data() const;
+    };
+
+    /**
+     * @brief Decodes the fields of a PayloadWriter in the same order.
+     * Every get returns false once the payload is exhausted or malformed.
+     */
+    class PayloadReader {
+    private:
+        const std::string &mData; ///< Encoded fields
+        size_t mOffset{0}; ///< Offset of the next field
+
+    public:
+        explicit PayloadReader(const std::string &data);
+
+        template<typename T>
+        bool get(T &value) {
+            static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only scalars are copied as is");
+            if (mData.size() - mOffset < sizeof(T))
+                return false;
+            std::memcpy(&value, mData.data() + mOffset, sizeof(T));
+            mOffset += sizeof(T);
+            return true;
+        }
+
+        bool get(std::string &value);
+        bool get(std::vector<double> &values);
+        bool get(std::map<std::string, double> &values);
+        bool get(std::vector<Order> &orders);
+        bool get(std::vector<Trade> &trades);
+        bool get(OrderBook &book);
+        bool get(ExecutionReport &report);
+        bool get(Json::Value &json);
+    };
+
+    /**
+     * @brief A recording file, written by several threads.
+     */
+    class RecordFile {
+    private:
+        std::mutex mMutex; ///< A mutex serialising the writes
+        FILE *mFile{nullptr}; ///< The file, written through the stdio buffer
+
+    public:
+        RecordFile() = default;
+
+        /**
+         * @brief Flushes and closes the file.
+         */
+        ~RecordFile();
+
+        RecordFile(const RecordFile &) = delete;
+
+        RecordFile &operator=(const RecordFile &) = delete;
+
+        /**
+         * @brief Creates a recording, replacing any file at the path.
+         * @param path Path of the file.
+         * @return false if the file cannot be created.
+         */
+        bool open(const std::string &path);
+
+        /**
+         * @brief Flushes and closes the file.
+         */
+        void close();
+
+        /**
+         * @brief Checks if the file is open.
+         * @return true if records are written.
+         */
+        bool isOpen();
+
+        /**
+         * @brief Appends a record.
+         * @param record The record.
+         */
+        void write(const ExchangeRecord &record);
+
+        /**
+         * @brief Writes the buffered records to the file.
+         */
+        void flush();
+
+        /**
+         * @brief Reads a recording.
+         * @param path Path of the file.
+         * @param records Receives the records, in the order they were written.
+         * @return false if the file cannot be read or is not a recording, a truncated last record is dropped.
+         */
+        static bool read(const std::string &path, std::vector<ExchangeRecord> &records);
+    };
+
+} // ats
+
+#endif //ATS_EXCHANGERECORDING_H
@@ -0,0 +1,121 @@
+/**
+ * @file ExecutionReport.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the ExecutionReport struct and the OrderHandle returned by OrderManager::createOrder.
+ * The EMS reports the outcome of every order it sends; the report completes the future held by the order
+ * handle and is passed to the optional completion callback given at creation.
+*/
+
+#ifndef ATS_EXECUTIONREPORT_H
+#define ATS_EXECUTIONREPORT_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <string>
+#include "OrderValidator.h"
+
+namespace ats {
+    /**
+     * @enum OrderStatus
+     * @brief Enum for the status of an order on the exchange.
+     */
+    enum OrderStatus : uint8_t {
+        NEW,                /**< Accepted by the exchange, nothing filled */
+        PARTIALLY_FILLED,   /**< Partially filled */
+        FILLED,             /**< Completely filled */
+        CANCELED,           /**< Cancelled */
+        PENDING_CANCEL,     /**< Being cancelled */
+        REJECTED,           /**< Rejected by the exchange or never sent */
+        EXPIRED,            /**< Expired (e.g. unfilled part of an IOC order) */
+        OSCOUNT             /**< Number of order statuses */
+    };
+
+    /**
+     * @brief Converts OrderStatus enum value to string.
+     * @param s The OrderStatus enum value to convert.
+     * @return A string representation of the OrderStatus value.
+     */
+    std::string OrderStatusToString(OrderStatus s);
+
+    /**
+     * @brief Converts a string to an OrderStatus enum value.
+     * @param s The string to convert.
+     * @return The corresponding OrderStatus enum value.
+     */
+    OrderStatus stringToOrderStatus(const std::string &s);
+
+    /**
+     * @brief The outcome of sending an order to the exchange.
+     */
+    struct ExecutionReport {
+        long orderId = -1; /**< OMS id of the order */
+        long emsId = 0; /**< Exchange id of the order, 0 if not acknowledged */
+        bool acked = false; /**< Whether the exchange accepted the order */
+        OrderStatus status = REJECTED; /**< Status of the order when it was acknowledged */
+        double executedQty = 0; /**< Quantity filled when the order was acknowledged */
+        ValidationResult rejectReason = VALID; /**< Failed pre-trade check if the OMS rejected the order */
+    };
+
+    typedef std::function<void(const ExecutionReport &)> ExecutionCallback; ///< Receives the execution report of an order
+
+    /**
+     * @brief Handle to an order created through the OrderManager.
+     *
+     * Converts to the order id (-1 if the order was rejected by the OMS) so existing callers can keep using ids.
+     */
+    class OrderHandle {
+    private:
+        long mId; ///< OMS id of the order, -1 if the order was not queued
+        std::shared_future<ExecutionReport> mReport; ///< Completed when the EMS reports the order
+
+    public:
+        /**
+         * @brief Constructs a handle.
+         * @param id OMS id of the order, -1 if the order was not queued.
+         * @param report Future completed by the execution report.
+         */
+        explicit OrderHandle(long id = -1, std::shared_future<ExecutionReport> report = {});
+
+        /**
+         * @brief Returns the OMS id of the order.
+         * @return The order id, -1 if the order was not queued.
+         */
+        long id() const;
+
+        /**
+         * @brief Returns the OMS id of the order.
+         */
+        operator long() const;
+
+        /**
+         * @brief Checks whether the order was queued and will be reported.
+         * @return true if an execution report will complete the handle.
+         */
+        bool valid() const;
+
+        /**
+         * @brief Checks whether the execution report is available, without blocking.
+         * @return true if get() will not block.
+         */
+        bool ready() const;
+
+        /**
+         * @brief Waits for the execution report.
+         * @param timeout Maximum time to wait.
+         * @return true if the report is available.
+         */
+        bool waitFor(std::chrono::milliseconds timeout) const;
+
+        /**
+         * @brief Returns the execution report, blocking until the EMS reports the order.
+         * @return The execution report, a REJECTED report if the handle is not valid.
+         */
+        ExecutionReport get() const;
+    };
+
+} // ats
+
+#endif //ATS_EXECUTIONREPORT_H
@@ -0,0 +1,83 @@
+/**
+ * @file Interval.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the Interval enum of kline durations and the calendar arithmetic on them.
+ * Klines open on UTC boundaries: epoch multiples of their duration, Mondays for weeks and the first day of the
+ * month for months, which tells whether the klines of an interval are made of whole klines of another.
+*/
+
+#ifndef ATS_INTERVAL_H
+#define ATS_INTERVAL_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+namespace ats {
+
+    /**
+     * @enum Interval
+     * @brief Enum for the kline intervals, from the shortest to the longest.
+     */
+    enum Interval : uint8_t {
+        Interval_1s,    /**< 1 second */
+        Interval_1m,    /**< 1 minute */
+        Interval_3m,    /**< 3 minutes */
+        Interval_5m,    /**< 5 minutes */
+        Interval_15m,   /**< 15 minutes */
+        Interval_30m,   /**< 30 minutes */
+        Interval_1h,    /**< 1 hour */
+        Interval_2h,    /**< 2 hours */
+        Interval_4h,    /**< 4 hours */
+        Interval_6h,    /**< 6 hours */
+        Interval_8h,    /**< 8 hours */
+        Interval_12h,   /**< 12 hours */
+        Interval_1d,    /**< 1 day */
+        Interval_3d,    /**< 3 days */
+        Interval_1w,    /**< 1 week, from Monday */
+        Interval_1M,    /**< 1 calendar month */
+        ICOUNT          /**< Number of intervals */
+    };
+
+    /**
+     * @brief Converts Interval enum value to string.
+     * @param i The Interval enum value to convert.
+     * @return The exchange notation of the interval, e.g. "15m".
+     */
+    std::string IntervalToString(Interval i);
+
+    /**
+     * @brief Converts the exchange notation of an interval to an Interval enum value.
+     * @param s The notation, e.g. "15m".
+     * @param interval Receives the interval.
+     * @return false if the notation is unknown.
+     */
+    bool stringToInterval(const std::string &s, Interval &interval);
+
+    /**
+     * @brief Returns the duration of an interval.
+     * @param i The interval.
+     * @return The duration in seconds, 30 days for a month.
+     */
+    time_t intervalSeconds(Interval i);
+
+    /**
+     * @brief Returns the open time of the kline containing a time.
+     * @param i The interval.
+     * @param time The time in seconds since epoch.
+     * @return The open time in seconds since epoch.
+     */
+    time_t intervalOpenTime(Interval i, time_t time);
+
+    /**
+     * @brief Checks if every kline of an interval is made of whole klines of a shorter one.
+     * @param from The shorter interval.
+     * @param to The longer interval.
+     * @return true if klines of to can be aggregated from klines of from.
+     */
+    bool canAggregate(Interval from, Interval to);
+
+} // ats
+
+#endif //ATS_INTERVAL_H
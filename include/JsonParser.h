@@ -0,0 +1,92 @@
+/**
+ * @file JsonParser.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains allocation-free decoders of exchange JSON payloads.
+ * Market data payloads are mostly numbers, which exchanges send as strings. The stream decoders walk the raw message
+ * once and convert numbers in place with std::from_chars, filling typed structs without building a Json::Value tree
+ * or any temporary string. REST bodies reach us as a Json::Value built by the exchange library, the number helpers
+ * read their values in place.
+*/
+
+#ifndef ATS_JSONPARSER_H
+#define ATS_JSONPARSER_H
+
+#include <cstdint>
+#include <string_view>
+#include "L2Book.h"
+#include "MarketEvents.h"
+#include "json/json.h"
+
+namespace ats {
+
+    /**
+     * @brief Converts decimal text to a double.
+     * @param text The text, without quotes.
+     * @param value Receives the number.
+     * @return false if the text is not entirely a number.
+     */
+    bool parseDouble(std::string_view text, double &value);
+
+    /**
+     * @brief Converts decimal text to an integer.
+     * @param text The text, without quotes.
+     * @param value Receives the number.
+     * @return false if the text is not entirely an integer.
+     */
+    bool parseInteger(std::string_view text, int64_t &value);
+
+    /**
+     * @brief Reads a number sent as a JSON number or string, without copying the string.
+     * @param value The JSON value.
+     * @return The number, 0 if the value is not a number.
+     */
+    double jsonDouble(const Json::Value &value);
+
+    /**
+     * @brief Reads a number sent as a JSON number or string, without copying the string.
+     * @param value The JSON value.
+     * @return The number.
+     * @throws std::invalid_argument if the value is not a number, like std::stod.
+     */
+    double jsonDoubleStrict(const Json::Value &value);
+
+    /**
+     * @brief Splits a combined stream message in its stream name and payload.
+     * @param message The message, {"stream":"...","data":{...}}.
+     * @param stream Receives the stream name.
+     * @param data Receives the raw payload object.
+     * @return false if the message is not a stream message, e.g. a subscription result.
+     */
+    bool parseStreamMessage(std::string_view message, std::string_view &stream, std::string_view &data);
+
+    /**
+     * @brief Decodes a depth diff event, {"U":..,"u":..,"b":[["price","qty"],..],"a":[..]}.
+     * @param data The raw event.
+     * @param update Receives the diff, its vectors are cleared first so their capacity is reused.
+     * @return false if the event is malformed.
+     */
+    bool parseDepthUpdate(std::string_view data, DepthUpdate &update);
+
+    /**
+     * @brief Decodes a trade event, {"p":"price","T":timeMs,..}.
+     * @param data The raw event.
+     * @param price Receives the price.
+     * @param time Receives the trade time in milliseconds since epoch.
+     * @return false if the event is malformed.
+     */
+    bool parseTrade(std::string_view data, double &price, int64_t &time);
+
+    /**
+     * @brief Decodes a kline event, {"k":{"t":openTimeMs,"i":"interval","o":..,"x":closed,..},..}.
+     * @param data The raw event.
+     * @param interval Receives the interval, pointing into data.
+     * @param kline Receives the kline, with its open time in seconds.
+     * @param closed Receives whether the kline is closed, false if the event does not say.
+     * @return false if the event is malformed.
+     */
+    bool parseKlineEvent(std::string_view data, std::string_view &interval, Kline &kline, bool &closed);
+
+} // ats
+
+#endif //ATS_JSONPARSER_H
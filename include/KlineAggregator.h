@@ -0,0 +1,76 @@
+/**
+ * @file KlineAggregator.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the KlineAggregator class, which builds the klines of an interval from those of a shorter one.
+ * The shorter klines arrive in order, the last one being updated until it closes. The aggregator keeps the
+ * combination of the closed ones of the current period apart from the open one, so an update replaces the open
+ * kline instead of being counted twice. Its klines are exact once it saw a period from its first shorter kline.
+*/
+
+#ifndef ATS_KLINEAGGREGATOR_H
+#define ATS_KLINEAGGREGATOR_H
+
+#include "Interval.h"
+#include "MarketEvents.h"
+
+namespace ats {
+
+    struct Klines;
+
+    /**
+     * @brief Incremental kline aggregation to one interval, not thread-safe.
+     */
+    class KlineAggregator {
+    private:
+        Interval mInterval; ///< The interval of the built klines
+        Kline mClosed; ///< Combination of the closed shorter klines of the current period
+        Kline mOpen; ///< The last shorter kline, which may still be updated
+        bool mHasClosed{false}; ///< Whether mClosed holds at least one kline
+        bool mHasOpen{false}; ///< Whether mOpen is set
+        bool mAligned{false}; ///< Whether the current period was seen from its first shorter kline
+        bool mSeeded{false}; ///< Whether seed() was called
+
+    public:
+        /**
+         * @brief Constructs an aggregator.
+         * @param interval The interval of the built klines.
+         */
+        explicit KlineAggregator(Interval interval);
+
+        /**
+         * @brief Returns the interval of the built klines.
+         * @return The interval.
+         */
+        Interval getInterval() const;
+
+        /**
+         * @brief Checks if seed() was called.
+         * @return true if the aggregator was seeded.
+         */
+        bool isSeeded() const;
+
+        /**
+         * @brief Checks if the current period was seen from its first shorter kline.
+         * @return true if the kline of the current period is complete.
+         */
+        bool isAligned() const;
+
+        /**
+         * @brief Adds the shorter klines of the last period of a history.
+         * @param source The shorter klines, in increasing open time.
+         */
+        void seed(const Klines &source);
+
+        /**
+         * @brief Adds a shorter kline, or an update of the last one.
+         * @param kline The shorter kline.
+         * @param bar Receives the kline of the interval containing it.
+         * @return false if the kline is older than the last one.
+         */
+        bool add(const Kline &kline, Kline &bar);
+    };
+
+} // ats
+
+#endif //ATS_KLINEAGGREGATOR_H
@@ -0,0 +1,156 @@
+/**
+ * @file KlineStore.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the KlineStore class, a persistent memory-mapped kline history of one symbol and interval.
+ * The file holds one column per kline field, so a reader scans the closes or the times of years of bars straight
+ * from the page cache without copying them. Klines are only appended, the last one being rewritten while it is open.
+ * A full file is copied to one of twice its capacity.
+*/
+
+#ifndef ATS_KLINESTORE_H
+#define ATS_KLINESTORE_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include "MarketEvents.h"
+
+namespace ats {
+
+    struct Klines;
+
+    /**
+     * @brief Append-only columnar kline file, not thread-safe.
+     */
+    class KlineStore {
+    public:
+        static constexpr size_t INITIAL_CAPACITY = 4096; ///< Klines the file is sized for when created, doubled when full
+
+    private:
+        std::string mPath; ///< Path of the file
+        int mFd{-1}; ///< File descriptor
+        char *mMap{nullptr}; ///< Mapped file
+        size_t mMapSize{0}; ///< Size of the mapping in bytes
+
+    public:
+        KlineStore() = default;
+
+        /**
+         * @brief Flushes and closes the store.
+         */
+        ~KlineStore();
+
+        KlineStore(const KlineStore &) = delete;
+
+        KlineStore &operator=(const KlineStore &) = delete;
+
+        /**
+         * @brief Opens or creates a store.
+         * @param path Path of the file.
+         * @return false if the file cannot be opened or is not a kline store.
+         */
+        bool open(const std::string &path);
+
+        /**
+         * @brief Flushes and closes the file.
+         */
+        void close();
+
+        /**
+         * @brief Checks if the store is open.
+         * @return true if a file is mapped.
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Returns the number of klines.
+         * @return The number of klines, 0 if closed.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Columns of the klines, in increasing open time.
+         * They point into the mapped file and stay valid until the next append() or close().
+         */
+        const int64_t *times() const;
+        const double *opens() const;
+        const double *highs() const;
+        const double *lows() const;
+        const double *closes() const;
+        const double *volumes() const;
+
+        /**
+         * @brief Returns a kline.
+         * @param i Index of the kline, lower than size().
+         * @return The kline.
+         */
+        Kline at(size_t i) const;
+
+        /**
+         * @brief Returns the open time of the last kline.
+         * @return The open time in seconds since epoch, 0 if empty.
+         */
+        time_t lastTime() const;
+
+        /**
+         * @brief Finds the first kline opened at or after a time.
+         * @param time The time in seconds since epoch.
+         * @return Its index, size() if there is none.
+         */
+        size_t lowerBound(time_t time) const;
+
+        /**
+         * @brief Copies a range of klines.
+         * @param first Index of the first kline.
+         * @param count Maximum number of klines.
+         * @return The klines.
+         */
+        Klines read(size_t first, size_t count) const;
+
+        /**
+         * @brief Adds a kline after the last one, or replaces the last one if it has the same open time.
+         * @param kline The kline.
+         * @return false if the kline is older than the last one or the file cannot grow.
+         */
+        bool append(const Kline &kline);
+
+        /**
+         * @brief Schedules the write of the mapped file to disk.
+         */
+        void flush();
+
+    private:
+        /**
+         * @brief Returns the number of klines the file has room for.
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Returns a column of the file.
+         */
+        template<typename T>
+        T *column(size_t index) const {
+            return reinterpret_cast<T *>(mMap + columnOffset(index, capacity()));
+        }
+
+        /**
+         * @brief Returns the offset of a column in a file with room for capacity klines.
+         */
+        static size_t columnOffset(size_t index, size_t capacity);
+
+        /**
+         * @brief Replaces the file with a copy having room for capacity klines.
+         * The copy is written aside and renamed over the file, which stays valid if the process stops meanwhile.
+         */
+        bool grow(size_t capacity);
+
+        /**
+         * @brief Unmaps and closes the file.
+         */
+        void unmap();
+    };
+
+} // ats
+
+#endif //ATS_KLINESTORE_H
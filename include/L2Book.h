@@ -0,0 +1,156 @@
+/**
+ * @file L2Book.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the L2Book class, a local price-level order book kept in sync with depth diffs.
+ * The book is seeded from a REST snapshot and then updated level by level from the exchange depth stream.
+ * Every diff carries the range [U, u] of update ids it covers: a diff that does not continue the last applied
+ * id is a gap, after which the book waits for a new snapshot. Books of symbols with a known tick size keep their
+ * levels in PriceLadders, the others in ordered maps.
+*/
+
+#ifndef ATS_L2BOOK_H
+#define ATS_L2BOOK_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+#include "BBOTable.h"
+#include "OrderManager.h"
+#include "PriceLadder.h"
+
+namespace ats {
+
+    /**
+     * @brief A depth diff: absolute quantities of the price levels that changed, 0 meaning removed.
+     */
+    struct DepthUpdate {
+        uint64_t firstUpdateId = 0; /**< First update id covered (U) */
+        uint64_t finalUpdateId = 0; /**< Last update id covered (u) */
+        std::vector<std::pair<double, double>> bids; /**< Changed bid levels (price, quantity) */
+        std::vector<std::pair<double, double>> asks; /**< Changed ask levels (price, quantity) */
+    };
+
+    /**
+     * @enum DepthUpdateResult
+     * @brief Enum for the outcome of applying a depth diff.
+     */
+    enum DepthUpdateResult : uint8_t {
+        DEPTH_APPLIED,      /**< The diff was applied */
+        DEPTH_STALE,        /**< The diff is older than the book and was dropped */
+        DEPTH_BUFFERED,     /**< The book waits for a snapshot, the diff was kept for replay */
+        DEPTH_GAP,          /**< Updates were missed, the book waits for a snapshot */
+        DURCOUNT            /**< Number of depth update results */
+    };
+
+    /**
+     * @brief Converts DepthUpdateResult enum value to string.
+     * @param r The DepthUpdateResult enum value to convert.
+     * @return A string representation of the DepthUpdateResult value.
+     */
+    std::string DepthUpdateResultToString(DepthUpdateResult r);
+
+    /**
+     * @brief Price-level order book of one symbol, not thread-safe.
+     */
+    class L2Book {
+    public:
+        static constexpr size_t MAX_BUFFERED = 1000; ///< Diffs kept while waiting for a snapshot
+
+    private:
+        std::map<double, double, std::greater<double>> mBids; ///< Bid quantities by price, best first
+        std::map<double, double> mAsks; ///< Ask quantities by price, best first
+        std::unique_ptr<PriceLadder> mBidLadder; ///< Bid levels, replaces mBids when the tick size is known
+        std::unique_ptr<PriceLadder> mAskLadder; ///< Ask levels, replaces mAsks when the tick size is known
+        uint64_t mLastUpdateId{0}; ///< Last update id applied
+        bool mSynced{false}; ///< Whether the book holds a snapshot and every diff since
+        std::deque<DepthUpdate> mBuffered; ///< Diffs received while not synced
+
+    public:
+        /**
+         * @brief Constructs an empty book waiting for a snapshot.
+         * @param tickSize Price increment of the symbol, 0 if unknown.
+         * @param ladderTicks Number of ticks held in the array of each ladder.
+         */
+        explicit L2Book(double tickSize = 0, size_t ladderTicks = PriceLadder::DEFAULT_TICKS);
+
+        /**
+         * @brief Replaces the book with a snapshot and replays the buffered diffs that follow it.
+         * @param snapshot The snapshot, with the update id it was taken at.
+         * @return true if the book is synced, false if the buffered diffs do not continue the snapshot
+         * and a newer one is needed.
+         */
+        bool applySnapshot(const OrderBook &snapshot);
+
+        /**
+         * @brief Applies a depth diff.
+         * @param update The diff.
+         * @return What happened to the diff, DEPTH_BUFFERED and DEPTH_GAP meaning a snapshot is needed.
+         */
+        DepthUpdateResult applyUpdate(const DepthUpdate &update);
+
+        /**
+         * @brief Drops the book content and waits for a new snapshot, e.g. after a reconnection.
+         */
+        void reset();
+
+        /**
+         * @brief Checks if the book is in sync with the exchange.
+         * @return true if a snapshot was applied and no diff was missed since.
+         */
+        bool isSynced() const;
+
+        /**
+         * @brief Returns the last update id applied to the book.
+         * @return The update id.
+         */
+        uint64_t getLastUpdateId() const;
+
+        /**
+         * @brief Exports the top of the book.
+         * @param depth Maximum number of levels per side, 0 for all of them.
+         * @return The book, best levels first.
+         */
+        OrderBook getOrderBook(size_t depth = 0) const;
+
+        /**
+         * @brief Returns the best level of each side, in constant time.
+         * @return The BBO with the last update id, its time left to the publisher.
+         */
+        BBO getBBO() const;
+
+        /**
+         * @brief Checks if the levels are kept in price ladders.
+         * @return true if the book was constructed with a tick size.
+         */
+        bool hasLadder() const;
+
+    private:
+        /**
+         * @brief Sets or removes the levels of a diff.
+         */
+        template<typename Levels>
+        static void applyLevels(Levels &book, const std::vector<std::pair<double, double>> &levels) {
+            for (auto &[price, quantity]: levels)
+                if (quantity == 0)
+                    book.erase(price);
+                else book[price] = quantity;
+        }
+
+        /**
+         * @brief Sets or removes the levels of a diff.
+         */
+        static void applyLevels(PriceLadder &ladder, const std::vector<std::pair<double, double>> &levels);
+
+        /**
+         * @brief Keeps a diff for replay on the next snapshot.
+         */
+        void buffer(const DepthUpdate &update);
+    };
+
+} // ats
+
+#endif //ATS_L2BOOK_H
@@ -0,0 +1,91 @@
+/**
+ * @file LatencyHistogram.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the LatencyHistogram class, a lock-free log-linear histogram of nanosecond latencies.
+ * Values are counted in buckets whose width grows with the value (HDR-style): every power of two is split
+ * into SUB_BUCKETS linear buckets, so percentiles are reported within 1/SUB_BUCKETS of the real value.
+*/
+
+#ifndef ATS_LATENCYHISTOGRAM_H
+#define ATS_LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace ats {
+    /**
+     * @brief Summary of a latency histogram, in nanoseconds.
+     */
+    struct LatencyStats {
+        uint64_t count = 0; /**< Number of recorded values */
+        double mean = 0; /**< Mean value */
+        int64_t min = 0; /**< Smallest value */
+        int64_t max = 0; /**< Largest value */
+        int64_t p50 = 0; /**< Median */
+        int64_t p90 = 0; /**< 90th percentile */
+        int64_t p99 = 0; /**< 99th percentile */
+        int64_t p999 = 0; /**< 99.9th percentile */
+    };
+
+    /**
+     * @brief Lock-free histogram of non-negative latencies, any thread can record or read.
+     */
+    class LatencyHistogram {
+    public:
+        static constexpr int SUB_BUCKET_BITS = 4; ///< log2 of the number of buckets per power of two
+        static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS; ///< Number of buckets per power of two
+        static constexpr int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS; ///< Number of buckets
+
+    private:
+        std::atomic<uint64_t> mBuckets[BUCKETS]; ///< Number of values in each bucket
+        std::atomic<uint64_t> mCount{0}; ///< Number of values
+        std::atomic<int64_t> mSum{0}; ///< Sum of the values
+        std::atomic<int64_t> mMin{INT64_MAX}; ///< Smallest value
+        std::atomic<int64_t> mMax{0}; ///< Largest value
+
+    public:
+        LatencyHistogram();
+
+        LatencyHistogram(const LatencyHistogram &) = delete;
+
+        LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+        /**
+         * @brief Records a value.
+         * @param ns The latency in nanoseconds, negative values are recorded as 0.
+         */
+        void record(int64_t ns);
+
+        /**
+         * @brief Returns the value below which a fraction of the recorded values fall.
+         * @param quantile The fraction, in [0, 1].
+         * @return The upper bound of the bucket holding the quantile, 0 if empty.
+         */
+        int64_t percentile(double quantile) const;
+
+        /**
+         * @brief Returns a summary of the recorded values.
+         * @return The count, mean, extremes and usual percentiles.
+         */
+        LatencyStats getStats() const;
+
+        /**
+         * @brief Clears the histogram, values recorded concurrently may be lost.
+         */
+        void reset();
+
+        /**
+         * @brief Returns the bucket of a value.
+         */
+        static int bucketFor(uint64_t value);
+
+        /**
+         * @brief Returns the largest value of a bucket.
+         */
+        static int64_t bucketUpperBound(int bucket);
+    };
+
+} // ats
+
+#endif //ATS_LATENCYHISTOGRAM_H
@@ -0,0 +1,181 @@
+/**
+ * @file LatencyTracker.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the LatencyTracker class, which timestamps every hop of an order through the OMS and EMS.
+ * Timestamps are kept in a ring indexed by order id and, once the exchange acknowledges the order, the time
+ * spent in each stage is recorded in a histogram per stage, overall and per symbol.
+*/
+
+#ifndef ATS_LATENCYTRACKER_H
+#define ATS_LATENCYTRACKER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "LatencyHistogram.h"
+#include "LockFreeQueue.h"
+#include "Order.h"
+
+namespace ats {
+    /**
+     * @enum OrderHop
+     * @brief Enum for the points where an order is timestamped.
+     */
+    enum OrderHop : uint8_t {
+        HOP_CREATED,        /**< createOrder queued the order */
+        HOP_PROCESSING,     /**< The OMS worker took the order from the pending queue */
+        HOP_EMS_QUEUED,     /**< The order passed the pre-trade checks and was handed to the EMS queue */
+        HOP_SENDING,        /**< The EMS took the order from its queue */
+        HOP_ACKED,          /**< The exchange acknowledged the order */
+        HCOUNT              /**< Number of hops */
+    };
+
+    /**
+     * @enum LatencyStage
+     * @brief Enum for the stages measured between two hops.
+     */
+    enum LatencyStage : uint8_t {
+        STAGE_PENDING,      /**< Waiting in the pending queue (HOP_CREATED to HOP_PROCESSING) */
+        STAGE_VALIDATION,   /**< Pre-trade checks and EMS back-pressure (HOP_PROCESSING to HOP_EMS_QUEUED) */
+        STAGE_EMS_QUEUE,    /**< Waiting in the EMS queue (HOP_EMS_QUEUED to HOP_SENDING) */
+        STAGE_EXCHANGE,     /**< Round trip to the exchange (HOP_SENDING to HOP_ACKED) */
+        STAGE_TOTAL,        /**< From creation to acknowledgement (HOP_CREATED to HOP_ACKED) */
+        LSCOUNT             /**< Number of stages */
+    };
+
+    /**
+     * @brief Converts LatencyStage enum value to string.
+     * @param s The LatencyStage enum value to convert.
+     * @return A string representation of the LatencyStage value.
+     */
+    std::string LatencyStageToString(LatencyStage s);
+
+    /**
+     * @brief Records the latency of every stage of the orders, lock-free.
+     */
+    class LatencyTracker {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 8192; ///< Default number of orders tracked at once
+
+    private:
+        /**
+         * @brief The hop timestamps of an order.
+         */
+        struct alignas(CACHE_LINE_SIZE) OrderTimes {
+            std::atomic<long> id{-1}; ///< Id of the tracked order
+            std::atomic<int64_t> hops[HCOUNT]; ///< Monotonic timestamp of each hop, in nanoseconds
+        };
+
+        /**
+         * @brief The histograms of a symbol.
+         */
+        struct SymbolLatency {
+            LatencyHistogram stages[LSCOUNT]; ///< One histogram per stage
+        };
+
+        static constexpr size_t CHUNK_SIZE = 256; ///< Symbols per lazily allocated chunk
+
+        const size_t mMask; ///< Capacity - 1
+        std::unique_ptr<OrderTimes[]> mTimes; ///< Timestamps of the orders in flight, indexed by id
+        LatencyHistogram mStages[LSCOUNT]; ///< Histograms over all symbols
+        std::atomic<std::atomic<SymbolLatency *> *> mSymbols[MAX_SYMBOLS / CHUNK_SIZE]; ///< Per-symbol histograms
+        std::atomic<bool> mEnabled{true}; ///< Whether orders are timestamped
+        std::thread mDumpThread; ///< Periodically dumps the statistics
+        std::mutex mDumpMutex; ///< Protects mDumping
+        std::condition_variable mDumpCondition; ///< Wakes the dump thread up when stopping
+        bool mDumping{false}; ///< Whether the dump thread is running
+
+    public:
+        /**
+         * @brief Constructs a tracker.
+         * @param capacity Number of orders that can be in flight at once, rounded up to a power of two.
+         */
+        explicit LatencyTracker(size_t capacity = DEFAULT_CAPACITY);
+
+        /**
+         * @brief Stops the dump thread and frees the histograms.
+         */
+        ~LatencyTracker();
+
+        LatencyTracker(const LatencyTracker &) = delete;
+
+        LatencyTracker &operator=(const LatencyTracker &) = delete;
+
+        /**
+         * @brief Returns a monotonic timestamp.
+         * @return Nanoseconds since an arbitrary point.
+         */
+        static int64_t now();
+
+        /**
+         * @brief Timestamps a hop of an order; HOP_CREATED starts tracking it and HOP_ACKED records its stages.
+         * @param order The order.
+         * @param hop The hop.
+         */
+        void mark(const Order &order, OrderHop hop);
+
+        /**
+         * @brief Enables or disables timestamping.
+         * @param enabled false to make mark() a no-op.
+         */
+        void setEnabled(bool enabled);
+
+        /**
+         * @brief Returns the statistics of a stage over all symbols.
+         * @param stage The stage.
+         * @return The latency statistics.
+         */
+        LatencyStats getStats(LatencyStage stage) const;
+
+        /**
+         * @brief Returns the statistics of a stage for a symbol.
+         * @param stage The stage.
+         * @param symbol The interned symbol.
+         * @return The latency statistics, empty if no order of the symbol was acknowledged.
+         */
+        LatencyStats getStats(LatencyStage stage, SymbolId symbol) const;
+
+        /**
+         * @brief Formats the statistics of every stage, overall and per symbol.
+         * @return One line per stage and symbol, in microseconds.
+         */
+        std::string dump() const;
+
+        /**
+         * @brief Clears every histogram.
+         */
+        void reset();
+
+        /**
+         * @brief Starts a thread passing dump() to a sink periodically.
+         * @param period The dump period.
+         * @param sink Receives the dumps.
+         */
+        void startDump(std::chrono::milliseconds period, std::function<void(const std::string &)> sink);
+
+        /**
+         * @brief Stops the dump thread.
+         */
+        void stopDump();
+
+    private:
+        /**
+         * @brief Returns the histograms of a symbol, allocating them if needed.
+         */
+        SymbolLatency &symbolLatency(SymbolId symbol);
+
+        /**
+         * @brief Returns the histograms of a symbol, nullptr if none were allocated.
+         */
+        const SymbolLatency *findSymbolLatency(SymbolId symbol) const;
+    };
+
+} // ats
+
+#endif //ATS_LATENCYTRACKER_H
@@ -0,0 +1,223 @@
+/**
+ * @file LockFreeQueue.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains bounded lock-free ring buffers used to hand orders between threads.
+ * SPSCQueue is a single-producer/single-consumer ring, MPSCQueue accepts any number of producers
+ * and a single consumer. Both have a fixed capacity (rounded up to a power of two), never allocate
+ * after construction and report back-pressure by failing tryPush when full.
+*/
+
+#ifndef ATS_LOCKFREEQUEUE_H
+#define ATS_LOCKFREEQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ats {
+
+    constexpr size_t CACHE_LINE_SIZE = 64; ///< Size used to pad shared atomics to separate cache lines
+
+    /**
+     * @brief Rounds a capacity up to the next power of two.
+     * @param n The requested capacity.
+     * @return The smallest power of two greater or equal to n (at least 2).
+     */
+    inline size_t roundUpToPowerOfTwo(size_t n) {
+        size_t p = 2;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    /**
+     * @brief Bounded single-producer/single-consumer lock-free queue.
+     * @tparam T Element type, must be default constructible and move assignable.
+     */
+    template<typename T>
+    class SPSCQueue {
+    private:
+        const size_t mCapacity; ///< Number of slots (power of two)
+        const size_t mMask; ///< mCapacity - 1
+        std::unique_ptr<T[]> mBuffer; ///< Ring storage
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> mHead{0}; ///< Next slot to read (consumer owned)
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> mTail{0}; ///< Next slot to write (producer owned)
+
+    public:
+        /**
+         * @brief Constructs a queue holding at least capacity elements.
+         * @param capacity The requested capacity, rounded up to a power of two.
+         */
+        explicit SPSCQueue(size_t capacity) : mCapacity(roundUpToPowerOfTwo(capacity)), mMask(mCapacity - 1),
+                                              mBuffer(new T[mCapacity]) {}
+
+        SPSCQueue(const SPSCQueue &) = delete;
+
+        SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+        /**
+         * @brief Pushes an element, producer side only.
+         * @param value The element to push.
+         * @return false if the queue is full.
+         */
+        bool tryPush(T value) {
+            size_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail - mHead.load(std::memory_order_acquire) == mCapacity)
+                return false;
+            mBuffer[tail & mMask] = std::move(value);
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pops the oldest element, consumer side only.
+         * @param value Receives the popped element.
+         * @return false if the queue is empty.
+         */
+        bool tryPop(T &value) {
+            size_t head = mHead.load(std::memory_order_relaxed);
+            if (head == mTail.load(std::memory_order_acquire))
+                return false;
+            value = std::move(mBuffer[head & mMask]);
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Checks whether the queue is empty.
+         * @return true if there is nothing to pop.
+         */
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Returns the current queue depth, exact for the owning threads, approximate otherwise.
+         * @return The number of elements in the queue.
+         */
+        size_t size() const {
+            size_t head = mHead.load(std::memory_order_acquire);
+            size_t tail = mTail.load(std::memory_order_acquire);
+            return tail - head;
+        }
+
+        /**
+         * @brief Returns the queue capacity.
+         * @return The number of slots.
+         */
+        size_t capacity() const {
+            return mCapacity;
+        }
+    };
+
+    /**
+     * @brief Bounded multi-producer/single-consumer lock-free queue.
+     * Each slot carries a sequence number so producers can claim slots with a single CAS
+     * and the consumer never sees a slot before its producer has finished writing it.
+     * @tparam T Element type, must be default constructible and move assignable.
+     */
+    template<typename T>
+    class MPSCQueue {
+    private:
+        /**
+         * @brief A ring slot with its publication sequence.
+         */
+        struct Slot {
+            std::atomic<size_t> sequence; ///< Slot state relative to the producer/consumer positions
+            T value; ///< Stored element
+        };
+
+        const size_t mCapacity; ///< Number of slots (power of two)
+        const size_t mMask; ///< mCapacity - 1
+        std::unique_ptr<Slot[]> mBuffer; ///< Ring storage
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> mHead{0}; ///< Next slot to read (consumer owned)
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> mTail{0}; ///< Next slot to claim (shared by producers)
+
+    public:
+        /**
+         * @brief Constructs a queue holding at least capacity elements.
+         * @param capacity The requested capacity, rounded up to a power of two.
+         */
+        explicit MPSCQueue(size_t capacity) : mCapacity(roundUpToPowerOfTwo(capacity)), mMask(mCapacity - 1),
+                                              mBuffer(new Slot[mCapacity]) {
+            for (size_t i = 0; i < mCapacity; i++)
+                mBuffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MPSCQueue(const MPSCQueue &) = delete;
+
+        MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+        /**
+         * @brief Pushes an element, safe from any number of threads.
+         * @param value The element to push.
+         * @return false if the queue is full.
+         */
+        bool tryPush(T value) {
+            size_t tail = mTail.load(std::memory_order_relaxed);
+            while (true) {
+                Slot &slot = mBuffer[tail & mMask];
+                size_t seq = slot.sequence.load(std::memory_order_acquire);
+                auto diff = (std::ptrdiff_t) seq - (std::ptrdiff_t) tail;
+                if (diff == 0) {
+                    if (mTail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                        slot.value = std::move(value);
+                        slot.sequence.store(tail + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0)
+                    return false;
+                else
+                    tail = mTail.load(std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Pops the oldest published element, consumer side only.
+         * @param value Receives the popped element.
+         * @return false if the queue is empty.
+         */
+        bool tryPop(T &value) {
+            size_t head = mHead.load(std::memory_order_relaxed);
+            Slot &slot = mBuffer[head & mMask];
+            if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+                return false;
+            value = std::move(slot.value);
+            slot.sequence.store(head + mCapacity, std::memory_order_release);
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Checks whether the next element is ready to be popped.
+         * @return true if there is nothing to pop.
+         */
+        bool empty() const {
+            size_t head = mHead.load(std::memory_order_acquire);
+            return mBuffer[head & mMask].sequence.load(std::memory_order_acquire) != head + 1;
+        }
+
+        /**
+         * @brief Returns the approximate queue depth (claimed slots, including ones still being written).
+         * @return The number of elements in the queue.
+         */
+        size_t size() const {
+            size_t head = mHead.load(std::memory_order_acquire);
+            size_t tail = mTail.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        /**
+         * @brief Returns the queue capacity.
+         * @return The number of slots.
+         */
+        size_t capacity() const {
+            return mCapacity;
+        }
+    };
+
+} // ats
+
+#endif //ATS_LOCKFREEQUEUE_H
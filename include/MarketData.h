@@ -7,12 +7,28 @@
 
 #ifndef ATS_MARKETDATA_H
 #define ATS_MARKETDATA_H
+#include <atomic>
+#include <condition_variable>
 #include <thread>
 #include <mutex>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include "AtomicSnapshot.h"
+#include "BBOTable.h"
+#include "Clock.h"
 #include "ExchangeManager.h"
+#include "Interval.h"
+#include "KlineAggregator.h"
+#include "KlineStore.h"
+#include "L2Book.h"
+#include "MarketEvents.h"
 #include "OrderManager.h"
+#include "PriceHistory.h"
+#include "ThreadPool.h"
+#include "TimerWheel.h"
+#include "TradeTape.h"
+#include "WebSocketClient.h"
 
 namespace ats {
     /**
@@ -46,31 +62,203 @@ namespace ats {
              closes.pop_back();
              volumes.pop_back();
          }
+
+         /**
+          * @brief Drops the oldest klines.
+          * @param count Number of klines to keep.
+          */
+         void keepLast(size_t count) {
+             if (times.size() <= count) return;
+             size_t drop = times.size() - count;
+             for (auto *column: {&opens, &highs, &lows, &closes, &volumes})
+                 column->erase(column->begin(), column->begin() + drop);
+             times.erase(times.begin(), times.begin() + drop);
+         }
+
+         void clear() {
+             times.clear();
+             opens.clear();
+             highs.clear();
+             lows.clear();
+             closes.clear();
+             volumes.clear();
+         }
+
+         Kline at(size_t i) const {
+             return {times[i], opens[i], highs[i], lows[i], closes[i], volumes[i]};
+         }
      };
 
+    /**
+     * @brief Published klines of a symbol,interval pair.
+     * The closed klines are shared between the snapshots published while the last kline is updated, so they are
+     * copied once per kline period rather than on every update.
+     */
+    struct KlinesSnapshot {
+        std::shared_ptr<const Klines> closed = std::make_shared<const Klines>(); /**< Every kline but the last one */
+        Kline last; /**< The most recent kline, which may still be open, valid if hasLast */
+        bool hasLast = false; /**< false if there is no kline */
+
+        size_t size() const { return closed->times.size() + hasLast; }
+
+        Kline at(size_t i) const { return i < closed->times.size() ? closed->at(i) : last; }
+
+        /**
+         * @brief Copies the klines into a single Klines.
+         * @return The klines, oldest first.
+         */
+        Klines toKlines() const {
+            Klines klines = *closed;
+            if (hasLast)
+                klines.push_back(last.time, last.open, last.high, last.low, last.close, last.volume);
+            return klines;
+        }
+    };
+
+    /**
+     * @enum RefreshType
+     * @brief Enum for the kinds of data refreshed over REST.
+     */
+    enum RefreshType : uint8_t {
+        REFRESH_PRICE,      /**< Last price of a symbol */
+        REFRESH_BOOK,       /**< Order book snapshot of a symbol */
+        REFRESH_KLINES,     /**< Recent klines of every subscribed interval of a symbol */
+        REFRESH_BALANCES,   /**< Account balances, not tied to a symbol */
+        RTCOUNT             /**< Number of refresh types */
+    };
+
+    /**
+     * @brief Converts RefreshType enum value to string.
+     * @param t The RefreshType enum value to convert.
+     * @return A string representation of the RefreshType value.
+     */
+    std::string RefreshTypeToString(RefreshType t);
+
+    /**
+     * @brief How often a kind of data is refreshed.
+     */
+    struct RefreshSchedule {
+        int64_t periodMs = 1000; /**< Period while the data keeps changing, doubled on each idle refresh */
+        uint8_t priority = 0; /**< Data due at the same time is fetched by decreasing priority */
+    };
+
+    /**
+     * @brief Lock-free view of the data of a subscribed symbol.
+     */
+    struct SymbolSnapshots {
+        AtomicSnapshot<OrderBook> book; /**< Top of the order book, republished whenever it changes */
+        std::shared_ptr<PriceHistory> prices; /**< Price history, written by MarketData and read lock-free */
+    };
+
+    /**
+     * @brief Immutable index of the published market data, replaced when subscriptions change.
+     */
+    struct SnapshotTable {
+        std::unordered_map<std::string, std::shared_ptr<SymbolSnapshots>> symbols; /**< Data of each symbol */
+        std::map<std::pair<std::string,std::string>, std::shared_ptr<AtomicSnapshot<KlinesSnapshot>>> klines; /**< Klines of each symbol,interval pair */
+    };
+
     /**
      * @brief Handles the streaming of market data for the trading system.
+     *
+     * Data is polled over REST every update interval unless a stream URL is given, in which case trades, depth
+     * diffs and klines are pushed over a WebSocket and REST is only used for balances, kline history, order book
+     * snapshots when a book loses sync and as a fallback while the stream is disconnected.
+     *
+     * Updates are serialised by a mutex and published as immutable snapshots: getters never take the mutex, and
+     * the *Snapshot getters share the published data instead of copying it.
+     *
+     * Consumers that would rather be notified than poll register handlers on an EventSubscription, see
+     * subscribeEvents.
+     *
+     * REST refreshes are scheduled on a timer wheel, each (symbol, data type) pair with its own period and
+     * priority, and the market data thread sleeps until the next one is due. The period of data that did not
+     * change since its last refresh doubles, up to MAX_BACKOFF times its schedule, and falls back as soon as it
+     * changes again.
+     *
+     * Once a kline store is opened, the klines of every (symbol, interval) pair are also appended to a memory-mapped
+     * KlineStore. Only the last KLINE_WINDOW of them are kept in memory, and a restart reads them from the store then
+     * fetches the missing range over REST, page by page, instead of downloading the history again.
+     *
+     * Of the intervals subscribed for a symbol, only those that are not made of whole klines of a shorter one are
+     * streamed. The others are aggregated from the shortest interval they are made of, so they stay aligned with it,
+     * and are no longer refreshed over REST once a period was aggregated from its start.
      */
     class MarketData {
     private:
+        static constexpr int STREAM_POLL_MS = 100; /**< Maximum time spent waiting for stream messages per loop */
+        static constexpr time_t RECONNECT_DELAY = 5; /**< Seconds between two stream connection attempts */
+        static constexpr size_t ORDER_BOOK_DEPTH = 100; /**< Levels per side returned by getOrderBook */
+        static constexpr size_t DEFAULT_FETCH_PARALLELISM = 8; /**< Default number of concurrent REST requests */
+        static constexpr int64_t BALANCES_PERIOD_MS = 30000; /**< Default period of the balances refresh */
+        static constexpr int64_t MAX_BACKOFF = 16; /**< Maximum period of idle data, in periods of its schedule */
+        static constexpr int INITIAL_KLINES = 500; /**< Klines fetched for a pair without history */
+        static constexpr int RECENT_KLINES = 10; /**< Klines fetched by a refresh */
+        static constexpr int KLINE_PAGE = 1000; /**< Klines fetched per request while filling a gap */
+        static constexpr size_t KLINE_WINDOW = 500; /**< Klines kept in memory per pair once they are stored */
+        static constexpr int TRADE_PAGE = 1000; /**< Trades fetched per request */
+        static constexpr int MAX_TRADE_PAGES = 10; /**< Requests per trade tape update, the next update resumes */
+        static constexpr size_t TRADE_RETENTION = 100000; /**< Most recent trades kept per symbol */
+
+        /**
+         * @brief A (symbol, data type) pair refreshed over REST.
+         */
+        struct RefreshStream {
+            std::string symbol; /**< The symbol, empty for balances */
+            RefreshType type; /**< The data type */
+            RefreshSchedule schedule; /**< Period and priority */
+            int64_t periodMs; /**< Current period, longer than the scheduled one while the data is idle */
+        };
+
         std::thread mMarketDataThread; /**< The thread used to run the market data stream */
-        std::mutex mDataMutex; /**< A mutex used to protect access to the market data */
-        bool mRunning; /**< Flag indicating whether the market data stream is running */
+        std::mutex mDataMutex; /**< A mutex serialising updates of the market data */
+        std::atomic<bool> mRunning{false}; /**< Flag indicating whether the market data stream is running */
+        std::string mStreamUrl; /**< Base URL of the WebSocket streams, REST polling only if empty */
+        WebSocketClient mStream; /**< The stream connection, used by the market data thread only */
+        std::set<std::string> mStreams; /**< Streams subscribed on the connection, market data thread only */
+        std::atomic<bool> mStreamsChanged{true}; /**< Whether the subscriptions changed since they were sent */
+        std::atomic<bool> mStreaming{false}; /**< Whether the stream is connected */
+        int64_t mReconnectTime{0}; /**< Earliest time of the next connection attempt, in nanoseconds on mClock */
+        int mRequestId{0}; /**< Id of the last subscription request */
         std::unordered_set<std::string> mSymbols; /**< The set of symbols to subscribe to for market data */
-        std::unordered_map<std::string, std::vector<double>> mPrices; /**< The current prices for each subscribed symbol */
+        std::unordered_map<std::string, std::shared_ptr<PriceHistory>> mPrices; /**< The last prices of each subscribed symbol */
+        size_t mPriceHistoryCapacity{PriceHistory::DEFAULT_CAPACITY}; /**< Number of prices kept per symbol */
         ExchangeManager& mExchangeManager; /**< A reference to the exchange manager used to retrieve market data */
+        Clock &mClock; /**< The clock timing the refreshes and timestamping prices and BBOs */
         time_t mUpdateInterval; /**< Interval between updates of locally recorded data */
-        std::unordered_map<std::string,OrderBook> mOrderBooks; /**< The order books for each subscribed symbol */
-        std::map<std::string,double> mBalances; /**< User balance for each symbol */
+        std::unordered_map<std::string,L2Book> mOrderBooks; /**< The order books for each subscribed symbol */
+        std::set<std::string> mResyncs; /**< Symbols whose streamed order book waits for a snapshot */
+        DepthUpdate mDepthUpdate; /**< Last decoded depth event, kept to reuse its capacity, guarded by mDataMutex */
+        AtomicSnapshot<std::map<std::string,double>> mBalances; /**< User balance for each symbol */
         std::map<std::pair<std::string,std::string>,Klines> mKlines; /**< Kline data for symbol,interval pairs */
+        std::string mKlineDirectory; /**< Directory of the kline stores, none if empty */
+        std::mutex mTradeMutex; /**< A mutex serialising the access to the trade tapes */
+        std::map<std::string, TradeTape> mTradeTapes; /**< Trades fetched per symbol */
+        std::map<std::pair<std::string,std::string>, std::unique_ptr<KlineStore>> mKlineStores; /**< Kline history of symbol,interval pairs */
+        std::set<std::pair<std::string,std::string>> mKlineGaps; /**< Pairs whose stored history stops before now */
+        std::map<std::pair<std::string,std::string>, std::vector<KlineAggregator>> mKlineAggregators; /**< Intervals built from each fetched symbol,interval pair */
+        std::map<std::pair<std::string,std::string>, std::pair<std::string,std::string>> mKlineSources; /**< Shorter subscribed pair each aggregated pair is built from */
+        AtomicSnapshot<SnapshotTable> mSnapshots; /**< Published data read by the getters */
+        BBOTable mBBOs; /**< Best bid and offer of each subscribed symbol, written under mDataMutex */
+        std::atomic<size_t> mFetchParallelism{DEFAULT_FETCH_PARALLELISM}; /**< Maximum number of concurrent REST requests */
+        std::unique_ptr<ThreadPool> mFetchPool; /**< Runs the REST requests of a refresh, rebuilt when the parallelism changes */
+        RefreshSchedule mDefaultSchedules[RTCOUNT]; /**< Schedule of newly subscribed data of each type */
+        std::unordered_map<uint64_t, RefreshStream> mRefreshStreams; /**< Data refreshed over REST, by timer id */
+        TimerWheel mRefreshWheel; /**< Next refresh of each entry of mRefreshStreams, not holding those being fetched */
+        std::condition_variable mWakeup; /**< Wakes the market data thread when it stops or the schedule changes */
+        uint64_t mScheduleVersion{0}; /**< Incremented under mDataMutex whenever the schedule changes */
+        AtomicSnapshot<std::vector<std::shared_ptr<EventSubscription>>> mEventSubscriptions; /**< Consumers of market events */
 
     public:
         /**
          * @brief Constructs a new MarketData object.
          * @param ems A reference to the ExchangeManager object used to retrieve market data.
          * @param updateInterval The interval between updates of local data, defaults to 1s.
+         * @param streamUrl Base URL of the WebSocket streams (e.g. wss://stream.binance.com:9443), REST polling if empty.
+         * @param clock The clock timing the refreshes, a SimulatedClock for backtests and replays.
          */
-        MarketData(ExchangeManager& ems, time_t updateInterval=1);
+        MarketData(ExchangeManager& ems, time_t updateInterval=1, const std::string &streamUrl="",
+                   Clock &clock=realClock());
 
         /**
          * @brief Destroys the MarketData object.
@@ -82,8 +270,11 @@ namespace ats {
          * @param symbols A vector of symbols to subscribe to for market data.
          * @param ems A reference to the ExchangeManager object used to retrieve market data.
          * @param updateInterval The interval between updates of local data, defaults to 1s.
+         * @param streamUrl Base URL of the WebSocket streams (e.g. wss://stream.binance.com:9443), REST polling if empty.
+         * @param clock The clock timing the refreshes, a SimulatedClock for backtests and replays.
          */
-        explicit MarketData(const std::vector<std::string>& symbols, ExchangeManager& ems, time_t updateInterval=1);
+        explicit MarketData(const std::vector<std::string>& symbols, ExchangeManager& ems, time_t updateInterval=1,
+                            const std::string &streamUrl="", Clock &clock=realClock());
 
         /**
          * @brief Starts the market data stream.
@@ -106,6 +297,18 @@ namespace ats {
          */
         bool isRunning();
 
+        /**
+         * @brief Checks whether market data is currently received over the WebSocket stream.
+         * @return True if the stream is connected, false if REST polling is used.
+         */
+        bool isStreaming();
+
+        /**
+         * @brief Returns the clock timing the refreshes, for strategies to throttle on the same time.
+         * @return The clock.
+         */
+        Clock &getClock();
+
         /**
          * @brief Subscribes to a symbol for market data.
          * @param symbol The symbol to subscribe to.
@@ -113,6 +316,13 @@ namespace ats {
          */
         void subscribe(const std::string& symbol, std::string interval="3m");
 
+        /**
+         * @brief Subscribes to a symbol for market data.
+         * @param symbol The symbol to subscribe to.
+         * @param interval The interval for the Kline we want to subscribe to
+         */
+        void subscribe(const std::string& symbol, Interval interval);
+
         /**
          * @brief Unsubscribes from a symbol for market data.
          * @param symbol The symbol to unsubscribe from.
@@ -129,16 +339,123 @@ namespace ats {
         /**
          * @brief Returns prices recorded for a symbol.
          * @param symbol The symbol to retrieve the prices for.
-         * @return The vector of prices recorded.
+         * @param count Maximum number of prices, 0 for all of them.
+         * @return The vector of prices recorded, oldest first.
+         */
+         std::vector<double> getPrices(const std::string& symbol, size_t count = 0);
+
+        /**
+         * @brief Reads the most recent prices of a symbol without copying them.
+         * @param symbol The symbol to read the prices of.
+         * @param count Maximum number of prices, 0 for all of them.
+         * @param reader Called with the window while the data is locked, it must not call back into MarketData.
+         * @return false if the symbol is not subscribed.
+         */
+        template<typename F>
+        bool readPrices(const std::string &symbol, size_t count, F reader) {
+            std::lock_guard<std::mutex> lock(mDataMutex);
+            auto it = mPrices.find(symbol);
+            if (it == mPrices.end())
+                return false;
+            reader(it->second->window(count));
+            return true;
+        }
+
+        /**
+         * @brief Sets the number of prices kept per symbol, keeping the most recent ones.
+         * @param capacity Number of prices, rounded up to a power of two.
+         */
+        void setPriceHistoryCapacity(size_t capacity);
+
+        /**
+         * @brief Sets the maximum number of REST requests in flight during a refresh, applied from the next refresh.
+         * @param parallelism Number of concurrent requests, 1 to fetch symbols one after the other.
+         */
+        void setFetchParallelism(size_t parallelism);
+
+        /**
+         * @brief Returns the maximum number of REST requests in flight during a refresh.
+         * @return The number of concurrent requests.
+         */
+        size_t getFetchParallelism() const;
+
+        /**
+         * @brief Fetches the prices, klines and order books of every subscribed symbol over REST.
+         * Prices come from a single request, klines and order books from concurrent requests. Called by the market
+         * data thread every update interval while the stream is down, and must not be called concurrently with it.
+         */
+        void refresh();
+
+        /**
+         * @brief Sets the schedule of a data type, for every symbol.
+         * @param type The data type.
+         * @param schedule The period and priority.
+         */
+        void setRefreshSchedule(RefreshType type, RefreshSchedule schedule);
+
+        /**
+         * @brief Sets the schedule of a data type for a subscribed symbol, e.g. a shorter period for a hot book.
+         * @param symbol The symbol, ignored for balances.
+         * @param type The data type.
+         * @param schedule The period and priority.
+         */
+        void setRefreshSchedule(const std::string &symbol, RefreshType type, RefreshSchedule schedule);
+
+        /**
+         * @brief Returns the current refresh period of a data type for a symbol, including the idle back-off.
+         * @param symbol The symbol, ignored for balances.
+         * @param type The data type.
+         * @return The period in milliseconds, -1 if the symbol is not subscribed.
+         */
+        int64_t getRefreshPeriod(const std::string &symbol, RefreshType type);
+
+        /**
+         * @brief Creates a subscription to market events, on which the consumer registers its handlers.
+         * @return The subscription, posted to until unsubscribeEvents.
          */
-         std::vector<double> getPrices(const std::string& symbol);
+        std::shared_ptr<EventSubscription> subscribeEvents();
+
+        /**
+         * @brief Posts events to a subscription again after unsubscribeEvents, reopening it.
+         * @param subscription The subscription, with its handlers.
+         */
+        void subscribeEvents(const std::shared_ptr<EventSubscription> &subscription);
+
+        /**
+         * @brief Stops posting events to a subscription and closes it.
+         * @param subscription The subscription.
+         */
+        void unsubscribeEvents(const std::shared_ptr<EventSubscription> &subscription);
 
          /**
-          * @brief Returns trade history for a symbol.
+          * @brief Returns the most recent trades of a symbol, after fetching the trades newer than its tape.
+          * Scans over the whole tape should use readTradeTape, which copies nothing.
           * @param symbol The symbol to retrieve the history for.
-          * @return The vector of trades.
+          * @param limit Maximum number of trades returned.
+          * @return The vector of trades, oldest first.
           */
-          std::vector<Trade> getTradeHistory(const std::string& symbol);
+          std::vector<Trade> getTradeHistory(const std::string& symbol, size_t limit = TRADE_PAGE);
+
+        /**
+         * @brief Fetches the trades of a symbol newer than the last one of its tape.
+         * The first update fetches the most recent trades, the following ones page from the last trade ID, at most
+         * MAX_TRADE_PAGES pages per call so that a long outage is caught up over several updates. The requests are
+         * made without holding the tapes, and the tape keeps the last TRADE_RETENTION trades.
+         * @param symbol The symbol.
+         * @return The number of trades added.
+         */
+        size_t updateTradeTape(const std::string &symbol);
+
+        /**
+         * @brief Reads the trade tape of a symbol while no update modifies it.
+         * @param symbol The symbol.
+         * @param reader Called with the tape, empty if it was never updated.
+         */
+        template<typename Reader>
+        void readTradeTape(const std::string &symbol, Reader &&reader) {
+            std::lock_guard<std::mutex> lock(mTradeMutex);
+            reader(mTradeTapes[symbol]);
+        }
 
         /**
          * @brief Retrieves the quantity for a given price and symbol.
@@ -154,6 +471,12 @@ namespace ats {
          */
          std::map<std::string,double> getBalances();
 
+        /**
+         * @brief Retrieves user's balances without copying them.
+         * @return The last published balances, nullptr before the first update.
+         */
+        std::shared_ptr<const std::map<std::string,double>> getBalancesSnapshot();
+
          /**
           * @brief Retrieves order status.
           *
@@ -170,6 +493,31 @@ namespace ats {
           */
           OrderBook getOrderBook(const std::string &symbol);
 
+        /**
+         * @brief Retrieves the OrderBook without copying it.
+         * @param symbol Symbol for which to get the order book.
+         * @return The last published order book, nullptr if the symbol is not subscribed.
+         */
+        std::shared_ptr<const OrderBook> getOrderBookSnapshot(const std::string &symbol);
+
+        /**
+         * @brief Retrieves the best bid and offer of a symbol name.
+         * The name is looked up in the symbol table under a shared lock, and never interned, so hot paths should
+         * resolve the SymbolId once and use the other overload.
+         * @param symbol Symbol for which to get the BBO.
+         * @param bbo Receives the BBO and the time it last changed.
+         * @return false if no synced order book was published for the symbol.
+         */
+        bool getBBO(const std::string &symbol, BBO &bbo);
+
+        /**
+         * @brief Retrieves the best bid and offer of an interned symbol, lock-free and without allocating.
+         * @param symbol Symbol for which to get the BBO.
+         * @param bbo Receives the BBO and the time it last changed.
+         * @return false if no synced order book was published for the symbol.
+         */
+        bool getBBO(SymbolId symbol, BBO &bbo) const;
+
           /**
            * @brief Retrieves Kline data.
            * @param symbol Symbol for which to get the Kline data.
@@ -178,6 +526,46 @@ namespace ats {
            */
            Klines getKlines(const std::string &symbol, const std::string& interval);
 
+        /**
+         * @brief Retrieves Kline data.
+         * @param symbol Symbol for which to get the Kline data.
+         * @param interval Interval for the Klines.
+         * @return The requested Kline data.
+         */
+        Klines getKlines(const std::string &symbol, Interval interval);
+
+        /**
+         * @brief Retrieves Kline data without copying it.
+         * @param symbol Symbol for which to get the Kline data.
+         * @param interval Interval for the Klines.
+         * @return The last published klines, nullptr if the pair is not subscribed.
+         */
+        std::shared_ptr<const KlinesSnapshot> getKlinesSnapshot(const std::string &symbol, const std::string &interval);
+
+        /**
+         * @brief Retrieves the Kline data of a period, from the kline store if it is open.
+         * @param symbol Symbol for which to get the Kline data.
+         * @param interval Interval for the Klines.
+         * @param start Open time of the first kline, in seconds since epoch.
+         * @param end Open time after the last kline, in seconds since epoch.
+         * @return The klines opened in [start, end).
+         */
+        Klines getKlineHistory(const std::string &symbol, const std::string &interval, time_t start, time_t end);
+
+        /**
+         * @brief Persists the klines in one file per symbol,interval pair, e.g. BTCUSDT_1m.klines.
+         * The stored history of the subscribed pairs is loaded and the klines missing since are fetched on the
+         * next refresh.
+         * @param directory The directory of the files, which must exist.
+         * @return false if a file cannot be opened.
+         */
+        bool openKlineStore(const std::string &directory);
+
+        /**
+         * @brief Flushes and closes the kline files, klines are then only kept in memory.
+         */
+        void closeKlineStore();
+
     private:
         /**
          * @brief Updates the price for a symbol.
@@ -186,25 +574,142 @@ namespace ats {
         void updatePrice(const std::string& symbol);
 
         /**
-         * @brief Updates the prices for all subscribed symbols.
+         * @brief Updates the prices of several symbols with a single request.
+         * @param symbols The symbols to update.
+         * @return Whether the price of each symbol changed.
          */
-        void updatePrices();
+        std::vector<char> updatePrices(const std::vector<std::string> &symbols);
 
         /**
-         * @brief Updates the Klines data for all symbols.
+         * @brief Updates the Klines data of every interval of several symbols.
+         * @param symbols The symbols to update.
+         * @param incompleteOnly Whether to only fetch what the stream does not complete: the gaps of the stored klines
+         * and the aggregated intervals seen from the middle of a period.
+         * @return Whether the last kline of each symbol changed.
          */
-         void updateKlines();
+        std::vector<char> updateKlines(const std::vector<std::string> &symbols, bool incompleteOnly = false);
 
         /**
          * @brief Updates the order book for a symbol.
          * @param symbol The symbol to update the price for.
+         * @return true if the book moved to a new update id.
+         */
+        bool updateOrderBook(const std::string& symbol);
+
+        /**
+         * @brief Updates the order books of several symbols.
+         * @param symbols The symbols to update.
+         * @return Whether the book of each symbol changed.
+         */
+        std::vector<char> updateOrderBooks(const std::vector<std::string> &symbols);
+
+        /**
+         * @brief Returns the subscribed symbols.
+         */
+        std::vector<std::string> getSymbols();
+
+        /**
+         * @brief Adds a (symbol, data type) pair to the schedule, due now, mDataMutex must be held.
+         */
+        void addRefreshStream(const std::string &symbol, RefreshType type);
+
+        /**
+         * @brief Returns the timer id of a (symbol, data type) pair.
+         */
+        static uint64_t refreshStreamId(const std::string &symbol, RefreshType type);
+
+        /**
+         * @brief Fetches the data whose refresh is due, by decreasing priority, and schedules the next refreshes.
+         */
+        void refreshDue();
+
+        /**
+         * @brief Sleeps until the next refresh is due, the schedule changes or the thread stops.
+         * @param maxMs Maximum sleep in milliseconds.
+         */
+        void waitForRefresh(int64_t maxMs);
+
+        /**
+         * @brief Republishes the snapshot table after a subscription change, mDataMutex must be held.
+         */
+        void publishSnapshots();
+
+        /**
+         * @brief Publishes the top of a synced order book, mDataMutex must be held.
+         */
+        void publishOrderBook(const std::string &symbol);
+
+        /**
+         * @brief Opens the kline file of a symbol,interval pair and loads its last klines, mDataMutex must be held.
+         * @return false if the file cannot be opened.
+         */
+        bool attachKlineStore(const std::pair<std::string,std::string> &key);
+
+        /**
+         * @brief Adds a kline to a pair and to its store, or replaces the last one with the same open time.
+         * mDataMutex must be held.
+         * @param key The symbol,interval pair.
+         * @param klines The klines of the pair.
+         * @param kline The kline.
+         * @return false if the kline is older than the last one.
+         */
+        bool appendKline(const std::pair<std::string,std::string> &key, Klines &klines, const Kline &kline);
+
+        /**
+         * @brief Chooses the interval each subscribed interval of a symbol is aggregated from, mDataMutex must be held.
+         */
+        void updateKlineSources(const std::string &symbol);
+
+        /**
+         * @brief Updates the intervals aggregated from a symbol,interval pair, mDataMutex must be held.
+         * @param source The pair.
+         * @param kline Its new or updated kline, already appended.
+         */
+        void aggregateKline(const std::pair<std::string,std::string> &source, const Kline &kline);
+
+        /**
+         * @brief Seeds the aggregators of the pairs whose history was fetched, mDataMutex must be held.
+         */
+        void seedKlineAggregators();
+
+        /**
+         * @brief Checks if the klines of a pair are aggregated from the start of the current period, mDataMutex must be held.
+         */
+        bool isAggregated(const std::pair<std::string,std::string> &key);
+
+        /**
+         * @brief Publishes the Klines of a symbol,interval pair, mDataMutex must be held.
+         * The closed klines of the previous snapshot are reused unless klines were appended or dropped since.
+         * @param key The symbol,interval pair.
+         * @param replaced true if the klines were replaced as a whole, so none of the previous snapshot is reused.
+         */
+        void publishKlines(const std::pair<std::string,std::string> &key, bool replaced = false);
+
+        /**
+         * @brief Posts an event to every subscription.
+         */
+        template<typename Post>
+        void notify(Post &&post) {
+            std::shared_ptr<const std::vector<std::shared_ptr<EventSubscription>>> subscriptions = mEventSubscriptions.load();
+            if (subscriptions)
+                for (const auto &subscription: *subscriptions)
+                    post(*subscription);
+        }
+
+        /**
+         * @brief Returns the published data of a symbol.
+         */
+        std::shared_ptr<SymbolSnapshots> findSnapshots(const std::string &symbol);
+
+        /**
+         * @brief Fetches snapshots for the streamed order books that lost sync.
          */
-        void updateOrderBook(const std::string& symbol);
+        void resyncOrderBooks();
 
         /**
-         * @brief Updates the order books for all subscribed symbols.
+         * @brief Returns the pool running REST requests, resized to the current parallelism.
          */
-        void updateOrderBooks();
+        ThreadPool &fetchPool();
 
         /**
          * @brief Updates balances.
@@ -214,7 +719,30 @@ namespace ats {
         /**
          * @brief Converts Json object to double.
          */
-         double jsonToDouble(Json::Value res);
+         double jsonToDouble(const Json::Value &res);
+
+        /**
+         * @brief Connects the stream if needed, then waits for and applies stream messages.
+         */
+        void pollStream();
+
+        /**
+         * @brief Subscribes to the streams of the current symbols and unsubscribes from the others.
+         */
+        void updateStreams();
+
+        /**
+         * @brief Applies a message received on the stream to the local data, dropping it if it cannot be applied.
+         * @param message The combined stream message.
+         */
+        void handleStreamMessage(const std::string &message);
+
+        /**
+         * @brief Records a price, keeping the most recent ones only, and hands it to the OMS validator as the
+         * reference of its price band, mDataMutex must be held.
+         * @param time Time of the price in milliseconds since epoch, now if 0.
+         */
+        void pushPrice(const std::string &symbol, double price, int64_t time = 0);
     };
 
 
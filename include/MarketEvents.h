@@ -0,0 +1,209 @@
+/**
+ * @file MarketEvents.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the EventSubscription class, through which a consumer is notified of market data updates.
+ * MarketData posts typed events (price, order book, kline close and balance change) to every subscription with a
+ * handler for them. Events wait in the subscription until its consumer dispatches them on its own thread, and an
+ * event replaces the pending one of the same kind and symbol, so a slow consumer only sees the latest values.
+*/
+
+#ifndef ATS_MARKETEVENTS_H
+#define ATS_MARKETEVENTS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "OrderManager.h"
+
+namespace ats {
+
+    /**
+     * @enum MarketEventType
+     * @brief Enum for the kinds of market data updates.
+     */
+    enum MarketEventType : uint8_t {
+        EVENT_PRICE,        /**< A new last price */
+        EVENT_BOOK,         /**< A new order book */
+        EVENT_KLINE_CLOSE,  /**< A kline closed */
+        EVENT_BALANCE,      /**< The account balances changed */
+        METCOUNT            /**< Number of market event types */
+    };
+
+    /**
+     * @brief Converts MarketEventType enum value to string.
+     * @param t The MarketEventType enum value to convert.
+     * @return A string representation of the MarketEventType value.
+     */
+    std::string MarketEventTypeToString(MarketEventType t);
+
+    /**
+     * @brief A single kline.
+     */
+    struct Kline {
+        time_t time = 0; /**< Open time, in seconds since epoch */
+        double open = 0; /**< Open price */
+        double high = 0; /**< Highest price */
+        double low = 0; /**< Lowest price */
+        double close = 0; /**< Close price */
+        double volume = 0; /**< Traded volume */
+    };
+
+    /**
+     * @brief Market events of interest to one consumer, thread-safe.
+     */
+    class EventSubscription {
+    public:
+        typedef std::function<void(const std::string &symbol, double price, int64_t time)> TickHandler;
+        typedef std::function<void(const std::string &symbol, const std::shared_ptr<const OrderBook> &book)> BookHandler;
+        typedef std::function<void(const std::string &symbol, const std::string &interval, const Kline &kline)> KlineHandler;
+        typedef std::function<void(const std::shared_ptr<const std::map<std::string, double>> &balances)> BalanceHandler;
+
+    private:
+        /**
+         * @brief An event waiting to be dispatched.
+         */
+        struct Event {
+            MarketEventType type; /**< Kind of event */
+            std::string symbol; /**< Symbol, empty for balances */
+            std::string interval; /**< Kline interval, empty for other events */
+            double price; /**< Price of EVENT_PRICE */
+            int64_t time; /**< Time of EVENT_PRICE, in milliseconds since epoch */
+            std::shared_ptr<const OrderBook> book; /**< Book of EVENT_BOOK */
+            Kline kline; /**< Closed kline of EVENT_KLINE_CLOSE */
+            std::shared_ptr<const std::map<std::string, double>> balances; /**< Balances of EVENT_BALANCE */
+        };
+
+        mutable std::mutex mMutex; ///< Protects the members below
+        std::condition_variable mReady; ///< Signalled when an event is posted or the subscription is closed
+        std::unordered_map<std::string, std::vector<TickHandler>> mTickHandlers; ///< Price handlers by symbol, "" for all
+        std::unordered_map<std::string, std::vector<BookHandler>> mBookHandlers; ///< Book handlers by symbol, "" for all
+        std::map<std::pair<std::string, std::string>, std::vector<KlineHandler>> mKlineHandlers; ///< Kline handlers by symbol,interval
+        std::vector<BalanceHandler> mBalanceHandlers; ///< Balance handlers
+        std::vector<Event> mPending; ///< Events not dispatched yet, in posting order
+        std::unordered_map<std::string, size_t> mPendingIndex; ///< Index in mPending of the coalesced event of each kind and symbol
+        uint64_t mPosted{0}; ///< Number of events posted
+        uint64_t mCoalesced{0}; ///< Number of events replaced by a newer one before being dispatched
+        bool mClosed{false}; ///< Whether the consumer stopped
+
+    public:
+        /**
+         * @brief Calls a handler on every new price of a symbol.
+         * @param symbol The symbol, empty for every symbol.
+         * @param handler The handler.
+         */
+        void onTick(const std::string &symbol, TickHandler handler);
+
+        /**
+         * @brief Calls a handler on every new order book of a symbol.
+         * @param symbol The symbol, empty for every symbol.
+         * @param handler The handler.
+         */
+        void onBook(const std::string &symbol, BookHandler handler);
+
+        /**
+         * @brief Calls a handler whenever a kline of a symbol closes.
+         * @param symbol The symbol.
+         * @param interval The kline interval, which must be subscribed in MarketData.
+         * @param handler The handler.
+         */
+        void onKline(const std::string &symbol, const std::string &interval, KlineHandler handler);
+
+        /**
+         * @brief Calls a handler whenever the account balances change.
+         * @param handler The handler.
+         */
+        void onBalance(BalanceHandler handler);
+
+        /**
+         * @brief Checks if a handler was registered.
+         * @return true if at least one handler was registered.
+         */
+        bool hasHandlers() const;
+
+        /**
+         * @brief Posts a new price, if a handler wants it.
+         */
+        void postTick(const std::string &symbol, double price, int64_t time);
+
+        /**
+         * @brief Posts a new order book, if a handler wants it.
+         */
+        void postBook(const std::string &symbol, const std::shared_ptr<const OrderBook> &book);
+
+        /**
+         * @brief Posts a closed kline, if a handler wants it, queued after any pending one.
+         */
+        void postKlineClose(const std::string &symbol, const std::string &interval, const Kline &kline);
+
+        /**
+         * @brief Posts new balances, if a handler wants them.
+         */
+        void postBalances(const std::shared_ptr<const std::map<std::string, double>> &balances);
+
+        /**
+         * @brief Waits for events and calls their handlers on the calling thread.
+         * @param timeoutMs Maximum wait in milliseconds, 0 to only dispatch the pending events.
+         * @return The number of events dispatched, 0 on timeout or once closed.
+         */
+        size_t dispatch(int timeoutMs);
+
+        /**
+         * @brief Drops the pending events and wakes up the consumer, nothing is posted afterwards.
+         */
+        void close();
+
+        /**
+         * @brief Reopens a closed subscription, keeping its handlers.
+         */
+        void open();
+
+        /**
+         * @brief Returns the number of events posted.
+         * @return The number of events.
+         */
+        uint64_t getPostedCount() const;
+
+        /**
+         * @brief Returns the number of events replaced by a newer one of the same kind and symbol before dispatch.
+         * Closed klines are never replaced.
+         * @return The number of coalesced events.
+         */
+        uint64_t getCoalescedCount() const;
+
+    private:
+        /**
+         * @brief Queues an event, mMutex must be held.
+         * A price, book or balance event replaces the pending one of the same kind and symbol, closed klines are
+         * all kept.
+         */
+        void post(Event &&event);
+
+        /**
+         * @brief Returns the handlers of a symbol and of every symbol.
+         */
+        template<typename Handler>
+        static std::vector<Handler> handlersFor(const std::unordered_map<std::string, std::vector<Handler>> &handlers,
+                                                const std::string &symbol) {
+            std::vector<Handler> found;
+            for (const std::string &key: {symbol, std::string()}) {
+                auto it = handlers.find(key);
+                if (it != handlers.end())
+                    found.insert(found.end(), it->second.begin(), it->second.end());
+                if (symbol.empty())
+                    break;
+            }
+            return found;
+        }
+    };
+
+} // ats
+
+#endif //ATS_MARKETEVENTS_H
@@ -0,0 +1,191 @@
+/**
+ * @file Order.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the declaration of the Order struct and related enums
+*/
+
+#ifndef ATS_ORDER_H
+#define ATS_ORDER_H
+
+#include <string>
+#include <cstdint>
+#include <ctime>
+#include <type_traits>
+#include "LockFreeQueue.h"
+#include "Symbol.h"
+
+namespace ats {
+    /**
+      * @enum OrderType
+      * @brief Enum for different types of orders.
+      */
+    enum OrderType : uint8_t {
+        LIMIT,                  /**< Limit order */
+        MARKET,                 /**< Market order */
+        STOP_LOSS,              /**< Stop loss order */
+        STOP_LOSS_LIMIT,        /**< Stop loss limit order */
+        TAKE_PROFIT,            /**< Take profit order */
+        TAKE_PROFIT_LIMIT,      /**< Take profit limit order */
+        LIMIT_MAKER,            /**< Limit maker order */
+        OTCOUNT                 /**< Number of order types */
+    };
+
+    /**
+     * @brief Converts OrderType enum value to string.
+     * @param t The OrderType enum value to convert.
+     * @return A string representation of the OrderType value.
+     */
+    std::string OrderTypeToString(OrderType t);
+
+    /**
+     * @brief Converts a string to an OrderType enum value.
+     * @param s The string to convert.
+     * @return The corresponding OrderType enum value.
+     */
+    OrderType stringToOrderType(const std::string &s);
+
+    /**
+     * @enum Side
+     * @brief Enum for buy/sell side of an order.
+     */
+    enum Side : uint8_t {
+        BUY,        /**< Buy side of an order */
+        SELL,       /**< Sell side of an order */
+        SCOUNT      /**< Number of sides */
+    };
+
+    /**
+     * @brief Converts Side enum value to string.
+     * @param t The Side enum value to convert.
+     * @return A string representation of the Side value.
+     */
+    std::string SideToString(Side t);
+
+    /**
+     * @brief Converts a string to a Side enum value.
+     * @param s The string to convert.
+     * @return The corresponding Side enum value.
+     */
+    Side stringToSide(const std::string &s);
+
+    /**
+     * @enum TimeInForce
+     * @brief Enum for the time in force of an order.
+     */
+    enum TimeInForce : uint8_t {
+        TIF_NONE,   /**< No time in force (e.g. MARKET orders) */
+        GTC,        /**< Good till cancelled */
+        IOC,        /**< Immediate or cancel */
+        FOK,        /**< Fill or kill */
+        TIFCOUNT    /**< Number of time in force values */
+    };
+
+    /**
+     * @brief Converts TimeInForce enum value to string.
+     * @param t The TimeInForce enum value to convert.
+     * @return A string representation of the TimeInForce value, empty for TIF_NONE.
+     */
+    std::string TimeInForceToString(TimeInForce t);
+
+    /**
+     * @brief Converts a string to a TimeInForce enum value.
+     * @param s The string to convert.
+     * @return The corresponding TimeInForce enum value.
+     */
+    TimeInForce stringToTimeInForce(const std::string &s);
+
+
+    /**
+     * @brief Encodes an order id as the client order id sent to the exchange.
+     * @param id The OMS order id.
+     * @return The client order id, echoed back by the exchange.
+     */
+    std::string clientOrderId(long id);
+
+    /**
+     * @brief Decodes a client order id sent by the OMS.
+     * @param clientOrderId The client order id reported by the exchange.
+     * @return The OMS order id, -1 if the order was not created by the OMS.
+     */
+    long parseClientOrderId(const std::string &clientOrderId);
+
+
+    /**
+     * @brief The Order struct represents an order to be placed on an exchange.
+     * It is a trivially copyable record the size of a cache line, the symbol is interned (see Symbol.h).
+     */
+    struct alignas(CACHE_LINE_SIZE) Order {
+
+        long id; /**< The ID of the order. */
+        long emsId = 0; /**< The EMS ID of the order. */
+        double quantity = 0; /**< The quantity of the asset to buy/sell. */
+        double price = 0; /**< The price of the asset in the quote currency. */
+        double stopPrice = 0; /**< The stop price of the order (only for STOP_LOSS, STOP_LOSS_LIMIT, TAKE_PROFIT, and TAKE_PROFIT_LIMIT orders). */
+        double icebergQty = 0; /**< The iceberg quantity of the order (only for LIMIT_MAKER orders). */
+        time_t time = 0; /**< The time when the order was sent. */
+        SymbolId symbol = NO_SYMBOL; /**< The trading symbol of the order. */
+        uint16_t recvWindow = 0; /**< The receive window of the order (in milliseconds, at most 60000). */
+        OrderType type = MARKET; /**< The type of the order (e.g. LIMIT, MARKET, etc.). */
+        Side side = BUY; /**< The side of the order (e.g. BUY or SELL). */
+        TimeInForce timeInForce = TIF_NONE; /**< The time in force of the order (e.g. GTC, IOC, FOK, etc.). */
+
+        Order(long id=-1) : id(id) {}
+
+        /**
+         * @brief The Order constructor.
+         * @param id The order ID.
+         * @param symbol The interned trading symbol of the order.
+         * @param quantity The quantity of the asset to be traded in the order.
+         * @param price The price per unit of the asset in the order.
+         * @param type The type of the order (LIMIT, MARKET, STOP_LOSS, etc.).
+         * @param side The side of the order (BUY or SELL).
+         * @param stopPrice The stop price of the order (if applicable).
+         * @param icebergQty The iceberg quantity of the order (if applicable).
+         * @param recvWindow The receive window of the order (if applicable).
+         * @param emsId The ID assigned by the EMS to the order (if applicable).
+         * @param timeInForce The time in force of the order (if applicable).
+         * @param time The time when the order was sent
+         */
+        Order(long id, OrderType type, Side side, SymbolId symbol, double quantity, double price,
+              double stopPrice = 0., double icebergQty = 0., long recvWindow = 0, long emsId = 0,
+              TimeInForce timeInForce = TIF_NONE, time_t time=0) {
+            this->id = id;
+            this->side = side;
+            this->symbol = symbol;
+            this->quantity = quantity;
+            this->type = type;
+            this->price = price;
+            this->stopPrice = stopPrice;
+            this->icebergQty = icebergQty;
+            this->recvWindow = uint16_t(recvWindow);
+            this->emsId = emsId;
+            this->timeInForce = timeInForce;
+            this->time = time;
+        }
+
+        /**
+         * @brief The Order constructor, interning the symbol name.
+         * @see Order(long, OrderType, Side, SymbolId, double, double, double, double, long, long, TimeInForce, time_t)
+         */
+        Order(long id, OrderType type, Side side, const std::string &symbol, double quantity, double price,
+              double stopPrice = 0., double icebergQty = 0., long recvWindow = 0, long emsId = 0,
+              TimeInForce timeInForce = TIF_NONE, time_t time=0)
+                : Order(id, type, side, stringToSymbol(symbol), quantity, price, stopPrice, icebergQty,
+                        recvWindow, emsId, timeInForce, time) {}
+
+        /**
+         * @brief Returns the trading symbol name.
+         * @return The symbol name.
+         */
+        const std::string &symbolName() const {
+            return SymbolToString(symbol);
+        }
+    };
+
+    static_assert(std::is_trivially_copyable<Order>::value, "Order must stay trivially copyable");
+    static_assert(sizeof(Order) == CACHE_LINE_SIZE, "Order must fit in a cache line");
+
+} // ats
+
+#endif //ATS_ORDER_H
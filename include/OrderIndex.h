@@ -0,0 +1,222 @@
+/**
+ * @file OrderIndex.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the OrderIndex class, the persistent table of orders known to the OMS.
+ * The index is updated in place by a single writer (the EMS thread) which reconciles it against the
+ * open orders reported by the exchange and emits change events. Readers never take a lock: every
+ * write is published through a sequence counter and readers retry when they overlap a write.
+*/
+
+#ifndef ATS_ORDERINDEX_H
+#define ATS_ORDERINDEX_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Order.h"
+
+namespace ats {
+
+    /**
+     * @brief An order together with the quantity already executed on the exchange.
+     */
+    struct OrderState {
+        Order order; /**< The order */
+        double executedQty = 0; /**< The quantity already filled */
+    };
+
+    /**
+     * @enum OrderEventType
+     * @brief Enum for the changes applied to the order index.
+     */
+    enum OrderEventType : uint8_t {
+        ORDER_NEW,          /**< The order was added to the index */
+        ORDER_FILL,         /**< The executed quantity of the order changed */
+        ORDER_REMOVED,      /**< The order is no longer open on the exchange */
+        OECOUNT             /**< Number of order event types */
+    };
+
+    /**
+     * @brief Converts OrderEventType enum value to string.
+     * @param t The OrderEventType enum value to convert.
+     * @return A string representation of the OrderEventType value.
+     */
+    std::string OrderEventTypeToString(OrderEventType t);
+
+    /**
+     * @brief A change applied to the order index.
+     */
+    struct OrderEvent {
+        OrderEventType type; /**< What changed */
+        OrderState state; /**< The order after the change (before it for ORDER_REMOVED) */
+        double filledQty; /**< Quantity filled since the previous state (ORDER_FILL only) */
+    };
+
+    typedef std::function<void(const OrderEvent &)> OrderEventCallback; ///< Receives order index changes
+
+    /**
+     * @brief Fixed-capacity open-addressing table of orders keyed by id, with a secondary index by symbol and side.
+     */
+    class OrderIndex {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 4096; ///< Default number of slots
+
+    private:
+        /**
+         * @brief Slot state.
+         */
+        enum SlotState : uint8_t {
+            EMPTY,      /**< Never used since the last compaction */
+            USED,       /**< Holds an order */
+            DELETED     /**< Tombstone left by a removal */
+        };
+
+        /**
+         * @brief A table slot, linked to the other slots of its (symbol, side) bucket.
+         */
+        struct Slot {
+            OrderState state; /**< The stored order */
+            int32_t next = -1; /**< Next slot in the same bucket */
+            int32_t prev = -1; /**< Previous slot in the same bucket */
+            int32_t usedPos = -1; /**< Position in mUsed (writer only) */
+            uint32_t mark = 0; /**< Last reconciliation that saw the order (writer only) */
+            SlotState slotState = EMPTY; /**< Whether the slot holds an order */
+        };
+
+        static constexpr size_t BUCKETS = 1024; ///< Number of (symbol, side) buckets
+
+        const size_t mCapacity; ///< Number of slots (power of two)
+        const size_t mMask; ///< mCapacity - 1
+        std::unique_ptr<Slot[]> mSlots; ///< The table
+        std::unique_ptr<int32_t[]> mBuckets; ///< First slot of each (symbol, side) bucket
+        std::vector<int32_t> mUsed; ///< Dense list of used slots (writer only)
+        size_t mDeleted{0}; ///< Number of tombstones (writer only)
+        uint32_t mEpoch{0}; ///< Current reconciliation (writer only)
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> mVersion{0}; ///< Odd while a write is in progress
+        std::atomic<size_t> mSize{0}; ///< Number of orders
+
+    public:
+        /**
+         * @brief Constructs an empty index.
+         * @param capacity Number of slots, rounded up to a power of two. The index holds up to 3/4 of it.
+         */
+        explicit OrderIndex(size_t capacity = DEFAULT_CAPACITY);
+
+        OrderIndex(const OrderIndex &) = delete;
+
+        OrderIndex &operator=(const OrderIndex &) = delete;
+
+        /**
+         * @brief Looks up an order by id, lock-free.
+         * @param id The order id.
+         * @param state Receives the order if found.
+         * @return true if the order is in the index.
+         */
+        bool find(long id, OrderState &state) const;
+
+        /**
+         * @brief Returns all orders, lock-free.
+         * @return The orders in the index.
+         */
+        std::vector<OrderState> getOrders() const;
+
+        /**
+         * @brief Returns the orders of a symbol and side, lock-free.
+         * @param symbol The interned symbol.
+         * @param side The order side.
+         * @return The matching orders.
+         */
+        std::vector<OrderState> getOrders(SymbolId symbol, Side side) const;
+
+        /**
+         * @brief Returns the number of orders.
+         * @return The number of orders in the index.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Inserts or updates an order, writer only.
+         * @param state The order and its executed quantity.
+         * @param onEvent Receives ORDER_NEW or ORDER_FILL if something changed.
+         * @return false if the index is full.
+         */
+        bool upsert(const OrderState &state, const OrderEventCallback &onEvent = nullptr);
+
+        /**
+         * @brief Removes an order, writer only.
+         * @param id The order id.
+         * @param onEvent Receives ORDER_REMOVED if the order was in the index.
+         * @return true if the order was removed.
+         */
+        bool erase(long id, const OrderEventCallback &onEvent = nullptr);
+
+        /**
+         * @brief Applies the difference between the index and the open orders reported by the exchange, writer only.
+         * @param openOrders Every order currently open on the exchange.
+         * @param onEvent Receives one event per inserted, filled or removed order.
+         */
+        void reconcile(const std::vector<OrderState> &openOrders, const OrderEventCallback &onEvent = nullptr);
+
+    private:
+        /**
+         * @brief Returns the home slot of an id.
+         */
+        size_t slotFor(long id) const;
+
+        /**
+         * @brief Returns the bucket of a (symbol, side) pair.
+         */
+        static size_t bucketFor(SymbolId symbol, Side side);
+
+        /**
+         * @brief Returns the slot holding id, or -1, writer only.
+         */
+        int32_t findSlot(long id) const;
+
+        /**
+         * @brief Runs a read section until it does not overlap a write.
+         */
+        template<typename F>
+        void read(F f) const {
+            while (true) {
+                uint64_t version = mVersion.load(std::memory_order_acquire);
+                if (version & 1)
+                    continue;
+                f();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (mVersion.load(std::memory_order_relaxed) == version)
+                    return;
+            }
+        }
+
+        /**
+         * @brief Starts a write section.
+         */
+        void beginWrite();
+
+        /**
+         * @brief Ends a write section.
+         */
+        void endWrite();
+
+        /**
+         * @brief Places an order in a free slot and links it, inside a write section.
+         */
+        bool place(const OrderState &state);
+
+        /**
+         * @brief Unlinks and frees a used slot, inside a write section.
+         */
+        void release(int32_t slot);
+
+        /**
+         * @brief Rebuilds the table without tombstones, inside a write section.
+         */
+        void compact();
+    };
+
+} // ats
+
+#endif //ATS_ORDERINDEX_H
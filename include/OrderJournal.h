@@ -0,0 +1,178 @@
+/**
+ * @file OrderJournal.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the OrderJournal class, a binary append-only journal of order lifecycle events.
+ * Records are pushed by the OMS and EMS threads into a lock-free queue and copied in batches by a writer
+ * thread into a memory-mapped file, which is flushed asynchronously. Opening an existing journal replays
+ * it sequentially, which lets the OrderManager rebuild its state at startup without querying the exchange.
+ * Opening also compacts the journal, so that it only grows with the orders that are still open.
+*/
+
+#ifndef ATS_ORDERJOURNAL_H
+#define ATS_ORDERJOURNAL_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Clock.h"
+#include "LockFreeQueue.h"
+#include "WaitStrategy.h"
+#include "Order.h"
+
+namespace ats {
+    /**
+     * @enum JournalEvent
+     * @brief Enum for the order lifecycle events recorded in the journal.
+     */
+    enum JournalEvent : uint8_t {
+        JOURNAL_CREATED,    /**< The order was created by a strategy */
+        JOURNAL_SENT,       /**< The order passed the pre-trade checks and was handed to the EMS */
+        JOURNAL_ACKED,      /**< The exchange accepted the order, the record holds its EMS id */
+        JOURNAL_REJECTED,   /**< The OMS or the exchange rejected the order */
+        JOURNAL_FILLED,     /**< The executed quantity of the order changed */
+        JOURNAL_CANCELLED,  /**< A cancel was requested for the order */
+        JOURNAL_CLOSED,     /**< The order is no longer open on the exchange */
+        JECOUNT             /**< Number of journal events */
+    };
+
+    /**
+     * @brief Converts JournalEvent enum value to string.
+     * @param e The JournalEvent enum value to convert.
+     * @return A string representation of the JournalEvent value.
+     */
+    std::string JournalEventToString(JournalEvent e);
+
+    constexpr size_t JOURNAL_SYMBOL_SIZE = 32; ///< Room for a symbol name in a journal record, null included
+
+    /**
+     * @brief A journal record, stored as is in the file.
+     * Symbol ids are interned per process, so the record carries the symbol name and the id of the order is
+     * remapped from it on replay.
+     */
+    struct JournalRecord {
+        Order order; /**< The order, with its EMS id once acknowledged */
+        uint64_t sequence = 0; /**< Position of the record in the journal, starting at 1 (0 marks the end) */
+        int64_t time = 0; /**< Time of the event, in nanoseconds since the epoch */
+        double executedQty = 0; /**< Executed quantity (JOURNAL_ACKED, JOURNAL_FILLED) */
+        JournalEvent event = JOURNAL_CREATED; /**< The event */
+        char symbol[JOURNAL_SYMBOL_SIZE] = {}; /**< Name of the order symbol, null-terminated */
+    };
+
+    static_assert(std::is_trivially_copyable<JournalRecord>::value, "JournalRecord is written to the file as is");
+    static_assert(sizeof(JournalRecord) == 2 * CACHE_LINE_SIZE, "The symbol name fits in the padding of the record");
+
+    typedef std::function<void(const JournalRecord &)> JournalCallback; ///< Receives replayed journal records
+
+    /**
+     * @brief Append-only memory-mapped journal of order lifecycle events.
+     */
+    class OrderJournal {
+    public:
+        static constexpr size_t DEFAULT_QUEUE_CAPACITY = 4096; ///< Default number of records waiting to be written
+        static constexpr size_t INITIAL_RECORDS = 8192; ///< Records the file is sized for when created, doubled when full
+
+    private:
+        MPSCQueue<JournalRecord> mRecords; ///< Records waiting to be written
+        Waiter mWaiter; ///< Used by the writer thread to wait for records
+        std::thread mWriterThread; ///< Copies records to the mapped file
+        std::mutex mOpenMutex; ///< Serializes open and close
+        std::atomic<bool> mRunning{false}; ///< Whether the writer thread is running
+        std::chrono::milliseconds mFlushInterval; ///< Period of the asynchronous flushes
+        Clock &mClock; ///< The clock the records are timestamped with
+        int mFd{-1}; ///< Journal file descriptor
+        char *mMap{nullptr}; ///< Mapped file
+        size_t mMapSize{0}; ///< Size of the mapping in bytes
+        std::atomic<uint64_t> mRecordCount{0}; ///< Records in the file (replayed and written)
+
+    public:
+        /**
+         * @brief Constructs a closed journal.
+         * @param queueCapacity Number of records that can wait for the writer before append() spins.
+         * @param flushInterval Period of the asynchronous flushes of the mapped file.
+         * @param clock The clock the records are timestamped with, on its wall time.
+         */
+        explicit OrderJournal(size_t queueCapacity = DEFAULT_QUEUE_CAPACITY,
+                              std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100),
+                              Clock &clock = realClock());
+
+        /**
+         * @brief Flushes and closes the journal.
+         */
+        ~OrderJournal();
+
+        OrderJournal(const OrderJournal &) = delete;
+
+        OrderJournal &operator=(const OrderJournal &) = delete;
+
+        /**
+         * @brief Opens or creates a journal, compacts and replays its records and starts the writer thread.
+         * @see compact()
+         * @param path Path of the journal file.
+         * @param onRecord Receives every record already in the journal, in order, with the symbol of the order interned.
+         * @return false if the file cannot be opened or is not a journal.
+         */
+        bool open(const std::string &path, const JournalCallback &onRecord = nullptr);
+
+        /**
+         * @brief Writes the queued records, flushes the file and stops the writer thread.
+         */
+        void close();
+
+        /**
+         * @brief Checks if the journal is open.
+         * @return true if records are being written.
+         */
+        bool isOpen();
+
+        /**
+         * @brief Queues a record, lock-free; spins only if the writer thread falls a whole queue behind.
+         * @param event The lifecycle event.
+         * @param order The order.
+         * @param executedQty The executed quantity, if relevant to the event.
+         */
+        void append(JournalEvent event, const Order &order, double executedQty = 0);
+
+        /**
+         * @brief Returns the number of records in the file.
+         * @return The records replayed at open plus the ones written since.
+         */
+        uint64_t getRecordCount();
+
+    private:
+        /**
+         * @brief The writer thread loop.
+         */
+        void run();
+
+        /**
+         * @brief Rewrites the journal with only the records of the open orders, then renames it over the old one.
+         * An open order keeps its latest JOURNAL_ACKED or JOURNAL_FILLED record and its latest record, and the
+         * last record of the highest order id is kept so the id high-water mark survives.
+         * @param path Path of the journal file.
+         * @param count Number of records in the mapped journal, updated to the number kept.
+         * @return false if the journal could not be rewritten; the file is then closed if it was lost.
+         */
+        bool compact(const std::string &path, uint64_t &count);
+
+        /**
+         * @brief Maps the file with at least the given size, growing it if needed.
+         */
+        bool map(size_t size);
+
+        /**
+         * @brief Unmaps and closes the file.
+         */
+        void unmap();
+
+        /**
+         * @brief Copies a record after the last one, writer only.
+         */
+        bool write(JournalRecord &record);
+    };
+
+} // ats
+
+#endif //ATS_ORDERJOURNAL_H
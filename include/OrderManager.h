@@ -16,115 +16,19 @@
 #include <vector>
 #include <unordered_map>
 #include <set>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include "LockFreeQueue.h"
+#include "WaitStrategy.h"
+#include "Order.h"
+#include "OrderIndex.h"
+#include "ExecutionReport.h"
+#include "OrderValidator.h"
+#include "OrderJournal.h"
+#include "LatencyTracker.h"
 
 namespace ats {
-    /**
-      * @enum OrderType
-      * @brief Enum for different types of orders.
-      */
-    enum OrderType {
-        LIMIT,                  /**< Limit order */
-        MARKET,                 /**< Market order */
-        STOP_LOSS,              /**< Stop loss order */
-        STOP_LOSS_LIMIT,        /**< Stop loss limit order */
-        TAKE_PROFIT,            /**< Take profit order */
-        TAKE_PROFIT_LIMIT,      /**< Take profit limit order */
-        LIMIT_MAKER,            /**< Limit maker order */
-        OTCOUNT                 /**< Number of order types */
-    };
-
-    /**
-     * @brief Converts OrderType enum value to string.
-     * @param t The OrderType enum value to convert.
-     * @return A string representation of the OrderType value.
-     */
-    std::string OrderTypeToString(OrderType t);
-
-    /**
-     * @brief Converts a string to an OrderType enum value.
-     * @param s The string to convert.
-     * @return The corresponding OrderType enum value.
-     */
-    OrderType stringToOrderType(const std::string &s);
-
-    /**
-     * @enum Side
-     * @brief Enum for buy/sell side of an order.
-     */
-    enum Side {
-        BUY,        /**< Buy side of an order */
-        SELL,       /**< Sell side of an order */
-        SCOUNT      /**< Number of sides */
-    };
-
-    /**
-     * @brief Converts Side enum value to string.
-     * @param t The Side enum value to convert.
-     * @return A string representation of the Side value.
-     */
-    std::string SideToString(Side t);
-
-    /**
-     * @brief Converts a string to a Side enum value.
-     * @param s The string to convert.
-     * @return The corresponding Side enum value.
-     */
-    Side stringToSide(const std::string &s);
-
-
-    /**
-     * @brief The Order struct represents an order to be placed on an exchange.
-     */
-    struct Order {
-
-        long id; /**< The ID of the order. */
-        std::string symbol; /**< The trading symbol of the order. */
-        double quantity; /**< The quantity of the asset to buy/sell. */
-        double price; /**< The price of the asset in the quote currency. */
-        OrderType type; /**< The type of the order (e.g. LIMIT, MARKET, etc.). */
-        Side side; /**< The side of the order (e.g. BUY or SELL). */
-        double stopPrice; /**< The stop price of the order (only for STOP_LOSS, STOP_LOSS_LIMIT, TAKE_PROFIT, and TAKE_PROFIT_LIMIT orders). */
-        double icebergQty; /**< The iceberg quantity of the order (only for LIMIT_MAKER orders). */
-        long recvWindow; /**< The receive window of the order (in milliseconds). */
-        long emsId; /**< The EMS ID of the order. */
-        std::string timeInForce; /**< The time in force of the order (e.g. GTC, IOC, FOK, etc.). */
-        time_t time; /**< The time when the order was sent. */
-
-        Order(long id=-1) : id(id) {}
-
-        /**
-         * @brief The Order constructor.
-         * @param id The order ID.
-         * @param symbol The trading symbol of the order.
-         * @param quantity The quantity of the asset to be traded in the order.
-         * @param price The price per unit of the asset in the order.
-         * @param type The type of the order (LIMIT, MARKET, STOP_LOSS, etc.).
-         * @param side The side of the order (BUY or SELL).
-         * @param stopPrice The stop price of the order (if applicable).
-         * @param icebergQty The iceberg quantity of the order (if applicable).
-         * @param recvWindow The receive window of the order (if applicable).
-         * @param emsId The ID assigned by the EMS to the order (if applicable).
-         * @param timeInForce The time in force of the order (if applicable).
-         * @param time The time when the order was sent
-         */
-        Order(long id, OrderType type, Side side, std::string symbol, double quantity, double price,
-              double stopPrice = 0., double icebergQty = 0., long recvWindow = 0, long emsId = 0,
-              std::string timeInForce = "", time_t time=0) {
-            this->id = id;
-            this->side = side;
-            this->symbol = symbol;
-            this->quantity = quantity;
-            this->type = type;
-            this->price = price;
-            this->stopPrice = stopPrice;
-            this->icebergQty = icebergQty;
-            this->recvWindow = recvWindow;
-            this->emsId = emsId;
-            this->timeInForce = timeInForce;
-            this->time = time;
-        }
-    };
-
     /**
      * @brief The OrderBook struct represents the orderbook.
      */
@@ -133,6 +37,7 @@ namespace ats {
         std::vector<double> bidVol; /**< The bid volumes. */
         std::vector<double> ask; /**< The ask prices. */
         std::vector<double> askVol; /**< The ask volumes. */
+        uint64_t lastUpdateId = 0; /**< The exchange update id the book is at, 0 if unknown. */
         /**
          * @brief The OrderBook constructor.
          * @param bid The bid prices.
@@ -148,35 +53,107 @@ namespace ats {
         }
     };
 
+    /**
+     * @brief Snapshot of the OrderManager queue depths.
+     */
+    struct QueueDepths {
+        size_t pending; /**< Orders created by strategies, waiting to be processed by the OMS */
+        size_t orders; /**< Processed orders waiting to be sent by the EMS */
+        size_t cancels; /**< Cancel requests waiting to be sent by the EMS */
+    };
+
+    /**
+     * @brief An order waiting for its execution report, registered only when a handle or a callback is requested.
+     */
+    struct PendingExecution {
+        std::optional<std::promise<ExecutionReport>> report; /**< Completes the future of the order handle, if any */
+        ExecutionCallback callback; /**< Optional completion callback */
+    };
+
+    /**
+     * @brief A partition of the traded symbols with its own queues, worker thread and sent-order table.
+     *
+     * Every order and cancel of a symbol goes through the same shard, so per-symbol ordering is preserved
+     * while different shards are processed and drained in parallel.
+     */
+    struct OrderShard {
+        OrderIndex orderIndex; ///< Orders of the shard sent to the exchange and still open
+        MPSCQueue<std::pair<long,SymbolId>> cancelOrders; ///< Orders waiting to be canceled (EMS side)
+        SPSCQueue<Order> orders; ///< Orders waiting to be sent (EMS side)
+        MPSCQueue<Order> pendingOrders; ///< Orders created by strategies, waiting to be processed by the OMS
+        std::thread thread; ///< The shard worker thread
+        std::mutex eventCallbackMutex; ///< A mutex for accessing eventCallback
+        OrderEventCallback eventCallback; ///< Receives order index changes of the shard
+        std::mutex symbolsMutex; ///< A mutex for accessing symbols
+        std::set<SymbolId> symbols; ///< Symbols traded through the shard
+        Waiter waiter; ///< Used by the worker thread to wait for pending orders
+        Waiter exchangeWaiter; ///< Used by the EMS thread of the shard to wait for orders and cancels
+        std::mutex executionsMutex; ///< A mutex for accessing executions
+        std::unordered_map<long, PendingExecution> executions; ///< Orders of the shard not reported by the EMS yet
+
+        /**
+         * @brief Construct an empty shard
+         *
+         * @param queueCapacity capacity of each order queue
+         * @param waitPolicy how the worker thread waits when there are no pending orders
+         */
+        OrderShard(size_t queueCapacity, WaitPolicy waitPolicy);
+    };
+
     /**
      * @brief A class for managing orders
+     *
+     * Symbols are partitioned across one or more shards (symbol id modulo the shard count), each with its
+     * own worker thread and queues, so that submission and cancellation scale with the number of shards.
      */
     class OrderManager {
+    public:
+        static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1024; ///< Default capacity of each order queue
+        static constexpr size_t VALIDATION_BATCH = 64; ///< Maximum number of pending orders validated at once
+        static constexpr int ID_TIME_SHIFT = 20; ///< Order ids start at the start time in seconds shifted by this
+
     private:
-        std::unordered_map<long,Order> mSentOrders; ///< A map of all orders sent
-        std::queue<std::pair<long,std::string>> mCancelOrders; ///< A queue of orders waiting to be canceled (EMS side)
-        std::queue<Order> mOrders; ///< A queue of orders waiting to be processed (EMS side)
-        std::queue<Order> mPendingOrders; ///< A queue of orders that have been sent and are waiting for confirmation
-        std::thread mOrderManagerThread; ///< A thread for processing orders
-        std::mutex mOrderCountMutex; ///< A mutex for accessing the order count
-        std::mutex mOrderFetchMutex; ///< A mutex for accessing mSentOrders
-        bool mRunning; ///< A flag indicating if the order manager is running
-        long mOrderCount; ///< A counter for the number of orders processed
-        std::set<std::string> mSymbols; ///< A set of subscribed symbols
-        double mLastOrderQty;
+        OrderValidator mValidator; ///< Pre-trade checks against the exchange filters
+        OrderJournal mJournal; ///< Order lifecycle journal, written only once opened
+        LatencyTracker mLatency; ///< Time spent by the orders in each stage, from creation to acknowledgement
+        std::vector<std::unique_ptr<OrderShard>> mShards; ///< The shards, indexed by symbol id modulo their count
+        std::atomic<bool> mRunning{false}; ///< A flag indicating if the order manager is running
+        /// The next order id, seeded from the clock so that ids stay unique across restarts without a journal
+        std::atomic<long> mOrderCount{long(std::time(nullptr)) << ID_TIME_SHIFT};
+
+        /**
+         * @brief Assign an id to an order and queue it, registering its execution only if it is awaited
+         *
+         * @param order The order to queue
+         * @param callback Optional callback receiving the execution report
+         * @param handle Whether the returned handle must be completed by the execution report
+         *
+         * @return OrderHandle Handle to the order, its id is -1 if the pending queue is full
+         */
+        OrderHandle queueOrder(Order &order, ExecutionCallback callback, bool handle);
     public:
         /**
          * @brief Construct a new OrderManager object
          *
+         * @param queueCapacity capacity of each order queue, createOrder fails once the pending queue is full
+         * @param waitPolicy how the shard threads wait when there are no pending orders
+         * @param shards number of shards, each with its own worker thread
+         * @param clock clock the journal records are timestamped with
          */
-        OrderManager();
+        explicit OrderManager(size_t queueCapacity = DEFAULT_QUEUE_CAPACITY, WaitPolicy waitPolicy = PARK,
+                              size_t shards = 1, Clock &clock = realClock());
 
         /**
          * @brief Construct a new OrderManager with an initial symbols list
          *
          * @param symbols an initial list of traded symbols
+         * @param queueCapacity capacity of each order queue, createOrder fails once the pending queue is full
+         * @param waitPolicy how the shard threads wait when there are no pending orders
+         * @param shards number of shards, each with its own worker thread
+         * @param clock clock the journal records are timestamped with
          */
-         OrderManager(std::vector<std::string> symbols);
+         OrderManager(std::vector<std::string> symbols, size_t queueCapacity = DEFAULT_QUEUE_CAPACITY,
+                      WaitPolicy waitPolicy = PARK, size_t shards = 1, Clock &clock = realClock());
 
         /**
          * @brief Destroy the OrderManager object
@@ -185,20 +162,23 @@ namespace ats {
         ~OrderManager();
 
         /**
-         * @brief Start the order manager thread
+         * @brief Start the shard threads
          *
          */
         void start();
 
         /**
-         * @brief Run the order manager loop
+         * @brief Run the order manager loop of a shard
          *
+         * @param shard index of the shard
          */
-        void run();
+        void run(size_t shard = 0);
 
         /**
-         * @brief Stop the order manager thread
+         * @brief Stop the shard threads
          *
+         * Orders still waiting to be processed are dropped, their handles and callbacks receive a rejected report
+         * from the calling thread. Orders already handed to the EMS are reported by the EMS.
          */
         void stop();
 
@@ -209,19 +189,6 @@ namespace ats {
          */
         bool isRunning();
 
-        /**
-         * @brief Get last filled order quantity
-         *
-         * @return -1 if not set, quantity of last filled order otherwise.
-         */
-         double getLastOrderQty();
-
-         /**
-          * @brief Sets last filled order quantity
-          *
-          */
-          void setLastOrderQty(double qty);
-
         /**
          * @brief Create a new order and add it to the queue
          *
@@ -230,19 +197,43 @@ namespace ats {
          * @param symbol The symbol to trade
          * @param quantity The quantity to trade
          * @param price The price to trade
+         * @param callback Optional callback receiving the execution report, invoked from the EMS thread
          *
-         * @return Order Id
+         * @return OrderHandle Handle to the order execution report, its id is -1 if the pending queue is full
          */
-        long createOrder(OrderType type, Side side, std::string symbol, double quantity, double price=0);
+        OrderHandle createOrder(OrderType type, Side side, std::string symbol, double quantity, double price=0,
+                                ExecutionCallback callback=nullptr);
 
         /**
          * @brief Add an order to the queue
          *
          * @param order The order to add
+         * @param callback Optional callback receiving the execution report, invoked from the EMS thread
+         *
+         * @return OrderHandle Handle to the order execution report, its id is -1 if the pending queue is full
+         */
+        OrderHandle createOrder(Order& order, ExecutionCallback callback=nullptr);
+
+        /**
+         * @brief Add an order to the queue without a handle, for callers that do not wait for its report
+         *
+         * Nothing is registered for the order unless a callback is given, so the submission only touches the
+         * pending queue.
+         *
+         * @param order The order to add
+         * @param callback Optional callback receiving the execution report, invoked from the EMS thread
          *
-         * @return Order Id
+         * @return long ID of the order, -1 if the pending queue is full
          */
-        long createOrder(Order& order);
+        long submitOrder(Order& order, ExecutionCallback callback=nullptr);
+
+        /**
+         * @brief Report the outcome of a sent order, completing its handle and invoking its callback
+         *
+         * @param order The order as sent
+         * @param report The execution report
+         */
+        void reportExecution(const Order &order, ExecutionReport report);
 
         /**
          * @brief Cancel an order
@@ -250,8 +241,19 @@ namespace ats {
          * @param orderId ID of the order
          * @param symbol Symbol of the order
          *
+         * @return false if the cancel queue is full
          */
-        void cancelOrder(long orderId, std::string symbol);
+        bool cancelOrder(long orderId, const std::string &symbol);
+
+        /**
+         * @brief Cancel an order
+         *
+         * @param orderId ID of the order
+         * @param symbol Interned symbol of the order
+         *
+         * @return false if the cancel queue is full
+         */
+        bool cancelOrder(long orderId, SymbolId symbol);
 
         /**
          * @brief Cancel all orders
@@ -259,50 +261,140 @@ namespace ats {
          void cancelAllOrders();
 
          /**
-          * @brief Update open orders
+          * @brief Reconcile the local open orders with the ones reported by the exchange
           *
-          * @param openOrders the new list of open orders
+          * Only the differences are applied: new orders are inserted, executed quantities updated and
+          * orders that are no longer open removed, each change being reported to the event callback.
+          *
+          * @param openOrders every order currently open on the exchange with its executed quantity
           */
-          void updateOpenOrders(std::unordered_map<long,Order> openOrders);
+          void updateOpenOrders(const std::vector<OrderState> &openOrders);
+
+         /**
+          * @brief Reconcile the open orders of a single shard, to be called by the thread draining that shard
+          *
+          * @param shard index of the shard
+          * @param openOrders every order of the shard symbols currently open on the exchange
+          */
+          void updateOpenOrders(size_t shard, const std::vector<OrderState> &openOrders);
+
+          /**
+           * @brief Record an order acknowledged by the exchange
+           *
+           * @param order the order as sent, with its EMS id
+           * @param executedQty the quantity already filled
+           */
+          void updateSentOrder(const Order &order, double executedQty);
+
+          /**
+           * @brief Remove an order canceled by the exchange, without waiting for the next reconciliation
+           *
+           * @param orderId the OMS id of the order
+           * @param symbol the symbol of the order
+           */
+          void updateCanceledOrder(long orderId, SymbolId symbol);
+
+          /**
+           * @brief Set the callback receiving open order changes (new, filled, removed)
+           *
+           * The callback is invoked from the thread reconciling orders, usually the EMS thread.
+           *
+           * @param callback the callback, nullptr to disable
+           */
+          void setOrderEventCallback(OrderEventCallback callback);
 
         /**
-         * @brief Process a single order
+         * @brief Validate and process a single order, rejected orders are reported without reaching the EMS
          *
          * @param order The order to process
          */
         void processOrder(Order order);
 
         /**
-         * @brief Process all orders in the queue
+         * @brief Open the order journal, rebuilding the orders and id counter recorded in it
+         *
+         * Must be called before orders are created and before the EMS is started: the open orders found in the
+         * journal are restored in the sent-order tables and every lifecycle event is recorded from then on.
+         *
+         * @param path Path of the journal file, created if it does not exist
+         *
+         * @return false if the journal cannot be opened
+         */
+        bool openJournal(const std::string &path);
+
+        /**
+         * @brief Flush and close the order journal
+         */
+        void closeJournal();
+
+        /**
+         * @brief Get the latency statistics of the orders, per stage and symbol
          *
+         * @return LatencyTracker& the tracker timestamping every order
          */
-        void processOrders();
+        LatencyTracker &getLatencyTracker();
+
+        /**
+         * @brief Get the pre-trade checks, to load the exchange filters
+         *
+         * @return OrderValidator& the validator used by processOrder
+         */
+        OrderValidator &getValidator();
+
+        /**
+         * @brief Process all orders in the queue of a shard
+         *
+         * @param shard index of the shard
+         */
+        void processOrders(size_t shard = 0);
+
+        /**
+         * @brief Get the number of shards
+         *
+         * @return size_t the number of shards
+         */
+        size_t getShardCount();
+
+        /**
+         * @brief Get the shard handling a symbol
+         *
+         * @param symbol Interned symbol
+         *
+         * @return size_t index of the shard
+         */
+        size_t getShard(SymbolId symbol);
 
         /**
          * @brief Check if there are orders to be sent
          *
+         * @param shard index of the shard
+         *
          * @return true if there are orders waiting to be sent
          * @return false otherwise
          */
-        bool hasOrders();
+        bool hasOrders(size_t shard = 0);
 
         /**
          * @brief Check if there are orders to be cancelled
          *
+         * @param shard index of the shard
+         *
          * @return true if there are orders to cancel
          * @return false otherwise
          */
-         bool hasCancelOrders();
+         bool hasCancelOrders(size_t shard = 0);
 
         /**
-         * @brief Get the oldest order from the order queue
+         * @brief Get the oldest order from the order queue of a shard
+         *
+         * @param shard index of the shard
          *
-         * @return Order& The oldest order in the queue
+         * @return Order The oldest order in the queue
          */
-        Order &getOldestOrder();
+        Order getOldestOrder(size_t shard = 0);
 
         /**
-         * @brief Returns order by ID
+         * @brief Returns order by ID, lock-free
          *
          * @param ID ID of the order to return
          *
@@ -311,11 +403,47 @@ namespace ats {
          Order getOrderById(long ID);
 
         /**
-         * @brief Get an order to cancel
+         * @brief Returns the open orders of a symbol and side, lock-free
+         *
+         * @param symbol Interned symbol of the orders
+         * @param side Side of the orders
+         *
+         * @return std::vector<OrderState> The open orders with their executed quantity
+         */
+         std::vector<OrderState> getOpenOrders(SymbolId symbol, Side side);
+
+        /**
+         * @brief Returns every open order, lock-free
+         *
+         * @return std::vector<OrderState> The open orders with their executed quantity
+         */
+         std::vector<OrderState> getOpenOrders();
+
+        /**
+         * @brief Get an order to cancel from a shard
+         *
+         * @param shard index of the shard
          *
          * @return {id,symbol} of the order to cancel
          */
-         std::pair<long,std::string> getCancelOrder();
+         std::pair<long,SymbolId> getCancelOrder(size_t shard = 0);
+
+        /**
+         * @brief Wait until a shard has orders or cancels to send, a time is reached or stop() holds
+         *
+         * The EMS thread of the shard waits with the wait policy of the order manager instead of polling.
+         *
+         * @param shard index of the shard
+         * @param clock clock of the time
+         * @param time time in nanoseconds on the clock, no timeout if negative
+         * @param stop checked along with the queues, the EMS calls wakeExchange() after making it true
+         */
+        void waitForOrders(size_t shard, Clock &clock, int64_t time, const std::function<bool()> &stop);
+
+        /**
+         * @brief Wake up the EMS threads waiting in waitForOrders
+         */
+        void wakeExchange();
 
          /**
           * @brief Get symbols currently ordered
@@ -324,13 +452,74 @@ namespace ats {
           */
           std::vector<std::string> getSymbols();
 
+         /**
+          * @brief Get symbols currently ordered through a shard
+          *
+          * @param shard index of the shard
+          *
+          * @return std::vector<std::string> a vector of symbols
+          */
+          std::vector<std::string> getSymbols(size_t shard);
+
+          /**
+           * @brief Get the current depth of each order queue, summed over the shards
+           *
+           * @return QueueDepths the number of elements waiting in each queue
+           */
+          QueueDepths getQueueDepths();
+
+          /**
+           * @brief Get the current depth of each order queue of a shard
+           *
+           * @param shard index of the shard
+           *
+           * @return QueueDepths the number of elements waiting in each queue
+           */
+          QueueDepths getQueueDepths(size_t shard);
+
+          /**
+           * @brief Set how the shard threads wait for pending orders
+           *
+           * @param policy the new wait policy
+           */
+          void setWaitPolicy(WaitPolicy policy);
+
+          /**
+           * @brief Get how the shard threads wait for pending orders
+           *
+           * @return WaitPolicy the current wait policy
+           */
+          WaitPolicy getWaitPolicy();
+
+          /**
+           * @brief Get the measured latency between an order being created and its shard thread waking up
+           *
+           * @return WakeupStats the wake-up latency statistics of the current wait policy, over all shards
+           */
+          WakeupStats getWakeupStats();
+
     private:
         /**
-        * @brief Generate a new unique order ID
+         * @brief Process an order that went through the pre-trade checks
+         */
+        void processOrder(const Order &order, ValidationResult result);
+
+        /**
+         * @brief Get the shard handling a symbol
+         */
+        OrderShard &shardFor(SymbolId symbol);
+
+        /**
+         * @brief Record an order index change in the journal and forward it to the event callback of the shard
+         */
+        void onOrderEvent(OrderShard &shard, const OrderEvent &event);
+
+        /**
+        * @brief Generate a new unique order ID, lock-free
         *
-        * @return int A new unique order ID
+        * @return long A new unique order ID
         */
-        int getNewOrderId();
+        long getNewOrderId();
     };
 
 } // ats
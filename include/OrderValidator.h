@@ -0,0 +1,142 @@
+/**
+ * @file OrderValidator.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the OrderValidator class, the pre-trade checks run by the OMS before an order reaches the EMS.
+ * Orders are checked against the exchange filters of their symbol (tick size, lot size, price range,
+ * percent price band and minimum notional). The filters are loaded once, usually from the exchangeInfo
+ * endpoint, into a flat table indexed by SymbolId so that a check is a handful of arithmetic operations.
+*/
+
+#ifndef ATS_ORDERVALIDATOR_H
+#define ATS_ORDERVALIDATOR_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "Order.h"
+
+namespace ats {
+    /**
+     * @enum ValidationResult
+     * @brief Enum for the outcome of the pre-trade checks.
+     */
+    enum ValidationResult : uint8_t {
+        VALID,              /**< The order passed every check */
+        INVALID_QUANTITY,   /**< The quantity is not positive */
+        INVALID_PRICE,      /**< A priced order has no positive price */
+        LOT_SIZE,           /**< The quantity is out of [minQty, maxQty] or not a multiple of the step size, MARKET_LOT_SIZE for market orders */
+        PRICE_RANGE,        /**< The price is out of [minPrice, maxPrice] */
+        TICK_SIZE,          /**< The price is not a multiple of the tick size */
+        PRICE_BAND,         /**< The price is too far from the reference price */
+        MIN_NOTIONAL,       /**< price * quantity is below the minimum notional */
+        VRCOUNT             /**< Number of validation results */
+    };
+
+    /**
+     * @brief Converts ValidationResult enum value to string.
+     * @param r The ValidationResult enum value to convert.
+     * @return A string representation of the ValidationResult value.
+     */
+    std::string ValidationResultToString(ValidationResult r);
+
+    /**
+     * @brief The exchange filters of a symbol, a zero value disables the corresponding check.
+     */
+    struct SymbolFilters {
+        double minPrice = 0; /**< Minimum price (PRICE_FILTER) */
+        double maxPrice = 0; /**< Maximum price (PRICE_FILTER) */
+        double tickSize = 0; /**< Price increment (PRICE_FILTER) */
+        double minQty = 0; /**< Minimum quantity (LOT_SIZE) */
+        double maxQty = 0; /**< Maximum quantity (LOT_SIZE) */
+        double stepSize = 0; /**< Quantity increment (LOT_SIZE) */
+        double marketMinQty = 0; /**< Minimum quantity of market orders (MARKET_LOT_SIZE) */
+        double marketMaxQty = 0; /**< Maximum quantity of market orders (MARKET_LOT_SIZE) */
+        double marketStepSize = 0; /**< Quantity increment of market orders (MARKET_LOT_SIZE) */
+        double minNotional = 0; /**< Minimum price * quantity (MIN_NOTIONAL / NOTIONAL) */
+        double multiplierUp = 0; /**< Highest price allowed, relative to the reference price (PERCENT_PRICE) */
+        double multiplierDown = 0; /**< Lowest price allowed, relative to the reference price (PERCENT_PRICE) */
+        double bidMultiplierUp = 0; /**< Highest buy price allowed, relative to the reference price (PERCENT_PRICE_BY_SIDE) */
+        double bidMultiplierDown = 0; /**< Lowest buy price allowed, relative to the reference price (PERCENT_PRICE_BY_SIDE) */
+        double askMultiplierUp = 0; /**< Highest sell price allowed, relative to the reference price (PERCENT_PRICE_BY_SIDE) */
+        double askMultiplierDown = 0; /**< Lowest sell price allowed, relative to the reference price (PERCENT_PRICE_BY_SIDE) */
+        bool loaded = false; /**< Whether filters were loaded for the symbol, unknown symbols are not checked */
+    };
+
+    /**
+     * @brief Checks orders against the exchange filters of their symbol.
+     *
+     * Checks are lock-free and can run from any thread. Loading publishes a new table, which is meant to
+     * happen once at start-up; previous tables are kept alive until the validator is destroyed.
+     */
+    class OrderValidator {
+    private:
+        /**
+         * @brief An immutable filters table indexed by SymbolId.
+         */
+        struct FilterTable {
+            std::vector<SymbolFilters> filters; ///< Filters of each symbol
+            std::vector<std::atomic<double>> referencePrices; ///< Reference price of each symbol, 0 if unknown
+
+            explicit FilterTable(size_t size) : filters(size), referencePrices(size) {}
+        };
+
+        std::mutex mLoadMutex; ///< Serializes loads
+        std::vector<std::unique_ptr<FilterTable>> mTables; ///< Every table published so far
+        std::atomic<FilterTable *> mTable{nullptr}; ///< The current table
+
+    public:
+        OrderValidator() = default;
+
+        OrderValidator(const OrderValidator &) = delete;
+
+        OrderValidator &operator=(const OrderValidator &) = delete;
+
+        /**
+         * @brief Replaces the filters of every symbol, keeping the known reference prices.
+         * @param filters The filters of each symbol.
+         */
+        void load(const std::vector<std::pair<SymbolId, SymbolFilters>> &filters);
+
+        /**
+         * @brief Returns the filters of a symbol.
+         * @param symbol The interned symbol.
+         * @return The filters, not loaded if the symbol is unknown.
+         */
+        SymbolFilters getFilters(SymbolId symbol) const;
+
+        /**
+         * @brief Sets the price the percent price band is centered on (e.g. the average or last price).
+         * @param symbol The interned symbol, ignored if it has no filters.
+         * @param price The reference price, 0 to disable the band.
+         */
+        void setReferencePrice(SymbolId symbol, double price);
+
+        /**
+         * @brief Checks an order.
+         * @param order The order to check.
+         * @return VALID or the first failed check.
+         */
+        ValidationResult validate(const Order &order) const;
+
+        /**
+         * @brief Checks an array of orders against a single snapshot of the filters.
+         * @param orders The orders to check.
+         * @param count The number of orders.
+         * @param results Receives the result of each order.
+         * @return The number of valid orders.
+         */
+        size_t validate(const Order *orders, size_t count, ValidationResult *results) const;
+
+    private:
+        /**
+         * @brief Checks an order against a table.
+         */
+        static ValidationResult validate(const FilterTable *table, const Order &order);
+    };
+
+} // ats
+
+#endif //ATS_ORDERVALIDATOR_H
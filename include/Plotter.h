@@ -18,24 +18,23 @@
 #include "implot_internal.h"
 #include "fmt/format.h"
 
-enum Interval {
-    Interval_1s,
-    Interval_1m,
-    Interval_3m,
-    Interval_5m,
-    Interval_15m,
-    Interval_30m,
-    Interval_1h,
-    Interval_2h,
-    Interval_4h,
-    Interval_6h,
-    Interval_8h,
-    Interval_12h,
-    Interval_1d,
-    Interval_3d,
-    Interval_1w,
-    Interval_1M,
-};
+using ats::Interval;
+using ats::Interval_1s;
+using ats::Interval_1m;
+using ats::Interval_3m;
+using ats::Interval_5m;
+using ats::Interval_15m;
+using ats::Interval_30m;
+using ats::Interval_1h;
+using ats::Interval_2h;
+using ats::Interval_4h;
+using ats::Interval_6h;
+using ats::Interval_8h;
+using ats::Interval_12h;
+using ats::Interval_1d;
+using ats::Interval_3d;
+using ats::Interval_1w;
+using ats::Interval_1M;
 
 struct TickerData {
 
@@ -145,7 +144,7 @@ public:
 
     ats::OrderBook get_order_book(std::string ticker);
 
-    double jsonToDouble(Json::Value);
+    double jsonToDouble(const Json::Value &);
 };
 
 template<typename T>
@@ -177,11 +176,11 @@ struct ImBinance : App {
     ImPlotTime t1;
     ImPlotTime t2;
     Interval interval = Interval_1h;
-    time_t start_time;
+    int64_t last_update;
     bool m_done_upd;
 
     void Start() override {
-        time(&start_time);
+        last_update = ats::realClock().now();
         t2 = ImPlot::FloorTime(ImPlotTime::FromDouble((double) time(0)), ImPlotTimeUnit_Day);
         t1 = ImPlot::AddTime(t2, ImPlotTimeUnit_Mo, -1);
         auto d = m_api.get_ticker("BTCUSDT", t1, t2, interval);
@@ -257,14 +256,12 @@ struct ImBinance : App {
 
         }
 
-        time_t end_time;
-        time(&end_time);
-        if (difftime(end_time, start_time) > 3) {
+        if (ats::realClock().now() - last_update > 3 * ats::NANOS_PER_SECOND) {
             if (m_done_upd) {
                 if (t.joinable())
                     t.join();
                 t = std::thread(&ImBinance::UpdateData, this);
-                time(&start_time);
+                last_update = ats::realClock().now();
             }
         }
 
@@ -374,25 +371,8 @@ struct ImBinance : App {
                             ImPlot::SetupAxisFormat(ImAxis_Y1, VolumeFormatter);
                             TickerTooltip(data, true, data.interval);
                             ImPlot::SetNextFillStyle(ImVec4(1.f, 0.75f, 0.25f, 1));
-                            std::vector<double> coef(Interval_1M + 1, 1);
-                            coef[0] = 1. / 24 / 60 / 60;
-                            coef[1] = coef[0] * 60;
-                            coef[2] = coef[1] * 3;
-                            coef[3] = coef[1] * 5;
-                            coef[4] = coef[1] * 15;
-                            coef[5] = coef[1] * 30;
-                            coef[6] = coef[5] * 2;
-                            coef[7] = coef[6] * 2;
-                            coef[8] = coef[7] * 2;
-                            coef[9] = coef[7] * 3;
-                            coef[10] = coef[8] * 2;
-                            coef[11] = coef[9] * 2;
-                            coef[12] = coef[11] * 2;
-                            coef[13] = coef[12] * 3;
-                            coef[14] = coef[12] * 7;
-                            coef[15] = coef[12] * 30;
                             ImPlot::PlotBars("Volume", data.time.data(), data.volume.data(), data.size(),
-                                             60 * 60 * 24 * 0.5 * coef[data.interval]);
+                                             0.5 * ats::intervalSeconds(data.interval));
                             ImPlot::EndPlot();
                         }
                         ImPlot::EndSubplots();
@@ -424,7 +404,7 @@ struct ImBinance : App {
                             for (const auto &order: open_orders) {
                                 ImGui::Text("%s", ats::OrderTypeToString(order.type).c_str());
                                 ImGui::NextColumn();
-                                ImGui::Text("%s", order.symbol.c_str());
+                                ImGui::Text("%s", order.symbolName().c_str());
                                 ImGui::NextColumn();
                                 if (order.side == ats::BUY)
                                     ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(0, 255, 0, 255));
@@ -0,0 +1,138 @@
+/**
+ * @file PriceHistory.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the PriceHistory class, a fixed-capacity ring of timestamped prices.
+ * Every entry is written twice, at its slot and at the same slot plus the capacity, so the most recent entries
+ * are always contiguous in memory and can be handed to readers as a window without copying. A single writer may
+ * push while other threads copy prices out: slots are relaxed atomics, so a read racing a push is well defined, and
+ * readers check that the slots they copied were not overwritten and retry otherwise. Relaxed accesses compile to
+ * plain loads and stores on the usual targets.
+*/
+
+#ifndef ATS_PRICEHISTORY_H
+#define ATS_PRICEHISTORY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ats {
+
+    /**
+     * @brief A read-only view of the most recent prices, oldest first.
+     * The view points into the history and is only valid until the next push.
+     */
+    struct PriceWindow {
+        const std::atomic<double> *prices = nullptr; /**< The prices */
+        const std::atomic<int64_t> *times = nullptr; /**< The times of the prices, in milliseconds since epoch */
+        size_t size = 0; /**< Number of prices */
+
+        bool empty() const { return size == 0; }
+
+        double operator[](size_t i) const { return prices[i].load(std::memory_order_relaxed); }
+
+        int64_t time(size_t i) const { return times[i].load(std::memory_order_relaxed); }
+
+        double back() const { return (*this)[size - 1]; }
+
+        const std::atomic<double> *begin() const { return prices; }
+
+        const std::atomic<double> *end() const { return prices + size; }
+    };
+
+    /**
+     * @brief Ring buffer of the last prices of a symbol, with a single writer.
+     */
+    class PriceHistory {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 1024; ///< Default number of prices kept
+
+    private:
+        const size_t mCapacity; ///< Number of prices kept (power of two)
+        const size_t mMask; ///< mCapacity - 1
+        std::unique_ptr<std::atomic<double>[]> mPrices; ///< Prices, mirrored over 2 * mCapacity slots
+        std::unique_ptr<std::atomic<int64_t>[]> mTimes; ///< Times, mirrored over 2 * mCapacity slots
+        std::atomic<uint64_t> mCount{0}; ///< Number of prices pushed since construction or the last clear
+        std::atomic<uint64_t> mStarted{0}; ///< Number of pushes started, ahead of mCount during a push
+
+    public:
+        /**
+         * @brief Constructs an empty history.
+         * @param capacity Number of prices kept, rounded up to a power of two.
+         */
+        explicit PriceHistory(size_t capacity = DEFAULT_CAPACITY);
+
+        PriceHistory(const PriceHistory &) = delete;
+
+        PriceHistory &operator=(const PriceHistory &) = delete;
+
+        /**
+         * @brief Appends a price, dropping the oldest one when full.
+         * @param price The price.
+         * @param time The time of the price, in milliseconds since epoch.
+         */
+        void push(double price, int64_t time);
+
+        /**
+         * @brief Removes every price, writer only with no concurrent reader.
+         */
+        void clear();
+
+        /**
+         * @brief Returns the number of prices held.
+         * @return The number of prices.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Returns the number of prices kept.
+         * @return The capacity.
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Checks if the history is empty.
+         * @return true if no price was pushed since construction or the last clear.
+         */
+        bool empty() const;
+
+        /**
+         * @brief Returns the last price, safe against a concurrent push.
+         * @return The last price, -1 if empty.
+         */
+        double back() const;
+
+        /**
+         * @brief Returns the time of the last price, safe against a concurrent push.
+         * @return The time in milliseconds since epoch, 0 if empty.
+         */
+        int64_t backTime() const;
+
+        /**
+         * @brief Returns a view of the most recent prices, without concurrent push.
+         * @param count Maximum number of prices, 0 for all of them.
+         * @return The window, valid until the next push.
+         */
+        PriceWindow window(size_t count = 0) const;
+
+        /**
+         * @brief Copies the most recent prices, safe against a concurrent push.
+         * @param count Maximum number of prices, 0 for all of them.
+         * @return The prices, oldest first.
+         */
+        std::vector<double> getPrices(size_t count = 0) const;
+
+    private:
+        /**
+         * @brief Copies the last count entries of an array, retrying while the writer overwrites them.
+         */
+        template<typename T>
+        size_t read(const std::atomic<T> *values, size_t count, T *out) const;
+    };
+
+} // ats
+
+#endif //ATS_PRICEHISTORY_H
@@ -0,0 +1,152 @@
+/**
+ * @file PriceLadder.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the PriceLadder class, one side of an order book stored as a tick-indexed array.
+ * Prices are converted to integer ticks and the quantities of a window of ticks around the best price are kept
+ * in a contiguous array, with an occupancy bitmap to find the next best level. Levels outside the window are kept
+ * in an overflow map and moved into the array when the window recentres, so the ladder never loses a level.
+*/
+
+#ifndef ATS_PRICELADDER_H
+#define ATS_PRICELADDER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace ats {
+
+    /**
+     * @brief One side of a price-level book, not thread-safe.
+     */
+    class PriceLadder {
+    public:
+        static constexpr size_t DEFAULT_TICKS = 4096; ///< Default number of ticks held in the array
+
+    private:
+        const double mTickSize; ///< Price increment
+        const double mScale; ///< Ticks per price unit, exact when 1 / mTickSize is an integer
+        const bool mExactScale; ///< Whether mScale is used for conversions instead of mTickSize
+        const bool mDescending; ///< true for bids (higher is better), false for asks
+        const size_t mTicks; ///< Number of ticks in the array (power of two, at least 64)
+        std::unique_ptr<double[]> mQuantities; ///< Quantity of each tick of the window, 0 if empty
+        std::unique_ptr<uint64_t[]> mOccupied; ///< One bit per non-empty tick of the window
+        std::map<int64_t, double> mOverflow; ///< Levels outside the window, by tick
+        int64_t mBase{0}; ///< Tick of mQuantities[0]
+        int64_t mBest{-1}; ///< Index of the best level in the window, -1 if the window is empty
+        size_t mSize{0}; ///< Number of levels, overflow included
+
+    public:
+        /**
+         * @brief Constructs an empty ladder.
+         * @param tickSize Price increment of the symbol.
+         * @param descending true for the bid side, false for the ask side.
+         * @param ticks Number of ticks held in the array, rounded up to a power of two.
+         */
+        PriceLadder(double tickSize, bool descending, size_t ticks = DEFAULT_TICKS);
+
+        PriceLadder(const PriceLadder &) = delete;
+
+        PriceLadder &operator=(const PriceLadder &) = delete;
+
+        /**
+         * @brief Sets the quantity of a level.
+         * @param price The level price, rounded to the nearest tick.
+         * @param quantity The new quantity, 0 to remove the level.
+         */
+        void set(double price, double quantity);
+
+        /**
+         * @brief Removes every level.
+         */
+        void clear();
+
+        /**
+         * @brief Returns the quantity of a level.
+         * @param price The level price.
+         * @return The quantity, 0 if there is no such level.
+         */
+        double getQuantity(double price) const;
+
+        /**
+         * @brief Checks if the ladder has no level.
+         * @return true if empty.
+         */
+        bool empty() const;
+
+        /**
+         * @brief Returns the number of levels.
+         * @return The number of non-empty levels.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Returns the best price.
+         * @return The highest bid or lowest ask, 0 if empty.
+         */
+        double getBestPrice() const;
+
+        /**
+         * @brief Returns the quantity at the best price.
+         * @return The quantity, 0 if empty.
+         */
+        double getBestQuantity() const;
+
+        /**
+         * @brief Returns the quantity available at prices at least as good as a limit.
+         * @param price The limit price.
+         * @return The summed quantity of the levels between the best price and the limit.
+         */
+        double getCumulativeQuantity(double price) const;
+
+        /**
+         * @brief Returns the best levels.
+         * @param prices Receives the prices, best first.
+         * @param quantities Receives the quantities.
+         * @param depth Maximum number of levels, 0 for all of them.
+         */
+        void getLevels(std::vector<double> &prices, std::vector<double> &quantities, size_t depth = 0) const;
+
+        /**
+         * @brief Returns the tick size.
+         * @return The price increment.
+         */
+        double getTickSize() const;
+
+    private:
+        /**
+         * @brief Converts a price to a tick.
+         */
+        int64_t toTick(double price) const;
+
+        /**
+         * @brief Converts a tick to a price.
+         */
+        double toPrice(int64_t tick) const;
+
+        /**
+         * @brief Checks if a tick is better than another one.
+         */
+        bool isBetter(int64_t tick, int64_t other) const;
+
+        /**
+         * @brief Returns the next non-empty index at or after from, in the worse direction, or -1.
+         */
+        int64_t findWorse(int64_t from) const;
+
+        /**
+         * @brief Moves the window so the best tick sits a quarter of the array away from the better end.
+         */
+        void recentre(int64_t bestTick);
+
+        /**
+         * @brief Sums the quantities of the array between two indices, inclusive.
+         */
+        double sum(int64_t first, int64_t last) const;
+    };
+
+} // ats
+
+#endif //ATS_PRICELADDER_H
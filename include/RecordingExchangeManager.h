@@ -0,0 +1,90 @@
+/**
+ * @file RecordingExchangeManager.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the RecordingExchangeManager class, which records the responses of another ExchangeManager.
+ * Every call is forwarded to the recorded exchange manager and its response is appended to a recording, which a
+ * ReplayExchangeManager plays back offline. The execution reports are observed on the recorded exchange manager,
+ * so orders it sends from its own threads are recorded too.
+*/
+
+#ifndef ATS_RECORDINGEXCHANGEMANAGER_H
+#define ATS_RECORDINGEXCHANGEMANAGER_H
+
+#include "Clock.h"
+#include "ExchangeManager.h"
+#include "ExchangeRecording.h"
+
+namespace ats {
+
+    /**
+     * @brief ExchangeManager forwarding to another one and recording its responses.
+     */
+    class RecordingExchangeManager : public ExchangeManager {
+    private:
+        ExchangeManager &mExchange; ///< The recorded exchange manager
+        RecordFile mFile; ///< The recording
+        Clock &mClock; ///< The clock the responses are timestamped with
+
+    public:
+        /**
+         * @brief Starts recording an exchange manager.
+         *
+         * @param exchange The recorded exchange manager, which must outlive the recorder.
+         * @param path Path of the recording, replaced if it exists.
+         * @param clock The clock the responses are timestamped with, the one the recorded system runs on.
+         */
+        RecordingExchangeManager(ExchangeManager &exchange, const std::string &path, Clock &clock = realClock());
+
+        /**
+         * @brief Stops observing the recorded exchange manager and closes the recording.
+         */
+        ~RecordingExchangeManager() override;
+
+        /**
+         * @brief Checks if the recording could be created.
+         *
+         * @return true if responses are recorded.
+         */
+        bool isRecording();
+
+        /**
+         * @brief Writes the buffered responses to the recording.
+         */
+        void flush();
+
+        double sendOrder(Order &order) override;
+
+        void modifyOrder(Order &oldOrder, Order &newOrder) override;
+
+        void cancelOrder(Order &order) override;
+
+        void getOrderStatus(Order &order, Json::Value &result) override;
+
+        std::vector<Order> getOpenOrders(std::string symbol) override;
+
+        std::vector<Trade> getTradeHistory(std::string symbol) override;
+
+        std::vector<Trade> getTradesFrom(std::string symbol, long fromId, int limit) override;
+
+        std::map<std::string,double> getBalances() override;
+
+        void getKlines(Json::Value& result, std::string symbol, std::string interval, time_t start_date,
+                       time_t end_date, int limit) override;
+
+        double getPrice(std::string symbol) override;
+
+        std::map<std::string,double> getPrices(const std::vector<std::string> &symbols) override;
+
+        OrderBook getOrderBook(std::string symbol) override;
+
+    private:
+        /**
+         * @brief Appends a response to the recording, timestamped now.
+         */
+        void record(RecordedCall call, const std::string &key, const PayloadWriter &payload);
+    };
+
+} // ats
+
+#endif //ATS_RECORDINGEXCHANGEMANAGER_H
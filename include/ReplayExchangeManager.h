@@ -0,0 +1,155 @@
+/**
+ * @file ReplayExchangeManager.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the ReplayExchangeManager class, an ExchangeManager answering from a recording.
+ * The responses of each call and key (e.g. the prices of a symbol, or the klines of a given request) are played back
+ * in the order they were recorded. An order is acknowledged only if it has the side, type, quantity and price of the
+ * order recorded in its place, otherwise it is rejected and counted as mismatched.
+ * As fast as possible, every call takes the next response, and keeps the last one once they are exhausted. At a
+ * given speed, the recording is replayed on a clock starting at its first response: market data calls return the
+ * last response due, waiting for the first one, and orders are acknowledged no earlier than they were. On a
+ * SimulatedClock, the replay moves as the clock is advanced.
+ * Like BinanceExchangeManager, the manager drains the OrderManager from one thread per shard, so strategies run
+ * against it unchanged.
+*/
+
+#ifndef ATS_REPLAYEXCHANGEMANAGER_H
+#define ATS_REPLAYEXCHANGEMANAGER_H
+
+#include <atomic>
+#include "Clock.h"
+#include "ExchangeManager.h"
+#include "ExchangeRecording.h"
+
+namespace ats {
+
+    /**
+     * @brief ExchangeManager playing back a recording.
+     */
+    class ReplayExchangeManager : public ExchangeManager {
+    private:
+        /**
+         * @brief The responses of a call and key.
+         */
+        struct ResponseStream {
+            std::vector<std::pair<int64_t, std::string>> responses; ///< Times and payloads, in recorded order
+            size_t next{0}; ///< Index of the next response
+        };
+
+        std::mutex mMutex; ///< A mutex serialising the access to the streams
+        std::map<std::pair<RecordedCall, std::string>, ResponseStream> mStreams; ///< Responses per call and key
+        size_t mRemaining{0}; ///< Number of responses not played yet
+        bool mOpen{false}; ///< Whether the recording could be read
+        const double mSpeed; ///< Replay speed, 0 for as fast as possible
+        int64_t mFirstTime{0}; ///< Time of the first response, in nanoseconds since the epoch
+        Clock &mClock; ///< The clock the replay runs on
+        int64_t mStart; ///< When the replay started, on mClock
+        std::atomic<size_t> mMismatchedOrders{0}; ///< Orders rejected for differing from the recorded ones
+        std::atomic<bool> mRunning{false}; ///< Flag to indicate if the replay threads are running
+        std::vector<std::thread> mThreads; ///< The threads draining the OrderManager, one per shard
+
+    public:
+        /**
+         * @brief Loads a recording and starts draining the OrderManager.
+         *
+         * @param orderManager The OrderManager to retrieve orders from.
+         * @param path Path of the recording.
+         * @param speed Replay speed, 1 for the recorded pace, 0 for as fast as possible.
+         * @param clock The clock the replay runs on at a given speed.
+         */
+        ReplayExchangeManager(OrderManager &orderManager, const std::string &path, double speed = 0,
+                              Clock &clock = realClock());
+
+        /**
+         * @brief Stops draining the OrderManager.
+         */
+        ~ReplayExchangeManager() override;
+
+        /**
+         * @brief Starts draining the OrderManager.
+         */
+        void start();
+
+        /**
+         * @brief Drains the orders and cancels of a shard.
+         *
+         * @param shard Index of the shard.
+         */
+        void run(size_t shard = 0);
+
+        /**
+         * @brief Stops draining the OrderManager.
+         */
+        void stop();
+
+        /**
+         * @brief Checks if the recording could be read.
+         *
+         * @return true if responses are played back.
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Checks if every recorded response was played.
+         *
+         * @return true if the replay is over.
+         */
+        bool isFinished();
+
+        /**
+         * @brief Returns the number of orders that differed from the order recorded in their place.
+         *
+         * @return The number of mismatched orders, 0 while the strategy replays as recorded.
+         */
+        size_t getMismatchedOrders() const;
+
+        double sendOrder(Order &order) override;
+
+        void modifyOrder(Order &oldOrder, Order &newOrder) override;
+
+        void cancelOrder(Order &order) override;
+
+        void getOrderStatus(Order &order, Json::Value &result) override;
+
+        std::vector<Order> getOpenOrders(std::string symbol) override;
+
+        std::vector<Trade> getTradeHistory(std::string symbol) override;
+
+        std::vector<Trade> getTradesFrom(std::string symbol, long fromId, int limit) override;
+
+        std::map<std::string,double> getBalances() override;
+
+        void getKlines(Json::Value& result, std::string symbol, std::string interval, time_t start_date,
+                       time_t end_date, int limit) override;
+
+        double getPrice(std::string symbol) override;
+
+        std::map<std::string,double> getPrices(const std::vector<std::string> &symbols) override;
+
+        OrderBook getOrderBook(std::string symbol) override;
+
+    private:
+        /**
+         * @brief Plays back the next recorded cancel of the symbol, removing the order if it was canceled.
+         *
+         * @param orderId The OMS id of the order.
+         * @param symbol The symbol of the order.
+         */
+        void cancelOrder(long orderId, SymbolId symbol);
+
+        /**
+         * @brief Takes the response of a call, waiting until it is due.
+         *
+         * @param call The call.
+         * @param key The key of the stream.
+         * @param repeat Whether the last response is repeated once the stream is exhausted.
+         * @param payload Receives the response.
+         * @return false if there is no response.
+         */
+        bool next(RecordedCall call, const std::string &key, bool repeat, std::string &payload);
+    };
+
+} // ats
+
+#endif //ATS_REPLAYEXCHANGEMANAGER_H
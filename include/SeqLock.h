@@ -0,0 +1,81 @@
+/**
+ * @file SeqLock.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the SeqLock class template, a single-writer slot for small trivially copyable values.
+ * The writer makes a sequence counter odd while it copies the value in and even again once done. Readers copy
+ * the value out and keep it only if the counter was even and unchanged around the copy, so they never block the
+ * writer nor each other.
+*/
+
+#ifndef ATS_SEQLOCK_H
+#define ATS_SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include "LockFreeQueue.h"
+
+namespace ats {
+
+    /**
+     * @brief A value published by one writer to any number of readers.
+     * @tparam T A trivially copyable type.
+     */
+    template<typename T>
+    class alignas(CACHE_LINE_SIZE) SeqLock {
+        static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied while being written");
+
+    private:
+        std::atomic<uint64_t> mSequence{0}; ///< Odd while a store is in progress
+        T mValue{}; ///< The value
+
+    public:
+        /**
+         * @brief Publishes a value, single writer.
+         * @param value The new value.
+         */
+        void store(const T &value) {
+            uint64_t sequence = mSequence.load(std::memory_order_relaxed);
+            mSequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            mValue = value;
+            mSequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief Makes a single attempt to read the value, wait-free.
+         * @param value Receives the value on success.
+         * @return false if the read overlapped a store.
+         */
+        bool tryLoad(T &value) const {
+            uint64_t sequence = mSequence.load(std::memory_order_acquire);
+            if (sequence & 1)
+                return false;
+            value = mValue;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return mSequence.load(std::memory_order_relaxed) == sequence;
+        }
+
+        /**
+         * @brief Reads the value, retrying while it overlaps stores.
+         * @return The value.
+         */
+        T load() const {
+            T value;
+            while (!tryLoad(value));
+            return value;
+        }
+
+        /**
+         * @brief Returns the number of stores so far.
+         * @return The number of completed stores.
+         */
+        uint64_t getVersion() const {
+            return mSequence.load(std::memory_order_acquire) / 2;
+        }
+    };
+
+} // ats
+
+#endif //ATS_SEQLOCK_H
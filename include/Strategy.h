@@ -6,10 +6,16 @@
  * @author Anouar Achghaf
  * @date 12/02/2023
  * @brief Defines an abstract interface for trading strategies
+ * A strategy either polls: its thread updates the price and evaluates the signal in a loop, or is event-driven:
+ * once it registers handlers on mEvents, its thread sleeps until one of those events arrives, runs the
+ * handlers and only then evaluates the signal.
+ * The thread calls the derived class, so it is started by start() once the derived object is built and its
+ * handlers registered, and stopped by stop() before the derived object is torn down.
 */
 
 #ifndef ATS_STRATEGY_H
 #define ATS_STRATEGY_H
+#include <atomic>
 #include <thread>
 #include <vector>
 #include "MarketData.h"
@@ -21,16 +27,20 @@ namespace ats {
      * @brief Defines an abstract interface for trading strategies
      */
     class Strategy {
+    public:
+        static constexpr int EVENT_WAIT_MS = 100; ///< Longest sleep of an event-driven strategy between checks of mRunning
+
     protected:
         MarketData& mData; ///< MarketData object to get market information
         OrderManager& mOrderManager; ///< OrderManager object to create and manage orders
         std::string mSymbol; ///< The symbol the strategy is trading
         std::vector<double> mPrices; ///< Vector of historical prices
         std::thread mStrategyThread; ///< Thread for running the strategy
-        bool mRunning; ///< Flag indicating if the strategy is running
+        std::atomic<bool> mRunning{false}; ///< Flag indicating if the strategy is running
+        std::shared_ptr<EventSubscription> mEvents; ///< Market events the strategy is woken up by, polling if it has no handler
     public:
         /**
-         * @brief Constructs a Strategy object
+         * @brief Constructs a stopped Strategy object
          * @param symbol The symbol the strategy will trade
          * @param data MarketData object to get market information
          * @param orderManager OrderManager object to create and manage orders
@@ -39,12 +49,12 @@ namespace ats {
         Strategy(std::string symbol, MarketData& data, OrderManager& orderManager, std::vector<double> prices={});
 
         /**
-         * @brief Destructs the Strategy object
+         * @brief Destructs the Strategy object, which must have been stopped by the derived class or the owner
          */
         virtual ~Strategy();
 
         /**
-         * @brief Starts the strategy thread
+         * @brief Subscribes to the market events and starts the strategy thread, once the derived object is built
          */
         virtual void start();
 
@@ -54,7 +64,8 @@ namespace ats {
         virtual void run();
 
         /**
-         * @brief Stops the strategy
+         * @brief Stops the strategy thread and unsubscribes from the market events, before the derived object is
+         * destroyed
          */
         virtual void stop();
 
@@ -0,0 +1,54 @@
+/**
+ * @file Symbol.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the global symbol interning table.
+ * Symbols are interned once into a small integer SymbolId so that hot structures such as Order can
+ * refer to them without owning a string. Converting an id back to its name is lock-free.
+*/
+
+#ifndef ATS_SYMBOL_H
+#define ATS_SYMBOL_H
+
+#include <cstdint>
+#include <string>
+
+namespace ats {
+    /**
+     * @brief Interned symbol identifier.
+     */
+    typedef uint16_t SymbolId;
+
+    constexpr SymbolId NO_SYMBOL = 0; ///< Id of the empty symbol, also returned when the table is full
+    constexpr size_t MAX_SYMBOLS = 65536; ///< Maximum number of symbols that can be interned
+
+    /**
+     * @brief Converts a SymbolId to the symbol name.
+     * @param id The SymbolId to convert.
+     * @return The symbol name, an empty string for NO_SYMBOL or unknown ids.
+     */
+    const std::string &SymbolToString(SymbolId id);
+
+    /**
+     * @brief Converts a symbol name to its SymbolId, interning it on first use.
+     * @param s The symbol name.
+     * @return The corresponding SymbolId, NO_SYMBOL if s is empty or the table is full.
+     */
+    SymbolId stringToSymbol(const std::string &s);
+
+    /**
+     * @brief Looks a symbol name up without interning it, under a shared lock.
+     * @param s The symbol name.
+     * @return The corresponding SymbolId, NO_SYMBOL if s was never interned.
+     */
+    SymbolId findSymbol(const std::string &s);
+
+    /**
+     * @brief Returns the number of interned symbols, including NO_SYMBOL.
+     * @return The number of symbols.
+     */
+    size_t symbolCount();
+
+} // ats
+
+#endif //ATS_SYMBOL_H
@@ -0,0 +1,86 @@
+/**
+ * @file ThreadPool.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the ThreadPool class, a fixed set of threads running batches of blocking tasks.
+ * MarketData uses it to issue REST requests for many symbols at once while bounding the number of requests in
+ * flight. The caller of a batch works on it too and returns once every task of the batch is done.
+*/
+
+#ifndef ATS_THREADPOOL_H
+#define ATS_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ats {
+
+    /**
+     * @brief Runs batches of indexed tasks on a bounded number of threads, one batch at a time.
+     */
+    class ThreadPool {
+    private:
+        std::vector<std::thread> mWorkers; ///< Threads helping the caller of a batch
+        std::mutex mMutex; ///< Protects the batch state below
+        std::condition_variable mWork; ///< Signalled when a batch starts or the pool stops
+        std::condition_variable mDone; ///< Signalled when the last task of a batch ends
+        const std::function<void(size_t)> *mTask{nullptr}; ///< Task of the current batch
+        size_t mCount{0}; ///< Number of tasks of the current batch
+        size_t mNext{0}; ///< Index of the next task to run
+        size_t mRemaining{0}; ///< Number of tasks of the current batch not finished yet
+        uint64_t mBatch{0}; ///< Number of batches started
+        std::exception_ptr mError; ///< First exception thrown by a task of the current batch
+        bool mStopping{false}; ///< Whether the workers must exit
+
+    public:
+        /**
+         * @brief Starts the pool.
+         * @param parallelism Maximum number of tasks running at once, including the caller of a batch.
+         */
+        explicit ThreadPool(size_t parallelism);
+
+        /**
+         * @brief Stops and joins the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Returns the maximum number of tasks running at once.
+         * @return The parallelism.
+         */
+        size_t getParallelism() const;
+
+        /**
+         * @brief Runs task(0) to task(count - 1) and waits for all of them, batches are not reentrant.
+         * A task throwing does not stop the others, the first exception is rethrown once the batch is done.
+         * @param count Number of tasks.
+         * @param task The task, called concurrently with different indices.
+         */
+        void run(size_t count, const std::function<void(size_t)> &task);
+
+    private:
+        /**
+         * @brief Runs tasks of a batch until none is left, mMutex must be held.
+         * Tasks are claimed under the mutex so a late thread never runs tasks of a later batch.
+         */
+        void drain(std::unique_lock<std::mutex> &lock, uint64_t batch);
+
+        /**
+         * @brief Worker loop.
+         */
+        void work();
+    };
+
+} // ats
+
+#endif //ATS_THREADPOOL_H
@@ -0,0 +1,103 @@
+/**
+ * @file TimerWheel.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the TimerWheel class, a hashed timer wheel of deadlines identified by integer ids.
+ * Time is cut in ticks and each deadline is stored in the slot of its tick modulo the number of slots, so
+ * scheduling is constant time and expiring only visits the slots of the ticks that elapsed. Deadlines further
+ * than one revolution away share slots with nearer ones and are skipped until their turn comes.
+*/
+
+#ifndef ATS_TIMERWHEEL_H
+#define ATS_TIMERWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ats {
+
+    /**
+     * @brief Deadlines keyed by id, not thread-safe.
+     */
+    class TimerWheel {
+    public:
+        static constexpr int64_t DEFAULT_TICK_MS = 10; ///< Default tick length
+        static constexpr size_t DEFAULT_SLOTS = 1024; ///< Default number of slots
+
+    private:
+        /**
+         * @brief A deadline stored in a slot, dropped lazily once rescheduled or cancelled.
+         */
+        struct Entry {
+            uint64_t id; ///< Timer id
+            int64_t due; ///< Deadline
+        };
+
+        const int64_t mTick; ///< Tick length, in the unit of the deadlines
+        const size_t mMask; ///< Number of slots - 1
+        std::vector<std::vector<Entry>> mSlots; ///< Entries by tick modulo the number of slots
+        std::unordered_map<uint64_t, int64_t> mDeadlines; ///< Current deadline of each timer
+        int64_t mCurrentTick; ///< First tick not fully expired
+
+    public:
+        /**
+         * @brief Constructs an empty wheel.
+         * @param tick Tick length, deadlines are expired with this resolution.
+         * @param slots Number of slots, rounded up to a power of two.
+         * @param now Current time.
+         */
+        explicit TimerWheel(int64_t tick = DEFAULT_TICK_MS, size_t slots = DEFAULT_SLOTS, int64_t now = 0);
+
+        /**
+         * @brief Sets the deadline of a timer, replacing its previous one.
+         * @param id The timer id.
+         * @param due The deadline, a past deadline expires on the next call to expire.
+         */
+        void schedule(uint64_t id, int64_t due);
+
+        /**
+         * @brief Removes a timer.
+         * @param id The timer id.
+         * @return false if the timer was not scheduled.
+         */
+        bool cancel(uint64_t id);
+
+        /**
+         * @brief Checks if a timer is scheduled.
+         * @param id The timer id.
+         * @return true if the timer has a deadline.
+         */
+        bool contains(uint64_t id) const;
+
+        /**
+         * @brief Returns the number of scheduled timers.
+         * @return The number of timers.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Returns the earliest deadline.
+         * @return The deadline, -1 if no timer is scheduled.
+         */
+        int64_t nextDeadline() const;
+
+        /**
+         * @brief Removes the timers whose deadline passed.
+         * @param now Current time.
+         * @param expired Receives the ids of the expired timers.
+         * @return The number of expired timers.
+         */
+        size_t expire(int64_t now, std::vector<uint64_t> &expired);
+
+    private:
+        /**
+         * @brief Checks if a slot entry is the current deadline of its timer.
+         */
+        bool isLive(const Entry &entry) const;
+    };
+
+} // ats
+
+#endif //ATS_TIMERWHEEL_H
@@ -35,6 +35,41 @@ namespace ats {
          */
         Trade(long id_, double price_, double quantity_, double quoteQty_, long time_,
               bool isBuyerMaker_, bool isBestMatch_);
+
+        /**
+         * @brief Returns the trade ID
+         */
+        long getId() const;
+
+        /**
+         * @brief Returns the trade price
+         */
+        double getPrice() const;
+
+        /**
+         * @brief Returns the trade quantity
+         */
+        double getQuantity() const;
+
+        /**
+         * @brief Returns the trade quote quantity
+         */
+        double getQuoteQty() const;
+
+        /**
+         * @brief Returns the trade execution time, in milliseconds since epoch
+         */
+        long getTime() const;
+
+        /**
+         * @brief Returns whether the buyer is the maker
+         */
+        bool getIsBuyerMaker() const;
+
+        /**
+         * @brief Returns whether the trade was the best price match at the time
+         */
+        bool getIsBestMatch() const;
     };
 
 
@@ -0,0 +1,161 @@
+/**
+ * @file TradeTape.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the TradeTape class, the columnar trade history of one symbol.
+ * Trades are appended in id order and stored one column per field. Ids and times are kept as 32-bit offsets from
+ * the first trade of their block, so a trade takes 24 bytes, and a range scan for a VWAP or a volume profile only
+ * walks the contiguous price and quantity columns between two indices found by binary search on the times.
+*/
+
+#ifndef ATS_TRADETAPE_H
+#define ATS_TRADETAPE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Trade.h"
+
+namespace ats {
+
+    /**
+     * @brief Append-only columnar trade history, not thread-safe.
+     */
+    class TradeTape {
+    public:
+        static constexpr size_t BLOCK_SIZE = 1024; ///< Maximum number of trades sharing a base id and time
+
+    private:
+        /**
+         * @brief The base of the offsets of consecutive trades.
+         */
+        struct Block {
+            int64_t id; ///< Id of the first trade
+            int64_t time; ///< Time of the first trade, in milliseconds since epoch
+            size_t first; ///< Index of the first trade
+        };
+
+        std::vector<Block> mBlocks; ///< Blocks, in increasing first index
+        std::vector<uint32_t> mIdOffsets; ///< Id of each trade minus the id of its block
+        std::vector<uint32_t> mTimeOffsets; ///< Time of each trade minus the time of its block
+        std::vector<double> mPrices; ///< Price of each trade
+        std::vector<double> mQuantities; ///< Quantity of each trade
+        std::vector<uint64_t> mBuyerMakers; ///< Whether the buyer is the maker, one bit per trade
+        int64_t mLastId{-1}; ///< Id of the last trade, -1 if empty
+        int64_t mLastTime{0}; ///< Time of the last trade
+
+    public:
+        /**
+         * @brief Returns the number of trades.
+         * @return The number of trades.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Checks if the tape holds no trade.
+         * @return true if empty.
+         */
+        bool empty() const;
+
+        /**
+         * @brief Returns the id of the last trade, from which the next ones are fetched.
+         * @return The id, -1 if empty.
+         */
+        int64_t lastId() const;
+
+        /**
+         * @brief Adds a trade after the last one.
+         * @param trade The trade.
+         * @return false if the trade is not newer than the last one.
+         */
+        bool append(const Trade &trade);
+
+        /**
+         * @brief Adds a trade after the last one.
+         * @param id The trade ID.
+         * @param price The price.
+         * @param quantity The quantity.
+         * @param time The execution time, in milliseconds since epoch.
+         * @param isBuyerMaker Whether the buyer is the maker.
+         * @return false if the id is not greater than the last one, or the time is older.
+         */
+        bool append(int64_t id, double price, double quantity, int64_t time, bool isBuyerMaker);
+
+        /**
+         * @brief Removes every trade.
+         */
+        void clear();
+
+        /**
+         * @brief Removes the oldest trades, moving the columns once, so callers trim with some slack.
+         * @param count Number of most recent trades to keep.
+         * @return The number of trades removed.
+         */
+        size_t trim(size_t count);
+
+        /**
+         * @brief Fields of a trade, ids and times find the block of the trade by binary search.
+         * @param i Index of the trade, lower than size().
+         */
+        int64_t id(size_t i) const;
+        int64_t time(size_t i) const;
+        double price(size_t i) const;
+        double quantity(size_t i) const;
+        bool isBuyerMaker(size_t i) const;
+
+        /**
+         * @brief Returns a trade, whose quote quantity is its price times its quantity.
+         * @param i Index of the trade, lower than size().
+         * @return The trade.
+         */
+        Trade at(size_t i) const;
+
+        /**
+         * @brief Columns of the prices and quantities, valid until the next append().
+         */
+        const double *prices() const;
+        const double *quantities() const;
+
+        /**
+         * @brief Finds the first trade executed at or after a time.
+         * @param time The time in milliseconds since epoch.
+         * @return Its index, size() if there is none.
+         */
+        size_t lowerBound(int64_t time) const;
+
+        /**
+         * @brief Sums the quantities traded in a time range.
+         * @param from Start of the range, in milliseconds since epoch.
+         * @param to End of the range, excluded.
+         * @return The volume.
+         */
+        double volume(int64_t from, int64_t to) const;
+
+        /**
+         * @brief Computes the volume weighted average price of a time range.
+         * @param from Start of the range, in milliseconds since epoch.
+         * @param to End of the range, excluded.
+         * @return The VWAP, 0 if nothing was traded.
+         */
+        double vwap(int64_t from, int64_t to) const;
+
+        /**
+         * @brief Computes the volume traded at each price level of a time range.
+         * @param from Start of the range, in milliseconds since epoch.
+         * @param to End of the range, excluded.
+         * @param step Width of a price level.
+         * @return The pairs {lowest price of the level, volume}, in increasing price.
+         */
+        std::vector<std::pair<double, double>> volumeProfile(int64_t from, int64_t to, double step) const;
+
+    private:
+        /**
+         * @brief Returns the block of a trade.
+         */
+        const Block &blockOf(size_t i) const;
+    };
+
+} // ats
+
+#endif //ATS_TRADETAPE_H
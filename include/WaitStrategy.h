@@ -0,0 +1,199 @@
+/**
+ * @file WaitStrategy.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the Waiter class used by worker threads to wait for new work.
+ * A Waiter either busy-spins, spins then yields, or spins then parks on a condition variable,
+ * and measures the latency between a producer's notification and the consumer waking up.
+*/
+
+#ifndef ATS_WAITSTRATEGY_H
+#define ATS_WAITSTRATEGY_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Clock.h"
+
+namespace ats {
+    /**
+     * @enum WaitPolicy
+     * @brief How an idle worker thread waits for new work.
+     */
+    enum WaitPolicy {
+        BUSY_SPIN,      /**< Spin on the CPU, lowest latency, uses a full core */
+        SPIN_YIELD,     /**< Spin for a while then yield the CPU between checks */
+        PARK,           /**< Spin for a while then sleep on a condition variable, lowest CPU use */
+        WPCOUNT         /**< Number of wait policies */
+    };
+
+    /**
+     * @brief Converts WaitPolicy enum value to string.
+     * @param p The WaitPolicy enum value to convert.
+     * @return A string representation of the WaitPolicy value.
+     */
+    std::string WaitPolicyToString(WaitPolicy p);
+
+    /**
+     * @brief Converts a string to a WaitPolicy enum value.
+     * @param s The string to convert.
+     * @return The corresponding WaitPolicy enum value.
+     */
+    WaitPolicy stringToWaitPolicy(const std::string &s);
+
+    /**
+     * @brief Wake-up latency measured by a Waiter.
+     */
+    struct WakeupStats {
+        long wakeups; /**< Number of measured wake-ups */
+        double meanNs; /**< Mean latency between notification and wake-up, in nanoseconds */
+        long maxNs; /**< Worst latency between notification and wake-up, in nanoseconds */
+    };
+
+    /**
+     * @brief Lets a single consumer thread wait for work signalled by any number of producers.
+     */
+    class Waiter {
+    private:
+        std::atomic<WaitPolicy> mPolicy; ///< Current wait policy
+        int mSpinCount; ///< Number of checks before yielding or parking
+        std::mutex mMutex; ///< Mutex protecting the condition variable
+        std::condition_variable mCondition; ///< Condition variable used by the PARK policy
+        std::atomic<bool> mParked{false}; ///< Whether the consumer is (about to be) parked
+        std::atomic<long> mNotifyTime{0}; ///< Time of the first notification since the consumer went idle
+        std::atomic<long> mWakeups{0}; ///< Number of measured wake-ups
+        std::atomic<long> mTotalLatency{0}; ///< Sum of measured wake-up latencies
+        std::atomic<long> mMaxLatency{0}; ///< Worst measured wake-up latency
+
+    public:
+        /**
+         * @brief Constructs a Waiter.
+         * @param policy The wait policy to use.
+         * @param spinCount Number of checks before yielding or parking.
+         */
+        explicit Waiter(WaitPolicy policy = PARK, int spinCount = 1000);
+
+        /**
+         * @brief Blocks the consumer until ready() returns true.
+         * @param ready Predicate checked between waits, must become true after a notify().
+         */
+        template<typename Predicate>
+        void wait(Predicate ready) {
+            mNotifyTime.store(0, std::memory_order_relaxed);
+            if (ready())
+                return;
+            WaitPolicy policy = mPolicy.load(std::memory_order_relaxed);
+            int spins = 0;
+            while (!ready())
+                if (policy != BUSY_SPIN && ++spins >= mSpinCount)
+                    break;
+            if (policy == BUSY_SPIN || spins < mSpinCount) {
+                recordWakeup();
+                return;
+            }
+            if (policy == SPIN_YIELD) {
+                while (!ready())
+                    std::this_thread::yield();
+            } else {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mParked.store(true);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                while (!ready())
+                    mCondition.wait_for(lock, std::chrono::milliseconds(100));
+                mParked.store(false);
+            }
+            recordWakeup();
+        }
+
+        /**
+         * @brief Blocks the consumer until ready() returns true or a time is reached on a clock.
+         * The spinning policies spin or yield until then, PARK sleeps on the clock, so a simulated clock wakes it
+         * when advanced past the time.
+         * @param clock The clock of the time.
+         * @param time The time in nanoseconds, no timeout if negative.
+         * @param ready Predicate checked between waits, must become true after a notify().
+         * @return true if ready() returned true, false on timeout.
+         */
+        template<typename Predicate>
+        bool waitUntil(Clock &clock, int64_t time, Predicate ready) {
+            mNotifyTime.store(0, std::memory_order_relaxed);
+            if (ready())
+                return true;
+            auto due = [&]() { return time >= 0 && clock.now() >= time; };
+            WaitPolicy policy = mPolicy.load(std::memory_order_relaxed);
+            int spins = 0;
+            while (!ready()) {
+                if (due())
+                    return false;
+                if (policy != BUSY_SPIN && ++spins >= mSpinCount)
+                    break;
+            }
+            if (policy == BUSY_SPIN || spins < mSpinCount) {
+                recordWakeup();
+                return true;
+            }
+            if (policy == SPIN_YIELD) {
+                while (!ready()) {
+                    if (due())
+                        return false;
+                    std::this_thread::yield();
+                }
+            } else {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mParked.store(true);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                clock.waitUntil(lock, mCondition, time, [&]() { return bool(ready()); });
+                mParked.store(false);
+                if (!ready())
+                    return false;
+            }
+            recordWakeup();
+            return true;
+        }
+
+        /**
+         * @brief Signals the consumer that work is available, called by producers after publishing.
+         */
+        void notify();
+
+        /**
+         * @brief Changes the wait policy, applied from the next wait.
+         * @param policy The new wait policy.
+         */
+        void setPolicy(WaitPolicy policy);
+
+        /**
+         * @brief Returns the current wait policy.
+         * @return The wait policy.
+         */
+        WaitPolicy getPolicy() const;
+
+        /**
+         * @brief Returns the wake-up latency measured so far.
+         * @return The wake-up statistics.
+         */
+        WakeupStats getWakeupStats() const;
+
+        /**
+         * @brief Clears the wake-up latency statistics.
+         */
+        void resetWakeupStats();
+
+    private:
+        /**
+         * @brief Returns a monotonic timestamp in nanoseconds.
+         */
+        static long now();
+
+        /**
+         * @brief Records the latency of the wake-up that just happened.
+         */
+        void recordWakeup();
+    };
+
+} // ats
+
+#endif //ATS_WAITSTRATEGY_H
@@ -0,0 +1,124 @@
+/**
+ * @file WebSocketClient.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the WebSocketClient class, a minimal blocking RFC 6455 client used for market data streams.
+ * Supports ws:// over plain TCP and wss:// over OpenSSL, text messages, fragmentation and ping/pong.
+ * A single thread is expected to use a client at a time.
+*/
+
+#ifndef ATS_WEBSOCKETCLIENT_H
+#define ATS_WEBSOCKETCLIENT_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_st SSL;
+
+namespace ats {
+    /**
+     * @brief A WebSocket client connection.
+     */
+    class WebSocketClient {
+    public:
+        static constexpr size_t MAX_MESSAGE_SIZE = size_t(16) << 20; ///< Largest message accepted, fragments included
+
+    private:
+        int mFd{-1}; ///< Socket
+        SSL_CTX *mContext{nullptr}; ///< TLS context (wss:// only)
+        SSL *mSsl{nullptr}; ///< TLS connection (wss:// only)
+        bool mConnected{false}; ///< Whether the handshake succeeded and the connection is open
+        std::string mInput; ///< Bytes received and not parsed yet
+        std::string mMessage; ///< Fragments of the message being received
+        std::mt19937 mRandom; ///< Generates the handshake key and frame masks
+
+    public:
+        WebSocketClient();
+
+        /**
+         * @brief Closes the connection.
+         */
+        ~WebSocketClient();
+
+        WebSocketClient(const WebSocketClient &) = delete;
+
+        WebSocketClient &operator=(const WebSocketClient &) = delete;
+
+        /**
+         * @brief Connects and performs the opening handshake, closing any previous connection.
+         * @param url ws://host[:port][/path] or wss://host[:port][/path].
+         * @param timeoutMs Maximum time to wait for the TCP connection, the TLS handshake and the handshake response,
+         * the host name resolution is not bounded.
+         * @return true if the connection is open.
+         */
+        bool connect(const std::string &url, int timeoutMs = 5000);
+
+        /**
+         * @brief Checks if the connection is open.
+         * @return true until the connection is closed or fails.
+         */
+        bool isConnected() const;
+
+        /**
+         * @brief Sends a text message.
+         * @param text The message.
+         * @return false if the connection failed.
+         */
+        bool send(const std::string &text);
+
+        /**
+         * @brief Waits for the next text or binary message, answering pings on the way.
+         * @param message Receives the message.
+         * @param timeoutMs Maximum time to wait.
+         * @return true if a message was received, false on timeout or when the connection is lost (see isConnected).
+         */
+        bool receive(std::string &message, int timeoutMs);
+
+        /**
+         * @brief Sends a close frame and closes the connection.
+         */
+        void close();
+
+        /**
+         * @brief Computes the Sec-WebSocket-Accept value answering a Sec-WebSocket-Key.
+         * @param key The Sec-WebSocket-Key sent by the client.
+         * @return The expected Sec-WebSocket-Accept.
+         */
+        static std::string acceptKey(const std::string &key);
+
+    private:
+        /**
+         * @brief Parses one frame from mInput, handling control frames.
+         * @return 1 if a complete message is in message, 2 if a control frame or a non-final fragment was consumed
+         * and parsing should continue, 0 if more input is needed, -1 on error or close. A frame making its message
+         * larger than MAX_MESSAGE_SIZE is rejected before it is buffered, closing the connection with 1009.
+         */
+        int parseFrame(std::string &message);
+
+        /**
+         * @brief Sends a masked frame.
+         */
+        bool sendFrame(uint8_t opcode, const char *data, size_t size);
+
+        /**
+         * @brief Reads available bytes into mInput, waiting at most timeoutMs.
+         * @return false on timeout or error.
+         */
+        bool readSome(int timeoutMs);
+
+        /**
+         * @brief Writes a buffer completely.
+         */
+        bool writeAll(const char *data, size_t size);
+
+        /**
+         * @brief Releases the socket and TLS state.
+         */
+        void disconnect();
+    };
+
+} // ats
+
+#endif //ATS_WEBSOCKETCLIENT_H
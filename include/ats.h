@@ -11,6 +11,7 @@
 #ifndef ALGO_TRADING_ATS_H
 #define ALGO_TRADING_ATS_H
 
+#include "Clock.h"
 #include "MarketData.h"
 #include "Strategy.h"
 #include "PositionManager.h"
@@ -0,0 +1,52 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "BBOTable.h"
+
+namespace ats {
+
+    BBOTable::BBOTable(Clock &clock) : mClock(clock) {
+        for (auto &chunk: mChunks)
+            chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    BBOTable::~BBOTable() {
+        for (auto &chunk: mChunks)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    bool BBOTable::update(SymbolId symbol, BBO bbo) {
+        SeqLock<BBO> &slot = record(symbol);
+        BBO current = slot.load();
+        if (current.time && current.sameLevels(bbo))
+            return false;
+        bbo.time = mClock.epochNow();
+        slot.store(bbo);
+        return true;
+    }
+
+    void BBOTable::clear(SymbolId symbol) {
+        if (mChunks[symbol / CHUNK_SIZE].load(std::memory_order_acquire))
+            record(symbol).store(BBO());
+    }
+
+    bool BBOTable::get(SymbolId symbol, BBO &bbo) const {
+        SeqLock<BBO> *chunk = mChunks[symbol / CHUNK_SIZE].load(std::memory_order_acquire);
+        if (!chunk)
+            return false;
+        bbo = chunk[symbol % CHUNK_SIZE].load();
+        return bbo.time != 0;
+    }
+
+    SeqLock<BBO> &BBOTable::record(SymbolId symbol) {
+        std::atomic<SeqLock<BBO> *> &chunk = mChunks[symbol / CHUNK_SIZE];
+        SeqLock<BBO> *records = chunk.load(std::memory_order_acquire);
+        if (!records) {
+            records = new SeqLock<BBO>[CHUNK_SIZE];
+            chunk.store(records, std::memory_order_release);
+        }
+        return records[symbol % CHUNK_SIZE];
+    }
+
+} // ats
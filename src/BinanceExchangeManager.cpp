@@ -4,15 +4,29 @@
 
 #include "BinanceExchangeManager.h"
 #include <iostream>
+#include <unordered_map>
+#include "JsonParser.h"
 
 namespace ats {
     using namespace binance;
 
+    BinanceExchangeManager::ShardSession::ShardSession(bool isSimulation, const std::string &apiKey,
+                                                       const std::string &secretKey) :
+            server(isSimulation ? Server("https://testnet.binance.vision", 1) : Server()),
+            account(server, apiKey, secretKey) {}
+
+    BinanceExchangeManager::MarketSession::MarketSession(bool isSimulation) :
+            server(isSimulation ? Server("https://testnet.binance.vision", 1) : Server()), market(server) {}
+
     BinanceExchangeManager::BinanceExchangeManager(OrderManager &orderManager, bool isSimulation, time_t updateInterval, std::string api_key,
-                                                   std::string secret_key) :
+                                                   std::string secret_key, Clock &clock) :
             ExchangeManager(orderManager),
             mServer(isSimulation ? Server("https://testnet.binance.vision", 1) : Server()),
-            mMarket(mServer), mAccount(mServer, api_key, secret_key), mUpdateInterval(updateInterval) {
+            mMarket(mServer), mAccount(mServer, api_key, secret_key), mIsSimulation(isSimulation),
+            mUpdateInterval(updateInterval), mClock(clock) {
+        for (size_t i = 0; i < mOrderManager.getShardCount(); i++)
+            mSessions.emplace_back(new ShardSession(isSimulation, api_key, secret_key));
+        loadSymbolFilters();
         start();
     }
 
@@ -21,35 +35,40 @@ namespace ats {
     }
 
     void BinanceExchangeManager::start() {
+        if (mRunning)
+            return;
         mRunning = true;
         updateOpenOrders();
-        mExchangeManagerThread = std::thread(&BinanceExchangeManager::run, this);
+        for (size_t i = 0; i < mSessions.size(); i++)
+            mExchangeManagerThreads.emplace_back(&BinanceExchangeManager::run, this, i);
     }
 
-    void BinanceExchangeManager::run() {
-        time_t lastUpd{0};
+    void BinanceExchangeManager::run(size_t shard) {
+        int64_t nextUpd = mClock.now();
         while (mRunning) {
-            time_t newUpd;
-            time(&newUpd);
-            if (mOrderManager.hasOrders()) {
-                Order &order = mOrderManager.getOldestOrder();
+            if (mOrderManager.hasOrders(shard)) {
+                Order order = mOrderManager.getOldestOrder(shard);
                 sendOrder(order);
             }
-            if (mOrderManager.hasCancelOrders()) {
-                std::pair<long, std::string> order = mOrderManager.getCancelOrder();
-                cancelOrder(order.first, order.second);
+            if (mOrderManager.hasCancelOrders(shard)) {
+                std::pair<long, SymbolId> order = mOrderManager.getCancelOrder(shard);
+                cancelOrder(order.first, SymbolToString(order.second));
             }
-            if (difftime(newUpd, lastUpd) < mUpdateInterval)
-                continue;
-            updateOpenOrders();
-            time(&lastUpd);
+            if (mClock.now() >= nextUpd) {
+                updateOpenOrders(shard);
+                nextUpd = mClock.now() + int64_t(mUpdateInterval) * NANOS_PER_SECOND;
+            }
+            mOrderManager.waitForOrders(shard, mClock, nextUpd, [this]() { return !mRunning; });
         }
     }
 
     void BinanceExchangeManager::stop() {
         mRunning = false;
-        if (mExchangeManagerThread.joinable())
-            mExchangeManagerThread.join();
+        mOrderManager.wakeExchange();
+        for (std::thread &thread: mExchangeManagerThreads)
+            if (thread.joinable())
+                thread.join();
+        mExchangeManagerThreads.clear();
     }
 
     bool BinanceExchangeManager::isRunning() {
@@ -60,43 +79,85 @@ namespace ats {
         return mIsSimulation;
     }
 
-    void BinanceExchangeManager::updateOpenOrders() {
-        auto symbols = mOrderManager.getSymbols();
-        std::unordered_map<long, Order> openOrders;
-        for (std::string symbol: symbols) {
-            auto orders = getOpenOrders(symbol);
-            for (Order &order: orders) {
-                order.id = order.emsId;
-                if (emsToOmsId.count(order.emsId)) {
-                    order.id = emsToOmsId[order.emsId];
-                    omsToEmsId[order.id] = order.emsId;
-                } else {
-                    emsToOmsId[order.emsId] = order.id;
-                    omsToEmsId[order.id] = order.emsId;
-                }
-                openOrders.insert({order.id, order});
+    void BinanceExchangeManager::loadSymbolFilters() {
+        Json::Value result;
+        BINANCE_ERR_CHECK(mMarket.getExchangeInfo(result));
+        std::vector<std::pair<SymbolId, SymbolFilters>> filters;
+        for (auto &symbol: result["symbols"])
+            try {
+                filters.emplace_back(stringToSymbol(symbol["symbol"].asString()), jsonToSymbolFilters(symbol));
+            } catch (...) {
+                continue;
+            }
+        if (!filters.empty())
+            mOrderManager.getValidator().load(filters);
+    }
+
+    SymbolFilters BinanceExchangeManager::jsonToSymbolFilters(Json::Value &result) {
+        SymbolFilters filters;
+        for (auto &filter: result["filters"]) {
+            std::string type = filter["filterType"].asString();
+            if (type == "PRICE_FILTER") {
+                filters.minPrice = jsonDoubleStrict(filter["minPrice"]);
+                filters.maxPrice = jsonDoubleStrict(filter["maxPrice"]);
+                filters.tickSize = jsonDoubleStrict(filter["tickSize"]);
+            } else if (type == "LOT_SIZE") {
+                filters.minQty = jsonDoubleStrict(filter["minQty"]);
+                filters.maxQty = jsonDoubleStrict(filter["maxQty"]);
+                filters.stepSize = jsonDoubleStrict(filter["stepSize"]);
+            } else if (type == "MARKET_LOT_SIZE") {
+                filters.marketMinQty = jsonDoubleStrict(filter["minQty"]);
+                filters.marketMaxQty = jsonDoubleStrict(filter["maxQty"]);
+                filters.marketStepSize = jsonDoubleStrict(filter["stepSize"]);
+            } else if (type == "MIN_NOTIONAL" || type == "NOTIONAL") {
+                filters.minNotional = jsonDoubleStrict(filter["minNotional"]);
+            } else if (type == "PERCENT_PRICE") {
+                filters.multiplierUp = jsonDoubleStrict(filter["multiplierUp"]);
+                filters.multiplierDown = jsonDoubleStrict(filter["multiplierDown"]);
+            } else if (type == "PERCENT_PRICE_BY_SIDE") {
+                filters.bidMultiplierUp = jsonDoubleStrict(filter["bidMultiplierUp"]);
+                filters.bidMultiplierDown = jsonDoubleStrict(filter["bidMultiplierDown"]);
+                filters.askMultiplierUp = jsonDoubleStrict(filter["askMultiplierUp"]);
+                filters.askMultiplierDown = jsonDoubleStrict(filter["askMultiplierDown"]);
             }
         }
-        mOrderManager.updateOpenOrders(openOrders);
+        return filters;
+    }
+
+    void BinanceExchangeManager::updateOpenOrders() {
+        for (size_t i = 0; i < mOrderManager.getShardCount(); i++)
+            updateOpenOrders(i);
+    }
+
+    void BinanceExchangeManager::updateOpenOrders(size_t shard) {
+        auto symbols = mOrderManager.getSymbols(shard);
+        std::vector<OrderState> openOrders;
+        for (std::string symbol: symbols)
+            for (OrderState &state: getOpenOrderStates(symbol))
+                openOrders.push_back(state);
+        mOrderManager.updateOpenOrders(shard, openOrders);
     }
 
     double BinanceExchangeManager::sendOrder(Order &order) {
         Json::Value result;
-        BINANCE_ERR_CHECK(mAccount.sendOrder(result, order.symbol.c_str(),
+        BINANCE_ERR_CHECK(accountFor(order.symbolName()).sendOrder(result, order.symbolName().c_str(),
                                              SideToString(order.side).c_str(), OrderTypeToString(order.type).c_str(),
-                                             order.timeInForce.c_str(), order.quantity, order.price, "",
+                                             TimeInForceToString(order.timeInForce).c_str(), order.quantity, order.price,
+                                             clientOrderId(order.id).c_str(),
                                              order.stopPrice, order.icebergQty, order.recvWindow));
         Logger::write_log(result.toStyledString().c_str());
         if (result.isMember("orderId"))
             order.emsId = result["orderId"].asInt64();
-        omsToEmsId[order.id] = order.emsId;
-        emsToOmsId[order.emsId] = order.id;
+        ExecutionReport report;
+        report.emsId = order.emsId;
         if (result.isMember("executedQty")) {
-            mOrderManager.setLastOrderQty(stod(result["executedQty"].asString()));
-            return stod(result["executedQty"].asString());
+            report.acked = true;
+            report.executedQty = jsonDoubleStrict(result["executedQty"]);
+            report.status = stringToOrderStatus(result["status"].asString());
+            mOrderManager.updateSentOrder(order, report.executedQty);
         }
-        mOrderManager.setLastOrderQty(0);
-        return 0;
+        reportExecution(order, report);
+        return report.executedQty;
     }
 
     void BinanceExchangeManager::modifyOrder(Order &oldOrder, Order &newOrder) {
@@ -107,30 +168,35 @@ namespace ats {
     void BinanceExchangeManager::cancelOrder(long id, std::string symbol) {
         Json::Value result;
         BINANCE_ERR_CHECK(
-                mAccount.cancelOrder(result, symbol.c_str(), omsToEmsId[id], "", "", 0));
+                accountFor(symbol).cancelOrder(result, symbol.c_str(), 0, clientOrderId(id).c_str(), "", 0));
         Logger::write_log(result.toStyledString().c_str());
+        reportCancel(id, stringToSymbol(symbol), result["status"].asString() == "CANCELED");
     }
 
     void BinanceExchangeManager::cancelOrder(Order &order) {
-        cancelOrder(order.id, order.symbol);
+        cancelOrder(order.id, order.symbolName());
     }
 
     void BinanceExchangeManager::getOrderStatus(Order &order, Json::Value &result) {
-        BINANCE_ERR_CHECK(mAccount.getOrder(result, order.symbol.c_str(), omsToEmsId[order.id], "", order.recvWindow));
+        BINANCE_ERR_CHECK(mAccount.getOrder(result, order.symbolName().c_str(), order.emsId,
+                                            order.emsId ? "" : clientOrderId(order.id).c_str(), order.recvWindow));
     }
 
     Order BinanceExchangeManager::jsonToOrder(Json::Value &result) {
         try {
             std::string symbol = result["symbol"].asString();
             long emsId = stol(result["orderId"].asString());
-            long omsId = (emsToOmsId.find(emsId) != emsToOmsId.end() ? emsToOmsId[emsId] : 0);
-            double price = stod(result["price"].asString());
-            double quantity = stod(result["origQty"].asString());
+            // Orders not created by the OMS (e.g. placed manually) are identified by their exchange id
+            long omsId = parseClientOrderId(result["clientOrderId"].asString());
+            if (omsId < 0)
+                omsId = emsId;
+            double price = jsonDoubleStrict(result["price"]);
+            double quantity = jsonDoubleStrict(result["origQty"]);
             Side side = stringToSide(result["side"].asString());
             OrderType type = stringToOrderType(result["type"].asString());
-            std::string timeInForce = result["timeInForce"].asString();
-            double stopPrice = stod(result["stopPrice"].asString());
-            double icebergQty = stod(result["icebergQty"].asString());
+            TimeInForce timeInForce = stringToTimeInForce(result["timeInForce"].asString());
+            double stopPrice = jsonDoubleStrict(result["stopPrice"]);
+            double icebergQty = jsonDoubleStrict(result["icebergQty"]);
             long time = stol(result["time"].asString()) / 1000;
 
             return Order{omsId, type, side, symbol, quantity, price,
@@ -140,20 +206,36 @@ namespace ats {
         }
     }
 
+    OrderState BinanceExchangeManager::jsonToOrderState(Json::Value &result) {
+        Order order = jsonToOrder(result);
+        try {
+            return {order, jsonDoubleStrict(result["executedQty"])};
+        } catch(...) {
+            return {order, 0};
+        }
+    }
+
     std::vector<Order> BinanceExchangeManager::getOpenOrders(std::string symbol) {
-        Json::Value result;
         std::vector<Order> orders;
+        for (OrderState &state: getOpenOrderStates(symbol))
+            orders.push_back(state.order);
+        return orders;
+    }
+
+    std::vector<OrderState> BinanceExchangeManager::getOpenOrderStates(std::string symbol) {
+        Json::Value result;
+        std::vector<OrderState> orders;
         if (!mAccount.keysAreSet()) {
             Logger::write_log("<getOpenOrders> Keys not set");
             return orders;
         }
         if (symbol != "")
-            BINANCE_ERR_CHECK(mAccount.getOpenOrders(result, symbol.c_str()));
+            BINANCE_ERR_CHECK(accountFor(symbol).getOpenOrders(result, symbol.c_str()));
         else
             BINANCE_ERR_CHECK(mAccount.getOpenOrders(result));
         for (Json::Value::ArrayIndex i = 0; i < result.size(); i++)
             try {
-                orders.push_back(jsonToOrder(result[i]));
+                orders.push_back(jsonToOrderState(result[i]));
             } catch (...) {
                 break;
             }
@@ -163,9 +245,9 @@ namespace ats {
     Trade BinanceExchangeManager::jsonToTrade(Json::Value &result) {
         try {
             long id = stol(result["id"].asString());
-            double price = stod(result["price"].asString());
-            double quantity = stod(result["qty"].asString());
-            double quoteQty = stod(result["quoteQty"].asString());
+            double price = jsonDoubleStrict(result["price"]);
+            double quantity = jsonDoubleStrict(result["qty"]);
+            double quoteQty = jsonDoubleStrict(result["quoteQty"]);
             long time = stol(result["time"].asString());
             bool isBuyerMaker = result["isBuyerMaker"].asString() == "true";
             bool isBestMatch = result["isBestMatch"].asString() == "true";
@@ -192,17 +274,51 @@ namespace ats {
         return trades;
     }
 
+    std::vector<Trade> BinanceExchangeManager::getTradesFrom(std::string symbol, long fromId, int limit) {
+        if (!mAccount.keysAreSet()) {
+            Logger::write_log("<getTradesFrom> Keys not set");
+            return {};
+        }
+        Json::Value result;
+        std::vector<Trade> trades;
+        BINANCE_ERR_CHECK(mAccount.getHistoricalTrades(result, symbol.c_str(), fromId < 0 ? -1 : fromId, limit));
+        trades.reserve(result.size());
+        for (Json::Value::ArrayIndex i = 0; i < result.size(); i++)
+            trades.push_back(jsonToTrade(result[i]));
+        return trades;
+    }
+
     double BinanceExchangeManager::getPrice(std::string symbol) {
         double price = -1;
-        BINANCE_ERR_CHECK(mMarket.getPrice(symbol.c_str(), price));
+        withMarket([&](Market &market) { BINANCE_ERR_CHECK(market.getPrice(symbol.c_str(), price)); });
         return price;
     }
 
+    std::map<std::string, double> BinanceExchangeManager::getPrices(const std::vector<std::string> &symbols) {
+        Json::Value result;
+        withMarket([&](Market &market) { BINANCE_ERR_CHECK(market.getAllPrices(result)); });
+        std::unordered_map<std::string, double> all;
+        all.reserve(result.size());
+        for (auto &ticker: result)
+            try {
+                all[ticker["symbol"].asString()] = jsonDoubleStrict(ticker["price"]);
+            } catch (...) {}
+        std::map<std::string, double> prices;
+        for (const std::string &symbol: symbols) {
+            auto it = all.find(symbol);
+            if (it != all.end())
+                prices.emplace(symbol, it->second);
+        }
+        return prices;
+    }
+
 
     void
     BinanceExchangeManager::getKlines(Json::Value &result, std::string symbol, std::string interval, time_t start_date,
                                       time_t end_date, int limit) {
-        BINANCE_ERR_CHECK(mMarket.getKlines(result, symbol.c_str(), interval.c_str(), start_date, end_date, limit));
+        withMarket([&](Market &market) {
+            BINANCE_ERR_CHECK(market.getKlines(result, symbol.c_str(), interval.c_str(), start_date, end_date, limit));
+        });
     }
 
     void BinanceExchangeManager::getUserInfo(Json::Value &result) {
@@ -224,24 +340,30 @@ namespace ats {
         std::map<std::string, double> balances;
         for (Json::Value::ArrayIndex i = 0; i < result["balances"].size(); i++) {
             auto res = result["balances"][i];
-            balances.insert(std::make_pair(res["asset"].asString(), stod(res["free"].asString())));
+            balances.insert(std::make_pair(res["asset"].asString(), jsonDoubleStrict(res["free"])));
         }
         return balances;
     }
 
+    Account &BinanceExchangeManager::accountFor(const std::string &symbol) {
+        return mSessions[mOrderManager.getShard(stringToSymbol(symbol))]->account;
+    }
+
     OrderBook BinanceExchangeManager::getOrderBook(std::string symbol) {
         Json::Value result;
-        BINANCE_ERR_CHECK(mMarket.getDepth(result, symbol.c_str()));
+        withMarket([&](Market &market) { BINANCE_ERR_CHECK(market.getDepth(result, symbol.c_str())); });
         std::vector<double> bids, bidVol, asks, askVol;
         for (auto &bid : result["bids"]) {
-            bids.push_back(stod(bid[0].asString()));
-            bidVol.push_back(stod(bid[1].asString()));
+            bids.push_back(jsonDoubleStrict(bid[0]));
+            bidVol.push_back(jsonDoubleStrict(bid[1]));
         }
         for (auto &ask : result["asks"]) {
-            asks.push_back(stod(ask[0].asString()));
-            askVol.push_back(stod(ask[1].asString()));
+            asks.push_back(jsonDoubleStrict(ask[0]));
+            askVol.push_back(jsonDoubleStrict(ask[1]));
         }
-        return OrderBook(bids, bidVol, asks, askVol);
+        OrderBook book(bids, bidVol, asks, askVol);
+        book.lastUpdateId = result["lastUpdateId"].asUInt64();
+        return book;
     }
 
 } // ats
\ No newline at end of file
@@ -0,0 +1,107 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "Clock.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace ats {
+
+    namespace {
+        std::chrono::steady_clock::time_point toTimePoint(int64_t time) {
+            return std::chrono::steady_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(time)));
+        }
+    }
+
+    int64_t Clock::nowMs() {
+        return now() / NANOS_PER_MILLI;
+    }
+
+    int64_t Clock::epochMs() {
+        return epochNow() / NANOS_PER_MILLI;
+    }
+
+    void Clock::sleepFor(int64_t duration) {
+        sleepUntil(now() + duration);
+    }
+
+    Clock &realClock() {
+        static RealClock clock;
+        return clock;
+    }
+
+    int64_t RealClock::now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t RealClock::epochNow() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    void RealClock::sleepUntil(int64_t time) {
+        std::this_thread::sleep_until(toTimePoint(time));
+    }
+
+    void RealClock::waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &condition, int64_t time,
+                              const std::function<bool()> &done) {
+        if (time < 0)
+            condition.wait(lock, done);
+        else condition.wait_until(lock, toTimePoint(time), done);
+    }
+
+    SimulatedClock::SimulatedClock(int64_t start, int64_t epoch) : mNow(start), mEpoch(epoch) {}
+
+    int64_t SimulatedClock::now() {
+        return mNow.load(std::memory_order_acquire);
+    }
+
+    int64_t SimulatedClock::epochNow() {
+        return mEpoch + now();
+    }
+
+    void SimulatedClock::sleepUntil(int64_t time) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mAdvanced.wait(lock, [&]() { return now() >= time; });
+    }
+
+    void SimulatedClock::waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &condition,
+                                   int64_t time, const std::function<bool()> &done) {
+        std::pair<std::mutex *, std::condition_variable *> waiter(lock.mutex(), &condition);
+        // registered before the time is checked, so an advance in between notifies the condition
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mWaiters.push_back(waiter);
+        }
+        lock.lock();
+        condition.wait(lock, [&]() { return done() || (time >= 0 && now() >= time); });
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mWaiters.erase(std::find(mWaiters.begin(), mWaiters.end(), waiter));
+        }
+        lock.lock();
+    }
+
+    void SimulatedClock::advance(int64_t duration) {
+        if (duration > 0)
+            set(now() + duration);
+    }
+
+    void SimulatedClock::set(int64_t time) {
+        int64_t current = now();
+        while (current < time && !mNow.compare_exchange_weak(current, time, std::memory_order_acq_rel));
+        std::lock_guard<std::mutex> guard(mMutex);
+        mAdvanced.notify_all();
+        for (auto &[mutex, condition]: mWaiters) {
+            std::lock_guard<std::mutex> waiterGuard(*mutex);
+            condition->notify_all();
+        }
+    }
+
+} // ats
@@ -3,9 +3,52 @@
 //
 
 #include "ExchangeManager.h"
+#include <algorithm>
 
 namespace ats {
 
     ExchangeManager::ExchangeManager(OrderManager& orderManager) : mOrderManager(orderManager) {}
 
+    OrderManager &ExchangeManager::getOrderManager() {
+        return mOrderManager;
+    }
+
+    void ExchangeManager::setExecutionListener(ExecutionListener listener) {
+        mExecutionListener = std::move(listener);
+    }
+
+    void ExchangeManager::reportExecution(const Order &order, const ExecutionReport &report) {
+        if (mExecutionListener)
+            mExecutionListener(order, report);
+        mOrderManager.reportExecution(order, report);
+    }
+
+    void ExchangeManager::setCancelListener(CancelListener listener) {
+        mCancelListener = std::move(listener);
+    }
+
+    void ExchangeManager::reportCancel(long orderId, SymbolId symbol, bool canceled) {
+        if (mCancelListener)
+            mCancelListener(orderId, symbol, canceled);
+        if (canceled)
+            mOrderManager.updateCanceledOrder(orderId, symbol);
+    }
+
+    std::map<std::string, double> ExchangeManager::getPrices(const std::vector<std::string> &symbols) {
+        std::map<std::string, double> prices;
+        for (const std::string &symbol: symbols)
+            prices[symbol] = getPrice(symbol);
+        return prices;
+    }
+
+    std::vector<Trade> ExchangeManager::getTradesFrom(std::string symbol, long fromId, int limit) {
+        std::vector<Trade> trades = getTradeHistory(symbol);
+        std::sort(trades.begin(), trades.end(),
+                  [](const Trade &a, const Trade &b) { return a.getId() < b.getId(); });
+        auto first = fromId < 0 ? trades.end() - std::min<ptrdiff_t>(limit, trades.size()) :
+                     std::lower_bound(trades.begin(), trades.end(), fromId,
+                                      [](const Trade &trade, long id) { return trade.getId() < id; });
+        return {first, first + std::min<ptrdiff_t>(limit, trades.end() - first)};
+    }
+
 } // ats
\ No newline at end of file
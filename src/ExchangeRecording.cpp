@@ -0,0 +1,297 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "ExchangeRecording.h"
+#include <memory>
+
+namespace ats {
+
+    namespace {
+        constexpr char MAGIC[8] = {'A', 'T', 'S', 'R', 'E', 'C', 0, 2}; // name and format version
+
+        /**
+         * @brief The fixed-size part of a record, followed by its key and payload.
+         */
+        struct RecordHeader {
+            int64_t time;
+            uint32_t keySize;
+            uint32_t payloadSize;
+            RecordedCall call;
+        };
+    }
+
+    std::string RecordedCallToString(RecordedCall c) {
+        switch (c) {
+            case CALL_SEND_ORDER:
+                return "SEND_ORDER";
+            case CALL_ORDER_STATUS:
+                return "ORDER_STATUS";
+            case CALL_OPEN_ORDERS:
+                return "OPEN_ORDERS";
+            case CALL_TRADE_HISTORY:
+                return "TRADE_HISTORY";
+            case CALL_TRADES_FROM:
+                return "TRADES_FROM";
+            case CALL_BALANCES:
+                return "BALANCES";
+            case CALL_KLINES:
+                return "KLINES";
+            case CALL_PRICE:
+                return "PRICE";
+            case CALL_PRICES:
+                return "PRICES";
+            case CALL_ORDER_BOOK:
+                return "ORDER_BOOK";
+            case CALL_CANCEL_ORDER:
+                return "CANCEL_ORDER";
+            default:
+                return "Unknown";
+        }
+    }
+
+    std::string klinesRecordKey(const std::string &symbol, const std::string &interval, time_t start_date,
+                                time_t end_date, int limit) {
+        return symbol + ' ' + interval + ' ' + std::to_string(start_date) + ' ' + std::to_string(end_date) + ' ' +
+               std::to_string(limit);
+    }
+
+    std::string tradesRecordKey(const std::string &symbol, long fromId, int limit) {
+        return symbol + ' ' + std::to_string(fromId) + ' ' + std::to_string(limit);
+    }
+
+    std::string pricesRecordKey(const std::vector<std::string> &symbols) {
+        std::string key;
+        for (const std::string &symbol: symbols)
+            key += (key.empty() ? "" : ",") + symbol;
+        return key;
+    }
+
+    PayloadWriter &PayloadWriter::put(const std::string &value) {
+        put(uint32_t(value.size()));
+        mData.append(value);
+        return *this;
+    }
+
+    PayloadWriter &PayloadWriter::put(const std::vector<double> &values) {
+        put(uint32_t(values.size()));
+        mData.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(double));
+        return *this;
+    }
+
+    PayloadWriter &PayloadWriter::put(const std::map<std::string, double> &values) {
+        put(uint32_t(values.size()));
+        for (const auto &[name, value]: values)
+            put(name).put(value);
+        return *this;
+    }
+
+    PayloadWriter &PayloadWriter::put(const std::vector<Order> &orders) {
+        put(uint32_t(orders.size()));
+        // symbols are interned per process, they are recorded by name
+        for (const Order &order: orders)
+            put(int64_t(order.id)).put(int64_t(order.emsId)).put(order.quantity).put(order.price)
+                    .put(order.stopPrice).put(order.icebergQty).put(int64_t(order.time)).put(order.symbolName())
+                    .put(order.recvWindow).put(order.type).put(order.side).put(order.timeInForce);
+        return *this;
+    }
+
+    PayloadWriter &PayloadWriter::put(const std::vector<Trade> &trades) {
+        put(uint32_t(trades.size()));
+        for (const Trade &trade: trades)
+            put(int64_t(trade.getId())).put(trade.getPrice()).put(trade.getQuantity()).put(trade.getQuoteQty())
+                    .put(int64_t(trade.getTime())).put(trade.getIsBuyerMaker()).put(trade.getIsBestMatch());
+        return *this;
+    }
+
+    PayloadWriter &PayloadWriter::put(const OrderBook &book) {
+        return put(book.bid).put(book.bidVol).put(book.ask).put(book.askVol).put(book.lastUpdateId);
+    }
+
+    PayloadWriter &PayloadWriter::put(const ExecutionReport &report) {
+        return put(int64_t(report.emsId)).put(report.acked).put(report.status).put(report.executedQty);
+    }
+
+    PayloadWriter &PayloadWriter::put(const Json::Value &json) {
+        Json::StreamWriterBuilder writer;
+        writer["indentation"] = "";
+        return put(Json::writeString(writer, json));
+    }
+
+    const std::string &PayloadWriter::data() const {
+        return mData;
+    }
+
+    PayloadReader::PayloadReader(const std::string &data) : mData(data) {}
+
+    bool PayloadReader::get(std::string &value) {
+        uint32_t size;
+        if (!get(size) || mData.size() - mOffset < size)
+            return false;
+        value.assign(mData, mOffset, size);
+        mOffset += size;
+        return true;
+    }
+
+    bool PayloadReader::get(std::vector<double> &values) {
+        uint32_t size;
+        if (!get(size) || (mData.size() - mOffset) / sizeof(double) < size)
+            return false;
+        values.resize(size);
+        std::memcpy(values.data(), mData.data() + mOffset, size * sizeof(double));
+        mOffset += size * sizeof(double);
+        return true;
+    }
+
+    bool PayloadReader::get(std::map<std::string, double> &values) {
+        uint32_t size;
+        if (!get(size))
+            return false;
+        values.clear();
+        for (uint32_t i = 0; i < size; i++) {
+            std::string name;
+            double value;
+            if (!get(name) || !get(value))
+                return false;
+            values[name] = value;
+        }
+        return true;
+    }
+
+    bool PayloadReader::get(std::vector<Order> &orders) {
+        uint32_t size;
+        if (!get(size))
+            return false;
+        orders.clear();
+        for (uint32_t i = 0; i < size; i++) {
+            int64_t id, emsId, time;
+            std::string symbol;
+            Order order;
+            if (!get(id) || !get(emsId) || !get(order.quantity) || !get(order.price) || !get(order.stopPrice) ||
+                !get(order.icebergQty) || !get(time) || !get(symbol) || !get(order.recvWindow) || !get(order.type) ||
+                !get(order.side) || !get(order.timeInForce))
+                return false;
+            order.id = long(id);
+            order.emsId = long(emsId);
+            order.time = time_t(time);
+            order.symbol = stringToSymbol(symbol);
+            orders.push_back(order);
+        }
+        return true;
+    }
+
+    bool PayloadReader::get(std::vector<Trade> &trades) {
+        uint32_t size;
+        if (!get(size))
+            return false;
+        trades.clear();
+        for (uint32_t i = 0; i < size; i++) {
+            int64_t id, time;
+            double price, quantity, quoteQty;
+            bool isBuyerMaker, isBestMatch;
+            if (!get(id) || !get(price) || !get(quantity) || !get(quoteQty) || !get(time) || !get(isBuyerMaker) ||
+                !get(isBestMatch))
+                return false;
+            trades.emplace_back(long(id), price, quantity, quoteQty, long(time), isBuyerMaker, isBestMatch);
+        }
+        return true;
+    }
+
+    bool PayloadReader::get(OrderBook &book) {
+        return get(book.bid) && get(book.bidVol) && get(book.ask) && get(book.askVol) && get(book.lastUpdateId);
+    }
+
+    bool PayloadReader::get(ExecutionReport &report) {
+        int64_t emsId;
+        if (!get(emsId) || !get(report.acked) || !get(report.status) || !get(report.executedQty))
+            return false;
+        report.emsId = long(emsId);
+        return true;
+    }
+
+    bool PayloadReader::get(Json::Value &json) {
+        std::string text;
+        if (!get(text))
+            return false;
+        Json::CharReaderBuilder builder;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        std::string errors;
+        return reader->parse(text.data(), text.data() + text.size(), &json, &errors);
+    }
+
+    RecordFile::~RecordFile() {
+        close();
+    }
+
+    bool RecordFile::open(const std::string &path) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mFile)
+            return false;
+        mFile = fopen(path.c_str(), "wb");
+        if (!mFile)
+            return false;
+        if (fwrite(MAGIC, sizeof(MAGIC), 1, mFile) != 1) {
+            fclose(mFile);
+            mFile = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    void RecordFile::close() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mFile)
+            return;
+        fclose(mFile);
+        mFile = nullptr;
+    }
+
+    bool RecordFile::isOpen() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mFile != nullptr;
+    }
+
+    void RecordFile::write(const ExchangeRecord &record) {
+        RecordHeader header{}; // zeroes the padding written with it
+        header.time = record.time;
+        header.keySize = uint32_t(record.key.size());
+        header.payloadSize = uint32_t(record.payload.size());
+        header.call = record.call;
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mFile)
+            return;
+        fwrite(&header, sizeof(header), 1, mFile);
+        fwrite(record.key.data(), 1, record.key.size(), mFile);
+        fwrite(record.payload.data(), 1, record.payload.size(), mFile);
+    }
+
+    void RecordFile::flush() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mFile)
+            fflush(mFile);
+    }
+
+    bool RecordFile::read(const std::string &path, std::vector<ExchangeRecord> &records) {
+        std::unique_ptr<FILE, int (*)(FILE *)> file(fopen(path.c_str(), "rb"), fclose);
+        if (!file)
+            return false;
+        char magic[sizeof(MAGIC)];
+        if (fread(magic, sizeof(magic), 1, file.get()) != 1 || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+            return false;
+        records.clear();
+        RecordHeader header;
+        while (fread(&header, sizeof(header), 1, file.get()) == 1) {
+            ExchangeRecord record;
+            record.time = header.time;
+            record.call = header.call;
+            record.key.resize(header.keySize);
+            record.payload.resize(header.payloadSize);
+            if (fread(&record.key[0], 1, header.keySize, file.get()) != header.keySize ||
+                fread(&record.payload[0], 1, header.payloadSize, file.get()) != header.payloadSize)
+                break;
+            records.push_back(std::move(record));
+        }
+        return true;
+    }
+
+} // ats
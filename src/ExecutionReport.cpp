@@ -0,0 +1,69 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "ExecutionReport.h"
+
+namespace ats {
+
+    std::string OrderStatusToString(OrderStatus s) {
+        switch (s) {
+            case NEW:
+                return "NEW";
+            case PARTIALLY_FILLED:
+                return "PARTIALLY_FILLED";
+            case FILLED:
+                return "FILLED";
+            case CANCELED:
+                return "CANCELED";
+            case PENDING_CANCEL:
+                return "PENDING_CANCEL";
+            case REJECTED:
+                return "REJECTED";
+            case EXPIRED:
+                return "EXPIRED";
+            default:
+                return "Unknown";
+        }
+    }
+
+    OrderStatus stringToOrderStatus(const std::string &s) {
+        for (int i = 0; i < OSCOUNT; i++)
+            if (OrderStatusToString(OrderStatus(i)) == s)
+                return OrderStatus(i);
+        return OSCOUNT;
+    }
+
+    OrderHandle::OrderHandle(long id, std::shared_future<ExecutionReport> report)
+            : mId(id), mReport(std::move(report)) {}
+
+    long OrderHandle::id() const {
+        return mId;
+    }
+
+    OrderHandle::operator long() const {
+        return mId;
+    }
+
+    bool OrderHandle::valid() const {
+        return mId >= 0 && mReport.valid();
+    }
+
+    bool OrderHandle::ready() const {
+        return valid() && mReport.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    bool OrderHandle::waitFor(std::chrono::milliseconds timeout) const {
+        return valid() && mReport.wait_for(timeout) == std::future_status::ready;
+    }
+
+    ExecutionReport OrderHandle::get() const {
+        if (!valid()) {
+            ExecutionReport report;
+            report.orderId = mId;
+            return report;
+        }
+        return mReport.get();
+    }
+
+} // ats
@@ -0,0 +1,74 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "Interval.h"
+
+namespace ats {
+
+    namespace {
+        constexpr time_t DAY = 24 * 60 * 60;
+        constexpr time_t WEEK_OFFSET = 4 * DAY; // the epoch is a Thursday, weeks start on Mondays
+
+        constexpr const char *NAMES[ICOUNT] = {"1s", "1m", "3m", "5m", "15m", "30m", "1h", "2h", "4h", "6h", "8h",
+                                               "12h", "1d", "3d", "1w", "1M"};
+        constexpr time_t SECONDS[ICOUNT] = {1, 60, 3 * 60, 5 * 60, 15 * 60, 30 * 60, 3600, 2 * 3600, 4 * 3600,
+                                            6 * 3600, 8 * 3600, 12 * 3600, DAY, 3 * DAY, 7 * DAY, 30 * DAY};
+
+        time_t floorTo(time_t time, time_t step, time_t offset) {
+            time_t shifted = time - offset;
+            time_t floored = shifted / step * step;
+            if (floored > shifted)
+                floored -= step;
+            return floored + offset;
+        }
+    }
+
+    std::string IntervalToString(Interval i) {
+        return i < ICOUNT ? NAMES[i] : "Unknown";
+    }
+
+    bool stringToInterval(const std::string &s, Interval &interval) {
+        for (uint8_t i = 0; i < ICOUNT; i++)
+            if (s == NAMES[i]) {
+                interval = Interval(i);
+                return true;
+            }
+        return false;
+    }
+
+    time_t intervalSeconds(Interval i) {
+        return i < ICOUNT ? SECONDS[i] : 0;
+    }
+
+    time_t intervalOpenTime(Interval i, time_t time) {
+        switch (i) {
+            case Interval_1w:
+                return floorTo(time, SECONDS[i], WEEK_OFFSET);
+            case Interval_1M: {
+                struct tm date{};
+                gmtime_r(&time, &date);
+                date.tm_mday = 1;
+                date.tm_hour = date.tm_min = date.tm_sec = 0;
+                return timegm(&date);
+            }
+            default:
+                return i < ICOUNT ? floorTo(time, SECONDS[i], 0) : time;
+        }
+    }
+
+    bool canAggregate(Interval from, Interval to) {
+        if (from >= to || to >= ICOUNT)
+            return false;
+        time_t step = SECONDS[from];
+        switch (to) {
+            case Interval_1w:
+                return from <= Interval_1d && SECONDS[to] % step == 0 && WEEK_OFFSET % step == 0;
+            case Interval_1M:
+                return from <= Interval_1d && DAY % step == 0;
+            default:
+                return SECONDS[to] % step == 0;
+        }
+    }
+
+} // ats
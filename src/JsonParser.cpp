@@ -0,0 +1,315 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "JsonParser.h"
+#include <charconv>
+#include <stdexcept>
+
+namespace ats {
+
+    namespace {
+        /**
+         * @brief Forward-only reader over a JSON text, strings are returned raw, escapes included.
+         */
+        class Scanner {
+        private:
+            const char *mPos; ///< Next character
+            const char *mEnd; ///< End of the text
+
+        public:
+            explicit Scanner(std::string_view text) : mPos(text.data()), mEnd(text.data() + text.size()) {}
+
+            bool consume(char c) {
+                skipSpace();
+                if (mPos < mEnd && *mPos == c) {
+                    mPos++;
+                    return true;
+                }
+                return false;
+            }
+
+            bool string(std::string_view &s) {
+                if (!consume('"'))
+                    return false;
+                const char *begin = mPos;
+                while (mPos < mEnd && *mPos != '"')
+                    mPos += *mPos == '\\' ? 2 : 1;
+                if (mPos >= mEnd)
+                    return false;
+                s = std::string_view(begin, mPos - begin);
+                mPos++;
+                return true;
+            }
+
+            /**
+             * @brief Reads a string, number or literal.
+             */
+            bool scalar(std::string_view &s) {
+                skipSpace();
+                if (mPos < mEnd && *mPos == '"')
+                    return string(s);
+                const char *begin = mPos;
+                while (mPos < mEnd && *mPos != ',' && *mPos != '}' && *mPos != ']' && !isSpace(*mPos))
+                    mPos++;
+                s = std::string_view(begin, mPos - begin);
+                return mPos > begin;
+            }
+
+            bool number(double &value) {
+                std::string_view s;
+                return scalar(s) && parseDouble(s, value);
+            }
+
+            template<typename Integer>
+            bool integer(Integer &value) {
+                std::string_view s;
+                int64_t parsed;
+                if (!scalar(s) || !parseInteger(s, parsed))
+                    return false;
+                value = Integer(parsed);
+                return true;
+            }
+
+            bool boolean(bool &value) {
+                std::string_view s;
+                if (!scalar(s) || (s != "true" && s != "false"))
+                    return false;
+                value = s == "true";
+                return true;
+            }
+
+            /**
+             * @brief Skips a value, returning its raw text.
+             */
+            bool value(std::string_view &raw) {
+                skipSpace();
+                const char *begin = mPos;
+                if (mPos >= mEnd)
+                    return false;
+                if (*mPos == '{' || *mPos == '[') {
+                    int depth = 0;
+                    while (mPos < mEnd) {
+                        char c = *mPos;
+                        if (c == '"') {
+                            std::string_view s;
+                            if (!string(s))
+                                return false;
+                            continue;
+                        }
+                        mPos++;
+                        if (c == '{' || c == '[')
+                            depth++;
+                        else if ((c == '}' || c == ']') && --depth == 0) {
+                            raw = std::string_view(begin, mPos - begin);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                return scalar(raw);
+            }
+
+            bool skip() {
+                std::string_view raw;
+                return value(raw);
+            }
+
+            /**
+             * @brief Reads an object, member(key) must read the value.
+             */
+            template<typename Member>
+            bool object(Member &&member) {
+                if (!consume('{'))
+                    return false;
+                if (consume('}'))
+                    return true;
+                do {
+                    std::string_view key;
+                    if (!string(key) || !consume(':') || !member(key))
+                        return false;
+                } while (consume(','));
+                return consume('}');
+            }
+
+            /**
+             * @brief Reads an array, element() must read one element.
+             */
+            template<typename Element>
+            bool array(Element &&element) {
+                if (!consume('['))
+                    return false;
+                if (consume(']'))
+                    return true;
+                do {
+                    if (!element())
+                        return false;
+                } while (consume(','));
+                return consume(']');
+            }
+
+            /**
+             * @brief Reads the remaining elements of an array and its end.
+             */
+            bool endArray() {
+                while (consume(','))
+                    if (!skip())
+                        return false;
+                return consume(']');
+            }
+
+        private:
+            static bool isSpace(char c) {
+                return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+            }
+
+            void skipSpace() {
+                while (mPos < mEnd && isSpace(*mPos))
+                    mPos++;
+            }
+        };
+
+        /**
+         * @brief Reads an array of [price, quantity, ..] levels.
+         */
+        template<typename Add>
+        bool parseLevels(Scanner &scanner, Add &&add) {
+            return scanner.array([&]() {
+                double price, quantity;
+                if (!scanner.consume('[') || !scanner.number(price) || !scanner.consume(',') ||
+                    !scanner.number(quantity) || !scanner.endArray())
+                    return false;
+                add(price, quantity);
+                return true;
+            });
+        }
+    }
+
+    bool parseDouble(std::string_view text, double &value) {
+        const char *end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        return ec == std::errc() && ptr == end;
+    }
+
+    bool parseInteger(std::string_view text, int64_t &value) {
+        const char *end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        return ec == std::errc() && ptr == end;
+    }
+
+    double jsonDouble(const Json::Value &value) {
+        if (value.isNumeric())
+            return value.asDouble();
+        const char *begin, *end;
+        double number;
+        if (value.isString() && value.getString(&begin, &end) && parseDouble({begin, size_t(end - begin)}, number))
+            return number;
+        return 0;
+    }
+
+    double jsonDoubleStrict(const Json::Value &value) {
+        if (value.isNumeric())
+            return value.asDouble();
+        const char *begin, *end;
+        double number;
+        if (value.isString() && value.getString(&begin, &end) && parseDouble({begin, size_t(end - begin)}, number))
+            return number;
+        throw std::invalid_argument("jsonDoubleStrict");
+    }
+
+    bool parseStreamMessage(std::string_view message, std::string_view &stream, std::string_view &data) {
+        Scanner scanner(message);
+        bool hasStream = false, hasData = false;
+        bool parsed = scanner.object([&](std::string_view key) {
+            if (key == "stream")
+                return hasStream = scanner.string(stream);
+            if (key == "data")
+                return hasData = scanner.value(data);
+            return scanner.skip();
+        });
+        return parsed && hasStream && hasData;
+    }
+
+    bool parseDepthUpdate(std::string_view data, DepthUpdate &update) {
+        update.bids.clear();
+        update.asks.clear();
+        Scanner scanner(data);
+        bool hasFirst = false, hasFinal = false;
+        return scanner.object([&](std::string_view key) {
+            if (key == "U")
+                return hasFirst = scanner.integer(update.firstUpdateId);
+            if (key == "u")
+                return hasFinal = scanner.integer(update.finalUpdateId);
+            if (key == "b")
+                return parseLevels(scanner, [&](double price, double quantity) {
+                    update.bids.emplace_back(price, quantity);
+                });
+            if (key == "a")
+                return parseLevels(scanner, [&](double price, double quantity) {
+                    update.asks.emplace_back(price, quantity);
+                });
+            return scanner.skip();
+        }) && hasFirst && hasFinal;
+    }
+
+    bool parseTrade(std::string_view data, double &price, int64_t &time) {
+        Scanner scanner(data);
+        bool hasPrice = false, hasTime = false;
+        return scanner.object([&](std::string_view key) {
+            if (key == "p")
+                return hasPrice = scanner.number(price);
+            if (key == "T")
+                return hasTime = scanner.integer(time);
+            return scanner.skip();
+        }) && hasPrice && hasTime;
+    }
+
+    bool parseKlineEvent(std::string_view data, std::string_view &interval, Kline &kline, bool &closed) {
+        Scanner scanner(data);
+        int found = 0;
+        closed = false;
+        bool parsed = scanner.object([&](std::string_view key) {
+            if (key != "k")
+                return scanner.skip();
+            return scanner.object([&](std::string_view field) {
+                if (field.size() != 1)
+                    return scanner.skip();
+                bool ok;
+                switch (field[0]) {
+                    case 't': {
+                        int64_t time = 0;
+                        ok = scanner.integer(time);
+                        kline.time = time_t(time / 1000);
+                        break;
+                    }
+                    case 'i':
+                        ok = scanner.string(interval);
+                        break;
+                    case 'o':
+                        ok = scanner.number(kline.open);
+                        break;
+                    case 'h':
+                        ok = scanner.number(kline.high);
+                        break;
+                    case 'l':
+                        ok = scanner.number(kline.low);
+                        break;
+                    case 'c':
+                        ok = scanner.number(kline.close);
+                        break;
+                    case 'v':
+                        ok = scanner.number(kline.volume);
+                        break;
+                    case 'x':
+                        return scanner.boolean(closed); // optional, an open kline by default
+                    default:
+                        return scanner.skip();
+                }
+                found += ok;
+                return ok;
+            });
+        });
+        return parsed && found == 7;
+    }
+
+} // ats
@@ -0,0 +1,74 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "KlineAggregator.h"
+#include <algorithm>
+#include "MarketData.h"
+
+namespace ats {
+
+    namespace {
+        /**
+         * @brief Appends a kline to the combination of the klines before it.
+         */
+        void combine(Kline &combined, const Kline &next) {
+            combined.high = std::max(combined.high, next.high);
+            combined.low = std::min(combined.low, next.low);
+            combined.close = next.close;
+            combined.volume += next.volume;
+        }
+    }
+
+    KlineAggregator::KlineAggregator(Interval interval) : mInterval(interval) {}
+
+    Interval KlineAggregator::getInterval() const {
+        return mInterval;
+    }
+
+    bool KlineAggregator::isSeeded() const {
+        return mSeeded;
+    }
+
+    bool KlineAggregator::isAligned() const {
+        return mAligned;
+    }
+
+    void KlineAggregator::seed(const Klines &source) {
+        mSeeded = true;
+        if (source.times.empty())
+            return;
+        time_t open = intervalOpenTime(mInterval, source.times.back());
+        Kline bar;
+        for (size_t i = std::lower_bound(source.times.begin(), source.times.end(), open) - source.times.begin();
+             i < source.times.size(); i++)
+            add(source.at(i), bar);
+    }
+
+    bool KlineAggregator::add(const Kline &kline, Kline &bar) {
+        time_t open = intervalOpenTime(mInterval, kline.time);
+        time_t current = mHasOpen ? intervalOpenTime(mInterval, mOpen.time) : 0;
+        if (open < current || (mHasOpen && open == current && kline.time < mOpen.time))
+            return false;
+        if (open > current || !mHasOpen) {
+            // a period is complete only if its first shorter kline was seen
+            mAligned = kline.time == open;
+            mHasClosed = false;
+        } else if (kline.time > mOpen.time) {
+            if (mHasClosed)
+                combine(mClosed, mOpen);
+            else mClosed = mOpen;
+            mClosed.time = open;
+            mHasClosed = true;
+        }
+        mOpen = kline;
+        mHasOpen = true;
+        if (mHasClosed) {
+            bar = mClosed;
+            combine(bar, mOpen);
+        } else bar = mOpen;
+        bar.time = open;
+        return true;
+    }
+
+} // ats
@@ -0,0 +1,224 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "KlineStore.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MarketData.h"
+
+namespace ats {
+
+    namespace {
+        /**
+         * @brief The file header, followed by the columns.
+         */
+        struct KlineHeader {
+            char magic[8]; /**< "ATSKLIN" */
+            uint32_t version; /**< Format version */
+            uint32_t reserved0;
+            uint64_t count; /**< Number of klines, written after their fields */
+            uint64_t capacity; /**< Length of each column */
+            char reserved[32];
+        };
+
+        constexpr char MAGIC[8] = "ATSKLIN";
+        constexpr uint32_t VERSION = 1;
+        constexpr size_t COLUMNS = 6; // time, open, high, low, close, volume
+        constexpr size_t TIME = 0, OPEN = 1, HIGH = 2, LOW = 3, CLOSE = 4, VOLUME = 5;
+
+        static_assert(sizeof(KlineHeader) == 64, "The columns start on a cache line");
+        static_assert(sizeof(int64_t) == sizeof(double), "The columns have the same width");
+    }
+
+    KlineStore::~KlineStore() {
+        close();
+    }
+
+    bool KlineStore::open(const std::string &path) {
+        close();
+        mFd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (mFd < 0)
+            return false;
+        struct stat st{};
+        if (fstat(mFd, &st) != 0) {
+            unmap();
+            return false;
+        }
+        size_t fileSize = size_t(st.st_size);
+        bool created = fileSize < sizeof(KlineHeader);
+        size_t size = created ? columnOffset(COLUMNS, INITIAL_CAPACITY) : fileSize;
+        if (created && ftruncate(mFd, off_t(size)) != 0) {
+            unmap();
+            return false;
+        }
+        void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+        if (map == MAP_FAILED) {
+            unmap();
+            return false;
+        }
+        mMap = static_cast<char *>(map);
+        mMapSize = size;
+        auto *header = reinterpret_cast<KlineHeader *>(mMap);
+        if (created) {
+            std::memset(header, 0, sizeof(KlineHeader));
+            std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+            header->version = VERSION;
+            header->capacity = INITIAL_CAPACITY;
+        } else if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+                   columnOffset(COLUMNS, header->capacity) > fileSize || header->count > header->capacity) {
+            unmap();
+            return false;
+        }
+        mPath = path;
+        return true;
+    }
+
+    void KlineStore::close() {
+        if (mMap)
+            msync(mMap, mMapSize, MS_SYNC);
+        unmap();
+    }
+
+    bool KlineStore::isOpen() const {
+        return mMap != nullptr;
+    }
+
+    size_t KlineStore::size() const {
+        return mMap ? reinterpret_cast<const KlineHeader *>(mMap)->count : 0;
+    }
+
+    const int64_t *KlineStore::times() const {
+        return column<int64_t>(TIME);
+    }
+
+    const double *KlineStore::opens() const {
+        return column<double>(OPEN);
+    }
+
+    const double *KlineStore::highs() const {
+        return column<double>(HIGH);
+    }
+
+    const double *KlineStore::lows() const {
+        return column<double>(LOW);
+    }
+
+    const double *KlineStore::closes() const {
+        return column<double>(CLOSE);
+    }
+
+    const double *KlineStore::volumes() const {
+        return column<double>(VOLUME);
+    }
+
+    Kline KlineStore::at(size_t i) const {
+        return {time_t(times()[i]), opens()[i], highs()[i], lows()[i], closes()[i], volumes()[i]};
+    }
+
+    time_t KlineStore::lastTime() const {
+        size_t count = size();
+        return count ? time_t(times()[count - 1]) : 0;
+    }
+
+    size_t KlineStore::lowerBound(time_t time) const {
+        if (!mMap)
+            return 0;
+        return std::lower_bound(times(), times() + size(), int64_t(time)) - times();
+    }
+
+    Klines KlineStore::read(size_t first, size_t count) const {
+        Klines klines;
+        size_t last = std::min(size(), first + count);
+        if (first >= last)
+            return klines;
+        klines.times.assign(times() + first, times() + last);
+        klines.opens.assign(opens() + first, opens() + last);
+        klines.highs.assign(highs() + first, highs() + last);
+        klines.lows.assign(lows() + first, lows() + last);
+        klines.closes.assign(closes() + first, closes() + last);
+        klines.volumes.assign(volumes() + first, volumes() + last);
+        return klines;
+    }
+
+    bool KlineStore::append(const Kline &kline) {
+        if (!mMap)
+            return false;
+        size_t count = size();
+        if (count && kline.time < lastTime())
+            return false;
+        size_t i = count && kline.time == lastTime() ? count - 1 : count;
+        if (i == capacity() && !grow(2 * capacity()))
+            return false;
+        column<int64_t>(TIME)[i] = kline.time;
+        column<double>(OPEN)[i] = kline.open;
+        column<double>(HIGH)[i] = kline.high;
+        column<double>(LOW)[i] = kline.low;
+        column<double>(CLOSE)[i] = kline.close;
+        column<double>(VOLUME)[i] = kline.volume;
+        reinterpret_cast<KlineHeader *>(mMap)->count = i + 1;
+        return true;
+    }
+
+    void KlineStore::flush() {
+        if (mMap)
+            msync(mMap, mMapSize, MS_ASYNC);
+    }
+
+    size_t KlineStore::capacity() const {
+        return mMap ? reinterpret_cast<const KlineHeader *>(mMap)->capacity : 0;
+    }
+
+    size_t KlineStore::columnOffset(size_t index, size_t capacity) {
+        return sizeof(KlineHeader) + index * capacity * sizeof(double);
+    }
+
+    bool KlineStore::grow(size_t capacity) {
+        std::string path = mPath + ".tmp";
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return false;
+        size_t bytes = columnOffset(COLUMNS, capacity);
+        void *map = ftruncate(fd, off_t(bytes)) == 0 ?
+                    mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+        if (map == MAP_FAILED) {
+            ::close(fd);
+            unlink(path.c_str());
+            return false;
+        }
+        char *copy = static_cast<char *>(map);
+        size_t count = size(), oldCapacity = this->capacity();
+        std::memcpy(copy, mMap, sizeof(KlineHeader));
+        reinterpret_cast<KlineHeader *>(copy)->capacity = capacity;
+        for (size_t index = 0; index < COLUMNS; index++)
+            std::memcpy(copy + columnOffset(index, capacity), mMap + columnOffset(index, oldCapacity),
+                        count * sizeof(double));
+        if (msync(copy, bytes, MS_SYNC) != 0 || rename(path.c_str(), mPath.c_str()) != 0) {
+            munmap(copy, bytes);
+            ::close(fd);
+            unlink(path.c_str());
+            return false;
+        }
+        unmap();
+        mFd = fd;
+        mMap = copy;
+        mMapSize = bytes;
+        return true;
+    }
+
+    void KlineStore::unmap() {
+        if (mMap)
+            munmap(mMap, mMapSize);
+        mMap = nullptr;
+        mMapSize = 0;
+        if (mFd >= 0)
+            ::close(mFd);
+        mFd = -1;
+    }
+
+} // ats
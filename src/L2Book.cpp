@@ -0,0 +1,162 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "L2Book.h"
+#include <algorithm>
+
+namespace ats {
+
+    std::string DepthUpdateResultToString(DepthUpdateResult r) {
+        switch (r) {
+            case DEPTH_APPLIED:
+                return "APPLIED";
+            case DEPTH_STALE:
+                return "STALE";
+            case DEPTH_BUFFERED:
+                return "BUFFERED";
+            case DEPTH_GAP:
+                return "GAP";
+            default:
+                return "Unknown";
+        }
+    }
+
+    L2Book::L2Book(double tickSize, size_t ladderTicks) {
+        if (tickSize > 0) {
+            mBidLadder = std::make_unique<PriceLadder>(tickSize, true, ladderTicks);
+            mAskLadder = std::make_unique<PriceLadder>(tickSize, false, ladderTicks);
+        }
+    }
+
+    bool L2Book::applySnapshot(const OrderBook &snapshot) {
+        mBids.clear();
+        mAsks.clear();
+        if (mBidLadder) {
+            mBidLadder->clear();
+            mAskLadder->clear();
+            for (size_t i = 0; i < snapshot.bid.size() && i < snapshot.bidVol.size(); i++)
+                mBidLadder->set(snapshot.bid[i], snapshot.bidVol[i]);
+            for (size_t i = 0; i < snapshot.ask.size() && i < snapshot.askVol.size(); i++)
+                mAskLadder->set(snapshot.ask[i], snapshot.askVol[i]);
+        } else {
+            for (size_t i = 0; i < snapshot.bid.size() && i < snapshot.bidVol.size(); i++)
+                mBids[snapshot.bid[i]] = snapshot.bidVol[i];
+            for (size_t i = 0; i < snapshot.ask.size() && i < snapshot.askVol.size(); i++)
+                mAsks[snapshot.ask[i]] = snapshot.askVol[i];
+        }
+        mLastUpdateId = snapshot.lastUpdateId;
+        mSynced = true;
+        std::deque<DepthUpdate> buffered;
+        buffered.swap(mBuffered);
+        for (const DepthUpdate &update: buffered)
+            applyUpdate(update);
+        return mSynced;
+    }
+
+    DepthUpdateResult L2Book::applyUpdate(const DepthUpdate &update) {
+        if (!mSynced) {
+            buffer(update);
+            return DEPTH_BUFFERED;
+        }
+        if (update.finalUpdateId <= mLastUpdateId)
+            return DEPTH_STALE;
+        // levels carry absolute quantities, so a diff overlapping ids already applied is still valid
+        if (update.firstUpdateId > mLastUpdateId + 1) {
+            mSynced = false;
+            buffer(update);
+            return DEPTH_GAP;
+        }
+        if (mBidLadder) {
+            applyLevels(*mBidLadder, update.bids);
+            applyLevels(*mAskLadder, update.asks);
+        } else {
+            applyLevels(mBids, update.bids);
+            applyLevels(mAsks, update.asks);
+        }
+        mLastUpdateId = update.finalUpdateId;
+        return DEPTH_APPLIED;
+    }
+
+    void L2Book::reset() {
+        mBids.clear();
+        mAsks.clear();
+        if (mBidLadder) {
+            mBidLadder->clear();
+            mAskLadder->clear();
+        }
+        mBuffered.clear();
+        mLastUpdateId = 0;
+        mSynced = false;
+    }
+
+    bool L2Book::isSynced() const {
+        return mSynced;
+    }
+
+    uint64_t L2Book::getLastUpdateId() const {
+        return mLastUpdateId;
+    }
+
+    OrderBook L2Book::getOrderBook(size_t depth) const {
+        OrderBook book;
+        book.lastUpdateId = mLastUpdateId;
+        if (mBidLadder) {
+            mBidLadder->getLevels(book.bid, book.bidVol, depth);
+            mAskLadder->getLevels(book.ask, book.askVol, depth);
+            return book;
+        }
+        size_t bids = depth ? std::min(depth, mBids.size()) : mBids.size();
+        size_t asks = depth ? std::min(depth, mAsks.size()) : mAsks.size();
+        book.bid.reserve(bids);
+        book.bidVol.reserve(bids);
+        book.ask.reserve(asks);
+        book.askVol.reserve(asks);
+        for (auto it = mBids.begin(); book.bid.size() < bids; ++it) {
+            book.bid.push_back(it->first);
+            book.bidVol.push_back(it->second);
+        }
+        for (auto it = mAsks.begin(); book.ask.size() < asks; ++it) {
+            book.ask.push_back(it->first);
+            book.askVol.push_back(it->second);
+        }
+        return book;
+    }
+
+    BBO L2Book::getBBO() const {
+        BBO bbo;
+        bbo.updateId = mLastUpdateId;
+        if (mBidLadder) {
+            bbo.bidPrice = mBidLadder->getBestPrice();
+            bbo.bidQty = mBidLadder->getBestQuantity();
+            bbo.askPrice = mAskLadder->getBestPrice();
+            bbo.askQty = mAskLadder->getBestQuantity();
+            return bbo;
+        }
+        if (!mBids.empty()) {
+            bbo.bidPrice = mBids.begin()->first;
+            bbo.bidQty = mBids.begin()->second;
+        }
+        if (!mAsks.empty()) {
+            bbo.askPrice = mAsks.begin()->first;
+            bbo.askQty = mAsks.begin()->second;
+        }
+        return bbo;
+    }
+
+    bool L2Book::hasLadder() const {
+        return mBidLadder != nullptr;
+    }
+
+    void L2Book::applyLevels(PriceLadder &ladder, const std::vector<std::pair<double, double>> &levels) {
+        for (auto &[price, quantity]: levels)
+            ladder.set(price, quantity);
+    }
+
+    void L2Book::buffer(const DepthUpdate &update) {
+        if (mBuffered.size() == MAX_BUFFERED)
+            mBuffered.pop_front();
+        mBuffered.push_back(update);
+    }
+
+} // ats
@@ -0,0 +1,82 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+
+namespace ats {
+
+    LatencyHistogram::LatencyHistogram() {
+        for (auto &bucket: mBuckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+
+    void LatencyHistogram::record(int64_t ns) {
+        ns = std::max<int64_t>(ns, 0);
+        mBuckets[bucketFor(uint64_t(ns))].fetch_add(1, std::memory_order_relaxed);
+        mCount.fetch_add(1, std::memory_order_relaxed);
+        mSum.fetch_add(ns, std::memory_order_relaxed);
+        int64_t min = mMin.load(std::memory_order_relaxed);
+        while (ns < min && !mMin.compare_exchange_weak(min, ns, std::memory_order_relaxed));
+        int64_t max = mMax.load(std::memory_order_relaxed);
+        while (ns > max && !mMax.compare_exchange_weak(max, ns, std::memory_order_relaxed));
+    }
+
+    int64_t LatencyHistogram::percentile(double quantile) const {
+        uint64_t total = 0;
+        for (auto &bucket: mBuckets)
+            total += bucket.load(std::memory_order_relaxed);
+        if (!total)
+            return 0;
+        uint64_t rank = std::max<uint64_t>(1, uint64_t(quantile * double(total) + 0.5));
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += mBuckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return std::min(bucketUpperBound(i), mMax.load(std::memory_order_relaxed));
+        }
+        return mMax.load(std::memory_order_relaxed);
+    }
+
+    LatencyStats LatencyHistogram::getStats() const {
+        LatencyStats stats;
+        stats.count = mCount.load(std::memory_order_relaxed);
+        if (!stats.count)
+            return stats;
+        stats.mean = double(mSum.load(std::memory_order_relaxed)) / double(stats.count);
+        stats.min = mMin.load(std::memory_order_relaxed);
+        stats.max = mMax.load(std::memory_order_relaxed);
+        stats.p50 = percentile(0.5);
+        stats.p90 = percentile(0.9);
+        stats.p99 = percentile(0.99);
+        stats.p999 = percentile(0.999);
+        return stats;
+    }
+
+    void LatencyHistogram::reset() {
+        for (auto &bucket: mBuckets)
+            bucket.store(0, std::memory_order_relaxed);
+        mCount.store(0, std::memory_order_relaxed);
+        mSum.store(0, std::memory_order_relaxed);
+        mMin.store(INT64_MAX, std::memory_order_relaxed);
+        mMax.store(0, std::memory_order_relaxed);
+    }
+
+    int LatencyHistogram::bucketFor(uint64_t value) {
+        if (value < uint64_t(SUB_BUCKETS))
+            return int(value);
+        int exponent = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+        int sub = int(value >> exponent) - SUB_BUCKETS;
+        return (exponent + 1) * SUB_BUCKETS + sub;
+    }
+
+    int64_t LatencyHistogram::bucketUpperBound(int bucket) {
+        if (bucket < SUB_BUCKETS)
+            return bucket;
+        int exponent = bucket / SUB_BUCKETS - 1;
+        int sub = bucket % SUB_BUCKETS + SUB_BUCKETS;
+        return int64_t(((uint64_t(sub) + 1) << exponent) - 1);
+    }
+
+} // ats
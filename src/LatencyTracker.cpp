@@ -0,0 +1,187 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "LatencyTracker.h"
+#include <iomanip>
+#include <sstream>
+
+namespace ats {
+
+    namespace {
+        void formatStats(std::ostringstream &out, const std::string &name, LatencyStage stage,
+                         const LatencyStats &stats) {
+            out << std::left << std::setw(12) << name << std::setw(11) << LatencyStageToString(stage)
+                << std::right << std::fixed << std::setprecision(1)
+                << " n=" << stats.count << " mean=" << stats.mean / 1e3 << "us p50=" << double(stats.p50) / 1e3
+                << "us p90=" << double(stats.p90) / 1e3 << "us p99=" << double(stats.p99) / 1e3
+                << "us p99.9=" << double(stats.p999) / 1e3 << "us max=" << double(stats.max) / 1e3 << "us\n";
+        }
+    }
+
+    std::string LatencyStageToString(LatencyStage s) {
+        switch (s) {
+            case STAGE_PENDING:
+                return "PENDING";
+            case STAGE_VALIDATION:
+                return "VALIDATION";
+            case STAGE_EMS_QUEUE:
+                return "EMS_QUEUE";
+            case STAGE_EXCHANGE:
+                return "EXCHANGE";
+            case STAGE_TOTAL:
+                return "TOTAL";
+            default:
+                return "Unknown";
+        }
+    }
+
+    LatencyTracker::LatencyTracker(size_t capacity) : mMask(roundUpToPowerOfTwo(capacity) - 1),
+                                                      mTimes(new OrderTimes[mMask + 1]) {
+        for (auto &chunk: mSymbols)
+            chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    LatencyTracker::~LatencyTracker() {
+        stopDump();
+        for (auto &chunk: mSymbols) {
+            std::atomic<SymbolLatency *> *symbols = chunk.load(std::memory_order_acquire);
+            if (!symbols)
+                continue;
+            for (size_t i = 0; i < CHUNK_SIZE; i++)
+                delete symbols[i].load(std::memory_order_acquire);
+            delete[] symbols;
+        }
+    }
+
+    int64_t LatencyTracker::now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void LatencyTracker::mark(const Order &order, OrderHop hop) {
+        if (!mEnabled.load(std::memory_order_relaxed) || order.id < 0)
+            return;
+        int64_t time = now();
+        OrderTimes &times = mTimes[size_t(order.id) & mMask];
+        if (hop == HOP_CREATED) {
+            for (auto &h: times.hops)
+                h.store(0, std::memory_order_relaxed);
+            times.id.store(order.id, std::memory_order_relaxed);
+        } else if (times.id.load(std::memory_order_relaxed) != order.id)
+            return; // evicted by a newer order
+        times.hops[hop].store(time, std::memory_order_relaxed);
+        if (hop != HOP_ACKED)
+            return;
+        int64_t hops[HCOUNT];
+        for (int i = 0; i < HCOUNT; i++)
+            hops[i] = times.hops[i].load(std::memory_order_relaxed);
+        SymbolLatency &symbol = symbolLatency(order.symbol);
+        auto record = [&](LatencyStage stage, OrderHop from, OrderHop to) {
+            if (!hops[from] || !hops[to])
+                return;
+            mStages[stage].record(hops[to] - hops[from]);
+            symbol.stages[stage].record(hops[to] - hops[from]);
+        };
+        record(STAGE_PENDING, HOP_CREATED, HOP_PROCESSING);
+        record(STAGE_VALIDATION, HOP_PROCESSING, HOP_EMS_QUEUED);
+        record(STAGE_EMS_QUEUE, HOP_EMS_QUEUED, HOP_SENDING);
+        record(STAGE_EXCHANGE, HOP_SENDING, HOP_ACKED);
+        record(STAGE_TOTAL, HOP_CREATED, HOP_ACKED);
+        times.id.store(-1, std::memory_order_relaxed);
+    }
+
+    void LatencyTracker::setEnabled(bool enabled) {
+        mEnabled = enabled;
+    }
+
+    LatencyStats LatencyTracker::getStats(LatencyStage stage) const {
+        return mStages[stage].getStats();
+    }
+
+    LatencyStats LatencyTracker::getStats(LatencyStage stage, SymbolId symbol) const {
+        const SymbolLatency *latency = findSymbolLatency(symbol);
+        return latency ? latency->stages[stage].getStats() : LatencyStats{};
+    }
+
+    std::string LatencyTracker::dump() const {
+        std::ostringstream out;
+        for (int stage = 0; stage < LSCOUNT; stage++)
+            formatStats(out, "ALL", LatencyStage(stage), getStats(LatencyStage(stage)));
+        for (size_t symbol = 0; symbol < symbolCount(); symbol++) {
+            const SymbolLatency *latency = findSymbolLatency(SymbolId(symbol));
+            if (!latency)
+                continue;
+            for (int stage = 0; stage < LSCOUNT; stage++)
+                formatStats(out, SymbolToString(SymbolId(symbol)), LatencyStage(stage),
+                            latency->stages[stage].getStats());
+        }
+        return out.str();
+    }
+
+    void LatencyTracker::reset() {
+        for (auto &stage: mStages)
+            stage.reset();
+        for (auto &chunk: mSymbols) {
+            std::atomic<SymbolLatency *> *symbols = chunk.load(std::memory_order_acquire);
+            if (!symbols)
+                continue;
+            for (size_t i = 0; i < CHUNK_SIZE; i++)
+                if (SymbolLatency *latency = symbols[i].load(std::memory_order_acquire))
+                    for (auto &stage: latency->stages)
+                        stage.reset();
+        }
+    }
+
+    void LatencyTracker::startDump(std::chrono::milliseconds period, std::function<void(const std::string &)> sink) {
+        stopDump();
+        std::lock_guard<std::mutex> lock(mDumpMutex);
+        mDumping = true;
+        mDumpThread = std::thread([this, period, sink]() {
+            std::unique_lock<std::mutex> lock(mDumpMutex);
+            while (!mDumpCondition.wait_for(lock, period, [this]() { return !mDumping; })) {
+                lock.unlock();
+                sink(dump());
+                lock.lock();
+            }
+        });
+    }
+
+    void LatencyTracker::stopDump() {
+        {
+            std::lock_guard<std::mutex> lock(mDumpMutex);
+            mDumping = false;
+        }
+        mDumpCondition.notify_all();
+        if (mDumpThread.joinable())
+            mDumpThread.join();
+    }
+
+    LatencyTracker::SymbolLatency &LatencyTracker::symbolLatency(SymbolId symbol) {
+        std::atomic<std::atomic<SymbolLatency *> *> &chunk = mSymbols[symbol / CHUNK_SIZE];
+        std::atomic<SymbolLatency *> *symbols = chunk.load(std::memory_order_acquire);
+        if (!symbols) {
+            auto *created = new std::atomic<SymbolLatency *>[CHUNK_SIZE];
+            for (size_t i = 0; i < CHUNK_SIZE; i++)
+                created[i].store(nullptr, std::memory_order_relaxed);
+            if (chunk.compare_exchange_strong(symbols, created, std::memory_order_acq_rel))
+                symbols = created;
+            else delete[] created;
+        }
+        std::atomic<SymbolLatency *> &slot = symbols[symbol % CHUNK_SIZE];
+        SymbolLatency *latency = slot.load(std::memory_order_acquire);
+        if (!latency) {
+            auto *created = new SymbolLatency();
+            if (slot.compare_exchange_strong(latency, created, std::memory_order_acq_rel))
+                latency = created;
+            else delete created;
+        }
+        return *latency;
+    }
+
+    const LatencyTracker::SymbolLatency *LatencyTracker::findSymbolLatency(SymbolId symbol) const {
+        std::atomic<SymbolLatency *> *symbols = mSymbols[symbol / CHUNK_SIZE].load(std::memory_order_acquire);
+        return symbols ? symbols[symbol % CHUNK_SIZE].load(std::memory_order_acquire) : nullptr;
+    }
+
+} // ats
@@ -3,14 +3,71 @@
 //
 
 #include "../include/MarketData.h"
+#include "../include/JsonParser.h"
+#include <algorithm>
+#include <chrono>
 #include <vector>
 
 namespace ats {
 
-    MarketData::MarketData(ExchangeManager &ems, time_t interval) : mExchangeManager(ems), mUpdateInterval(interval) {}
+    namespace {
+        /**
+         * @brief Builds the snapshot of a symbol,interval pair's klines, sharing the closed ones of the previous.
+         * Closed klines only change when klines are appended or the oldest dropped, which moves their ends.
+         */
+        std::shared_ptr<const KlinesSnapshot> snapshotKlines(const Klines &klines, const KlinesSnapshot *previous) {
+            auto snapshot = std::make_shared<KlinesSnapshot>();
+            size_t closed = klines.times.empty() ? 0 : klines.times.size() - 1;
+            if (previous && previous->closed->times.size() == closed && (!closed ||
+                (previous->closed->times.front() == klines.times.front() &&
+                 previous->closed->times.back() == klines.times[closed - 1])))
+                snapshot->closed = previous->closed;
+            else if (closed) {
+                auto prefix = std::make_shared<Klines>();
+                prefix->times.assign(klines.times.begin(), klines.times.begin() + closed);
+                prefix->opens.assign(klines.opens.begin(), klines.opens.begin() + closed);
+                prefix->highs.assign(klines.highs.begin(), klines.highs.begin() + closed);
+                prefix->lows.assign(klines.lows.begin(), klines.lows.begin() + closed);
+                prefix->closes.assign(klines.closes.begin(), klines.closes.begin() + closed);
+                prefix->volumes.assign(klines.volumes.begin(), klines.volumes.begin() + closed);
+                snapshot->closed = std::move(prefix);
+            }
+            if (!klines.times.empty()) {
+                snapshot->last = klines.at(closed);
+                snapshot->hasLast = true;
+            }
+            return snapshot;
+        }
+    }
 
-    MarketData::MarketData(const std::vector<std::string> &symbols, ExchangeManager &ems, time_t interval)
-            : mExchangeManager(ems), mUpdateInterval(interval) {
+    std::string RefreshTypeToString(RefreshType t) {
+        switch (t) {
+            case REFRESH_PRICE:
+                return "PRICE";
+            case REFRESH_BOOK:
+                return "BOOK";
+            case REFRESH_KLINES:
+                return "KLINES";
+            case REFRESH_BALANCES:
+                return "BALANCES";
+            default:
+                return "Unknown";
+        }
+    }
+
+    MarketData::MarketData(ExchangeManager &ems, time_t interval, const std::string &streamUrl, Clock &clock)
+            : mStreamUrl(streamUrl), mExchangeManager(ems), mClock(clock), mUpdateInterval(interval), mBBOs(clock),
+              mRefreshWheel(TimerWheel::DEFAULT_TICK_MS, TimerWheel::DEFAULT_SLOTS, clock.nowMs()) {
+        mDefaultSchedules[REFRESH_PRICE] = {int64_t(interval) * 1000, 2};
+        mDefaultSchedules[REFRESH_BOOK] = {int64_t(interval) * 1000, 3};
+        mDefaultSchedules[REFRESH_KLINES] = {int64_t(interval) * 1000, 1};
+        mDefaultSchedules[REFRESH_BALANCES] = {BALANCES_PERIOD_MS, 0};
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        addRefreshStream("", REFRESH_BALANCES);
+    }
+
+    MarketData::MarketData(const std::vector<std::string> &symbols, ExchangeManager &ems, time_t interval,
+                           const std::string &streamUrl, Clock &clock) : MarketData(ems, interval, streamUrl, clock) {
         for (const std::string &symbol: symbols)
             subscribe(symbol);
         mRunning = false;
@@ -29,33 +86,194 @@ namespace ats {
     }
 
     void MarketData::run() {
-        time_t lastUpd{0};
         while (mRunning) {
-            time_t newUpd;
-            time(&newUpd);
-            if (difftime(newUpd, lastUpd) > mUpdateInterval) {
-                updatePrices();
-                updateKlines();
-                updateOrderBooks();
-                updateBalances();
-                time(&lastUpd);
-            }
+            if (!mStreamUrl.empty())
+                pollStream();
+            refreshDue();
+            // while connected the stream receive is the wait, otherwise wake up for the next connection attempt
+            if (!mStreaming)
+                waitForRefresh(mStreamUrl.empty() ? -1 : RECONNECT_DELAY * 1000);
         }
     }
 
     void MarketData::stop() {
-        mRunning = false;
+        {
+            std::lock_guard<std::mutex> lock(mDataMutex);
+            mRunning = false;
+        }
+        mWakeup.notify_all();
         if (mMarketDataThread.joinable())
             mMarketDataThread.join();
+        mStream.close();
+        mStreaming = false;
+    }
+
+    bool MarketData::isStreaming() {
+        return mStreaming;
+    }
+
+    Clock &MarketData::getClock() {
+        return mClock;
+    }
+
+    void MarketData::pollStream() {
+        if (!mStream.isConnected()) {
+            mStreaming = false;
+            int64_t now = mClock.now();
+            if (now < mReconnectTime)
+                return;
+            mReconnectTime = now + RECONNECT_DELAY * NANOS_PER_SECOND;
+            if (!mStream.connect(mStreamUrl + "/stream"))
+                return;
+            mStreams.clear();
+            mStreamsChanged = true;
+            mStreaming = true;
+            std::unique_lock<std::mutex> lock(mDataMutex);
+            // resynced from the first diffs and a snapshot, readers keep the last published books meanwhile
+            for (auto &[symbol, book]: mOrderBooks)
+                book.reset();
+            lock.unlock();
+            updateKlines(getSymbols()); // the kline streams only carry the current candle
+        }
+        if (mStreamsChanged.exchange(false))
+            updateStreams();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(STREAM_POLL_MS);
+        std::string message;
+        while (mStream.isConnected()) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0 || !mStream.receive(message, int(remaining)))
+                break;
+            handleStreamMessage(message);
+        }
+        resyncOrderBooks();
+        mStreaming = mStream.isConnected();
+    }
+
+    void MarketData::updateStreams() {
+        std::set<std::string> streams;
+        {
+            std::lock_guard<std::mutex> lock(mDataMutex);
+            for (const std::string &symbol: mSymbols) {
+                std::string name = symbol;
+                std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+                streams.insert(name + "@trade");
+                streams.insert(name + "@depth@100ms");
+            }
+            for (const auto &[key, klines]: mKlines) {
+                if (mKlineSources.count(key))
+                    continue;
+                std::string name = key.first;
+                std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+                streams.insert(name + "@kline_" + key.second);
+            }
+        }
+        Json::Value subscribe, unsubscribe;
+        for (const std::string &stream: streams)
+            if (!mStreams.count(stream))
+                subscribe.append(stream);
+        for (const std::string &stream: mStreams)
+            if (!streams.count(stream))
+                unsubscribe.append(stream);
+        Json::StreamWriterBuilder writer;
+        writer["indentation"] = "";
+        for (auto &[method, params]: {std::make_pair("UNSUBSCRIBE", unsubscribe), std::make_pair("SUBSCRIBE", subscribe)}) {
+            if (params.empty())
+                continue;
+            Json::Value request;
+            request["method"] = method;
+            request["params"] = params;
+            request["id"] = ++mRequestId;
+            if (!mStream.send(Json::writeString(writer, request)))
+                return;
+        }
+        mStreams.swap(streams);
+    }
+
+    void MarketData::handleStreamMessage(const std::string &message) {
+        try {
+            std::string_view stream, data;
+            if (!parseStreamMessage(message, stream, data))
+                return; // e.g. subscription results
+            size_t at = stream.find('@');
+            if (at == std::string_view::npos)
+                return;
+            std::string symbol(stream.substr(0, at));
+            std::string_view type = stream.substr(at + 1);
+            std::transform(symbol.begin(), symbol.end(), symbol.begin(), ::toupper);
+            std::lock_guard<std::mutex> lock(mDataMutex);
+            if (!mSymbols.count(symbol))
+                return;
+            if (type == "trade") {
+                double price;
+                int64_t time;
+                if (parseTrade(data, price, time))
+                    pushPrice(symbol, price, time);
+            } else if (type.compare(0, 5, "depth") == 0) {
+                if (!parseDepthUpdate(data, mDepthUpdate))
+                    return;
+                DepthUpdateResult result = mOrderBooks[symbol].applyUpdate(mDepthUpdate);
+                if (result == DEPTH_APPLIED)
+                    publishOrderBook(symbol);
+                else if (result == DEPTH_BUFFERED || result == DEPTH_GAP)
+                    mResyncs.insert(symbol);
+            } else if (type.compare(0, 6, "kline_") == 0) {
+                std::string_view interval;
+                Kline kline;
+                bool closed;
+                if (!parseKlineEvent(data, interval, kline, closed))
+                    return;
+                auto it = mKlines.find({symbol, std::string(interval)});
+                // a stored history is completed by REST first, the store would skip the klines in between
+                if (it == mKlines.end() || mKlineGaps.count(it->first))
+                    return;
+                if (!appendKline(it->first, it->second, kline))
+                    return;
+                publishKlines(it->first);
+                if (closed)
+                    notify([&](EventSubscription &subscription) {
+                        subscription.postKlineClose(symbol, it->first.second, kline);
+                    });
+            }
+        } catch (...) {
+            // a message that cannot be applied is dropped, it must not end the market data thread
+        }
+    }
+
+    void MarketData::pushPrice(const std::string &symbol, double price, int64_t time) {
+        auto it = mPrices.find(symbol);
+        if (it == mPrices.end())
+            return;
+        if (!time)
+            time = mClock.epochMs();
+        it->second->push(price, time);
+        // the last trade is the reference the validator's price band is checked against
+        mExchangeManager.getOrderManager().getValidator().setReferencePrice(stringToSymbol(symbol), price);
+        notify([&](EventSubscription &subscription) { subscription.postTick(symbol, price, time); });
+    }
+
+    void MarketData::subscribe(const std::string &symbol, Interval interval) {
+        subscribe(symbol, IntervalToString(interval));
     }
 
     void MarketData::subscribe(const std::string &symbol, std::string interval) {
         std::lock_guard<std::mutex> lock(mDataMutex);
         mSymbols.insert(symbol);
-        mOrderBooks[symbol];
-        mPrices[symbol];
+        // books of symbols with known exchange filters use tick-indexed ladders
+        double tickSize = mExchangeManager.getOrderManager().getValidator().getFilters(stringToSymbol(symbol)).tickSize;
+        mOrderBooks.try_emplace(symbol, tickSize);
+        if (!mPrices.count(symbol))
+            mPrices[symbol] = std::make_shared<PriceHistory>(mPriceHistoryCapacity);
         mKlines[{symbol, interval}];
-        mOrderBooks[symbol];
+        if (!mKlineDirectory.empty() && !mKlineStores.count({symbol, interval}))
+            attachKlineStore({symbol, interval});
+        updateKlineSources(symbol);
+        for (RefreshType type: {REFRESH_PRICE, REFRESH_BOOK, REFRESH_KLINES})
+            addRefreshStream(symbol, type);
+        publishSnapshots();
+        mStreamsChanged = true;
+        mScheduleVersion++;
+        mWakeup.notify_all();
     }
 
     void MarketData::unsubscribe(const std::string &symbol) {
@@ -63,83 +281,386 @@ namespace ats {
         mSymbols.erase(symbol);
         mPrices.erase(symbol);
         mOrderBooks.erase(symbol);
+        mResyncs.erase(symbol);
+        mBBOs.clear(stringToSymbol(symbol));
+        for (RefreshType type: {REFRESH_PRICE, REFRESH_BOOK, REFRESH_KLINES}) {
+            mRefreshStreams.erase(refreshStreamId(symbol, type));
+            mRefreshWheel.cancel(refreshStreamId(symbol, type));
+        }
         std::vector<std::string> intervalsToErase;
         for (const auto &[key, kline] : mKlines) {
             if (key.first == symbol)
                 intervalsToErase.push_back(key.second);
         }
-        for (const std::string& interval : intervalsToErase)
+        for (const std::string& interval : intervalsToErase) {
             mKlines.erase({symbol, interval});
+            mKlineStores.erase({symbol, interval});
+            mKlineGaps.erase({symbol, interval});
+        }
+        updateKlineSources(symbol);
+        publishSnapshots();
+        mStreamsChanged = true;
     }
 
     double MarketData::getPrice(const std::string& symbol) {
-        std::unique_lock<std::mutex> lock(mDataMutex);
-        if (mPrices.count(symbol)) {
-            if (mPrices[symbol].empty()) {
-                lock.unlock();
-                updatePrice(symbol);
+        std::shared_ptr<SymbolSnapshots> snapshots = findSnapshots(symbol);
+        if (!snapshots)
+            return -1;
+        if (snapshots->prices->empty())
+            updatePrice(symbol);
+        return snapshots->prices->back();
+    }
+
+    std::vector<double> MarketData::getPrices(const std::string& symbol, size_t count) {
+        std::shared_ptr<SymbolSnapshots> snapshots = findSnapshots(symbol);
+        if (!snapshots)
+            return {};
+        return snapshots->prices->getPrices(count);
+    }
+
+    void MarketData::setPriceHistoryCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        mPriceHistoryCapacity = capacity;
+        for (auto &[symbol, prices]: mPrices) {
+            auto resized = std::make_shared<PriceHistory>(capacity);
+            PriceWindow window = prices->window(resized->capacity());
+            for (size_t i = 0; i < window.size; i++)
+                resized->push(window[i], window.time(i));
+            prices = resized;
+        }
+        publishSnapshots();
+    }
+
+    void MarketData::setFetchParallelism(size_t parallelism) {
+        mFetchParallelism = parallelism ? parallelism : 1;
+    }
+
+    size_t MarketData::getFetchParallelism() const {
+        return mFetchParallelism;
+    }
+
+    void MarketData::refresh() {
+        std::vector<std::string> symbols = getSymbols();
+        updatePrices(symbols);
+        updateKlines(symbols);
+        updateOrderBooks(symbols);
+    }
+
+    void MarketData::setRefreshSchedule(RefreshType type, RefreshSchedule schedule) {
+        if (type >= RTCOUNT)
+            return;
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        mDefaultSchedules[type] = schedule;
+        int64_t now = mClock.nowMs();
+        for (auto &[id, stream]: mRefreshStreams)
+            if (stream.type == type) {
+                stream.schedule = schedule;
+                stream.periodMs = schedule.periodMs;
+                if (mRefreshWheel.contains(id))
+                    mRefreshWheel.schedule(id, now + schedule.periodMs);
             }
-            return mPrices[symbol].back();
+        mScheduleVersion++;
+        mWakeup.notify_all();
+    }
+
+    void MarketData::setRefreshSchedule(const std::string &symbol, RefreshType type, RefreshSchedule schedule) {
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        uint64_t id = refreshStreamId(symbol, type);
+        auto it = mRefreshStreams.find(id);
+        if (it == mRefreshStreams.end())
+            return;
+        it->second.schedule = schedule;
+        it->second.periodMs = schedule.periodMs;
+        if (mRefreshWheel.contains(id))
+            mRefreshWheel.schedule(id, mClock.nowMs() + schedule.periodMs);
+        mScheduleVersion++;
+        mWakeup.notify_all();
+    }
+
+    int64_t MarketData::getRefreshPeriod(const std::string &symbol, RefreshType type) {
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        auto it = mRefreshStreams.find(refreshStreamId(symbol, type));
+        return it == mRefreshStreams.end() ? -1 : it->second.periodMs;
+    }
+
+    std::shared_ptr<EventSubscription> MarketData::subscribeEvents() {
+        auto subscription = std::make_shared<EventSubscription>();
+        subscribeEvents(subscription);
+        return subscription;
+    }
+
+    void MarketData::subscribeEvents(const std::shared_ptr<EventSubscription> &subscription) {
+        if (!subscription)
+            return;
+        subscription->open();
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        std::shared_ptr<const std::vector<std::shared_ptr<EventSubscription>>> previous = mEventSubscriptions.load();
+        if (previous && std::find(previous->begin(), previous->end(), subscription) != previous->end())
+            return;
+        auto subscriptions = previous ? std::make_shared<std::vector<std::shared_ptr<EventSubscription>>>(*previous)
+                                      : std::make_shared<std::vector<std::shared_ptr<EventSubscription>>>();
+        subscriptions->push_back(subscription);
+        mEventSubscriptions.store(std::move(subscriptions));
+    }
+
+    void MarketData::unsubscribeEvents(const std::shared_ptr<EventSubscription> &subscription) {
+        if (!subscription)
+            return;
+        std::unique_lock<std::mutex> lock(mDataMutex);
+        std::shared_ptr<const std::vector<std::shared_ptr<EventSubscription>>> previous = mEventSubscriptions.load();
+        if (previous) {
+            auto subscriptions = std::make_shared<std::vector<std::shared_ptr<EventSubscription>>>();
+            for (const auto &other: *previous)
+                if (other != subscription)
+                    subscriptions->push_back(other);
+            mEventSubscriptions.store(std::move(subscriptions));
         }
-        return -1;
+        lock.unlock();
+        subscription->close();
     }
 
-    std::vector<double> MarketData::getPrices(const std::string& symbol) {
+    std::vector<std::string> MarketData::getSymbols() {
         std::lock_guard<std::mutex> lock(mDataMutex);
-        return mPrices[symbol];
+        return {mSymbols.begin(), mSymbols.end()};
     }
 
-    std::vector<Trade> MarketData::getTradeHistory(const std::string& symbol) {
-        return mExchangeManager.getTradeHistory(symbol);
+    void MarketData::addRefreshStream(const std::string &symbol, RefreshType type) {
+        uint64_t id = refreshStreamId(symbol, type);
+        if (mRefreshStreams.count(id))
+            return;
+        RefreshSchedule schedule = mDefaultSchedules[type];
+        mRefreshStreams.emplace(id, RefreshStream{type == REFRESH_BALANCES ? "" : symbol, type, schedule,
+                                                  schedule.periodMs});
+        mRefreshWheel.schedule(id, mClock.nowMs());
     }
 
-    void MarketData::updatePrice(const std::string &symbol) {
+    uint64_t MarketData::refreshStreamId(const std::string &symbol, RefreshType type) {
+        return type == REFRESH_BALANCES ? uint64_t(type) : uint64_t(stringToSymbol(symbol)) << 8 | type;
+    }
+
+    void MarketData::refreshDue() {
         std::unique_lock<std::mutex> lock(mDataMutex);
-        if (mPrices[symbol].size() == 1000)
-            mPrices[symbol].erase(mPrices[symbol].begin(), mPrices[symbol].begin()+500);
+        std::vector<uint64_t> ids;
+        mRefreshWheel.expire(mClock.nowMs(), ids);
+        if (ids.empty())
+            return;
+        std::vector<RefreshStream> due;
+        for (uint64_t id: ids)
+            due.push_back(mRefreshStreams.at(id));
         lock.unlock();
-        double price = mExchangeManager.getPrice(symbol);
+        std::vector<size_t> order(due.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return due[a].schedule.priority > due[b].schedule.priority;
+        });
+        // data of a type is fetched together, types in the order of their most urgent entry
+        std::vector<char> changed(due.size(), 0);
+        bool fetched[RTCOUNT] = {};
+        bool streamed = mStreaming;
+        for (size_t i: order) {
+            RefreshType type = due[i].type;
+            if (fetched[type])
+                continue;
+            fetched[type] = true;
+            std::vector<size_t> members;
+            std::vector<std::string> symbols;
+            for (size_t j: order)
+                if (due[j].type == type) {
+                    members.push_back(j);
+                    symbols.push_back(due[j].symbol);
+                }
+            std::vector<char> result(symbols.size(), 0);
+            if (type == REFRESH_BALANCES) {
+                updateBalances();
+                result.assign(symbols.size(), 1);
+            } else if (streamed) {
+                // pushed by the stream, REST stays the fallback and completes what the stream cannot
+                if (type == REFRESH_KLINES)
+                    updateKlines(symbols, true);
+                result.assign(symbols.size(), 1);
+            } else if (type == REFRESH_PRICE)
+                result = updatePrices(symbols);
+            else if (type == REFRESH_BOOK)
+                result = updateOrderBooks(symbols);
+            else if (type == REFRESH_KLINES)
+                result = updateKlines(symbols);
+            for (size_t k = 0; k < members.size(); k++)
+                changed[members[k]] = result[k];
+        }
         lock.lock();
-        mPrices[symbol].push_back(price);
+        int64_t now = mClock.nowMs();
+        for (size_t i = 0; i < due.size(); i++) {
+            auto it = mRefreshStreams.find(ids[i]);
+            if (it == mRefreshStreams.end() || mRefreshWheel.contains(ids[i]))
+                continue; // unsubscribed or rescheduled meanwhile
+            RefreshStream &stream = it->second;
+            stream.periodMs = changed[i] ? stream.schedule.periodMs :
+                              std::min(stream.periodMs * 2, stream.schedule.periodMs * MAX_BACKOFF);
+            mRefreshWheel.schedule(ids[i], now + stream.periodMs);
+        }
     }
 
-    void MarketData::updatePrices() {
+    void MarketData::waitForRefresh(int64_t maxMs) {
         std::unique_lock<std::mutex> lock(mDataMutex);
-        auto mSymbolsCopy = mSymbols;
-        lock.unlock();
-        for (const std::string &symbol: mSymbolsCopy)
-            updatePrice(symbol);
+        int64_t now = mClock.nowMs();
+        int64_t deadline = mRefreshWheel.nextDeadline();
+        if (maxMs >= 0 && (deadline < 0 || deadline > now + maxMs))
+            deadline = now + maxMs;
+        uint64_t version = mScheduleVersion;
+        auto woken = [&]() { return !mRunning || mScheduleVersion != version; };
+        if (deadline < 0 || deadline > now)
+            mClock.waitUntil(lock, mWakeup, deadline < 0 ? -1 : deadline * NANOS_PER_MILLI, woken);
     }
 
-    void MarketData::updateKlines() {
+    std::vector<Trade> MarketData::getTradeHistory(const std::string& symbol, size_t limit) {
+        updateTradeTape(symbol);
+        std::vector<Trade> trades;
+        readTradeTape(symbol, [&](const TradeTape &tape) {
+            size_t first = tape.size() - std::min(limit, tape.size());
+            trades.reserve(tape.size() - first);
+            for (size_t i = first; i < tape.size(); i++)
+                trades.push_back(tape.at(i));
+        });
+        return trades;
+    }
+
+    size_t MarketData::updateTradeTape(const std::string &symbol) {
+        size_t total = 0;
+        for (int page = 0; page < MAX_TRADE_PAGES; page++) {
+            long fromId;
+            {
+                std::lock_guard<std::mutex> lock(mTradeMutex);
+                TradeTape &tape = mTradeTapes[symbol];
+                fromId = tape.lastId() < 0 ? -1 : long(tape.lastId() + 1);
+            }
+            std::vector<Trade> trades = mExchangeManager.getTradesFrom(symbol, fromId, TRADE_PAGE);
+            size_t added = 0;
+            {
+                // a concurrent update may have appended the same page, its trades are then rejected
+                std::lock_guard<std::mutex> lock(mTradeMutex);
+                TradeTape &tape = mTradeTapes[symbol];
+                for (const Trade &trade: trades)
+                    added += tape.append(trade);
+                if (tape.size() >= TRADE_RETENTION + TradeTape::BLOCK_SIZE)
+                    tape.trim(TRADE_RETENTION);
+            }
+            total += added;
+            // the first page is the most recent one, a partial page reached the last trade
+            if (fromId < 0 || !added || trades.size() < size_t(TRADE_PAGE))
+                break;
+        }
+        return total;
+    }
+
+    void MarketData::updatePrice(const std::string &symbol) {
+        double price = mExchangeManager.getPrice(symbol);
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        pushPrice(symbol, price);
+    }
+
+    std::vector<char> MarketData::updatePrices(const std::vector<std::string> &symbols) {
+        std::vector<char> changed(symbols.size(), 0);
+        if (symbols.empty())
+            return changed;
+        std::map<std::string, double> prices = mExchangeManager.getPrices(symbols);
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        for (size_t i = 0; i < symbols.size(); i++) {
+            auto price = prices.find(symbols[i]);
+            auto history = mPrices.find(symbols[i]);
+            if (price == prices.end() || history == mPrices.end())
+                continue;
+            changed[i] = history->second->empty() || history->second->back() != price->second;
+            pushPrice(symbols[i], price->second);
+        }
+        return changed;
+    }
+
+    std::vector<char> MarketData::updateKlines(const std::vector<std::string> &symbols, bool incompleteOnly) {
+        /**
+         * @brief A kline request, from a start time while filling a gap, the most recent klines otherwise.
+         */
+        struct KlineFetch {
+            std::pair<std::string,std::string> key;
+            time_t start; // in milliseconds, 0 for the most recent klines
+            int limit;
+        };
         std::unique_lock<std::mutex> lock(mDataMutex);
-        std::map<std::pair<std::string,std::string>, Klines> klinesCopy = mKlines;
+        std::unordered_map<std::string, size_t> indices;
+        for (size_t i = 0; i < symbols.size(); i++)
+            indices.emplace(symbols[i], i);
+        std::vector<KlineFetch> fetches;
+        for (auto &[key, klines] : mKlines) {
+            // aggregated intervals are not streamed, they are fetched until their aggregator is aligned
+            bool incomplete = mKlineGaps.count(key) || (mKlineSources.count(key) && !isAggregated(key));
+            if (!indices.count(key.first) || (incompleteOnly && !incomplete))
+                continue;
+            auto store = mKlineStores.find(key);
+            if (mKlineGaps.count(key) && store != mKlineStores.end())
+                fetches.push_back({key, store->second->lastTime() * 1000, KLINE_PAGE});
+            else if (klines.times.empty())
+                fetches.push_back({key, 0, INITIAL_KLINES});
+            else if (!isAggregated(key))
+                fetches.push_back({key, 0, RECENT_KLINES});
+        }
         lock.unlock();
-        for (auto &[key, klines] : klinesCopy) {
-            Json::Value result;
-            if (klines.times.size())
-                mExchangeManager.getKlines(result, key.first, key.second, 0, 0, 10);
-            else mExchangeManager.getKlines(result, key.first, key.second, 0, 0, 500);
-            try {
-                for (Json::Value::ArrayIndex i = 0; i < result.size(); i++) {
-                    time_t t = jsonToDouble(result[i][0])/1000;
-                    double o = jsonToDouble(result[i][1]);
-                    double h = jsonToDouble(result[i][2]);
-                    double l = jsonToDouble(result[i][3]);
-                    double c = jsonToDouble(result[i][4]);
-                    double v = jsonToDouble(result[i][5]);
-                    if (!klines.times.empty() && t < klines.times.back()) continue;
-                    if (!klines.times.empty() && t == klines.times.back())
-                        klines.pop_back();
-                    klines.push_back(t, o, h, l, c, v);
+        std::vector<char> changed(symbols.size(), 0);
+        fetchPool().run(fetches.size(), [&](size_t k) {
+            KlineFetch fetch = fetches[k];
+            while (true) {
+                Json::Value result;
+                try {
+                    mExchangeManager.getKlines(result, fetch.key.first, fetch.key.second, fetch.start, 0, fetch.limit);
+                } catch (...) {
+                    return; // retried on the next refresh
                 }
+                std::lock_guard<std::mutex> guard(mDataMutex);
+                auto it = mKlines.find(fetch.key);
+                if (it == mKlines.end())
+                    return;
+                Klines &klines = it->second;
+                size_t size = klines.times.size();
+                time_t lastTime = size ? klines.times.back() : 0;
+                double lastClose = size ? klines.closes.back() : 0, lastVolume = size ? klines.volumes.back() : 0;
+                try {
+                    for (Json::Value::ArrayIndex i = 0; i < result.size(); i++) {
+                        time_t t = jsonToDouble(result[i][0])/1000;
+                        double o = jsonToDouble(result[i][1]);
+                        double h = jsonToDouble(result[i][2]);
+                        double l = jsonToDouble(result[i][3]);
+                        double c = jsonToDouble(result[i][4]);
+                        double v = jsonToDouble(result[i][5]);
+                        appendKline(fetch.key, klines, {t, o, h, l, c, v});
+                    }
+                }
+                catch (...) {}
+                if (klines.times.size() != size || (size && (klines.times.back() != lastTime ||
+                    klines.closes.back() != lastClose || klines.volumes.back() != lastVolume)))
+                    changed[indices[fetch.key.first]] = 1;
+                publishKlines(fetch.key);
+                // a newer kline was opened, the one before it closed
+                if (size && klines.times.back() > lastTime && klines.times.size() >= 2)
+                    notify([&](EventSubscription &subscription) {
+                        subscription.postKlineClose(fetch.key.first, fetch.key.second,
+                                                    klines.at(klines.times.size() - 2));
+                    });
+                auto store = mKlineStores.find(fetch.key);
+                if (store != mKlineStores.end())
+                    store->second->flush();
+                if (!fetch.start || store == mKlineStores.end() || result.empty())
+                    return; // a failed page is retried on the next refresh
+                // pages start at the last stored kline, a partial one reached the current kline
+                time_t next = store->second->lastTime() * 1000;
+                if (result.size() < Json::Value::ArrayIndex(fetch.limit) || next <= fetch.start) {
+                    mKlineGaps.erase(fetch.key);
+                    return;
+                }
+                fetch.start = next;
             }
-            catch (...) {
-                return;
-            }
-        }
+        });
         lock.lock();
-        mKlines.swap(klinesCopy);
+        seedKlineAggregators();
+        return changed;
     }
 
     bool MarketData::isRunning() {
@@ -151,55 +672,334 @@ namespace ats {
     }
 
     std::map<std::string, double> MarketData::getBalances() {
-        std::lock_guard<std::mutex> lock(mDataMutex);
-        return mBalances;
+        auto balances = mBalances.load();
+        return balances ? *balances : std::map<std::string, double>();
+    }
+
+    std::shared_ptr<const std::map<std::string, double>> MarketData::getBalancesSnapshot() {
+        return mBalances.load();
     }
 
     std::string MarketData::getOrderStatus(long id, const std::string& symbol) {
         Json::Value result;
         Order order{id};
-        order.symbol = symbol;
+        order.symbol = stringToSymbol(symbol);
         mExchangeManager.getOrderStatus(order, result);
         std::string status = result.get("status", "REJECTED").asString();
         return status;
     }
 
     OrderBook MarketData::getOrderBook(const std::string &symbol) {
-        std::lock_guard<std::mutex> lock(mDataMutex);
-        if (mOrderBooks.count(symbol))
-            return mOrderBooks[symbol];
-        return {};
+        std::shared_ptr<const OrderBook> book = getOrderBookSnapshot(symbol);
+        return book ? *book : OrderBook();
     }
 
+    std::shared_ptr<const OrderBook> MarketData::getOrderBookSnapshot(const std::string &symbol) {
+        std::shared_ptr<SymbolSnapshots> snapshots = findSnapshots(symbol);
+        return snapshots ? snapshots->book.load() : nullptr;
+    }
+
+    bool MarketData::getBBO(const std::string &symbol, BBO &bbo) {
+        SymbolId id = findSymbol(symbol);
+        return id != NO_SYMBOL && getBBO(id, bbo);
+    }
+
+    bool MarketData::getBBO(SymbolId symbol, BBO &bbo) const {
+        return mBBOs.get(symbol, bbo);
+    }
+
+    Klines MarketData::getKlines(const std::string &symbol, Interval interval) {
+        return getKlines(symbol, IntervalToString(interval));
+    }
 
     Klines MarketData::getKlines(const std::string &symbol, const std::string& interval) {
-        if (mKlines.count({symbol, interval}))
-            return mKlines[{symbol, interval}];
-        return {};
+        std::shared_ptr<const KlinesSnapshot> klines = getKlinesSnapshot(symbol, interval);
+        return klines ? klines->toKlines() : Klines();
+    }
+
+    std::shared_ptr<const KlinesSnapshot> MarketData::getKlinesSnapshot(const std::string &symbol, const std::string &interval) {
+        std::shared_ptr<const SnapshotTable> table = mSnapshots.load();
+        if (!table)
+            return nullptr;
+        auto it = table->klines.find({symbol, interval});
+        return it == table->klines.end() ? nullptr : it->second->load();
+    }
+
+    Klines MarketData::getKlineHistory(const std::string &symbol, const std::string &interval, time_t start,
+                                       time_t end) {
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        auto store = mKlineStores.find({symbol, interval});
+        if (store != mKlineStores.end()) {
+            size_t first = store->second->lowerBound(start);
+            return store->second->read(first, std::max(store->second->lowerBound(end), first) - first);
+        }
+        Klines history;
+        auto it = mKlines.find({symbol, interval});
+        if (it == mKlines.end())
+            return history;
+        const Klines &klines = it->second;
+        for (size_t i = 0; i < klines.times.size(); i++)
+            if (klines.times[i] >= start && klines.times[i] < end)
+                history.push_back(klines.times[i], klines.opens[i], klines.highs[i], klines.lows[i],
+                                  klines.closes[i], klines.volumes[i]);
+        return history;
+    }
+
+    bool MarketData::openKlineStore(const std::string &directory) {
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        mKlineDirectory = directory;
+        bool opened = true;
+        for (auto &[key, klines]: mKlines)
+            if (!mKlineStores.count(key))
+                opened &= attachKlineStore(key);
+        return opened;
+    }
+
+    void MarketData::closeKlineStore() {
+        std::lock_guard<std::mutex> lock(mDataMutex);
+        mKlineStores.clear();
+        mKlineGaps.clear();
+        mKlineDirectory.clear();
     }
 
-    void MarketData::updateOrderBook(const std::string &symbol) {
+    bool MarketData::updateOrderBook(const std::string &symbol) {
         OrderBook orderBook = mExchangeManager.getOrderBook(symbol);
         std::lock_guard<std::mutex> lock(mDataMutex);
-        mOrderBooks[symbol] = orderBook;
+        auto it = mOrderBooks.find(symbol);
+        if (it == mOrderBooks.end())
+            return false;
+        uint64_t lastUpdateId = it->second.getLastUpdateId();
+        bool synced = it->second.isSynced();
+        if (!it->second.applySnapshot(orderBook))
+            return false;
+        publishOrderBook(symbol);
+        return !synced || it->second.getLastUpdateId() != lastUpdateId;
     }
 
-    void MarketData::updateOrderBooks() {
+    std::vector<char> MarketData::updateOrderBooks(const std::vector<std::string> &symbols) {
+        std::vector<char> changed(symbols.size(), 0);
+        fetchPool().run(symbols.size(), [&](size_t i) {
+            // a failed or malformed snapshot leaves the book unchanged until the next refresh
+            try {
+                changed[i] = updateOrderBook(symbols[i]);
+            } catch (...) {}
+        });
+        return changed;
+    }
+
+    void MarketData::resyncOrderBooks() {
         std::unique_lock<std::mutex> lock(mDataMutex);
-        auto mSymbolsCopy = mSymbols;
+        std::vector<std::string> resyncs(mResyncs.begin(), mResyncs.end());
         lock.unlock();
-        for (const std::string &symbol: mSymbolsCopy)
-            updateOrderBook(symbol);
+        fetchPool().run(resyncs.size(), [&](size_t i) {
+            const std::string &symbol = resyncs[i];
+            OrderBook snapshot;
+            try {
+                snapshot = mExchangeManager.getOrderBook(symbol);
+            } catch (...) {
+                return; // retried on the next poll
+            }
+            std::lock_guard<std::mutex> guard(mDataMutex);
+            auto it = mOrderBooks.find(symbol);
+            // a snapshot older than the buffered diffs is retried on the next poll
+            if (it == mOrderBooks.end())
+                mResyncs.erase(symbol);
+            else if (it->second.applySnapshot(snapshot)) {
+                mResyncs.erase(symbol);
+                publishOrderBook(symbol);
+            }
+        });
+    }
+
+    ThreadPool &MarketData::fetchPool() {
+        size_t parallelism = mFetchParallelism;
+        if (!mFetchPool || mFetchPool->getParallelism() != parallelism)
+            mFetchPool = std::make_unique<ThreadPool>(parallelism);
+        return *mFetchPool;
     }
 
     void MarketData::updateBalances() {
-        auto balances = mExchangeManager.getBalances();
-        std::unique_lock<std::mutex> lock(mDataMutex);
-        balances.swap(mBalances);
+        auto balances = std::make_shared<const std::map<std::string, double>>(mExchangeManager.getBalances());
+        std::shared_ptr<const std::map<std::string, double>> previous = mBalances.load();
+        mBalances.store(balances);
+        if (!previous || *previous != *balances)
+            notify([&](EventSubscription &subscription) { subscription.postBalances(balances); });
+    }
+
+    void MarketData::publishSnapshots() {
+        std::shared_ptr<const SnapshotTable> previous = mSnapshots.load();
+        auto table = std::make_shared<SnapshotTable>();
+        for (const std::string &symbol: mSymbols) {
+            auto snapshots = std::make_shared<SymbolSnapshots>();
+            snapshots->prices = mPrices[symbol];
+            auto it = previous ? previous->symbols.find(symbol) : table->symbols.end();
+            if (previous && it != previous->symbols.end())
+                snapshots->book.store(it->second->book.load());
+            else snapshots->book.store(std::make_shared<const OrderBook>());
+            table->symbols.emplace(symbol, std::move(snapshots));
+        }
+        for (const auto &[key, klines]: mKlines) {
+            auto it = previous ? previous->klines.find(key) : table->klines.end();
+            if (previous && it != previous->klines.end())
+                table->klines.emplace(key, it->second);
+            else table->klines.emplace(key, std::make_shared<AtomicSnapshot<KlinesSnapshot>>(
+                        snapshotKlines(klines, nullptr)));
+        }
+        mSnapshots.store(std::move(table));
+    }
+
+    void MarketData::publishOrderBook(const std::string &symbol) {
+        std::shared_ptr<SymbolSnapshots> snapshots = findSnapshots(symbol);
+        auto it = mOrderBooks.find(symbol);
+        if (it == mOrderBooks.end())
+            return;
+        mBBOs.update(stringToSymbol(symbol), it->second.getBBO());
+        if (!snapshots)
+            return;
+        auto book = std::make_shared<const OrderBook>(it->second.getOrderBook(ORDER_BOOK_DEPTH));
+        snapshots->book.store(book);
+        notify([&](EventSubscription &subscription) { subscription.postBook(symbol, book); });
+    }
+
+    bool MarketData::attachKlineStore(const std::pair<std::string,std::string> &key) {
+        auto store = std::make_unique<KlineStore>();
+        if (!store->open(mKlineDirectory + "/" + key.first + "_" + key.second + ".klines"))
+            return false;
+        Klines &klines = mKlines[key];
+        if (store->size()) {
+            // the stored history replaces the fetched klines, the gap up to now is filled on the next refresh
+            size_t count = std::min(store->size(), KLINE_WINDOW);
+            klines = store->read(store->size() - count, count);
+            mKlineGaps.insert(key);
+            // filled now rather than on the next kline refresh, which may be backed off
+            uint64_t id = refreshStreamId(key.first, REFRESH_KLINES);
+            if (mRefreshStreams.count(id)) {
+                mRefreshWheel.schedule(id, mClock.nowMs());
+                mScheduleVersion++;
+                mWakeup.notify_all();
+            }
+        } else {
+            for (size_t i = 0; i < klines.times.size(); i++)
+                store->append(klines.at(i));
+        }
+        mKlineStores[key] = std::move(store);
+        publishKlines(key, true);
+        return true;
+    }
+
+    bool MarketData::appendKline(const std::pair<std::string,std::string> &key, Klines &klines, const Kline &kline) {
+        if (!klines.times.empty() && kline.time < klines.times.back())
+            return false;
+        if (!klines.times.empty() && kline.time == klines.times.back())
+            klines.pop_back();
+        klines.push_back(kline.time, kline.open, kline.high, kline.low, kline.close, kline.volume);
+        auto store = mKlineStores.find(key);
+        if (store != mKlineStores.end()) {
+            store->second->append(kline);
+            // older klines are read from the store, trimming by halves keeps the erase cost constant per kline
+            if (klines.times.size() >= 2 * KLINE_WINDOW)
+                klines.keepLast(KLINE_WINDOW);
+        }
+        aggregateKline(key, kline);
+        return true;
+    }
+
+    void MarketData::updateKlineSources(const std::string &symbol) {
+        for (auto it = mKlineAggregators.begin(); it != mKlineAggregators.end();)
+            it = it->first.first == symbol ? mKlineAggregators.erase(it) : std::next(it);
+        for (auto it = mKlineSources.begin(); it != mKlineSources.end();)
+            it = it->first.first == symbol ? mKlineSources.erase(it) : std::next(it);
+        std::vector<Interval> intervals;
+        for (const auto &[key, klines]: mKlines) {
+            Interval interval;
+            if (key.first == symbol && stringToInterval(key.second, interval))
+                intervals.push_back(interval);
+        }
+        std::sort(intervals.begin(), intervals.end());
+        for (size_t i = 0; i < intervals.size(); i++)
+            for (size_t j = 0; j < i; j++)
+                if (canAggregate(intervals[j], intervals[i])) {
+                    // the shortest source is never aggregated itself
+                    std::pair<std::string,std::string> source(symbol, IntervalToString(intervals[j]));
+                    mKlineAggregators[source].emplace_back(intervals[i]);
+                    mKlineSources[{symbol, IntervalToString(intervals[i])}] = source;
+                    break;
+                }
+    }
+
+    void MarketData::seedKlineAggregators() {
+        for (auto &[source, aggregators] : mKlineAggregators)
+            for (KlineAggregator &aggregator: aggregators) {
+                std::pair<std::string,std::string> key(source.first, IntervalToString(aggregator.getInterval()));
+                auto it = mKlines.find(key);
+                if (!aggregator.isSeeded() && it != mKlines.end() && !it->second.times.empty() &&
+                    !mKlineGaps.count(key))
+                    aggregator.seed(mKlines[source]);
+            }
+    }
+
+    bool MarketData::isAggregated(const std::pair<std::string,std::string> &key) {
+        auto source = mKlineSources.find(key);
+        if (source == mKlineSources.end())
+            return false;
+        auto aggregators = mKlineAggregators.find(source->second);
+        if (aggregators == mKlineAggregators.end())
+            return false;
+        for (const KlineAggregator &aggregator: aggregators->second)
+            if (IntervalToString(aggregator.getInterval()) == key.second)
+                return aggregator.isAligned();
+        return false;
+    }
+
+    void MarketData::aggregateKline(const std::pair<std::string,std::string> &source, const Kline &kline) {
+        auto aggregators = mKlineAggregators.find(source);
+        if (aggregators == mKlineAggregators.end())
+            return;
+        const Klines &sourceKlines = mKlines[source];
+        for (KlineAggregator &aggregator: aggregators->second) {
+            std::pair<std::string,std::string> key(source.first, IntervalToString(aggregator.getInterval()));
+            auto it = mKlines.find(key);
+            // the history is fetched before the aggregation starts, and a stored one is completed first
+            if (it == mKlines.end() || it->second.times.empty() || mKlineGaps.count(key))
+                continue;
+            Klines &klines = it->second;
+            time_t lastTime = klines.times.back();
+            if (!aggregator.isSeeded())
+                aggregator.seed(sourceKlines);
+            Kline bar;
+            // a period seen from the middle is left to the REST refresh
+            if (!aggregator.add(kline, bar) || !aggregator.isAligned() || !appendKline(key, klines, bar))
+                continue;
+            publishKlines(key);
+            if (bar.time > lastTime && klines.times.size() >= 2)
+                notify([&](EventSubscription &subscription) {
+                    subscription.postKlineClose(key.first, key.second, klines.at(klines.times.size() - 2));
+                });
+        }
+    }
+
+    void MarketData::publishKlines(const std::pair<std::string,std::string> &key, bool replaced) {
+        std::shared_ptr<const SnapshotTable> table = mSnapshots.load();
+        auto it = mKlines.find(key);
+        if (!table || it == mKlines.end())
+            return;
+        auto cell = table->klines.find(key);
+        if (cell == table->klines.end())
+            return;
+        std::shared_ptr<const KlinesSnapshot> previous = replaced ? nullptr : cell->second->load();
+        cell->second->store(snapshotKlines(it->second, previous.get()));
+    }
+
+    std::shared_ptr<SymbolSnapshots> MarketData::findSnapshots(const std::string &symbol) {
+        std::shared_ptr<const SnapshotTable> table = mSnapshots.load();
+        if (!table)
+            return nullptr;
+        auto it = table->symbols.find(symbol);
+        return it == table->symbols.end() ? nullptr : it->second;
     }
 
-    double MarketData::jsonToDouble(Json::Value res) {
-        return atof(res.asString().c_str());
+    double MarketData::jsonToDouble(const Json::Value &res) {
+        return ats::jsonDouble(res);
     }
 
 } // ats
\ No newline at end of file
@@ -0,0 +1,169 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "MarketEvents.h"
+#include <chrono>
+
+namespace ats {
+
+    std::string MarketEventTypeToString(MarketEventType t) {
+        switch (t) {
+            case EVENT_PRICE:
+                return "PRICE";
+            case EVENT_BOOK:
+                return "BOOK";
+            case EVENT_KLINE_CLOSE:
+                return "KLINE_CLOSE";
+            case EVENT_BALANCE:
+                return "BALANCE";
+            default:
+                return "Unknown";
+        }
+    }
+
+    void EventSubscription::onTick(const std::string &symbol, TickHandler handler) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTickHandlers[symbol].push_back(std::move(handler));
+    }
+
+    void EventSubscription::onBook(const std::string &symbol, BookHandler handler) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mBookHandlers[symbol].push_back(std::move(handler));
+    }
+
+    void EventSubscription::onKline(const std::string &symbol, const std::string &interval, KlineHandler handler) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mKlineHandlers[{symbol, interval}].push_back(std::move(handler));
+    }
+
+    void EventSubscription::onBalance(BalanceHandler handler) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mBalanceHandlers.push_back(std::move(handler));
+    }
+
+    bool EventSubscription::hasHandlers() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return !mTickHandlers.empty() || !mBookHandlers.empty() || !mKlineHandlers.empty() ||
+               !mBalanceHandlers.empty();
+    }
+
+    void EventSubscription::postTick(const std::string &symbol, double price, int64_t time) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mClosed || (!mTickHandlers.count(symbol) && !mTickHandlers.count("")))
+            return;
+        post({EVENT_PRICE, symbol, "", price, time, nullptr, {}, nullptr});
+    }
+
+    void EventSubscription::postBook(const std::string &symbol, const std::shared_ptr<const OrderBook> &book) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mClosed || (!mBookHandlers.count(symbol) && !mBookHandlers.count("")))
+            return;
+        post({EVENT_BOOK, symbol, "", 0, 0, book, {}, nullptr});
+    }
+
+    void EventSubscription::postKlineClose(const std::string &symbol, const std::string &interval, const Kline &kline) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mClosed || !mKlineHandlers.count({symbol, interval}))
+            return;
+        post({EVENT_KLINE_CLOSE, symbol, interval, 0, 0, nullptr, kline, nullptr});
+    }
+
+    void EventSubscription::postBalances(const std::shared_ptr<const std::map<std::string, double>> &balances) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mClosed || mBalanceHandlers.empty())
+            return;
+        post({EVENT_BALANCE, "", "", 0, 0, nullptr, {}, balances});
+    }
+
+    size_t EventSubscription::dispatch(int timeoutMs) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (timeoutMs > 0)
+            mReady.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                            [this]() { return mClosed || !mPending.empty(); });
+        if (mClosed || mPending.empty())
+            return 0;
+        std::vector<Event> events;
+        events.swap(mPending);
+        mPendingIndex.clear();
+        // handlers are looked up now and called without the lock, so they may register other handlers
+        std::vector<std::function<void()>> calls;
+        for (Event &event: events) {
+            switch (event.type) {
+                case EVENT_PRICE:
+                    for (auto &handler: handlersFor(mTickHandlers, event.symbol))
+                        calls.emplace_back([handler, &event]() { handler(event.symbol, event.price, event.time); });
+                    break;
+                case EVENT_BOOK:
+                    for (auto &handler: handlersFor(mBookHandlers, event.symbol))
+                        calls.emplace_back([handler, &event]() { handler(event.symbol, event.book); });
+                    break;
+                case EVENT_KLINE_CLOSE: {
+                    auto it = mKlineHandlers.find({event.symbol, event.interval});
+                    if (it != mKlineHandlers.end())
+                        for (auto &handler: it->second)
+                            calls.emplace_back([handler, &event]() { handler(event.symbol, event.interval, event.kline); });
+                    break;
+                }
+                case EVENT_BALANCE:
+                    for (auto &handler: mBalanceHandlers)
+                        calls.emplace_back([handler, &event]() { handler(event.balances); });
+                    break;
+                default:
+                    break;
+            }
+        }
+        lock.unlock();
+        for (auto &call: calls)
+            call();
+        return events.size();
+    }
+
+    void EventSubscription::close() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mClosed = true;
+            mPending.clear();
+            mPendingIndex.clear();
+        }
+        mReady.notify_all();
+    }
+
+    void EventSubscription::open() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = false;
+    }
+
+    uint64_t EventSubscription::getPostedCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mPosted;
+    }
+
+    uint64_t EventSubscription::getCoalescedCount() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCoalesced;
+    }
+
+    void EventSubscription::post(Event &&event) {
+        mPosted++;
+        // every closed kline is a bar of its own, only the latest value events are coalesced
+        if (event.type == EVENT_KLINE_CLOSE) {
+            mPending.push_back(std::move(event));
+            if (mPending.size() == 1)
+                mReady.notify_one();
+            return;
+        }
+        std::string key = std::to_string(event.type) + '|' + event.symbol + '|' + event.interval;
+        auto [it, inserted] = mPendingIndex.try_emplace(key, mPending.size());
+        if (!inserted) {
+            // the consumer is behind, it only needs the latest value
+            mPending[it->second] = std::move(event);
+            mCoalesced++;
+            return;
+        }
+        mPending.push_back(std::move(event));
+        if (mPending.size() == 1)
+            mReady.notify_one();
+    }
+
+} // ats
@@ -0,0 +1,103 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "Order.h"
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
+namespace ats {
+
+    std::string OrderTypeToString(OrderType t) {
+        switch (t) {
+            case LIMIT:
+                return "LIMIT";
+            case MARKET:
+                return "MARKET";
+            case STOP_LOSS:
+                return "STOP_LOSS";
+            case STOP_LOSS_LIMIT:
+                return "STOP_LOSS_LIMIT";
+            case TAKE_PROFIT:
+                return "TAKE_PROFIT";
+            case TAKE_PROFIT_LIMIT:
+                return "TAKE_PROFIT_LIMIT";
+            case LIMIT_MAKER:
+                return "LIMIT_MAKER";
+            default:
+                return "Unknown";
+        }
+    }
+
+    OrderType stringToOrderType(const std::string &s) {
+        for (int i = 0; i < OTCOUNT; i++)
+            if (OrderTypeToString(OrderType(i)) == s)
+                return OrderType(i);
+        return OTCOUNT;
+    }
+
+    std::string SideToString(Side s) {
+        switch (s) {
+            case BUY:
+                return "BUY";
+            case SELL:
+                return "SELL";
+            default:
+                return "Unknown";
+        }
+    }
+
+    Side stringToSide(const std::string &s) {
+        for (int i = 0; i < SCOUNT; i++)
+            if (SideToString(Side(i)) == s)
+                return Side(i);
+        return SCOUNT;
+    }
+
+    std::string TimeInForceToString(TimeInForce t) {
+        switch (t) {
+            case TIF_NONE:
+                return "";
+            case GTC:
+                return "GTC";
+            case IOC:
+                return "IOC";
+            case FOK:
+                return "FOK";
+            default:
+                return "Unknown";
+        }
+    }
+
+    TimeInForce stringToTimeInForce(const std::string &s) {
+        for (int i = 0; i < TIFCOUNT; i++)
+            if (TimeInForceToString(TimeInForce(i)) == s)
+                return TimeInForce(i);
+        return TIFCOUNT;
+    }
+
+    namespace {
+        constexpr char CLIENT_ORDER_ID_PREFIX[] = "ats-";
+        constexpr size_t CLIENT_ORDER_ID_PREFIX_LENGTH = sizeof(CLIENT_ORDER_ID_PREFIX) - 1;
+    }
+
+    std::string clientOrderId(long id) {
+        return CLIENT_ORDER_ID_PREFIX + std::to_string(id);
+    }
+
+    long parseClientOrderId(const std::string &clientOrderId) {
+        if (clientOrderId.compare(0, CLIENT_ORDER_ID_PREFIX_LENGTH, CLIENT_ORDER_ID_PREFIX) != 0 ||
+            clientOrderId.size() == CLIENT_ORDER_ID_PREFIX_LENGTH ||
+            !std::isdigit(static_cast<unsigned char>(clientOrderId[CLIENT_ORDER_ID_PREFIX_LENGTH])))
+            return -1;
+        const char *digits = clientOrderId.c_str() + CLIENT_ORDER_ID_PREFIX_LENGTH;
+        char *end;
+        errno = 0;
+        long id = std::strtol(digits, &end, 10);
+        if (*end != '\0' || errno || id < 0)
+            return -1;
+        return id;
+    }
+
+} // ats
@@ -0,0 +1,240 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "OrderIndex.h"
+
+namespace ats {
+
+    namespace {
+        bool sameOrder(const Order &a, const Order &b) {
+            return a.emsId == b.emsId && a.quantity == b.quantity && a.price == b.price &&
+                   a.stopPrice == b.stopPrice && a.icebergQty == b.icebergQty && a.time == b.time &&
+                   a.type == b.type && a.timeInForce == b.timeInForce;
+        }
+    }
+
+    std::string OrderEventTypeToString(OrderEventType t) {
+        switch (t) {
+            case ORDER_NEW:
+                return "NEW";
+            case ORDER_FILL:
+                return "FILL";
+            case ORDER_REMOVED:
+                return "REMOVED";
+            default:
+                return "Unknown";
+        }
+    }
+
+    OrderIndex::OrderIndex(size_t capacity) : mCapacity(roundUpToPowerOfTwo(capacity)), mMask(mCapacity - 1),
+                                              mSlots(new Slot[mCapacity]), mBuckets(new int32_t[BUCKETS]) {
+        for (size_t i = 0; i < BUCKETS; i++)
+            mBuckets[i] = -1;
+        mUsed.reserve(mCapacity);
+    }
+
+    bool OrderIndex::find(long id, OrderState &state) const {
+        bool found;
+        read([&]() {
+            found = false;
+            size_t home = slotFor(id);
+            for (size_t i = 0; i < mCapacity; i++) {
+                const Slot &slot = mSlots[(home + i) & mMask];
+                if (slot.slotState == EMPTY)
+                    return;
+                if (slot.slotState == USED && slot.state.order.id == id) {
+                    state = slot.state;
+                    found = true;
+                    return;
+                }
+            }
+        });
+        return found;
+    }
+
+    std::vector<OrderState> OrderIndex::getOrders() const {
+        std::vector<OrderState> orders;
+        read([&]() {
+            orders.clear();
+            for (size_t i = 0; i < mCapacity; i++)
+                if (mSlots[i].slotState == USED)
+                    orders.push_back(mSlots[i].state);
+        });
+        return orders;
+    }
+
+    std::vector<OrderState> OrderIndex::getOrders(SymbolId symbol, Side side) const {
+        std::vector<OrderState> orders;
+        read([&]() {
+            orders.clear();
+            int32_t slot = mBuckets[bucketFor(symbol, side)];
+            for (size_t steps = 0; slot >= 0 && size_t(slot) < mCapacity && steps < mCapacity; steps++) {
+                const Slot &s = mSlots[slot];
+                if (s.slotState == USED && s.state.order.symbol == symbol && s.state.order.side == side)
+                    orders.push_back(s.state);
+                slot = s.next;
+            }
+        });
+        return orders;
+    }
+
+    size_t OrderIndex::size() const {
+        return mSize.load(std::memory_order_acquire);
+    }
+
+    bool OrderIndex::upsert(const OrderState &state, const OrderEventCallback &onEvent) {
+        int32_t slot = findSlot(state.order.id);
+        if (slot < 0) {
+            beginWrite();
+            bool placed = place(state);
+            endWrite();
+            if (placed && onEvent)
+                onEvent({ORDER_NEW, state, 0});
+            return placed;
+        }
+        Slot &s = mSlots[slot];
+        double filled = state.executedQty - s.state.executedQty;
+        bool moved = s.state.order.symbol != state.order.symbol || s.state.order.side != state.order.side;
+        if (filled == 0 && !moved && sameOrder(s.state.order, state.order))
+            return true;
+        beginWrite();
+        if (moved) {
+            uint32_t mark = s.mark;
+            release(slot);
+            place(state);
+            mSlots[mUsed.back()].mark = mark;
+        } else
+            s.state = state;
+        endWrite();
+        if (filled != 0 && onEvent)
+            onEvent({ORDER_FILL, state, filled});
+        return true;
+    }
+
+    bool OrderIndex::erase(long id, const OrderEventCallback &onEvent) {
+        int32_t slot = findSlot(id);
+        if (slot < 0)
+            return false;
+        OrderState state = mSlots[slot].state;
+        beginWrite();
+        release(slot);
+        endWrite();
+        if (onEvent)
+            onEvent({ORDER_REMOVED, state, 0});
+        return true;
+    }
+
+    void OrderIndex::reconcile(const std::vector<OrderState> &openOrders, const OrderEventCallback &onEvent) {
+        mEpoch++;
+        for (const OrderState &state: openOrders) {
+            upsert(state, onEvent);
+            int32_t slot = findSlot(state.order.id);
+            if (slot >= 0)
+                mSlots[slot].mark = mEpoch;
+        }
+        std::vector<long> removed;
+        for (int32_t slot: mUsed)
+            if (mSlots[slot].mark != mEpoch)
+                removed.push_back(mSlots[slot].state.order.id);
+        for (long id: removed)
+            erase(id, onEvent);
+    }
+
+    size_t OrderIndex::slotFor(long id) const {
+        return size_t((unsigned long long) id * 0x9E3779B97F4A7C15ULL >> 32) & mMask;
+    }
+
+    size_t OrderIndex::bucketFor(SymbolId symbol, Side side) {
+        return (size_t(symbol) * SCOUNT + side) % BUCKETS;
+    }
+
+    int32_t OrderIndex::findSlot(long id) const {
+        size_t home = slotFor(id);
+        for (size_t i = 0; i < mCapacity; i++) {
+            size_t slot = (home + i) & mMask;
+            if (mSlots[slot].slotState == EMPTY)
+                return -1;
+            if (mSlots[slot].slotState == USED && mSlots[slot].state.order.id == id)
+                return int32_t(slot);
+        }
+        return -1;
+    }
+
+    void OrderIndex::beginWrite() {
+        mVersion.store(mVersion.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void OrderIndex::endWrite() {
+        mVersion.store(mVersion.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool OrderIndex::place(const OrderState &state) {
+        if ((mUsed.size() + mDeleted + 1) * 4 > mCapacity * 3) {
+            if (!mDeleted)
+                return false;
+            compact();
+            if ((mUsed.size() + 1) * 4 > mCapacity * 3)
+                return false;
+        }
+        size_t home = slotFor(state.order.id);
+        size_t slot = home;
+        for (size_t i = 0; i < mCapacity; i++) {
+            slot = (home + i) & mMask;
+            if (mSlots[slot].slotState != USED)
+                break;
+        }
+        Slot &s = mSlots[slot];
+        if (s.slotState == DELETED)
+            mDeleted--;
+        int32_t &head = mBuckets[bucketFor(state.order.symbol, state.order.side)];
+        s.state = state;
+        s.prev = -1;
+        s.next = head;
+        if (head >= 0)
+            mSlots[head].prev = int32_t(slot);
+        head = int32_t(slot);
+        s.usedPos = int32_t(mUsed.size());
+        s.mark = mEpoch;
+        mUsed.push_back(int32_t(slot));
+        s.slotState = USED;
+        mSize.store(mUsed.size(), std::memory_order_release);
+        return true;
+    }
+
+    void OrderIndex::release(int32_t slot) {
+        Slot &s = mSlots[slot];
+        if (s.prev >= 0)
+            mSlots[s.prev].next = s.next;
+        else mBuckets[bucketFor(s.state.order.symbol, s.state.order.side)] = s.next;
+        if (s.next >= 0)
+            mSlots[s.next].prev = s.prev;
+        int32_t last = mUsed.back();
+        mUsed[s.usedPos] = last;
+        mSlots[last].usedPos = s.usedPos;
+        mUsed.pop_back();
+        s.slotState = DELETED;
+        s.next = s.prev = s.usedPos = -1;
+        mDeleted++;
+        mSize.store(mUsed.size(), std::memory_order_release);
+    }
+
+    void OrderIndex::compact() {
+        std::vector<std::pair<OrderState, uint32_t>> orders;
+        orders.reserve(mUsed.size());
+        for (int32_t slot: mUsed)
+            orders.emplace_back(mSlots[slot].state, mSlots[slot].mark);
+        for (size_t i = 0; i < mCapacity; i++)
+            mSlots[i] = Slot();
+        for (size_t i = 0; i < BUCKETS; i++)
+            mBuckets[i] = -1;
+        mUsed.clear();
+        mDeleted = 0;
+        for (auto &[state, mark]: orders) {
+            place(state);
+            mSlots[mUsed.back()].mark = mark;
+        }
+    }
+
+} // ats
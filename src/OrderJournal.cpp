@@ -0,0 +1,291 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "OrderJournal.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ats {
+
+    namespace {
+        /**
+         * @brief The file header, followed by the records.
+         */
+        struct JournalHeader {
+            char magic[8]; /**< "ATSJRNL" */
+            uint32_t version; /**< Format version */
+            uint32_t recordSize; /**< sizeof(JournalRecord) when the journal was created */
+            char reserved[48];
+        };
+
+        constexpr char MAGIC[8] = "ATSJRNL";
+        constexpr uint32_t VERSION = 2;
+        constexpr size_t WRITE_BATCH = 256;
+
+        static_assert(sizeof(JournalHeader) == 64, "The records start on a cache line");
+    }
+
+    std::string JournalEventToString(JournalEvent e) {
+        switch (e) {
+            case JOURNAL_CREATED:
+                return "CREATED";
+            case JOURNAL_SENT:
+                return "SENT";
+            case JOURNAL_ACKED:
+                return "ACKED";
+            case JOURNAL_REJECTED:
+                return "REJECTED";
+            case JOURNAL_FILLED:
+                return "FILLED";
+            case JOURNAL_CANCELLED:
+                return "CANCELLED";
+            case JOURNAL_CLOSED:
+                return "CLOSED";
+            default:
+                return "Unknown";
+        }
+    }
+
+    OrderJournal::OrderJournal(size_t queueCapacity, std::chrono::milliseconds flushInterval, Clock &clock)
+            : mRecords(queueCapacity), mWaiter(PARK), mFlushInterval(flushInterval), mClock(clock) {}
+
+    OrderJournal::~OrderJournal() {
+        close();
+    }
+
+    bool OrderJournal::open(const std::string &path, const JournalCallback &onRecord) {
+        std::lock_guard<std::mutex> lock(mOpenMutex);
+        if (mRunning)
+            return false;
+        mFd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (mFd < 0)
+            return false;
+        struct stat st{};
+        if (fstat(mFd, &st) != 0) {
+            unmap();
+            return false;
+        }
+        size_t fileSize = size_t(st.st_size);
+        bool created = fileSize < sizeof(JournalHeader);
+        if (!map(created ? sizeof(JournalHeader) + INITIAL_RECORDS * sizeof(JournalRecord) : fileSize)) {
+            unmap();
+            return false;
+        }
+        auto *header = reinterpret_cast<JournalHeader *>(mMap);
+        if (created) {
+            std::memset(header, 0, sizeof(JournalHeader));
+            std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+            header->version = VERSION;
+            header->recordSize = sizeof(JournalRecord);
+        } else if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+                   header->recordSize != sizeof(JournalRecord)) {
+            unmap();
+            return false;
+        }
+        // The journal ends at the first record that was not completely written
+        uint64_t count = 0;
+        size_t capacity = (mMapSize - sizeof(JournalHeader)) / sizeof(JournalRecord);
+        JournalRecord record;
+        while (count < capacity) {
+            std::memcpy(&record, mMap + sizeof(JournalHeader) + count * sizeof(JournalRecord), sizeof(JournalRecord));
+            if (record.sequence != count + 1 || record.event >= JECOUNT)
+                break;
+            count++;
+        }
+        // a failed compaction leaves the old journal in place, unless it was lost on the way
+        if (count > 0 && !compact(path, count) && !mMap)
+            return false;
+        const char *records = mMap + sizeof(JournalHeader);
+        for (uint64_t i = 0; i < count; i++) {
+            std::memcpy(&record, records + i * sizeof(JournalRecord), sizeof(JournalRecord));
+            // symbol ids are interned per process, the one of the writer is meaningless here
+            record.order.symbol = stringToSymbol(std::string(record.symbol,
+                                                             strnlen(record.symbol, JOURNAL_SYMBOL_SIZE)));
+            if (onRecord)
+                onRecord(record);
+        }
+        mRecordCount = count;
+        mRunning = true;
+        mWriterThread = std::thread(&OrderJournal::run, this);
+        return true;
+    }
+
+    void OrderJournal::close() {
+        std::lock_guard<std::mutex> lock(mOpenMutex);
+        if (!mRunning)
+            return;
+        mRunning = false;
+        mWaiter.notify();
+        if (mWriterThread.joinable())
+            mWriterThread.join();
+        if (mMap)
+            msync(mMap, mMapSize, MS_SYNC);
+        unmap();
+    }
+
+    bool OrderJournal::isOpen() {
+        return mRunning;
+    }
+
+    void OrderJournal::append(JournalEvent event, const Order &order, double executedQty) {
+        JournalRecord record;
+        record.order = order;
+        record.time = mClock.epochNow();
+        record.executedQty = executedQty;
+        record.event = event;
+        const std::string &symbol = order.symbolName();
+        std::memcpy(record.symbol, symbol.data(), std::min(symbol.size(), JOURNAL_SYMBOL_SIZE - 1));
+        while (!mRecords.tryPush(record))
+            if (!mRunning)
+                return;
+            else std::this_thread::yield();
+        mWaiter.notify();
+    }
+
+    uint64_t OrderJournal::getRecordCount() {
+        return mRecordCount.load(std::memory_order_acquire);
+    }
+
+    void OrderJournal::run() {
+        auto lastFlush = std::chrono::steady_clock::now();
+        bool dirty = false;
+        JournalRecord record;
+        while (true) {
+            size_t written = 0;
+            while (written < WRITE_BATCH && mRecords.tryPop(record))
+                if (write(record))
+                    written++;
+            dirty |= written > 0;
+            auto now = std::chrono::steady_clock::now();
+            if (dirty && mMap && now - lastFlush >= mFlushInterval) {
+                msync(mMap, mMapSize, MS_ASYNC);
+                lastFlush = now;
+                dirty = false;
+            }
+            if (written)
+                continue;
+            if (!mRunning && mRecords.empty())
+                return;
+            mWaiter.wait([this, dirty, lastFlush]() {
+                return !mRecords.empty() || !mRunning ||
+                       (dirty && std::chrono::steady_clock::now() - lastFlush >= mFlushInterval);
+            });
+        }
+    }
+
+    bool OrderJournal::compact(const std::string &path, uint64_t &count) {
+        const char *records = mMap + sizeof(JournalHeader);
+        std::unordered_map<long, uint64_t> last, lastState;
+        std::unordered_set<long> closed;
+        long maxId = -1;
+        JournalRecord record;
+        for (uint64_t i = 0; i < count; i++) {
+            std::memcpy(&record, records + i * sizeof(JournalRecord), sizeof(JournalRecord));
+            long id = record.order.id;
+            last[id] = i;
+            if (record.event == JOURNAL_ACKED || record.event == JOURNAL_FILLED)
+                lastState[id] = i;
+            else if (record.event == JOURNAL_REJECTED || record.event == JOURNAL_CLOSED)
+                closed.insert(id);
+            maxId = std::max(maxId, id);
+        }
+        // An open order keeps its latest state and its latest event, the highest id keeps its last record
+        std::vector<uint64_t> kept;
+        for (auto &[id, index]: last) {
+            if (closed.count(id) && id != maxId)
+                continue;
+            kept.push_back(index);
+            auto state = lastState.find(id);
+            if (!closed.count(id) && state != lastState.end() && state->second != index)
+                kept.push_back(state->second);
+        }
+        if (kept.size() == count)
+            return true;
+        std::sort(kept.begin(), kept.end());
+
+        std::vector<char> buffer(sizeof(JournalHeader) + kept.size() * sizeof(JournalRecord));
+        std::memcpy(buffer.data(), mMap, sizeof(JournalHeader));
+        for (size_t i = 0; i < kept.size(); i++) {
+            std::memcpy(&record, records + kept[i] * sizeof(JournalRecord), sizeof(JournalRecord));
+            record.sequence = i + 1;
+            std::memcpy(buffer.data() + sizeof(JournalHeader) + i * sizeof(JournalRecord), &record,
+                        sizeof(JournalRecord));
+        }
+        // The compacted journal replaces the old one only once it is completely on disk
+        std::string compactPath = path + ".compact";
+        int fd = ::open(compactPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return false;
+        size_t written = 0;
+        while (written < buffer.size()) {
+            ssize_t n = ::write(fd, buffer.data() + written, buffer.size() - written);
+            if (n <= 0)
+                break;
+            written += size_t(n);
+        }
+        if (written < buffer.size() || fsync(fd) != 0 || std::rename(compactPath.c_str(), path.c_str()) != 0) {
+            ::close(fd);
+            std::remove(compactPath.c_str());
+            return false;
+        }
+        unmap();
+        mFd = fd;
+        count = kept.size();
+        if (!map(sizeof(JournalHeader) + std::max<size_t>(2 * count, INITIAL_RECORDS) * sizeof(JournalRecord))) {
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    bool OrderJournal::map(size_t size) {
+        if (mMap) {
+            munmap(mMap, mMapSize);
+            mMap = nullptr;
+            mMapSize = 0;
+        }
+        struct stat st{};
+        if (fstat(mFd, &st) != 0)
+            return false;
+        if (size_t(st.st_size) < size && ftruncate(mFd, off_t(size)) != 0)
+            return false;
+        void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+        if (map == MAP_FAILED)
+            return false;
+        mMap = static_cast<char *>(map);
+        mMapSize = size;
+        return true;
+    }
+
+    void OrderJournal::unmap() {
+        if (mMap)
+            munmap(mMap, mMapSize);
+        mMap = nullptr;
+        mMapSize = 0;
+        if (mFd >= 0)
+            ::close(mFd);
+        mFd = -1;
+    }
+
+    bool OrderJournal::write(JournalRecord &record) {
+        uint64_t count = mRecordCount.load(std::memory_order_relaxed);
+        size_t offset = sizeof(JournalHeader) + count * sizeof(JournalRecord);
+        if (offset + sizeof(JournalRecord) > mMapSize &&
+            !map(sizeof(JournalHeader) + std::max<size_t>(2 * count, INITIAL_RECORDS) * sizeof(JournalRecord)))
+            return false;
+        record.sequence = count + 1;
+        std::memcpy(mMap + offset, &record, sizeof(JournalRecord));
+        mRecordCount.store(count + 1, std::memory_order_release);
+        return true;
+    }
+
+} // ats
@@ -3,180 +3,432 @@
 //
 
 #include "OrderManager.h"
+#include <algorithm>
 
 namespace ats {
 
-    std::string OrderTypeToString(OrderType t) {
-        switch (t) {
-            case LIMIT:
-                return "LIMIT";
-            case MARKET:
-                return "MARKET";
-            case STOP_LOSS:
-                return "STOP_LOSS";
-            case STOP_LOSS_LIMIT:
-                return "STOP_LOSS_LIMIT";
-            case TAKE_PROFIT:
-                return "TAKE_PROFIT";
-            case TAKE_PROFIT_LIMIT:
-                return "TAKE_PROFIT_LIMIT";
-            case LIMIT_MAKER:
-                return "LIMIT_MAKER";
-            default:
-                return "Unknown";
-        }
-    }
-
-    OrderType stringToOrderType(const std::string &s) {
-        for (int i = 0; i < OTCOUNT; i++)
-            if (OrderTypeToString(OrderType(i)) == s)
-                return OrderType(i);
-        return OTCOUNT;
-    }
-
-    std::string SideToString(Side s) {
-        switch (s) {
-            case BUY:
-                return "BUY";
-            case SELL:
-                return "SELL";
-            default:
-                return "Unknown";
-        }
-    }
+    OrderShard::OrderShard(size_t queueCapacity, WaitPolicy waitPolicy)
+            : cancelOrders(queueCapacity), orders(queueCapacity), pendingOrders(queueCapacity), waiter(waitPolicy),
+              exchangeWaiter(waitPolicy) {}
 
-    Side stringToSide(const std::string &s) {
-        for (int i = 0; i < SCOUNT; i++)
-            if (SideToString(Side(i)) == s)
-                return Side(i);
-        return SCOUNT;
-    }
-
-    OrderManager::OrderManager() {
+    OrderManager::OrderManager(size_t queueCapacity, WaitPolicy waitPolicy, size_t shards, Clock &clock)
+            : mJournal(OrderJournal::DEFAULT_QUEUE_CAPACITY, std::chrono::milliseconds(100), clock) {
+        for (size_t i = 0; i < std::max<size_t>(shards, 1); i++)
+            mShards.emplace_back(new OrderShard(queueCapacity, waitPolicy));
         start();
     }
 
-    OrderManager::OrderManager(std::vector<std::string> symbols) {
-        for (std::string symbol : symbols)
-            mSymbols.insert(symbol);
-        setLastOrderQty(-1);
+    OrderManager::OrderManager(std::vector<std::string> symbols, size_t queueCapacity, WaitPolicy waitPolicy,
+                               size_t shards, Clock &clock)
+            : mJournal(OrderJournal::DEFAULT_QUEUE_CAPACITY, std::chrono::milliseconds(100), clock) {
+        for (size_t i = 0; i < std::max<size_t>(shards, 1); i++)
+            mShards.emplace_back(new OrderShard(queueCapacity, waitPolicy));
+        for (const std::string &symbol : symbols) {
+            SymbolId id = stringToSymbol(symbol);
+            shardFor(id).symbols.insert(id);
+        }
         start();
     }
 
     OrderManager::~OrderManager() {
         stop();
+        for (auto &shard: mShards)
+            for (auto &[id, execution]: shard->executions) {
+                ExecutionReport report;
+                report.orderId = id;
+                if (execution.report)
+                    execution.report->set_value(report);
+            }
     }
 
     void OrderManager::start() {
         if (!mRunning) {
             mRunning = true;
-            mOrderManagerThread = std::thread(&OrderManager::run, this);
+            for (size_t i = 0; i < mShards.size(); i++)
+                mShards[i]->thread = std::thread(&OrderManager::run, this, i);
         }
     }
 
-    void OrderManager::run() {
-        processOrders();
+    void OrderManager::run(size_t shard) {
+        processOrders(shard);
     }
 
     void OrderManager::stop() {
         mRunning = false;
-        if (mOrderManagerThread.joinable())
-            mOrderManagerThread.join();
+        for (auto &shard: mShards) {
+            shard->waiter.notify();
+            if (shard->thread.joinable())
+                shard->thread.join();
+        }
+        // The shard threads are joined, this thread is now the only consumer of the pending queues
+        Order order;
+        for (auto &shard: mShards)
+            while (shard->pendingOrders.tryPop(order))
+                reportExecution(order, ExecutionReport());
     }
 
     bool OrderManager::isRunning() {
         return mRunning;
     }
 
-    double OrderManager::getLastOrderQty() {
-        return mLastOrderQty;
+    OrderHandle OrderManager::createOrder(OrderType type, Side side, std::string symbol, double quantity, double price,
+                                          ExecutionCallback callback) {
+        Order order(0, type, side, symbol, quantity, price);
+        return createOrder(order, std::move(callback));
     }
 
-    void OrderManager::setLastOrderQty(double qty) {
-        mLastOrderQty = qty;
+    OrderHandle OrderManager::createOrder(Order& order, ExecutionCallback callback) {
+        return queueOrder(order, std::move(callback), true);
     }
 
-    long OrderManager::createOrder(OrderType type, Side side, std::string symbol, double quantity, double price) {
-        long id = getNewOrderId();
-        mSymbols.insert(symbol);
-        mPendingOrders.push(Order(id, type, side, symbol, quantity, price));
-        return id;
+    long OrderManager::submitOrder(Order& order, ExecutionCallback callback) {
+        return queueOrder(order, std::move(callback), false);
     }
 
-    long OrderManager::createOrder(Order& order) {
-        mSymbols.insert(order.symbol);
+    OrderHandle OrderManager::queueOrder(Order &order, ExecutionCallback callback, bool handle) {
         order.id = getNewOrderId();
-        mPendingOrders.push(order);
-        return order.id;
+        OrderShard &shard = shardFor(order.symbol);
+        if (mJournal.isOpen())
+            mJournal.append(JOURNAL_CREATED, order);
+        mLatency.mark(order, HOP_CREATED);
+        bool awaited = handle || callback;
+        std::shared_future<ExecutionReport> report;
+        if (awaited) {
+            // Registered before queueing so that the EMS always finds it
+            std::lock_guard<std::mutex> lock(shard.executionsMutex);
+            PendingExecution &execution = shard.executions[order.id];
+            execution.callback = std::move(callback);
+            if (handle)
+                report = execution.report.emplace().get_future().share();
+        }
+        if (!shard.pendingOrders.tryPush(order)) {
+            if (mJournal.isOpen())
+                mJournal.append(JOURNAL_REJECTED, order);
+            if (awaited) {
+                std::lock_guard<std::mutex> lock(shard.executionsMutex);
+                shard.executions.erase(order.id);
+            }
+            return OrderHandle();
+        }
+        shard.waiter.notify();
+        return OrderHandle(order.id, report);
+    }
+
+    void OrderManager::reportExecution(const Order &order, ExecutionReport report) {
+        OrderShard &shard = shardFor(order.symbol);
+        PendingExecution execution;
+        {
+            std::lock_guard<std::mutex> lock(shard.executionsMutex);
+            auto it = shard.executions.find(order.id);
+            if (it != shard.executions.end()) {
+                execution = std::move(it->second);
+                shard.executions.erase(it);
+            }
+        }
+        report.orderId = order.id;
+        if (report.acked)
+            mLatency.mark(order, HOP_ACKED);
+        // Acknowledged orders are journaled when they enter the sent-order table
+        if (!report.acked && mJournal.isOpen())
+            mJournal.append(JOURNAL_REJECTED, order);
+        if (execution.report)
+            execution.report->set_value(report);
+        if (execution.callback)
+            execution.callback(report);
+    }
+
+    bool OrderManager::cancelOrder(long orderId, const std::string &symbol) {
+        return cancelOrder(orderId, stringToSymbol(symbol));
     }
 
-    void OrderManager::cancelOrder(long orderId, std::string symbol) {
-        mCancelOrders.push({orderId, symbol});
+    bool OrderManager::cancelOrder(long orderId, SymbolId symbol) {
+        OrderShard &shard = shardFor(symbol);
+        if (!shard.cancelOrders.tryPush({orderId, symbol}))
+            return false;
+        shard.exchangeWaiter.notify();
+        if (mJournal.isOpen()) {
+            Order order(orderId);
+            order.symbol = symbol;
+            mJournal.append(JOURNAL_CANCELLED, order);
+        }
+        return true;
     }
 
     void OrderManager::cancelAllOrders() {
-        std::lock_guard<std::mutex> lock(mOrderFetchMutex);
-        for (auto &pair: mSentOrders)
-            cancelOrder(pair.second.id, pair.second.symbol);
+        for (auto &shard: mShards)
+            for (const OrderState &state: shard->orderIndex.getOrders())
+                cancelOrder(state.order.id, state.order.symbol);
+    }
+
+    void OrderManager::updateOpenOrders(const std::vector<OrderState> &openOrders) {
+        std::vector<std::vector<OrderState>> partitions(mShards.size());
+        for (const OrderState &state: openOrders)
+            partitions[getShard(state.order.symbol)].push_back(state);
+        for (size_t i = 0; i < mShards.size(); i++)
+            updateOpenOrders(i, partitions[i]);
+    }
+
+    void OrderManager::updateOpenOrders(size_t shard, const std::vector<OrderState> &openOrders) {
+        OrderShard &s = *mShards[shard];
+        std::lock_guard<std::mutex> lock(s.eventCallbackMutex);
+        s.orderIndex.reconcile(openOrders, [this, &s](const OrderEvent &event) { onOrderEvent(s, event); });
+    }
+
+    void OrderManager::updateSentOrder(const Order &order, double executedQty) {
+        OrderShard &shard = shardFor(order.symbol);
+        std::lock_guard<std::mutex> lock(shard.eventCallbackMutex);
+        shard.orderIndex.upsert({order, executedQty},
+                                [this, &shard](const OrderEvent &event) { onOrderEvent(shard, event); });
+    }
+
+    void OrderManager::updateCanceledOrder(long orderId, SymbolId symbol) {
+        OrderShard &shard = shardFor(symbol);
+        std::lock_guard<std::mutex> lock(shard.eventCallbackMutex);
+        shard.orderIndex.erase(orderId, [this, &shard](const OrderEvent &event) { onOrderEvent(shard, event); });
     }
 
-    void OrderManager::updateOpenOrders(std::unordered_map<long, Order> openOrders) {
-        std::lock_guard<std::mutex> lock(mOrderFetchMutex);
-        mSentOrders.swap(openOrders);
+    void OrderManager::onOrderEvent(OrderShard &shard, const OrderEvent &event) {
+        if (mJournal.isOpen())
+            switch (event.type) {
+                case ORDER_NEW:
+                    mJournal.append(JOURNAL_ACKED, event.state.order, event.state.executedQty);
+                    break;
+                case ORDER_FILL:
+                    mJournal.append(JOURNAL_FILLED, event.state.order, event.state.executedQty);
+                    break;
+                case ORDER_REMOVED:
+                    mJournal.append(JOURNAL_CLOSED, event.state.order, event.state.executedQty);
+                    break;
+                default:
+                    break;
+            }
+        if (shard.eventCallback)
+            shard.eventCallback(event);
+    }
+
+    bool OrderManager::openJournal(const std::string &path) {
+        std::unordered_map<long, OrderState> openOrders;
+        long nextId = 0;
+        bool opened = mJournal.open(path, [&](const JournalRecord &record) {
+            long id = record.order.id;
+            nextId = std::max(nextId, id + 1);
+            switch (record.event) {
+                case JOURNAL_ACKED:
+                case JOURNAL_FILLED:
+                    openOrders[id] = {record.order, record.executedQty};
+                    break;
+                case JOURNAL_REJECTED:
+                case JOURNAL_CLOSED:
+                    openOrders.erase(id);
+                    break;
+                default:
+                    break;
+            }
+        });
+        if (!opened)
+            return false;
+        for (auto &[id, state]: openOrders) {
+            OrderShard &shard = shardFor(state.order.symbol);
+            shard.orderIndex.upsert(state);
+            std::lock_guard<std::mutex> lock(shard.symbolsMutex);
+            shard.symbols.insert(state.order.symbol);
+        }
+        long count = mOrderCount.load();
+        while (count < nextId && !mOrderCount.compare_exchange_weak(count, nextId));
+        return true;
+    }
+
+    void OrderManager::closeJournal() {
+        mJournal.close();
+    }
+
+    void OrderManager::setOrderEventCallback(OrderEventCallback callback) {
+        for (auto &shard: mShards) {
+            std::lock_guard<std::mutex> lock(shard->eventCallbackMutex);
+            shard->eventCallback = callback;
+        }
     }
 
     void OrderManager::processOrder(Order order) {
-        bool valid = true;
-        if (valid)
-            mOrders.push(order);
+        processOrder(order, mValidator.validate(order));
     }
 
-    void OrderManager::processOrders() {
-        while (mRunning)
-            if (!mPendingOrders.empty()) {
-                Order order = mPendingOrders.front();
-                mPendingOrders.pop();
-                processOrder(order);
+    LatencyTracker &OrderManager::getLatencyTracker() {
+        return mLatency;
+    }
+
+    OrderValidator &OrderManager::getValidator() {
+        return mValidator;
+    }
+
+    void OrderManager::processOrder(const Order &order, ValidationResult result) {
+        if (result != VALID) {
+            ExecutionReport report;
+            report.rejectReason = result;
+            reportExecution(order, report);
+            return;
+        }
+        OrderShard &shard = shardFor(order.symbol);
+        {
+            std::lock_guard<std::mutex> lock(shard.symbolsMutex);
+            shard.symbols.insert(order.symbol);
+        }
+        if (mJournal.isOpen())
+            mJournal.append(JOURNAL_SENT, order);
+        mLatency.mark(order, HOP_EMS_QUEUED);
+        // Back-pressure: hold the order until the EMS drains, pending orders queue up behind it
+        while (!shard.orders.tryPush(order))
+            if (!mRunning)
+                return;
+            else std::this_thread::yield();
+        shard.exchangeWaiter.notify();
+    }
+
+    void OrderManager::processOrders(size_t shard) {
+        OrderShard &s = *mShards[shard];
+        Order batch[VALIDATION_BATCH];
+        ValidationResult results[VALIDATION_BATCH];
+        while (mRunning) {
+            size_t count = 0;
+            while (count < VALIDATION_BATCH && s.pendingOrders.tryPop(batch[count]))
+                count++;
+            if (!count) {
+                s.waiter.wait([this, &s]() { return !s.pendingOrders.empty() || !mRunning; });
+                continue;
             }
+            for (size_t i = 0; i < count; i++)
+                mLatency.mark(batch[i], HOP_PROCESSING);
+            mValidator.validate(batch, count, results);
+            for (size_t i = 0; i < count; i++)
+                processOrder(batch[i], results[i]);
+        }
+    }
+
+    long OrderManager::getNewOrderId() {
+        return mOrderCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t OrderManager::getShardCount() {
+        return mShards.size();
+    }
+
+    size_t OrderManager::getShard(SymbolId symbol) {
+        return symbol % mShards.size();
     }
 
-    int OrderManager::getNewOrderId() {
-        std::lock_guard<std::mutex> lock(mOrderCountMutex);
-        return mOrderCount++;
+    OrderShard &OrderManager::shardFor(SymbolId symbol) {
+        return *mShards[getShard(symbol)];
     }
 
-    bool OrderManager::hasOrders() {
-        return !mOrders.empty();
+    bool OrderManager::hasOrders(size_t shard) {
+        return !mShards[shard]->orders.empty();
     }
 
-    bool OrderManager::hasCancelOrders() {
-        return !mCancelOrders.empty();
+    bool OrderManager::hasCancelOrders(size_t shard) {
+        return !mShards[shard]->cancelOrders.empty();
     }
 
-    Order &OrderManager::getOldestOrder() {
-        Order oldest = mOrders.front();
-        mOrders.pop();
-        std::lock_guard<std::mutex> lock(mOrderFetchMutex);
-        mSentOrders.insert({oldest.id, oldest});
-        return mSentOrders.find(oldest.id)->second;
+    Order OrderManager::getOldestOrder(size_t shard) {
+        Order oldest;
+        if (mShards[shard]->orders.tryPop(oldest))
+            mLatency.mark(oldest, HOP_SENDING);
+        return oldest;
     }
 
     Order OrderManager::getOrderById(long ID) {
-        if (mSentOrders.count(ID))
-            return mSentOrders[ID];
+        OrderState state;
+        for (auto &shard: mShards)
+            if (shard->orderIndex.find(ID, state))
+                return state.order;
         return Order{};
     }
 
-    std::pair<long, std::string> OrderManager::getCancelOrder() {
-        std::pair<long, std::string> order = mCancelOrders.front();
-        mCancelOrders.pop();
+    std::vector<OrderState> OrderManager::getOpenOrders(SymbolId symbol, Side side) {
+        return shardFor(symbol).orderIndex.getOrders(symbol, side);
+    }
+
+    std::vector<OrderState> OrderManager::getOpenOrders() {
+        std::vector<OrderState> orders;
+        for (auto &shard: mShards)
+            for (const OrderState &state: shard->orderIndex.getOrders())
+                orders.push_back(state);
+        return orders;
+    }
+
+    std::pair<long, SymbolId> OrderManager::getCancelOrder(size_t shard) {
+        std::pair<long, SymbolId> order;
+        mShards[shard]->cancelOrders.tryPop(order);
         return order;
     }
 
+    void OrderManager::waitForOrders(size_t shard, Clock &clock, int64_t time, const std::function<bool()> &stop) {
+        OrderShard &s = *mShards[shard];
+        s.exchangeWaiter.waitUntil(clock, time, [&s, &stop]() {
+            return !s.orders.empty() || !s.cancelOrders.empty() || stop();
+        });
+    }
+
+    void OrderManager::wakeExchange() {
+        for (auto &shard: mShards)
+            shard->exchangeWaiter.notify();
+    }
+
     std::vector<std::string> OrderManager::getSymbols() {
         std::vector<std::string> vSymbols;
-        for (const std::string& symbol : mSymbols)
-            vSymbols.push_back(symbol);
+        for (size_t i = 0; i < mShards.size(); i++)
+            for (std::string &symbol: getSymbols(i))
+                vSymbols.push_back(symbol);
+        return vSymbols;
+    }
+
+    std::vector<std::string> OrderManager::getSymbols(size_t shard) {
+        OrderShard &s = *mShards[shard];
+        std::lock_guard<std::mutex> lock(s.symbolsMutex);
+        std::vector<std::string> vSymbols;
+        for (SymbolId symbol : s.symbols)
+            vSymbols.push_back(SymbolToString(symbol));
         return vSymbols;
     }
-} // ats
\ No newline at end of file
+
+    QueueDepths OrderManager::getQueueDepths() {
+        QueueDepths depths{0, 0, 0};
+        for (size_t i = 0; i < mShards.size(); i++) {
+            QueueDepths shard = getQueueDepths(i);
+            depths.pending += shard.pending;
+            depths.orders += shard.orders;
+            depths.cancels += shard.cancels;
+        }
+        return depths;
+    }
+
+    QueueDepths OrderManager::getQueueDepths(size_t shard) {
+        OrderShard &s = *mShards[shard];
+        return {s.pendingOrders.size(), s.orders.size(), s.cancelOrders.size()};
+    }
+
+    void OrderManager::setWaitPolicy(WaitPolicy policy) {
+        for (auto &shard: mShards) {
+            shard->waiter.setPolicy(policy);
+            shard->waiter.resetWakeupStats();
+            shard->exchangeWaiter.setPolicy(policy);
+        }
+    }
+
+    WaitPolicy OrderManager::getWaitPolicy() {
+        return mShards[0]->waiter.getPolicy();
+    }
+
+    WakeupStats OrderManager::getWakeupStats() {
+        WakeupStats total{0, 0, 0};
+        for (auto &shard: mShards) {
+            WakeupStats stats = shard->waiter.getWakeupStats();
+            if (stats.wakeups == 0)
+                continue;
+            total.meanNs = (total.meanNs * total.wakeups + stats.meanNs * stats.wakeups) /
+                           double(total.wakeups + stats.wakeups);
+            total.wakeups += stats.wakeups;
+            total.maxNs = std::max(total.maxNs, stats.maxNs);
+        }
+        return total;
+    }
+} // ats
@@ -0,0 +1,125 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "OrderValidator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ats {
+
+    namespace {
+        bool isMultiple(double value, double origin, double step) {
+            double steps = (value - origin) / step;
+            return std::fabs(steps - std::round(steps)) <= 1e-6;
+        }
+    }
+
+    std::string ValidationResultToString(ValidationResult r) {
+        switch (r) {
+            case VALID:
+                return "VALID";
+            case INVALID_QUANTITY:
+                return "INVALID_QUANTITY";
+            case INVALID_PRICE:
+                return "INVALID_PRICE";
+            case LOT_SIZE:
+                return "LOT_SIZE";
+            case PRICE_RANGE:
+                return "PRICE_RANGE";
+            case TICK_SIZE:
+                return "TICK_SIZE";
+            case PRICE_BAND:
+                return "PRICE_BAND";
+            case MIN_NOTIONAL:
+                return "MIN_NOTIONAL";
+            default:
+                return "Unknown";
+        }
+    }
+
+    void OrderValidator::load(const std::vector<std::pair<SymbolId, SymbolFilters>> &filters) {
+        std::lock_guard<std::mutex> lock(mLoadMutex);
+        size_t size = 0;
+        for (auto &[symbol, symbolFilters]: filters)
+            size = std::max(size, size_t(symbol) + 1);
+        FilterTable *previous = mTable.load(std::memory_order_relaxed);
+        if (previous)
+            size = std::max(size, previous->filters.size());
+        auto table = std::make_unique<FilterTable>(size);
+        for (auto &[symbol, symbolFilters]: filters) {
+            table->filters[symbol] = symbolFilters;
+            table->filters[symbol].loaded = true;
+        }
+        if (previous)
+            for (size_t i = 0; i < previous->referencePrices.size(); i++)
+                table->referencePrices[i].store(previous->referencePrices[i].load(std::memory_order_relaxed),
+                                                std::memory_order_relaxed);
+        mTable.store(table.get(), std::memory_order_release);
+        mTables.push_back(std::move(table));
+    }
+
+    SymbolFilters OrderValidator::getFilters(SymbolId symbol) const {
+        const FilterTable *table = mTable.load(std::memory_order_acquire);
+        if (!table || symbol >= table->filters.size())
+            return {};
+        return table->filters[symbol];
+    }
+
+    void OrderValidator::setReferencePrice(SymbolId symbol, double price) {
+        FilterTable *table = mTable.load(std::memory_order_acquire);
+        if (table && symbol < table->referencePrices.size())
+            table->referencePrices[symbol].store(price, std::memory_order_relaxed);
+    }
+
+    ValidationResult OrderValidator::validate(const Order &order) const {
+        return validate(mTable.load(std::memory_order_acquire), order);
+    }
+
+    size_t OrderValidator::validate(const Order *orders, size_t count, ValidationResult *results) const {
+        const FilterTable *table = mTable.load(std::memory_order_acquire);
+        size_t valid = 0;
+        for (size_t i = 0; i < count; i++) {
+            results[i] = validate(table, orders[i]);
+            valid += results[i] == VALID;
+        }
+        return valid;
+    }
+
+    ValidationResult OrderValidator::validate(const FilterTable *table, const Order &order) {
+        if (!(order.quantity > 0))
+            return INVALID_QUANTITY;
+        bool priced = order.type != MARKET;
+        if (priced && !(order.price > 0))
+            return INVALID_PRICE;
+        if (!table || order.symbol >= table->filters.size() || !table->filters[order.symbol].loaded)
+            return VALID;
+        const SymbolFilters &f = table->filters[order.symbol];
+        double minQty = priced ? f.minQty : f.marketMinQty;
+        double maxQty = priced ? f.maxQty : f.marketMaxQty;
+        double stepSize = priced ? f.stepSize : f.marketStepSize;
+        if (order.quantity < minQty || (maxQty > 0 && order.quantity > maxQty) ||
+            (stepSize > 0 && !isMultiple(order.quantity, minQty, stepSize)))
+            return LOT_SIZE;
+        double referencePrice = table->referencePrices[order.symbol].load(std::memory_order_relaxed);
+        if (priced) {
+            if (order.price < f.minPrice || (f.maxPrice > 0 && order.price > f.maxPrice))
+                return PRICE_RANGE;
+            if (f.tickSize > 0 && !isMultiple(order.price, f.minPrice, f.tickSize))
+                return TICK_SIZE;
+            bool buy = order.side == BUY;
+            double sideUp = buy ? f.bidMultiplierUp : f.askMultiplierUp;
+            double sideDown = buy ? f.bidMultiplierDown : f.askMultiplierDown;
+            if (referencePrice > 0 && ((f.multiplierUp > 0 && order.price > referencePrice * f.multiplierUp) ||
+                                       order.price < referencePrice * f.multiplierDown ||
+                                       (sideUp > 0 && order.price > referencePrice * sideUp) ||
+                                       order.price < referencePrice * sideDown))
+                return PRICE_BAND;
+        }
+        double price = priced ? order.price : referencePrice;
+        if (price > 0 && price * order.quantity < f.minNotional)
+            return MIN_NOTIONAL;
+        return VALID;
+    }
+
+} // ats
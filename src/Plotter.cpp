@@ -2,6 +2,7 @@
 // Created by Anouar Achghaf on 05/03/2023.
 //
 #include "Plotter.h"
+#include "JsonParser.h"
 
 BinanceAPI::BinanceAPI(ats::BinanceExchangeManager &ems_) : ems(ems_) {}
 
@@ -75,27 +76,11 @@ ats::OrderBook BinanceAPI::get_order_book(std::string ticker) {
 }
 
 std::string BinanceAPI::getStrInterval(Interval interval) {
-    static const std::string interval_str[]{"1s",
-                                            "1m",
-                                            "3m",
-                                            "5m",
-                                            "15m",
-                                            "30m",
-                                            "1h",
-                                            "2h",
-                                            "4h",
-                                            "6h",
-                                            "8h",
-                                            "12h",
-                                            "1d",
-                                            "3d",
-                                            "1w",
-                                            "1M"};
-    return interval_str[interval];
+    return ats::IntervalToString(interval);
 }
 
-double BinanceAPI::jsonToDouble(Json::Value res) {
-    return atof(res.asString().c_str());
+double BinanceAPI::jsonToDouble(const Json::Value &res) {
+    return ats::jsonDouble(res);
 }
 
 std::vector<ats::Order> BinanceAPI::get_open_orders(std::string ticker) {
@@ -123,24 +108,7 @@ std::time_t timestamp_from_string(std::string date, const char *format = "%Y-%m-
 
 void TickerTooltip(const TickerData &data, bool span_subplots, Interval interval) {
     ImDrawList *draw_list = ImPlot::GetPlotDrawList();
-    std::vector<double> coef(Interval_1M+1, 1);
-    coef[0] = 1. / 24 / 60 / 60;
-    coef[1] = coef[0] * 60;
-    coef[2] = coef[1] * 3;
-    coef[3] = coef[1] * 5;
-    coef[4] = coef[1] * 15;
-    coef[5] = coef[1] * 30;
-    coef[6] = coef[5] * 2;
-    coef[7] = coef[6] * 2;
-    coef[8] = coef[7] * 2;
-    coef[9] = coef[7] * 3;
-    coef[10] = coef[8] * 2;
-    coef[11] = coef[9] * 2;
-    coef[12] = coef[11] * 2;
-    coef[13] = coef[12] * 3;
-    coef[14] = coef[12] * 7;
-    coef[15] = coef[12] * 30;
-    const double half_width = 24 * 60 * 60 * 0.25 * 1.5 * coef[interval];
+    const double half_width = 0.25 * 1.5 * ats::intervalSeconds(interval);
     const bool hovered = span_subplots ? ImPlot::IsSubplotsHovered() : ImPlot::IsPlotHovered();
     if (hovered) {
         ImPlotPoint mouse = ImPlot::GetPlotMousePos();
@@ -190,25 +158,8 @@ void PlotOHLC(const char *label_id, const TickerData &data, ImVec4 bullCol,
     // get ImGui window DrawList
     ImDrawList *draw_list = ImPlot::GetPlotDrawList();
 
-    std::vector<double> coef(Interval_1M+1, 1);
-    coef[0] = 1. / 24 / 60 / 60;
-    coef[1] = coef[0] * 60;
-    coef[2] = coef[1] * 3;
-    coef[3] = coef[1] * 5;
-    coef[4] = coef[1] * 15;
-    coef[5] = coef[1] * 30;
-    coef[6] = coef[5] * 2;
-    coef[7] = coef[6] * 2;
-    coef[8] = coef[7] * 2;
-    coef[9] = coef[7] * 3;
-    coef[10] = coef[8] * 2;
-    coef[11] = coef[9] * 2;
-    coef[12] = coef[11] * 2;
-    coef[13] = coef[12] * 3;
-    coef[14] = coef[12] * 7;
-    coef[15] = coef[12] * 30;
     // calc real value width
-    const double half_width = 24 * 60 * 60 * 0.48 * coef[interval];
+    const double half_width = 0.48 * ats::intervalSeconds(interval);
     // begin plot item
     if (ImPlot::BeginItem(label_id)) {
         // override legend icon color
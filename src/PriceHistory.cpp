@@ -0,0 +1,85 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "PriceHistory.h"
+#include <algorithm>
+#include "LockFreeQueue.h"
+
+namespace ats {
+
+    PriceHistory::PriceHistory(size_t capacity) : mCapacity(roundUpToPowerOfTwo(capacity ? capacity : 1)),
+                                                  mMask(mCapacity - 1), mPrices(new std::atomic<double>[2 * mCapacity]),
+                                                  mTimes(new std::atomic<int64_t>[2 * mCapacity]) {}
+
+    void PriceHistory::push(double price, int64_t time) {
+        uint64_t count = mCount.load(std::memory_order_relaxed);
+        size_t slot = count & mMask;
+        mStarted.store(count + 1, std::memory_order_relaxed);
+        // readers see the push started before the slot changes
+        std::atomic_thread_fence(std::memory_order_release);
+        mPrices[slot].store(price, std::memory_order_relaxed);
+        mPrices[slot + mCapacity].store(price, std::memory_order_relaxed);
+        mTimes[slot].store(time, std::memory_order_relaxed);
+        mTimes[slot + mCapacity].store(time, std::memory_order_relaxed);
+        mCount.store(count + 1, std::memory_order_release);
+    }
+
+    void PriceHistory::clear() {
+        mStarted.store(0, std::memory_order_relaxed);
+        mCount.store(0, std::memory_order_release);
+    }
+
+    size_t PriceHistory::size() const {
+        return std::min<uint64_t>(mCount.load(std::memory_order_acquire), mCapacity);
+    }
+
+    size_t PriceHistory::capacity() const {
+        return mCapacity;
+    }
+
+    bool PriceHistory::empty() const {
+        return mCount.load(std::memory_order_acquire) == 0;
+    }
+
+    double PriceHistory::back() const {
+        double price;
+        return read(mPrices.get(), 1, &price) ? price : -1;
+    }
+
+    int64_t PriceHistory::backTime() const {
+        int64_t time;
+        return read(mTimes.get(), 1, &time) ? time : 0;
+    }
+
+    PriceWindow PriceHistory::window(size_t count) const {
+        uint64_t end = mCount.load(std::memory_order_acquire);
+        size_t size = std::min<uint64_t>(end, mCapacity);
+        if (count && count < size)
+            size = count;
+        size_t first = (end & mMask) + mCapacity - size;
+        return {mPrices.get() + first, mTimes.get() + first, size};
+    }
+
+    std::vector<double> PriceHistory::getPrices(size_t count) const {
+        std::vector<double> prices(count && count < mCapacity ? count : mCapacity);
+        prices.resize(read(mPrices.get(), prices.size(), prices.data()));
+        return prices;
+    }
+
+    template<typename T>
+    size_t PriceHistory::read(const std::atomic<T> *values, size_t count, T *out) const {
+        while (true) {
+            uint64_t end = mCount.load(std::memory_order_acquire);
+            size_t size = std::min<uint64_t>({end, mCapacity, count});
+            size_t first = (end & mMask) + mCapacity - size;
+            for (size_t i = 0; i < size; i++)
+                out[i] = values[first + i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // the oldest slot copied is only reused by the push of position end - size + capacity
+            if (mStarted.load(std::memory_order_relaxed) + size <= end + mCapacity)
+                return size;
+        }
+    }
+
+} // ats
@@ -0,0 +1,204 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "PriceLadder.h"
+#include <algorithm>
+#include <cmath>
+#include "LockFreeQueue.h"
+
+namespace ats {
+
+    PriceLadder::PriceLadder(double tickSize, bool descending, size_t ticks)
+            : mTickSize(tickSize), mScale(std::round(1 / tickSize)),
+              mExactScale(mScale >= 1 && std::fabs(mScale * tickSize - 1) < 1e-9), mDescending(descending),
+              mTicks(std::max<size_t>(64, roundUpToPowerOfTwo(ticks))), mQuantities(new double[mTicks]()),
+              mOccupied(new uint64_t[mTicks / 64]()) {}
+
+    void PriceLadder::set(double price, double quantity) {
+        int64_t tick = toTick(price);
+        if (quantity > 0) {
+            if (!mSize || ((tick - mBase < 0 || tick - mBase >= int64_t(mTicks)) &&
+                           isBetter(tick, mBase + mBest)))
+                recentre(tick);
+            int64_t index = tick - mBase;
+            if (index < 0 || index >= int64_t(mTicks)) {
+                // worse than the whole window
+                mSize += mOverflow.count(tick) ? 0 : 1;
+                mOverflow[tick] = quantity;
+                return;
+            }
+            if (mQuantities[index] == 0) {
+                mOccupied[index >> 6] |= 1ULL << (index & 63);
+                mSize++;
+            }
+            mQuantities[index] = quantity;
+            if (mBest < 0 || isBetter(tick, mBase + mBest))
+                mBest = index;
+            return;
+        }
+        int64_t index = tick - mBase;
+        if (index < 0 || index >= int64_t(mTicks)) {
+            mSize -= mOverflow.erase(tick);
+            return;
+        }
+        if (mQuantities[index] == 0)
+            return;
+        mQuantities[index] = 0;
+        mOccupied[index >> 6] &= ~(1ULL << (index & 63));
+        mSize--;
+        if (index == mBest) {
+            mBest = findWorse(mDescending ? index - 1 : index + 1);
+            if (mBest < 0 && !mOverflow.empty())
+                recentre(mDescending ? mOverflow.rbegin()->first : mOverflow.begin()->first);
+        }
+    }
+
+    void PriceLadder::clear() {
+        std::fill(mQuantities.get(), mQuantities.get() + mTicks, 0.0);
+        std::fill(mOccupied.get(), mOccupied.get() + mTicks / 64, 0);
+        mOverflow.clear();
+        mBest = -1;
+        mSize = 0;
+    }
+
+    double PriceLadder::getQuantity(double price) const {
+        int64_t tick = toTick(price);
+        int64_t index = tick - mBase;
+        if (index >= 0 && index < int64_t(mTicks))
+            return mQuantities[index];
+        auto it = mOverflow.find(tick);
+        return it == mOverflow.end() ? 0 : it->second;
+    }
+
+    bool PriceLadder::empty() const {
+        return mSize == 0;
+    }
+
+    size_t PriceLadder::size() const {
+        return mSize;
+    }
+
+    double PriceLadder::getBestPrice() const {
+        return mBest < 0 ? 0 : toPrice(mBase + mBest);
+    }
+
+    double PriceLadder::getBestQuantity() const {
+        return mBest < 0 ? 0 : mQuantities[mBest];
+    }
+
+    double PriceLadder::getCumulativeQuantity(double price) const {
+        if (mBest < 0)
+            return 0;
+        int64_t tick = toTick(price);
+        if (isBetter(tick, mBase + mBest))
+            return 0;
+        int64_t index = tick - mBase;
+        double quantity = mDescending ? sum(std::max<int64_t>(index, 0), mBest)
+                                      : sum(mBest, std::min<int64_t>(index, int64_t(mTicks) - 1));
+        if (mDescending)
+            for (auto it = mOverflow.lower_bound(tick); it != mOverflow.end(); ++it)
+                quantity += it->second;
+        else
+            for (auto it = mOverflow.begin(); it != mOverflow.end() && it->first <= tick; ++it)
+                quantity += it->second;
+        return quantity;
+    }
+
+    void PriceLadder::getLevels(std::vector<double> &prices, std::vector<double> &quantities, size_t depth) const {
+        size_t levels = depth ? std::min(depth, mSize) : mSize;
+        prices.clear();
+        quantities.clear();
+        prices.reserve(levels);
+        quantities.reserve(levels);
+        for (int64_t index = mBest; index >= 0 && prices.size() < levels;
+             index = findWorse(mDescending ? index - 1 : index + 1)) {
+            prices.push_back(toPrice(mBase + index));
+            quantities.push_back(mQuantities[index]);
+        }
+        auto add = [&](const std::pair<const int64_t, double> &level) {
+            prices.push_back(toPrice(level.first));
+            quantities.push_back(level.second);
+        };
+        if (mDescending)
+            for (auto it = mOverflow.rbegin(); it != mOverflow.rend() && prices.size() < levels; ++it)
+                add(*it);
+        else
+            for (auto it = mOverflow.begin(); it != mOverflow.end() && prices.size() < levels; ++it)
+                add(*it);
+    }
+
+    double PriceLadder::getTickSize() const {
+        return mTickSize;
+    }
+
+    int64_t PriceLadder::toTick(double price) const {
+        return mExactScale ? std::llround(price * mScale) : std::llround(price / mTickSize);
+    }
+
+    double PriceLadder::toPrice(int64_t tick) const {
+        // dividing by an exact scale gives the same double as parsing the decimal price
+        return mExactScale ? double(tick) / mScale : double(tick) * mTickSize;
+    }
+
+    bool PriceLadder::isBetter(int64_t tick, int64_t other) const {
+        return mDescending ? tick > other : tick < other;
+    }
+
+    int64_t PriceLadder::findWorse(int64_t from) const {
+        if (from < 0 || from >= int64_t(mTicks))
+            return -1;
+        int64_t word = from >> 6;
+        unsigned bit = unsigned(from & 63);
+        if (mDescending) {
+            uint64_t bits = mOccupied[word] & (bit == 63 ? ~0ULL : (1ULL << (bit + 1)) - 1);
+            while (!bits) {
+                if (--word < 0)
+                    return -1;
+                bits = mOccupied[word];
+            }
+            return word * 64 + 63 - __builtin_clzll(bits);
+        }
+        uint64_t bits = mOccupied[word] & (~0ULL << bit);
+        while (!bits) {
+            if (++word >= int64_t(mTicks / 64))
+                return -1;
+            bits = mOccupied[word];
+        }
+        return word * 64 + __builtin_ctzll(bits);
+    }
+
+    void PriceLadder::recentre(int64_t bestTick) {
+        for (int64_t index = findWorse(mDescending ? int64_t(mTicks) - 1 : 0); index >= 0;
+             index = findWorse(mDescending ? index - 1 : index + 1)) {
+            mOverflow[mBase + index] = mQuantities[index];
+            mQuantities[index] = 0;
+        }
+        std::fill(mOccupied.get(), mOccupied.get() + mTicks / 64, 0);
+        mBase = bestTick - int64_t(mDescending ? mTicks - mTicks / 4 : mTicks / 4);
+        auto first = mOverflow.lower_bound(mBase), last = mOverflow.lower_bound(mBase + int64_t(mTicks));
+        for (auto it = first; it != last; ++it) {
+            int64_t index = it->first - mBase;
+            mQuantities[index] = it->second;
+            mOccupied[index >> 6] |= 1ULL << (index & 63);
+        }
+        mOverflow.erase(first, last);
+        mBest = findWorse(mDescending ? int64_t(mTicks) - 1 : 0);
+    }
+
+    double PriceLadder::sum(int64_t first, int64_t last) const {
+        // independent accumulators let the compiler vectorise the loop
+        double partial[4] = {0, 0, 0, 0};
+        int64_t i = first;
+        for (; i + 3 <= last; i += 4) {
+            partial[0] += mQuantities[i];
+            partial[1] += mQuantities[i + 1];
+            partial[2] += mQuantities[i + 2];
+            partial[3] += mQuantities[i + 3];
+        }
+        for (; i <= last; i++)
+            partial[0] += mQuantities[i];
+        return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+    }
+
+} // ats
@@ -0,0 +1,114 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "RecordingExchangeManager.h"
+
+namespace ats {
+
+    RecordingExchangeManager::RecordingExchangeManager(ExchangeManager &exchange, const std::string &path,
+                                                       Clock &clock)
+            : ExchangeManager(exchange.getOrderManager()), mExchange(exchange), mClock(clock) {
+        mFile.open(path);
+        mExchange.setExecutionListener([this](const Order &order, const ExecutionReport &report) {
+            record(CALL_SEND_ORDER, order.symbolName(), PayloadWriter().put(order.side).put(order.type)
+                    .put(order.quantity).put(order.price).put(report));
+        });
+        // ids differ from one run to the next, a replay matches the cancels of a symbol by their order
+        mExchange.setCancelListener([this](long, SymbolId symbol, bool canceled) {
+            record(CALL_CANCEL_ORDER, SymbolToString(symbol), PayloadWriter().put(canceled));
+        });
+    }
+
+    RecordingExchangeManager::~RecordingExchangeManager() {
+        mExchange.setExecutionListener(nullptr);
+        mExchange.setCancelListener(nullptr);
+        mFile.close();
+    }
+
+    bool RecordingExchangeManager::isRecording() {
+        return mFile.isOpen();
+    }
+
+    void RecordingExchangeManager::flush() {
+        mFile.flush();
+    }
+
+    double RecordingExchangeManager::sendOrder(Order &order) {
+        // the execution report is recorded by the listener
+        return mExchange.sendOrder(order);
+    }
+
+    void RecordingExchangeManager::modifyOrder(Order &oldOrder, Order &newOrder) {
+        mExchange.modifyOrder(oldOrder, newOrder);
+    }
+
+    void RecordingExchangeManager::cancelOrder(Order &order) {
+        // the outcome is recorded by the listener
+        mExchange.cancelOrder(order);
+    }
+
+    void RecordingExchangeManager::getOrderStatus(Order &order, Json::Value &result) {
+        mExchange.getOrderStatus(order, result);
+        record(CALL_ORDER_STATUS, order.symbolName(), PayloadWriter().put(result));
+    }
+
+    std::vector<Order> RecordingExchangeManager::getOpenOrders(std::string symbol) {
+        std::vector<Order> orders = mExchange.getOpenOrders(symbol);
+        record(CALL_OPEN_ORDERS, symbol, PayloadWriter().put(orders));
+        return orders;
+    }
+
+    std::vector<Trade> RecordingExchangeManager::getTradeHistory(std::string symbol) {
+        std::vector<Trade> trades = mExchange.getTradeHistory(symbol);
+        record(CALL_TRADE_HISTORY, symbol, PayloadWriter().put(trades));
+        return trades;
+    }
+
+    std::vector<Trade> RecordingExchangeManager::getTradesFrom(std::string symbol, long fromId, int limit) {
+        std::vector<Trade> trades = mExchange.getTradesFrom(symbol, fromId, limit);
+        record(CALL_TRADES_FROM, tradesRecordKey(symbol, fromId, limit), PayloadWriter().put(trades));
+        return trades;
+    }
+
+    std::map<std::string, double> RecordingExchangeManager::getBalances() {
+        std::map<std::string, double> balances = mExchange.getBalances();
+        record(CALL_BALANCES, "", PayloadWriter().put(balances));
+        return balances;
+    }
+
+    void RecordingExchangeManager::getKlines(Json::Value &result, std::string symbol, std::string interval,
+                                             time_t start_date, time_t end_date, int limit) {
+        mExchange.getKlines(result, symbol, interval, start_date, end_date, limit);
+        record(CALL_KLINES, klinesRecordKey(symbol, interval, start_date, end_date, limit),
+               PayloadWriter().put(result));
+    }
+
+    double RecordingExchangeManager::getPrice(std::string symbol) {
+        double price = mExchange.getPrice(symbol);
+        record(CALL_PRICE, symbol, PayloadWriter().put(price));
+        return price;
+    }
+
+    std::map<std::string, double> RecordingExchangeManager::getPrices(const std::vector<std::string> &symbols) {
+        std::map<std::string, double> prices = mExchange.getPrices(symbols);
+        record(CALL_PRICES, pricesRecordKey(symbols), PayloadWriter().put(prices));
+        return prices;
+    }
+
+    OrderBook RecordingExchangeManager::getOrderBook(std::string symbol) {
+        OrderBook book = mExchange.getOrderBook(symbol);
+        record(CALL_ORDER_BOOK, symbol, PayloadWriter().put(book));
+        return book;
+    }
+
+    void RecordingExchangeManager::record(RecordedCall call, const std::string &key, const PayloadWriter &payload) {
+        ExchangeRecord record;
+        record.time = mClock.now();
+        record.call = call;
+        record.key = key;
+        record.payload = payload.data();
+        mFile.write(record);
+    }
+
+} // ats
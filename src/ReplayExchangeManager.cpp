@@ -0,0 +1,216 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "ReplayExchangeManager.h"
+#include <algorithm>
+#include <limits>
+
+namespace ats {
+
+    ReplayExchangeManager::ReplayExchangeManager(OrderManager &orderManager, const std::string &path, double speed,
+                                                 Clock &clock)
+            : ExchangeManager(orderManager), mSpeed(speed), mClock(clock), mStart(clock.now()) {
+        std::vector<ExchangeRecord> records;
+        mOpen = RecordFile::read(path, records);
+        mFirstTime = records.empty() ? 0 : std::numeric_limits<int64_t>::max();
+        for (ExchangeRecord &record: records) {
+            mFirstTime = std::min(mFirstTime, record.time);
+            mStreams[{record.call, record.key}].responses.emplace_back(record.time, std::move(record.payload));
+        }
+        mRemaining = records.size();
+        start();
+    }
+
+    ReplayExchangeManager::~ReplayExchangeManager() {
+        stop();
+    }
+
+    void ReplayExchangeManager::start() {
+        if (mRunning)
+            return;
+        mRunning = true;
+        for (size_t i = 0; i < mOrderManager.getShardCount(); i++)
+            mThreads.emplace_back(&ReplayExchangeManager::run, this, i);
+    }
+
+    void ReplayExchangeManager::run(size_t shard) {
+        while (mRunning) {
+            if (mOrderManager.hasOrders(shard)) {
+                Order order = mOrderManager.getOldestOrder(shard);
+                sendOrder(order);
+            }
+            if (mOrderManager.hasCancelOrders(shard)) {
+                std::pair<long, SymbolId> order = mOrderManager.getCancelOrder(shard);
+                cancelOrder(order.first, order.second);
+            }
+            mOrderManager.waitForOrders(shard, mClock, -1, [this]() { return !mRunning; });
+        }
+    }
+
+    void ReplayExchangeManager::stop() {
+        mRunning = false;
+        mOrderManager.wakeExchange();
+        for (std::thread &thread: mThreads)
+            if (thread.joinable())
+                thread.join();
+        mThreads.clear();
+    }
+
+    bool ReplayExchangeManager::isOpen() const {
+        return mOpen;
+    }
+
+    bool ReplayExchangeManager::isFinished() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mRemaining == 0;
+    }
+
+    size_t ReplayExchangeManager::getMismatchedOrders() const {
+        return mMismatchedOrders;
+    }
+
+    double ReplayExchangeManager::sendOrder(Order &order) {
+        std::string payload;
+        ExecutionReport report;
+        // an order sent more often than recorded, or unlike the recorded one, is rejected
+        if (next(CALL_SEND_ORDER, order.symbolName(), false, payload)) {
+            PayloadReader reader(payload);
+            Side side;
+            OrderType type;
+            double quantity, price;
+            if (!reader.get(side) || !reader.get(type) || !reader.get(quantity) || !reader.get(price) ||
+                !reader.get(report))
+                report = ExecutionReport();
+            else if (side != order.side || type != order.type || quantity != order.quantity || price != order.price) {
+                report = ExecutionReport();
+                mMismatchedOrders++;
+            }
+        }
+        order.emsId = report.emsId;
+        if (report.acked)
+            mOrderManager.updateSentOrder(order, report.executedQty);
+        reportExecution(order, report);
+        return report.executedQty;
+    }
+
+    void ReplayExchangeManager::modifyOrder(Order &oldOrder, Order &newOrder) {
+        cancelOrder(oldOrder);
+        sendOrder(newOrder);
+    }
+
+    void ReplayExchangeManager::cancelOrder(Order &order) {
+        cancelOrder(order.id, order.symbol);
+    }
+
+    void ReplayExchangeManager::cancelOrder(long orderId, SymbolId symbol) {
+        std::string payload;
+        bool canceled = false;
+        // a cancel sent more often than recorded leaves the order open
+        if (next(CALL_CANCEL_ORDER, SymbolToString(symbol), false, payload) && !PayloadReader(payload).get(canceled))
+            canceled = false;
+        reportCancel(orderId, symbol, canceled);
+    }
+
+    void ReplayExchangeManager::getOrderStatus(Order &order, Json::Value &result) {
+        std::string payload;
+        if (next(CALL_ORDER_STATUS, order.symbolName(), true, payload))
+            PayloadReader(payload).get(result);
+    }
+
+    std::vector<Order> ReplayExchangeManager::getOpenOrders(std::string symbol) {
+        std::string payload;
+        std::vector<Order> orders;
+        if (next(CALL_OPEN_ORDERS, symbol, true, payload))
+            PayloadReader(payload).get(orders);
+        return orders;
+    }
+
+    std::vector<Trade> ReplayExchangeManager::getTradeHistory(std::string symbol) {
+        std::string payload;
+        std::vector<Trade> trades;
+        if (next(CALL_TRADE_HISTORY, symbol, true, payload))
+            PayloadReader(payload).get(trades);
+        return trades;
+    }
+
+    std::vector<Trade> ReplayExchangeManager::getTradesFrom(std::string symbol, long fromId, int limit) {
+        std::string payload;
+        std::vector<Trade> trades;
+        if (next(CALL_TRADES_FROM, tradesRecordKey(symbol, fromId, limit), true, payload))
+            PayloadReader(payload).get(trades);
+        return trades;
+    }
+
+    std::map<std::string, double> ReplayExchangeManager::getBalances() {
+        std::string payload;
+        std::map<std::string, double> balances;
+        if (next(CALL_BALANCES, "", true, payload))
+            PayloadReader(payload).get(balances);
+        return balances;
+    }
+
+    void ReplayExchangeManager::getKlines(Json::Value &result, std::string symbol, std::string interval,
+                                          time_t start_date, time_t end_date, int limit) {
+        std::string payload;
+        if (next(CALL_KLINES, klinesRecordKey(symbol, interval, start_date, end_date, limit), true, payload))
+            PayloadReader(payload).get(result);
+    }
+
+    double ReplayExchangeManager::getPrice(std::string symbol) {
+        std::string payload;
+        double price = -1;
+        if (next(CALL_PRICE, symbol, true, payload))
+            PayloadReader(payload).get(price);
+        return price;
+    }
+
+    std::map<std::string, double> ReplayExchangeManager::getPrices(const std::vector<std::string> &symbols) {
+        std::string payload;
+        std::map<std::string, double> prices;
+        if (next(CALL_PRICES, pricesRecordKey(symbols), true, payload))
+            PayloadReader(payload).get(prices);
+        return prices;
+    }
+
+    OrderBook ReplayExchangeManager::getOrderBook(std::string symbol) {
+        std::string payload;
+        OrderBook book;
+        if (next(CALL_ORDER_BOOK, symbol, true, payload))
+            PayloadReader(payload).get(book);
+        return book;
+    }
+
+    bool ReplayExchangeManager::next(RecordedCall call, const std::string &key, bool repeat, std::string &payload) {
+        int64_t due;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto it = mStreams.find({call, key});
+            if (it == mStreams.end())
+                return false;
+            ResponseStream &stream = it->second;
+            if (stream.next == stream.responses.size()) {
+                if (!repeat)
+                    return false;
+                payload = stream.responses.back().second;
+                return true;
+            }
+            size_t i = stream.next;
+            if (mSpeed > 0 && repeat) {
+                // market data skips to the last response due on the replay clock
+                int64_t now = mFirstTime + int64_t(double(mClock.now() - mStart) * mSpeed);
+                while (i + 1 < stream.responses.size() && stream.responses[i + 1].first <= now)
+                    i++;
+            }
+            mRemaining -= i + 1 - stream.next;
+            stream.next = i + 1;
+            payload = stream.responses[i].second;
+            if (mSpeed <= 0)
+                return true;
+            due = mStart + int64_t(double(stream.responses[i].first - mFirstTime) / mSpeed);
+        }
+        mClock.sleepUntil(due);
+        return true;
+    }
+
+} // ats
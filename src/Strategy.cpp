@@ -9,15 +9,17 @@
 namespace ats {
     Strategy::Strategy(std::string symbol, MarketData& data, OrderManager& orderManager, std::vector<double> prices)
     : mSymbol(std::move(symbol)), mData(data), mOrderManager(orderManager), mPrices(std::move(prices)) {
-        Strategy::start();
+        mEvents = std::make_shared<EventSubscription>();
     }
 
     Strategy::~Strategy() {
+        // derived classes stop first, this only keeps a forgotten thread from outliving the object
         Strategy::stop();
     }
 
     void Strategy::start() {
         if (!mRunning) {
+            mData.subscribeEvents(mEvents);
             mRunning = true;
             mStrategyThread = std::thread(&Strategy::run, this);
         }
@@ -25,13 +27,19 @@ namespace ats {
 
     void Strategy::stop() {
         mRunning = false;
+        // closing the subscription wakes up a thread waiting for events
+        mData.unsubscribeEvents(mEvents);
         if (mStrategyThread.joinable())
             mStrategyThread.join();
     }
 
     void Strategy::run() {
         while (mRunning) {
-            updatePrice();
+            if (mEvents->hasHandlers()) {
+                // handlers update the strategy state, nothing to evaluate until one ran
+                if (!mEvents->dispatch(EVENT_WAIT_MS))
+                    continue;
+            } else updatePrice();
             double signal = getSignal();
             if (signal > 0)
                 sell();
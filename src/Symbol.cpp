@@ -0,0 +1,106 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "Symbol.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace ats {
+
+    namespace {
+        constexpr size_t CHUNK_SIZE = 256; ///< Names per chunk
+        constexpr size_t CHUNK_COUNT = MAX_SYMBOLS / CHUNK_SIZE; ///< Number of chunks
+
+        /**
+         * @brief Names are stored in lazily allocated fixed chunks so that readers never see storage move.
+         */
+        class SymbolTable {
+        private:
+            std::atomic<std::string *> mChunks[CHUNK_COUNT]; ///< Chunks of interned names
+            std::atomic<size_t> mCount{1}; ///< Number of published ids, id 0 is the empty symbol
+            std::unordered_map<std::string, SymbolId> mIds; ///< Name to id lookup
+            std::shared_mutex mMutex; ///< Protects mIds and appending names
+
+        public:
+            SymbolTable() {
+                for (auto &chunk: mChunks)
+                    chunk.store(nullptr, std::memory_order_relaxed);
+                mChunks[0].store(new std::string[CHUNK_SIZE], std::memory_order_release);
+            }
+
+            ~SymbolTable() {
+                for (auto &chunk: mChunks)
+                    delete[] chunk.load(std::memory_order_relaxed);
+            }
+
+            const std::string &name(SymbolId id) {
+                if (id >= mCount.load(std::memory_order_acquire))
+                    return mChunks[0].load(std::memory_order_acquire)[NO_SYMBOL];
+                return mChunks[id / CHUNK_SIZE].load(std::memory_order_acquire)[id % CHUNK_SIZE];
+            }
+
+            SymbolId find(const std::string &s) {
+                std::shared_lock<std::shared_mutex> lock(mMutex);
+                auto it = mIds.find(s);
+                return it == mIds.end() ? NO_SYMBOL : it->second;
+            }
+
+            SymbolId intern(const std::string &s) {
+                if (s.empty())
+                    return NO_SYMBOL;
+                {
+                    std::shared_lock<std::shared_mutex> lock(mMutex);
+                    auto it = mIds.find(s);
+                    if (it != mIds.end())
+                        return it->second;
+                }
+                std::unique_lock<std::shared_mutex> lock(mMutex);
+                auto it = mIds.find(s);
+                if (it != mIds.end())
+                    return it->second;
+                size_t id = mCount.load(std::memory_order_relaxed);
+                if (id >= MAX_SYMBOLS)
+                    return NO_SYMBOL;
+                std::string *chunk = mChunks[id / CHUNK_SIZE].load(std::memory_order_relaxed);
+                if (!chunk) {
+                    chunk = new std::string[CHUNK_SIZE];
+                    mChunks[id / CHUNK_SIZE].store(chunk, std::memory_order_release);
+                }
+                chunk[id % CHUNK_SIZE] = s;
+                mIds.insert({s, SymbolId(id)});
+                mCount.store(id + 1, std::memory_order_release);
+                return SymbolId(id);
+            }
+
+            size_t size() {
+                return mCount.load(std::memory_order_acquire);
+            }
+        };
+
+        SymbolTable &symbolTable() {
+            static SymbolTable table;
+            return table;
+        }
+    }
+
+    const std::string &SymbolToString(SymbolId id) {
+        return symbolTable().name(id);
+    }
+
+    SymbolId stringToSymbol(const std::string &s) {
+        return symbolTable().intern(s);
+    }
+
+    SymbolId findSymbol(const std::string &s) {
+        return symbolTable().find(s);
+    }
+
+    size_t symbolCount() {
+        return symbolTable().size();
+    }
+
+} // ats
@@ -0,0 +1,93 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "ThreadPool.h"
+
+namespace ats {
+
+    ThreadPool::ThreadPool(size_t parallelism) {
+        for (size_t i = 1; i < parallelism; i++)
+            mWorkers.emplace_back(&ThreadPool::work, this);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWork.notify_all();
+        for (auto &worker: mWorkers)
+            worker.join();
+    }
+
+    size_t ThreadPool::getParallelism() const {
+        return mWorkers.size() + 1;
+    }
+
+    void ThreadPool::run(size_t count, const std::function<void(size_t)> &task) {
+        if (count == 0)
+            return;
+        if (mWorkers.empty() || count == 1) {
+            std::exception_ptr error;
+            for (size_t i = 0; i < count; i++)
+                try {
+                    task(i);
+                } catch (...) {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            if (error)
+                std::rethrow_exception(error);
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mMutex);
+        mTask = &task;
+        mCount = count;
+        mNext = 0;
+        mRemaining = count;
+        uint64_t batch = ++mBatch;
+        mWork.notify_all();
+        drain(lock, batch);
+        mDone.wait(lock, [this]() { return mRemaining == 0; });
+        mTask = nullptr;
+        std::exception_ptr error = std::move(mError);
+        mError = nullptr;
+        lock.unlock();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void ThreadPool::drain(std::unique_lock<std::mutex> &lock, uint64_t batch) {
+        while (mBatch == batch && mNext < mCount) {
+            size_t i = mNext++;
+            const std::function<void(size_t)> &task = *mTask;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                task(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !mError)
+                mError = error;
+            if (--mRemaining == 0)
+                mDone.notify_one();
+        }
+    }
+
+    void ThreadPool::work() {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true) {
+            mWork.wait(lock, [&]() { return mStopping || mBatch != seen; });
+            if (mStopping)
+                return;
+            seen = mBatch;
+            if (mTask)
+                drain(lock, seen);
+        }
+    }
+
+} // ats
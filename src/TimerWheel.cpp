@@ -0,0 +1,85 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "TimerWheel.h"
+#include <algorithm>
+#include "LockFreeQueue.h"
+
+namespace ats {
+
+    TimerWheel::TimerWheel(int64_t tick, size_t slots, int64_t now) : mTick(tick > 0 ? tick : 1),
+                                                                      mMask(roundUpToPowerOfTwo(slots ? slots : 1) - 1),
+                                                                      mSlots(mMask + 1),
+                                                                      mCurrentTick(now / mTick) {}
+
+    void TimerWheel::schedule(uint64_t id, int64_t due) {
+        auto [it, inserted] = mDeadlines.try_emplace(id, due);
+        if (!inserted) {
+            if (it->second == due)
+                return;
+            it->second = due; // the old entry is dropped when its slot is visited
+        }
+        int64_t tick = std::max(due / mTick, mCurrentTick);
+        mSlots[tick & mMask].push_back({id, due});
+    }
+
+    bool TimerWheel::cancel(uint64_t id) {
+        return mDeadlines.erase(id) != 0;
+    }
+
+    bool TimerWheel::contains(uint64_t id) const {
+        return mDeadlines.count(id) != 0;
+    }
+
+    size_t TimerWheel::size() const {
+        return mDeadlines.size();
+    }
+
+    int64_t TimerWheel::nextDeadline() const {
+        if (mDeadlines.empty())
+            return -1;
+        for (int64_t tick = mCurrentTick; tick <= mCurrentTick + int64_t(mMask); tick++) {
+            int64_t earliest = -1;
+            for (const Entry &entry: mSlots[tick & mMask])
+                if (entry.due / mTick <= tick && isLive(entry) && (earliest < 0 || entry.due < earliest))
+                    earliest = entry.due;
+            if (earliest >= 0)
+                return earliest;
+        }
+        // every timer is more than a revolution away
+        int64_t earliest = mDeadlines.begin()->second;
+        for (auto &[id, due]: mDeadlines)
+            earliest = std::min(earliest, due);
+        return earliest;
+    }
+
+    size_t TimerWheel::expire(int64_t now, std::vector<uint64_t> &expired) {
+        size_t count = 0;
+        int64_t nowTick = now / mTick;
+        // past a revolution every slot is visited once
+        int64_t first = std::max(mCurrentTick, nowTick - int64_t(mMask));
+        for (int64_t tick = first; tick <= nowTick; tick++) {
+            std::vector<Entry> &slot = mSlots[tick & mMask];
+            size_t kept = 0;
+            for (const Entry &entry: slot) {
+                if (!isLive(entry))
+                    continue;
+                if (entry.due <= now) {
+                    mDeadlines.erase(entry.id);
+                    expired.push_back(entry.id);
+                    count++;
+                } else slot[kept++] = entry;
+            }
+            slot.resize(kept);
+        }
+        mCurrentTick = std::max(mCurrentTick, nowTick);
+        return count;
+    }
+
+    bool TimerWheel::isLive(const Entry &entry) const {
+        auto it = mDeadlines.find(entry.id);
+        return it != mDeadlines.end() && it->second == entry.due;
+    }
+
+} // ats
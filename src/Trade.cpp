@@ -17,4 +17,32 @@ namespace ats {
         isBuyerMaker = isBuyerMaker_;
         isBestMatch = isBestMatch_;
     }
+
+    long Trade::getId() const {
+        return id;
+    }
+
+    double Trade::getPrice() const {
+        return price;
+    }
+
+    double Trade::getQuantity() const {
+        return quantity;
+    }
+
+    double Trade::getQuoteQty() const {
+        return quoteQty;
+    }
+
+    long Trade::getTime() const {
+        return time;
+    }
+
+    bool Trade::getIsBuyerMaker() const {
+        return isBuyerMaker;
+    }
+
+    bool Trade::getIsBestMatch() const {
+        return isBestMatch;
+    }
 } // ats
\ No newline at end of file
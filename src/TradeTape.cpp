@@ -0,0 +1,167 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "TradeTape.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace ats {
+
+    size_t TradeTape::size() const {
+        return mPrices.size();
+    }
+
+    bool TradeTape::empty() const {
+        return mPrices.empty();
+    }
+
+    int64_t TradeTape::lastId() const {
+        return mLastId;
+    }
+
+    bool TradeTape::append(const Trade &trade) {
+        return append(trade.getId(), trade.getPrice(), trade.getQuantity(), trade.getTime(), trade.getIsBuyerMaker());
+    }
+
+    bool TradeTape::append(int64_t id, double price, double quantity, int64_t time, bool isBuyerMaker) {
+        if (id <= mLastId || (!empty() && time < mLastTime))
+            return false;
+        constexpr int64_t MAX_OFFSET = std::numeric_limits<uint32_t>::max();
+        size_t i = size();
+        // a block is closed when full or when an offset would not fit
+        if (mBlocks.empty() || i - mBlocks.back().first == BLOCK_SIZE ||
+            id - mBlocks.back().id > MAX_OFFSET || time - mBlocks.back().time > MAX_OFFSET)
+            mBlocks.push_back({id, time, i});
+        const Block &block = mBlocks.back();
+        mIdOffsets.push_back(uint32_t(id - block.id));
+        mTimeOffsets.push_back(uint32_t(time - block.time));
+        mPrices.push_back(price);
+        mQuantities.push_back(quantity);
+        if (i % 64 == 0)
+            mBuyerMakers.push_back(0);
+        if (isBuyerMaker)
+            mBuyerMakers.back() |= uint64_t(1) << (i % 64);
+        mLastId = id;
+        mLastTime = time;
+        return true;
+    }
+
+    void TradeTape::clear() {
+        mBlocks.clear();
+        mIdOffsets.clear();
+        mTimeOffsets.clear();
+        mPrices.clear();
+        mQuantities.clear();
+        mBuyerMakers.clear();
+        mLastId = -1;
+        mLastTime = 0;
+    }
+
+    size_t TradeTape::trim(size_t count) {
+        if (size() <= count)
+            return 0;
+        size_t removed = size() - count;
+        // the block holding the first kept trade keeps its base, only the index of its first trade moves
+        auto kept = std::prev(std::upper_bound(mBlocks.begin(), mBlocks.end(), removed,
+                                               [](size_t index, const Block &block) { return index < block.first; }));
+        mBlocks.erase(mBlocks.begin(), kept);
+        for (Block &block: mBlocks)
+            block.first = block.first > removed ? block.first - removed : 0;
+        mIdOffsets.erase(mIdOffsets.begin(), mIdOffsets.begin() + long(removed));
+        mTimeOffsets.erase(mTimeOffsets.begin(), mTimeOffsets.begin() + long(removed));
+        mPrices.erase(mPrices.begin(), mPrices.begin() + long(removed));
+        mQuantities.erase(mQuantities.begin(), mQuantities.begin() + long(removed));
+        std::vector<uint64_t> buyerMakers((count + 63) / 64, 0);
+        for (size_t i = 0; i < count; i++)
+            if ((mBuyerMakers[(removed + i) / 64] >> ((removed + i) % 64)) & 1)
+                buyerMakers[i / 64] |= uint64_t(1) << (i % 64);
+        mBuyerMakers = std::move(buyerMakers);
+        return removed;
+    }
+
+    int64_t TradeTape::id(size_t i) const {
+        return blockOf(i).id + mIdOffsets[i];
+    }
+
+    int64_t TradeTape::time(size_t i) const {
+        return blockOf(i).time + mTimeOffsets[i];
+    }
+
+    double TradeTape::price(size_t i) const {
+        return mPrices[i];
+    }
+
+    double TradeTape::quantity(size_t i) const {
+        return mQuantities[i];
+    }
+
+    bool TradeTape::isBuyerMaker(size_t i) const {
+        return (mBuyerMakers[i / 64] >> (i % 64)) & 1;
+    }
+
+    Trade TradeTape::at(size_t i) const {
+        const Block &block = blockOf(i);
+        return {long(block.id + mIdOffsets[i]), mPrices[i], mQuantities[i], mPrices[i] * mQuantities[i],
+                long(block.time + mTimeOffsets[i]), isBuyerMaker(i), true};
+    }
+
+    const double *TradeTape::prices() const {
+        return mPrices.data();
+    }
+
+    const double *TradeTape::quantities() const {
+        return mQuantities.data();
+    }
+
+    size_t TradeTape::lowerBound(int64_t time) const {
+        // every trade before the first block opened at or after the time is in the block before it
+        auto next = std::lower_bound(mBlocks.begin(), mBlocks.end(), time,
+                                     [](const Block &block, int64_t t) { return block.time < t; });
+        size_t end = next == mBlocks.end() ? size() : next->first;
+        if (next == mBlocks.begin())
+            return end;
+        const Block &block = *std::prev(next);
+        if (time - block.time > int64_t(std::numeric_limits<uint32_t>::max()))
+            return end;
+        auto offsets = mTimeOffsets.begin();
+        return std::lower_bound(offsets + block.first, offsets + end, uint32_t(time - block.time)) - offsets;
+    }
+
+    double TradeTape::volume(int64_t from, int64_t to) const {
+        double volume = 0;
+        for (size_t i = lowerBound(from), end = lowerBound(to); i < end; i++)
+            volume += mQuantities[i];
+        return volume;
+    }
+
+    double TradeTape::vwap(int64_t from, int64_t to) const {
+        double notional = 0, volume = 0;
+        for (size_t i = lowerBound(from), end = lowerBound(to); i < end; i++) {
+            notional += mPrices[i] * mQuantities[i];
+            volume += mQuantities[i];
+        }
+        return volume > 0 ? notional / volume : 0;
+    }
+
+    std::vector<std::pair<double, double>> TradeTape::volumeProfile(int64_t from, int64_t to, double step) const {
+        std::map<int64_t, double> levels;
+        if (step > 0)
+            for (size_t i = lowerBound(from), end = lowerBound(to); i < end; i++)
+                levels[int64_t(std::floor(mPrices[i] / step))] += mQuantities[i];
+        std::vector<std::pair<double, double>> profile;
+        profile.reserve(levels.size());
+        for (const auto &[level, volume]: levels)
+            profile.emplace_back(level * step, volume);
+        return profile;
+    }
+
+    const TradeTape::Block &TradeTape::blockOf(size_t i) const {
+        auto next = std::upper_bound(mBlocks.begin(), mBlocks.end(), i,
+                                     [](size_t index, const Block &block) { return index < block.first; });
+        return *std::prev(next);
+    }
+
+} // ats
@@ -0,0 +1,79 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "WaitStrategy.h"
+
+namespace ats {
+
+    std::string WaitPolicyToString(WaitPolicy p) {
+        switch (p) {
+            case BUSY_SPIN:
+                return "BUSY_SPIN";
+            case SPIN_YIELD:
+                return "SPIN_YIELD";
+            case PARK:
+                return "PARK";
+            default:
+                return "Unknown";
+        }
+    }
+
+    WaitPolicy stringToWaitPolicy(const std::string &s) {
+        for (int i = 0; i < WPCOUNT; i++)
+            if (WaitPolicyToString(WaitPolicy(i)) == s)
+                return WaitPolicy(i);
+        return WPCOUNT;
+    }
+
+    Waiter::Waiter(WaitPolicy policy, int spinCount) : mPolicy(policy), mSpinCount(spinCount) {}
+
+    void Waiter::notify() {
+        long expected = 0;
+        mNotifyTime.compare_exchange_strong(expected, now(), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mParked.load()) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mCondition.notify_one();
+        }
+    }
+
+    void Waiter::setPolicy(WaitPolicy policy) {
+        mPolicy.store(policy);
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCondition.notify_one();
+    }
+
+    WaitPolicy Waiter::getPolicy() const {
+        return mPolicy.load();
+    }
+
+    WakeupStats Waiter::getWakeupStats() const {
+        long wakeups = mWakeups.load(std::memory_order_relaxed);
+        long total = mTotalLatency.load(std::memory_order_relaxed);
+        return {wakeups, wakeups ? double(total) / wakeups : 0., mMaxLatency.load(std::memory_order_relaxed)};
+    }
+
+    void Waiter::resetWakeupStats() {
+        mWakeups.store(0, std::memory_order_relaxed);
+        mTotalLatency.store(0, std::memory_order_relaxed);
+        mMaxLatency.store(0, std::memory_order_relaxed);
+    }
+
+    long Waiter::now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void Waiter::recordWakeup() {
+        long notified = mNotifyTime.exchange(0, std::memory_order_relaxed);
+        if (!notified)
+            return;
+        long latency = now() - notified;
+        mWakeups.fetch_add(1, std::memory_order_relaxed);
+        mTotalLatency.fetch_add(latency, std::memory_order_relaxed);
+        if (latency > mMaxLatency.load(std::memory_order_relaxed))
+            mMaxLatency.store(latency, std::memory_order_relaxed);
+    }
+
+} // ats
@@ -0,0 +1,418 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+
+#include "WebSocketClient.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/sha.h>
+#include <openssl/ssl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ats {
+
+    namespace {
+        constexpr char HANDSHAKE_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        constexpr uint8_t OP_CONTINUATION = 0x0, OP_TEXT = 0x1, OP_BINARY = 0x2, OP_CLOSE = 0x8, OP_PING = 0x9,
+                OP_PONG = 0xA;
+
+        std::string base64(const unsigned char *data, size_t size) {
+            static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            std::string out;
+            for (size_t i = 0; i < size; i += 3) {
+                uint32_t n = uint32_t(data[i]) << 16;
+                if (i + 1 < size) n |= uint32_t(data[i + 1]) << 8;
+                if (i + 2 < size) n |= data[i + 2];
+                out += table[(n >> 18) & 63];
+                out += table[(n >> 12) & 63];
+                out += i + 1 < size ? table[(n >> 6) & 63] : '=';
+                out += i + 2 < size ? table[n & 63] : '=';
+            }
+            return out;
+        }
+
+        std::string lower(std::string s) {
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+            return s;
+        }
+
+        int remainingMs(std::chrono::steady_clock::time_point deadline) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+            return int(std::max<long long>(remaining, 0));
+        }
+
+        bool waitFor(int fd, short events, std::chrono::steady_clock::time_point deadline) {
+            pollfd pfd{fd, events, 0};
+            return poll(&pfd, 1, remainingMs(deadline)) > 0;
+        }
+
+        bool setBlocking(int fd, bool blocking) {
+            int flags = fcntl(fd, F_GETFL, 0);
+            return flags >= 0 && fcntl(fd, F_SETFL, blocking ? flags & ~O_NONBLOCK : flags | O_NONBLOCK) == 0;
+        }
+
+        /**
+         * Connects a non-blocking socket, waiting at most until the deadline.
+         */
+        bool connectBefore(int fd, const sockaddr *address, socklen_t size,
+                           std::chrono::steady_clock::time_point deadline) {
+            if (::connect(fd, address, size) == 0)
+                return true;
+            if (errno != EINPROGRESS || !waitFor(fd, POLLOUT, deadline))
+                return false;
+            int error = 0;
+            socklen_t length = sizeof(error);
+            return getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0;
+        }
+
+        // Socket BIO writing with MSG_NOSIGNAL, so that a peer reset fails the SSL call instead of raising SIGPIPE
+        int bioWrite(BIO *bio, const char *data, int size) {
+            int fd = int(reinterpret_cast<intptr_t>(BIO_get_data(bio)));
+            BIO_clear_retry_flags(bio);
+            long written = ::send(fd, data, size_t(size), MSG_NOSIGNAL);
+            if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                BIO_set_retry_write(bio);
+            return int(written);
+        }
+
+        int bioRead(BIO *bio, char *data, int size) {
+            int fd = int(reinterpret_cast<intptr_t>(BIO_get_data(bio)));
+            BIO_clear_retry_flags(bio);
+            long received = ::recv(fd, data, size_t(size), 0);
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                BIO_set_retry_read(bio);
+            return int(received);
+        }
+
+        long bioCtrl(BIO *, int command, long, void *) {
+            return command == BIO_CTRL_FLUSH ? 1 : 0;
+        }
+
+        BIO *socketBio(int fd) {
+            static BIO_METHOD *method = []() {
+                BIO_METHOD *m = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "ats socket");
+                if (m) {
+                    BIO_meth_set_write(m, bioWrite);
+                    BIO_meth_set_read(m, bioRead);
+                    BIO_meth_set_ctrl(m, bioCtrl);
+                }
+                return m;
+            }();
+            BIO *bio = method ? BIO_new(method) : nullptr;
+            if (bio) {
+                BIO_set_data(bio, reinterpret_cast<void *>(intptr_t(fd)));
+                BIO_set_init(bio, 1);
+            }
+            return bio;
+        }
+
+        /**
+         * Runs the TLS handshake on a non-blocking socket, waiting at most until the deadline.
+         */
+        bool handshakeBefore(SSL *ssl, int fd, std::chrono::steady_clock::time_point deadline) {
+            while (true) {
+                int result = SSL_connect(ssl);
+                if (result == 1)
+                    return true;
+                int error = SSL_get_error(ssl, result);
+                if (error == SSL_ERROR_WANT_READ) {
+                    if (!waitFor(fd, POLLIN, deadline))
+                        return false;
+                } else if (error != SSL_ERROR_WANT_WRITE || !waitFor(fd, POLLOUT, deadline))
+                    return false;
+            }
+        }
+    }
+
+    WebSocketClient::WebSocketClient() : mRandom(std::random_device{}()) {}
+
+    WebSocketClient::~WebSocketClient() {
+        close();
+    }
+
+    bool WebSocketClient::connect(const std::string &url, int timeoutMs) {
+        close();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        bool secure;
+        size_t hostStart;
+        if (url.compare(0, 5, "ws://") == 0) {
+            secure = false;
+            hostStart = 5;
+        } else if (url.compare(0, 6, "wss://") == 0) {
+            secure = true;
+            hostStart = 6;
+        } else return false;
+        size_t pathStart = url.find('/', hostStart);
+        std::string authority = url.substr(hostStart, pathStart - hostStart);
+        std::string path = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+        std::string host = authority, port = secure ? "443" : "80";
+        size_t colon = authority.rfind(':');
+        if (colon != std::string::npos) {
+            host = authority.substr(0, colon);
+            port = authority.substr(colon + 1);
+        }
+
+        addrinfo hints{}, *addresses = nullptr;
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0)
+            return false;
+        for (addrinfo *address = addresses; address && mFd < 0; address = address->ai_next) {
+            mFd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (mFd >= 0 && (!setBlocking(mFd, false) ||
+                             !connectBefore(mFd, address->ai_addr, address->ai_addrlen, deadline))) {
+                ::close(mFd);
+                mFd = -1;
+            }
+        }
+        freeaddrinfo(addresses);
+        if (mFd < 0)
+            return false;
+        int one = 1;
+        setsockopt(mFd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        if (secure) {
+            mContext = SSL_CTX_new(TLS_client_method());
+            if (!mContext) {
+                disconnect();
+                return false;
+            }
+            SSL_CTX_set_default_verify_paths(mContext);
+            SSL_CTX_set_verify(mContext, SSL_VERIFY_PEER, nullptr);
+            mSsl = SSL_new(mContext);
+            BIO *bio = mSsl ? socketBio(mFd) : nullptr;
+            if (bio)
+                SSL_set_bio(mSsl, bio, bio);
+            if (!bio || !SSL_set_tlsext_host_name(mSsl, host.c_str()) || !SSL_set1_host(mSsl, host.c_str()) ||
+                !handshakeBefore(mSsl, mFd, deadline)) {
+                disconnect();
+                return false;
+            }
+        }
+        // Reads poll with their own timeout, writes block until the frame is sent
+        if (!setBlocking(mFd, true)) {
+            disconnect();
+            return false;
+        }
+
+        unsigned char nonce[16];
+        for (unsigned char &byte: nonce)
+            byte = (unsigned char) (mRandom() & 0xFF);
+        std::string key = base64(nonce, sizeof(nonce));
+        std::string request = "GET " + path + " HTTP/1.1\r\n"
+                              "Host: " + authority + "\r\n"
+                              "Upgrade: websocket\r\n"
+                              "Connection: Upgrade\r\n"
+                              "Sec-WebSocket-Key: " + key + "\r\n"
+                              "Sec-WebSocket-Version: 13\r\n\r\n";
+        if (!writeAll(request.data(), request.size())) {
+            disconnect();
+            return false;
+        }
+        size_t end;
+        while ((end = mInput.find("\r\n\r\n")) == std::string::npos)
+            if (!readSome(remainingMs(deadline))) {
+                disconnect();
+                return false;
+            }
+        std::string response = lower(mInput.substr(0, end + 2));
+        mInput.erase(0, end + 4);
+        std::string expected = "sec-websocket-accept: " + lower(acceptKey(key)) + "\r\n";
+        if (response.compare(0, 12, "http/1.1 101") != 0 || response.find(expected) == std::string::npos) {
+            disconnect();
+            return false;
+        }
+        mConnected = true;
+        return true;
+    }
+
+    bool WebSocketClient::isConnected() const {
+        return mConnected;
+    }
+
+    bool WebSocketClient::send(const std::string &text) {
+        return mConnected && sendFrame(OP_TEXT, text.data(), text.size());
+    }
+
+    bool WebSocketClient::receive(std::string &message, int timeoutMs) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (mConnected) {
+            int parsed = parseFrame(message);
+            if (parsed == 1)
+                return true;
+            if (parsed < 0) {
+                disconnect();
+                return false;
+            }
+            if (parsed == 2)
+                continue;
+            int remaining = remainingMs(deadline);
+            if (!remaining || !readSome(remaining))
+                return false;
+        }
+        return false;
+    }
+
+    void WebSocketClient::close() {
+        if (mConnected)
+            sendFrame(OP_CLOSE, nullptr, 0);
+        disconnect();
+    }
+
+    std::string WebSocketClient::acceptKey(const std::string &key) {
+        std::string input = key + HANDSHAKE_GUID;
+        unsigned char digest[SHA_DIGEST_LENGTH];
+        SHA1(reinterpret_cast<const unsigned char *>(input.data()), input.size(), digest);
+        return base64(digest, sizeof(digest));
+    }
+
+    int WebSocketClient::parseFrame(std::string &message) {
+        if (mInput.size() < 2)
+            return 0;
+        auto *bytes = reinterpret_cast<const unsigned char *>(mInput.data());
+        bool fin = bytes[0] & 0x80;
+        uint8_t opcode = bytes[0] & 0x0F;
+        bool masked = bytes[1] & 0x80;
+        uint64_t size = bytes[1] & 0x7F;
+        size_t header = 2;
+        if (size == 126) {
+            if (mInput.size() < 4)
+                return 0;
+            size = (uint64_t(bytes[2]) << 8) | bytes[3];
+            header = 4;
+        } else if (size == 127) {
+            if (mInput.size() < 10)
+                return 0;
+            size = 0;
+            for (int i = 0; i < 8; i++)
+                size = (size << 8) | bytes[2 + i];
+            header = 10;
+        }
+        // checked before header + size is computed, a 64-bit length could wrap it
+        if (size > MAX_MESSAGE_SIZE || (opcode == OP_CONTINUATION && size > MAX_MESSAGE_SIZE - mMessage.size())) {
+            const char tooBig[2] = {char(1009 >> 8), char(1009 & 0xFF)};
+            sendFrame(OP_CLOSE, tooBig, sizeof(tooBig));
+            return -1;
+        }
+        size_t maskOffset = header;
+        if (masked)
+            header += 4;
+        if (mInput.size() < header + size)
+            return 0;
+        std::string payload = mInput.substr(header, size);
+        if (masked)
+            for (size_t i = 0; i < payload.size(); i++)
+                payload[i] = char(payload[i] ^ mInput[maskOffset + i % 4]);
+        mInput.erase(0, header + size);
+        switch (opcode) {
+            case OP_TEXT:
+            case OP_BINARY:
+                if (fin) {
+                    message = std::move(payload);
+                    return 1;
+                }
+                mMessage = std::move(payload);
+                return 2;
+            case OP_CONTINUATION:
+                mMessage += payload;
+                if (!fin)
+                    return 2;
+                message = std::move(mMessage);
+                mMessage.clear();
+                return 1;
+            case OP_PING:
+                return sendFrame(OP_PONG, payload.data(), payload.size()) ? 2 : -1;
+            case OP_PONG:
+                return 2;
+            case OP_CLOSE:
+                sendFrame(OP_CLOSE, payload.data(), std::min<size_t>(payload.size(), 2));
+                return -1;
+            default:
+                return -1;
+        }
+    }
+
+    bool WebSocketClient::sendFrame(uint8_t opcode, const char *data, size_t size) {
+        std::string frame;
+        frame.reserve(size + 14);
+        frame += char(0x80 | opcode);
+        if (size < 126)
+            frame += char(0x80 | size);
+        else if (size <= 0xFFFF) {
+            frame += char(0x80 | 126);
+            frame += char(size >> 8);
+            frame += char(size & 0xFF);
+        } else {
+            frame += char(0x80 | 127);
+            for (int i = 7; i >= 0; i--)
+                frame += char((uint64_t(size) >> (8 * i)) & 0xFF);
+        }
+        uint32_t mask = mRandom();
+        char maskBytes[4] = {char(mask >> 24), char(mask >> 16), char(mask >> 8), char(mask)};
+        frame.append(maskBytes, 4);
+        for (size_t i = 0; i < size; i++)
+            frame += char(data[i] ^ maskBytes[i % 4]);
+        if (writeAll(frame.data(), frame.size()))
+            return true;
+        disconnect();
+        return false;
+    }
+
+    bool WebSocketClient::readSome(int timeoutMs) {
+        if (mFd < 0)
+            return false;
+        if (!mSsl || SSL_pending(mSsl) <= 0) {
+            pollfd fd{mFd, POLLIN, 0};
+            if (poll(&fd, 1, timeoutMs) <= 0)
+                return false;
+        }
+        char buffer[16384];
+        long received = mSsl ? SSL_read(mSsl, buffer, sizeof(buffer)) : recv(mFd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            disconnect();
+            return false;
+        }
+        mInput.append(buffer, size_t(received));
+        return true;
+    }
+
+    bool WebSocketClient::writeAll(const char *data, size_t size) {
+        while (size > 0 && mFd >= 0) {
+            long written = mSsl ? SSL_write(mSsl, data, int(size)) : ::send(mFd, data, size, MSG_NOSIGNAL);
+            if (written <= 0)
+                return false;
+            data += written;
+            size -= size_t(written);
+        }
+        return size == 0;
+    }
+
+    void WebSocketClient::disconnect() {
+        mConnected = false;
+        if (mSsl) {
+            SSL_free(mSsl);
+            mSsl = nullptr;
+        }
+        if (mContext) {
+            SSL_CTX_free(mContext);
+            mContext = nullptr;
+        }
+        if (mFd >= 0) {
+            ::close(mFd);
+            mFd = -1;
+        }
+        mInput.clear();
+        mMessage.clear();
+    }
+
+} // ats
@@ -0,0 +1,90 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "BBOTable.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace ats;
+
+TEST(BBOTableTest, StampsOnlyChanges) {
+    BBOTable table;
+    BBO bbo;
+    ASSERT_FALSE(table.get(42, bbo));
+
+    BBO top;
+    top.bidPrice = 100;
+    top.bidQty = 2;
+    top.askPrice = 101;
+    top.askQty = 3;
+    top.updateId = 7;
+    ASSERT_TRUE(table.update(42, top));
+    ASSERT_TRUE(table.get(42, bbo));
+    ASSERT_DOUBLE_EQ(bbo.bidPrice, 100);
+    ASSERT_DOUBLE_EQ(bbo.askQty, 3);
+    ASSERT_EQ(bbo.updateId, 7);
+    int64_t changed = bbo.time;
+    ASSERT_GT(changed, 0);
+
+    // a diff below the top leaves the record untouched
+    top.updateId = 8;
+    ASSERT_FALSE(table.update(42, top));
+    ASSERT_TRUE(table.get(42, bbo));
+    ASSERT_EQ(bbo.updateId, 7);
+    ASSERT_EQ(bbo.time, changed);
+
+    ASSERT_FALSE(table.get(43, bbo));
+    ASSERT_FALSE(table.get(42 + 256, bbo));
+    table.clear(42);
+    ASSERT_FALSE(table.get(42, bbo));
+}
+
+TEST(BBOTableTest, StampsChangesOnTheWallTimeOfItsClock) {
+    SimulatedClock clock(0, 1700000000 * NANOS_PER_SECOND);
+    BBOTable table(clock);
+    BBO top;
+    top.bidPrice = 100;
+    ASSERT_TRUE(table.update(1, top));
+    BBO bbo;
+    ASSERT_TRUE(table.get(1, bbo));
+    ASSERT_EQ(bbo.time, 1700000000 * NANOS_PER_SECOND);
+    clock.advance(NANOS_PER_MILLI);
+    top.bidPrice = 101;
+    ASSERT_TRUE(table.update(1, top));
+    ASSERT_TRUE(table.get(1, bbo));
+    ASSERT_EQ(bbo.time, 1700000000 * NANOS_PER_SECOND + NANOS_PER_MILLI);
+}
+
+TEST(BBOTableTest, ReadersNeverSeeTornRecords) {
+    BBOTable table;
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 1; i <= 200000; i++) {
+            BBO bbo;
+            bbo.bidPrice = i;
+            bbo.bidQty = i;
+            bbo.askPrice = i + 1;
+            bbo.askQty = i;
+            bbo.updateId = i;
+            table.update(7, bbo);
+        }
+        done = true;
+    });
+    uint64_t last = 0;
+    while (!done) {
+        BBO bbo;
+        if (!table.get(7, bbo))
+            continue;
+        ASSERT_DOUBLE_EQ(bbo.bidPrice, double(bbo.updateId));
+        ASSERT_DOUBLE_EQ(bbo.bidQty, double(bbo.updateId));
+        ASSERT_DOUBLE_EQ(bbo.askPrice, double(bbo.updateId + 1));
+        ASSERT_DOUBLE_EQ(bbo.askQty, double(bbo.updateId));
+        ASSERT_GE(bbo.updateId, last);
+        last = bbo.updateId;
+    }
+    writer.join();
+    BBO bbo;
+    ASSERT_TRUE(table.get(7, bbo));
+    ASSERT_EQ(bbo.updateId, 200000);
+}
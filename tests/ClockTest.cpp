@@ -0,0 +1,87 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "Clock.h"
+
+using namespace ats;
+
+TEST(ClockTest, RealClockIsMonotonic) {
+    Clock &clock = realClock();
+    int64_t start = clock.now();
+    clock.sleepFor(2 * NANOS_PER_MILLI);
+    ASSERT_GE(clock.now() - start, 2 * NANOS_PER_MILLI);
+    ASSERT_EQ(clock.nowMs(), clock.now() / NANOS_PER_MILLI);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::unique_lock<std::mutex> lock(mutex);
+    start = clock.now();
+    clock.waitUntil(lock, condition, start + 5 * NANOS_PER_MILLI, []() { return false; });
+    ASSERT_TRUE(lock.owns_lock());
+    ASSERT_GE(clock.now() - start, 5 * NANOS_PER_MILLI);
+
+    // the wall time is the system clock's, which may jump, so it is only compared loosely
+    int64_t wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    ASSERT_LT(std::abs(clock.epochNow() - wall), NANOS_PER_SECOND);
+}
+
+TEST(ClockTest, SimulatedClockOnlyMovesWhenAdvanced) {
+    SimulatedClock clock(NANOS_PER_SECOND);
+    ASSERT_EQ(clock.now(), NANOS_PER_SECOND);
+    ASSERT_EQ(clock.nowMs(), 1000);
+    ASSERT_EQ(clock.epochNow(), NANOS_PER_SECOND);
+    SimulatedClock dated(5 * NANOS_PER_MILLI, 1700000000 * NANOS_PER_SECOND);
+    ASSERT_EQ(dated.epochMs(), 1700000000005);
+    clock.advance(-5);
+    clock.set(0);
+    ASSERT_EQ(clock.now(), NANOS_PER_SECOND);
+
+    std::atomic<bool> woken{false};
+    std::thread sleeper([&]() {
+        clock.sleepFor(NANOS_PER_SECOND);
+        woken = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(woken);
+    clock.advance(NANOS_PER_SECOND / 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(woken);
+    clock.set(2 * NANOS_PER_SECOND);
+    sleeper.join();
+    ASSERT_TRUE(woken);
+}
+
+TEST(ClockTest, SimulatedWaitEndsOnTheDeadlineOrThePredicate) {
+    SimulatedClock clock;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool done = false;
+    std::atomic<int> woken{0};
+    std::thread waiter([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        clock.waitUntil(lock, condition, NANOS_PER_SECOND, [&]() { return done; });
+        woken++;
+        clock.waitUntil(lock, condition, -1, [&]() { return done; });
+        woken++;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(woken, 0);
+    clock.advance(NANOS_PER_SECOND);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(woken, 1);
+    // without a deadline, only the predicate ends the wait
+    clock.advance(NANOS_PER_SECOND);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(woken, 1);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    condition.notify_all();
+    waiter.join();
+    ASSERT_EQ(woken, 2);
+}
@@ -0,0 +1,245 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "RecordingExchangeManager.h"
+#include "ReplayExchangeManager.h"
+#include "StubExchangeManager.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <unistd.h>
+
+using namespace ats;
+
+namespace {
+    std::string recordingPath(const std::string &name) {
+        return "/tmp/ats_" + name + "_" + std::to_string(getpid()) + ".rec";
+    }
+
+    Json::Value klinesResponse(int close) {
+        Json::Value klines, kline;
+        kline.append("1700000000000");
+        kline.append(std::to_string(close));
+        klines.append(kline);
+        return klines;
+    }
+
+    /**
+     * @brief Answers with a price increasing on every request, acknowledges orders as half filled and cancels them.
+     */
+    class LiveExchangeManager : public StubExchangeManager {
+    public:
+        explicit LiveExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        double sendOrder(Order &order) override {
+            ExecutionReport report;
+            report.emsId = order.emsId = 42;
+            report.acked = true;
+            report.status = PARTIALLY_FILLED;
+            report.executedQty = order.quantity / 2;
+            reportExecution(order, report);
+            return report.executedQty;
+        }
+
+        void cancelOrder(Order &order) override {
+            reportCancel(order.id, order.symbol, true);
+        }
+
+        std::vector<Order> getOpenOrders(std::string symbol) override {
+            return {Order(7, LIMIT, SELL, symbol, 2, 30000, 0, 0, 0, 99)};
+        }
+
+        std::vector<Trade> getTradeHistory(std::string) override {
+            return {Trade(5, 30000, 0.1, 3000, 1700000000000, true, true)};
+        }
+
+        std::map<std::string, double> getBalances() override { return {{"BTC", 1.5}, {"USDT", 100}}; }
+
+        // the close of the kline is the limit of the request
+        void getKlines(Json::Value &result, std::string, std::string, time_t, time_t, int limit) override {
+            Json::Value kline;
+            for (const char *field: {"1700000000000", "1", "2", "0.5"})
+                kline.append(field);
+            kline.append(std::to_string(limit));
+            kline.append("10");
+            result.append(kline);
+        }
+
+        double getPrice(std::string) override { return price++; }
+
+        OrderBook getOrderBook(std::string) override { return {{99, 98}, {1, 2}, {101}, {3}}; }
+
+        double price = 100;
+    };
+}
+
+TEST(ExchangeReplayTest, ResponsesArePlayedBackInOrder) {
+    std::string path = recordingPath("replay");
+    {
+        OrderManager oms;
+        LiveExchangeManager live(oms);
+        RecordingExchangeManager recorder(live, path);
+        ASSERT_TRUE(recorder.isRecording());
+        ASSERT_EQ(recorder.getPrice("BTCUSDT"), 100);
+        ASSERT_EQ(recorder.getPrice("BTCUSDT"), 101);
+        Json::Value klines;
+        recorder.getKlines(klines, "BTCUSDT", "1m", 0, 0, 500);
+        klines.clear();
+        recorder.getKlines(klines, "BTCUSDT", "1m", 0, 0, 10);
+        recorder.getOrderBook("BTCUSDT");
+        recorder.getBalances();
+        recorder.getOpenOrders("BTCUSDT");
+        recorder.getTradesFrom("BTCUSDT", -1, 10);
+        Order order(1, LIMIT, BUY, "BTCUSDT", 1, 30000);
+        ASSERT_EQ(recorder.sendOrder(order), 0.5);
+    }
+
+    OrderManager oms;
+    ReplayExchangeManager replay(oms, path);
+    ASSERT_TRUE(replay.isOpen());
+    ASSERT_EQ(replay.getPrice("BTCUSDT"), 100);
+    ASSERT_EQ(replay.getPrice("BTCUSDT"), 101);
+    ASSERT_EQ(replay.getPrice("ETHUSDT"), -1);
+    // klines are matched by request, not by call order
+    Json::Value klines;
+    replay.getKlines(klines, "BTCUSDT", "1m", 0, 0, 10);
+    ASSERT_EQ(klines.size(), 1);
+    ASSERT_EQ(klines[0][4].asString(), "10");
+    klines.clear();
+    replay.getKlines(klines, "BTCUSDT", "1m", 0, 0, 500);
+    ASSERT_EQ(klines[0][4].asString(), "500");
+    klines.clear();
+    replay.getKlines(klines, "BTCUSDT", "1m", 1700000000, 0, 1000);
+    ASSERT_TRUE(klines.empty());
+    OrderBook book = replay.getOrderBook("BTCUSDT");
+    ASSERT_EQ(book.bid, std::vector<double>({99, 98}));
+    ASSERT_EQ(book.askVol, std::vector<double>({3}));
+    ASSERT_EQ(replay.getBalances().at("BTC"), 1.5);
+    std::vector<Order> orders = replay.getOpenOrders("BTCUSDT");
+    ASSERT_EQ(orders.size(), 1);
+    ASSERT_EQ(orders[0].emsId, 99);
+    ASSERT_EQ(orders[0].symbolName(), "BTCUSDT");
+    std::vector<Trade> trades = replay.getTradesFrom("BTCUSDT", -1, 10);
+    ASSERT_EQ(trades.size(), 1);
+    ASSERT_EQ(trades[0].getTime(), 1700000000000);
+    ASSERT_FALSE(replay.isFinished());
+
+    // the order created by the strategy is acknowledged as it was recorded
+    OrderHandle handle = oms.createOrder(LIMIT, BUY, "BTCUSDT", 1, 30000);
+    ASSERT_TRUE(handle.waitFor(std::chrono::seconds(5)));
+    ExecutionReport report = handle.get();
+    ASSERT_TRUE(report.acked);
+    ASSERT_EQ(report.emsId, 42);
+    ASSERT_EQ(report.status, PARTIALLY_FILLED);
+    ASSERT_EQ(report.executedQty, 0.5);
+    ASSERT_TRUE(replay.isFinished());
+    // the last price is kept once the recording is over
+    ASSERT_EQ(replay.getPrice("BTCUSDT"), 101);
+    std::remove(path.c_str());
+}
+
+TEST(ExchangeReplayTest, SpeedFollowsTheRecordedClock) {
+    std::string path = recordingPath("speed");
+    {
+        RecordFile file;
+        ASSERT_TRUE(file.open(path));
+        const int64_t t0 = 1700000000000000000;
+        for (int i = 0; i < 3; i++)
+            file.write({t0 + i * 200000000LL, CALL_PRICE, "BTCUSDT", PayloadWriter().put(100.0 + i).data()});
+    }
+    OrderManager oms;
+    auto start = std::chrono::steady_clock::now();
+    ReplayExchangeManager replay(oms, path, 2); // a response every 100 ms
+    ASSERT_EQ(replay.getPrice("BTCUSDT"), 100);
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    // the response due at 200 ms replaces the skipped one
+    ASSERT_EQ(replay.getPrice("BTCUSDT"), 102);
+    ASSERT_TRUE(replay.isFinished());
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(250));
+    std::remove(path.c_str());
+}
+
+TEST(ExchangeReplayTest, OrdersUnlikeTheRecordedOnesAreRejected) {
+    std::string path = recordingPath("mismatch");
+    SimulatedClock clock(5000);
+    {
+        OrderManager oms;
+        LiveExchangeManager live(oms);
+        RecordingExchangeManager recorder(live, path, clock);
+        for (double price: {30000.0, 30001.0}) {
+            Order order(1, LIMIT, BUY, "BTCUSDT", 1, price);
+            recorder.sendOrder(order);
+        }
+    }
+    std::vector<ExchangeRecord> records;
+    ASSERT_TRUE(RecordFile::read(path, records));
+    ASSERT_EQ(records.size(), 2);
+    ASSERT_EQ(records[0].time, 5000);
+
+    OrderManager oms;
+    ReplayExchangeManager replay(oms, path);
+    OrderHandle moved = oms.createOrder(LIMIT, BUY, "BTCUSDT", 1, 29000);
+    ASSERT_TRUE(moved.waitFor(std::chrono::seconds(5)));
+    ASSERT_FALSE(moved.get().acked);
+    ASSERT_EQ(replay.getMismatchedOrders(), 1);
+    OrderHandle same = oms.createOrder(LIMIT, BUY, "BTCUSDT", 1, 30001);
+    ASSERT_TRUE(same.waitFor(std::chrono::seconds(5)));
+    ASSERT_TRUE(same.get().acked);
+    ASSERT_EQ(replay.getMismatchedOrders(), 1);
+    std::remove(path.c_str());
+}
+
+TEST(ExchangeReplayTest, KlineHistoryIsNotSkippedByLaterRefreshes) {
+    std::string path = recordingPath("history");
+    {
+        RecordFile file;
+        ASSERT_TRUE(file.open(path));
+        const int64_t t0 = 1700000000000000000;
+        file.write({t0, CALL_KLINES, klinesRecordKey("BTCUSDT", "1m", 0, 0, 500),
+                    PayloadWriter().put(klinesResponse(500)).data()});
+        for (int i = 1; i < 3; i++)
+            file.write({t0 + i * 100000000LL, CALL_KLINES, klinesRecordKey("BTCUSDT", "1m", 0, 0, 10),
+                        PayloadWriter().put(klinesResponse(i)).data()});
+    }
+    OrderManager oms;
+    ReplayExchangeManager replay(oms, path, 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    Json::Value klines;
+    replay.getKlines(klines, "BTCUSDT", "1m", 0, 0, 500);
+    ASSERT_EQ(klines[0][1].asString(), "500");
+    klines.clear();
+    replay.getKlines(klines, "BTCUSDT", "1m", 0, 0, 10);
+    ASSERT_EQ(klines[0][1].asString(), "2");
+    ASSERT_TRUE(replay.isFinished());
+    std::remove(path.c_str());
+}
+
+TEST(ExchangeReplayTest, CanceledOrdersAreRemovedAsRecorded) {
+    std::string path = recordingPath("cancel");
+    {
+        OrderManager oms;
+        LiveExchangeManager live(oms);
+        RecordingExchangeManager recorder(live, path);
+        Order order(1, LIMIT, BUY, "BTCUSDT", 1, 30000);
+        recorder.sendOrder(order);
+        recorder.cancelOrder(order);
+    }
+    std::vector<ExchangeRecord> records;
+    ASSERT_TRUE(RecordFile::read(path, records));
+    ASSERT_EQ(records.size(), 2);
+    ASSERT_EQ(records[1].call, CALL_CANCEL_ORDER);
+    ASSERT_EQ(records[1].key, "BTCUSDT");
+
+    OrderManager oms;
+    ReplayExchangeManager replay(oms, path);
+    SymbolId btc = stringToSymbol("BTCUSDT");
+    OrderHandle handle = oms.createOrder(LIMIT, BUY, "BTCUSDT", 1, 30000);
+    ASSERT_TRUE(handle.waitFor(std::chrono::seconds(5)));
+    ASSERT_TRUE(handle.get().acked);
+    ASSERT_EQ(oms.getOpenOrders(btc, BUY).size(), 1);
+    ASSERT_TRUE(oms.cancelOrder(handle.id(), btc));
+    for (int i = 0; i < 500 && !oms.getOpenOrders(btc, BUY).empty(); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(oms.getOpenOrders(btc, BUY).empty());
+    ASSERT_TRUE(replay.isFinished());
+    std::remove(path.c_str());
+}
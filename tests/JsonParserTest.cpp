@@ -0,0 +1,68 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "JsonParser.h"
+#include <gtest/gtest.h>
+
+using namespace ats;
+
+TEST(JsonParserTest, ParsesNumbers) {
+    double d;
+    int64_t i;
+    ASSERT_TRUE(parseDouble("27123.45000000", d));
+    ASSERT_DOUBLE_EQ(d, 27123.45);
+    ASSERT_TRUE(parseDouble("1e-8", d));
+    ASSERT_DOUBLE_EQ(d, 1e-8);
+    ASSERT_FALSE(parseDouble("", d));
+    ASSERT_FALSE(parseDouble("12abc", d));
+    ASSERT_TRUE(parseInteger("1499040000000", i));
+    ASSERT_EQ(i, 1499040000000);
+    ASSERT_FALSE(parseInteger("1.5", i));
+
+    ASSERT_DOUBLE_EQ(jsonDouble(Json::Value("0.00100000")), 0.001);
+    ASSERT_DOUBLE_EQ(jsonDouble(Json::Value(1499040000000)), 1499040000000.0);
+    ASSERT_DOUBLE_EQ(jsonDouble(Json::Value()), 0);
+    ASSERT_DOUBLE_EQ(jsonDoubleStrict(Json::Value("5.5")), 5.5);
+    ASSERT_THROW(jsonDoubleStrict(Json::Value()), std::invalid_argument);
+    ASSERT_THROW(jsonDoubleStrict(Json::Value("n/a")), std::invalid_argument);
+}
+
+TEST(JsonParserTest, DecodesDepth) {
+    DepthUpdate update;
+    ASSERT_TRUE(parseDepthUpdate(R"({"e":"depthUpdate","E":123456789,"s":"BNBBTC","U":157,"u":160,
+                                     "b":[["0.0024","10"]],"a":[["0.0026","100"],["0.0027","0"]]})", update));
+    ASSERT_EQ(update.firstUpdateId, 157);
+    ASSERT_EQ(update.finalUpdateId, 160);
+    ASSERT_EQ(update.bids.size(), 1);
+    ASSERT_DOUBLE_EQ(update.bids[0].first, 0.0024);
+    ASSERT_EQ(update.asks.size(), 2);
+    ASSERT_DOUBLE_EQ(update.asks[1].second, 0);
+    ASSERT_TRUE(parseDepthUpdate(R"({"U":161,"u":161,"b":[],"a":[]})", update));
+    ASSERT_TRUE(update.bids.empty() && update.asks.empty());
+    ASSERT_FALSE(parseDepthUpdate(R"({"U":161,"u":161,"b":[["0.1"]],"a":[]})", update));
+}
+
+TEST(JsonParserTest, DecodesEvents) {
+    std::string_view stream, data;
+    ASSERT_TRUE(parseStreamMessage(R"({"stream":"btcusdt@trade","data":{"e":"trade","p":"0.001","T":123456785,"m":true,"M":true}})",
+                                   stream, data));
+    ASSERT_EQ(stream, "btcusdt@trade");
+    double price;
+    int64_t time;
+    ASSERT_TRUE(parseTrade(data, price, time));
+    ASSERT_DOUBLE_EQ(price, 0.001);
+    ASSERT_EQ(time, 123456785);
+    ASSERT_FALSE(parseStreamMessage(R"({"result":null,"id":1})", stream, data));
+
+    std::string_view interval;
+    Kline kline;
+    bool closed = true;
+    ASSERT_TRUE(parseKlineEvent(R"({"e":"kline","s":"BNBBTC","k":{"t":1672515780000,"T":1672515839999,"s":"BNBBTC",
+        "i":"1m","f":100,"L":200,"o":"0.0010","c":"0.0020","h":"0.0025","l":"0.0015","v":"1000","n":100,"x":false,
+        "q":"1.0000","V":"500","Q":"0.500","B":"123456"}})", interval, kline, closed));
+    ASSERT_EQ(interval, "1m");
+    ASSERT_EQ(kline.time, 1672515780);
+    ASSERT_DOUBLE_EQ(kline.high, 0.0025);
+    ASSERT_DOUBLE_EQ(kline.volume, 1000);
+    ASSERT_FALSE(closed);
+}
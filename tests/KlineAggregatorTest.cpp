@@ -0,0 +1,173 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "KlineAggregator.h"
+#include "MarketData.h"
+#include "OrderManager.h"
+#include "StubExchangeManager.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+
+using namespace ats;
+
+namespace {
+    /**
+     * @brief Serves the 1m klines 0..count-1 and their aggregation to longer intervals.
+     * Kline i opens at T0 + 60 * i with open i, high i + 1, low i - 1, close i + 0.5 and volume 1 + i % 3.
+     */
+    class AggregatingExchangeManager : public StubExchangeManager {
+    public:
+        static constexpr time_t T0 = 1699999200; // on an hour
+
+        explicit AggregatingExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        void getKlines(Json::Value &result, std::string, std::string interval, time_t, time_t, int limit) override {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                requests[interval]++;
+            }
+            Interval i;
+            ASSERT_TRUE(stringToInterval(interval, i));
+            std::vector<Kline> bars = klines(i);
+            for (size_t k = bars.size() > size_t(limit) ? bars.size() - limit : 0; k < bars.size(); k++) {
+                Json::Value kline;
+                kline.append(Json::Int64(bars[k].time * 1000));
+                for (double value: {bars[k].open, bars[k].high, bars[k].low, bars[k].close, bars[k].volume})
+                    kline.append(std::to_string(value));
+                result.append(kline);
+            }
+        }
+
+        std::vector<Kline> klines(Interval interval) const {
+            std::vector<Kline> bars;
+            for (int i = 0; i < count; i++) {
+                Kline minute{T0 + 60 * i, double(i), i + 1.0, i - 1.0, i + 0.5, 1.0 + i % 3};
+                time_t open = intervalOpenTime(interval, minute.time);
+                if (bars.empty() || bars.back().time != open) {
+                    minute.time = open;
+                    bars.push_back(minute);
+                    continue;
+                }
+                Kline &bar = bars.back();
+                bar.high = std::max(bar.high, minute.high);
+                bar.low = std::min(bar.low, minute.low);
+                bar.close = minute.close;
+                bar.volume += minute.volume;
+            }
+            return bars;
+        }
+
+        int requestCount(const std::string &interval) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return requests[interval];
+        }
+
+        int count = 0;
+
+    private:
+        std::mutex mMutex;
+        std::map<std::string, int> requests;
+    };
+
+    void expectSameKline(const Kline &actual, const Kline &expected) {
+        EXPECT_EQ(actual.time, expected.time);
+        EXPECT_DOUBLE_EQ(actual.open, expected.open);
+        EXPECT_DOUBLE_EQ(actual.high, expected.high);
+        EXPECT_DOUBLE_EQ(actual.low, expected.low);
+        EXPECT_DOUBLE_EQ(actual.close, expected.close);
+        EXPECT_DOUBLE_EQ(actual.volume, expected.volume);
+    }
+}
+
+TEST(KlineAggregatorTest, AlignsIntervals) {
+    Interval interval;
+    ASSERT_TRUE(stringToInterval("15m", interval));
+    ASSERT_EQ(interval, Interval_15m);
+    ASSERT_EQ(IntervalToString(Interval_1M), "1M");
+    ASSERT_FALSE(stringToInterval("7m", interval));
+    ASSERT_EQ(intervalSeconds(Interval_4h), 4 * 3600);
+
+    // Wednesday 2023-01-04 13:45:10 UTC
+    time_t time = 1672839910;
+    ASSERT_EQ(intervalOpenTime(Interval_15m, time), 1672839900);
+    ASSERT_EQ(intervalOpenTime(Interval_1d, time), 1672790400);
+    ASSERT_EQ(intervalOpenTime(Interval_1w, time), 1672617600); // Monday 2023-01-02
+    ASSERT_EQ(intervalOpenTime(Interval_1M, time), 1672531200); // 2023-01-01
+
+    ASSERT_TRUE(canAggregate(Interval_1m, Interval_3m));
+    ASSERT_FALSE(canAggregate(Interval_3m, Interval_5m));
+    ASSERT_TRUE(canAggregate(Interval_4h, Interval_1w));
+    ASSERT_FALSE(canAggregate(Interval_3d, Interval_1w));
+    ASSERT_TRUE(canAggregate(Interval_1h, Interval_1M));
+    ASSERT_FALSE(canAggregate(Interval_1w, Interval_1M));
+    ASSERT_FALSE(canAggregate(Interval_1h, Interval_1m));
+}
+
+TEST(KlineAggregatorTest, ReplacesTheOpenKline) {
+    KlineAggregator aggregator(Interval_5m);
+    Kline bar;
+    ASSERT_TRUE(aggregator.add({600, 10, 12, 9, 11, 1}, bar));
+    ASSERT_TRUE(aggregator.add({660, 11, 13, 10, 12, 2}, bar));
+    // the open minute is updated twice, its volume is counted once
+    ASSERT_TRUE(aggregator.add({720, 12, 12, 12, 12, 1}, bar));
+    ASSERT_TRUE(aggregator.add({720, 12, 15, 8, 14, 3}, bar));
+    expectSameKline(bar, {600, 10, 15, 8, 14, 6});
+    ASSERT_FALSE(aggregator.add({660, 0, 0, 0, 0, 0}, bar));
+    ASSERT_TRUE(aggregator.add({900, 14, 14, 13, 13, 1}, bar));
+    expectSameKline(bar, {900, 14, 14, 13, 13, 1});
+
+    ASSERT_TRUE(aggregator.isAligned());
+
+    // a period seen from its second minute is incomplete until the next one starts
+    Klines minutes;
+    minutes.push_back(1020, 20, 21, 19, 20, 2);
+    minutes.push_back(1080, 20, 22, 20, 21, 1);
+    KlineAggregator seeded(Interval_5m);
+    seeded.seed(minutes);
+    ASSERT_TRUE(seeded.isSeeded());
+    ASSERT_TRUE(seeded.add({1080, 20, 23, 20, 22, 2}, bar));
+    expectSameKline(bar, {900, 20, 23, 19, 22, 4});
+    ASSERT_FALSE(seeded.isAligned());
+    ASSERT_TRUE(seeded.add({1200, 22, 24, 21, 23, 1}, bar));
+    expectSameKline(bar, {1200, 22, 24, 21, 23, 1});
+    ASSERT_TRUE(seeded.isAligned());
+}
+
+TEST(KlineAggregatorTest, LongerIntervalsAreBuiltFromTheShortestOne) {
+    OrderManager oms;
+    AggregatingExchangeManager ems(oms);
+    ems.count = 90;
+    MarketData md(ems, 1000);
+    md.subscribe("BTCUSDT", Interval_1m);
+    md.subscribe("BTCUSDT", Interval_5m);
+    md.subscribe("BTCUSDT", "1h");
+    md.subscribe("BTCUSDT", Interval_3d); // made of whole minutes too
+    md.refresh();
+    for (const char *interval: {"1m", "5m", "1h", "3d"})
+        ASSERT_EQ(ems.requestCount(interval), 1);
+
+    for (int count: {97, 98, 104, 113, 121}) { // a refresh fetches the last 10 minutes
+        ems.count = count;
+        md.refresh();
+        for (Interval interval: {Interval_5m, Interval_1h, Interval_3d}) {
+            std::vector<Kline> expected = ems.klines(interval);
+            Klines klines = md.getKlines("BTCUSDT", interval);
+            ASSERT_EQ(klines.times.size(), expected.size());
+            for (size_t i = 0; i < expected.size(); i++)
+                expectSameKline(klines.at(i), expected[i]);
+        }
+    }
+    ASSERT_EQ(ems.requestCount("1m"), 6);
+    for (const char *interval: {"5m", "1h"})
+        ASSERT_EQ(ems.requestCount(interval), 1);
+    // the 3d period started before the first minute, it is refreshed until the next one
+    ASSERT_EQ(ems.requestCount("3d"), 6);
+
+    // without the shorter interval, the longer ones are fetched again
+    md.unsubscribe("BTCUSDT");
+    md.subscribe("BTCUSDT", Interval_5m);
+    md.refresh();
+    md.refresh();
+    ASSERT_EQ(ems.requestCount("5m"), 3);
+}
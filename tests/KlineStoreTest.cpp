@@ -0,0 +1,140 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "KlineStore.h"
+#include "MarketData.h"
+#include "OrderManager.h"
+#include "StubExchangeManager.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ats;
+
+static std::string storeDirectory() {
+    std::string directory = "/tmp/ats_klines_" + std::to_string(getpid());
+    mkdir(directory.c_str(), 0755);
+    return directory;
+}
+
+static std::string storePath(const std::string &name) {
+    return storeDirectory() + "/" + name + ".klines";
+}
+
+namespace {
+    /**
+     * @brief Serves 3m klines 0..count-1, kline i opening at T0 + 180 * i, honouring startTime and limit.
+     */
+    class HistoryExchangeManager : public StubExchangeManager {
+    public:
+        static constexpr time_t T0 = 1700000000;
+
+        explicit HistoryExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        void getKlines(Json::Value &result, std::string, std::string, time_t start_date, time_t, int limit) override {
+            klineRequests++;
+            if (start_date)
+                pagedRequests++;
+            int first = start_date ? int((start_date / 1000 - T0) / 180) : std::max(0, count - limit);
+            for (int i = first; i < count && i < first + limit; i++) {
+                Json::Value kline;
+                kline.append(Json::Int64((T0 + 180 * i) * 1000));
+                for (double value: {double(i), i + 1.0, i - 1.0, i + 0.5, 10.0})
+                    kline.append(std::to_string(value));
+                result.append(kline);
+            }
+        }
+
+        int count = 0;
+        std::atomic<int> klineRequests{0};
+        std::atomic<int> pagedRequests{0};
+    };
+}
+
+TEST(KlineStoreTest, AppendsAndPersistsColumns) {
+    std::string path = storePath("columns");
+    std::remove(path.c_str());
+    size_t count = KlineStore::INITIAL_CAPACITY + 100;
+    {
+        KlineStore store;
+        ASSERT_TRUE(store.open(path));
+        ASSERT_EQ(store.size(), 0);
+        ASSERT_EQ(store.lastTime(), 0);
+        for (size_t i = 0; i < count; i++)
+            ASSERT_TRUE(store.append({time_t(60 * i), double(i), i + 1.0, i - 1.0, i + 0.5, 1}));
+        // the open kline is rewritten, older ones are rejected
+        ASSERT_TRUE(store.append({time_t(60 * (count - 1)), 0, 0, 0, 42, 2}));
+        ASSERT_FALSE(store.append({0, 0, 0, 0, 0, 0}));
+        ASSERT_EQ(store.size(), count);
+    }
+    KlineStore store;
+    ASSERT_TRUE(store.open(path));
+    ASSERT_EQ(store.size(), count);
+    ASSERT_EQ(store.times()[4000], 240000);
+    ASSERT_DOUBLE_EQ(store.highs()[4000], 4001);
+    ASSERT_DOUBLE_EQ(store.closes()[count - 1], 42);
+    ASSERT_EQ(store.at(count - 1).volume, 2);
+    ASSERT_EQ(store.lowerBound(61), 2);
+    ASSERT_EQ(store.lowerBound(0), 0);
+    ASSERT_EQ(store.lowerBound(time_t(60 * count)), count);
+    Klines klines = store.read(count - 3, 10);
+    ASSERT_EQ(klines.times.size(), 3);
+    ASSERT_DOUBLE_EQ(klines.opens[0], double(count - 3));
+    store.close();
+    std::remove(path.c_str());
+
+    FILE *file = fopen(path.c_str(), "w");
+    fputs("not a kline store, but longer than a header.....................................", file);
+    fclose(file);
+    ASSERT_FALSE(store.open(path));
+    std::remove(path.c_str());
+    rmdir(storeDirectory().c_str());
+}
+
+TEST(KlineStoreTest, RestartFillsOnlyTheGap) {
+    std::string path = storeDirectory() + "/BTCUSDT_3m.klines";
+    std::remove(path.c_str());
+    OrderManager oms;
+    HistoryExchangeManager ems(oms);
+    ems.count = 700;
+    {
+        MarketData md(ems, 1000);
+        ASSERT_TRUE(md.openKlineStore(storeDirectory()));
+        md.subscribe("BTCUSDT");
+        md.refresh();
+        ASSERT_EQ(md.getKlines("BTCUSDT", "3m").times.size(), 500);
+    }
+
+    // 2500 klines opened while stopped
+    ems.count = 3200;
+    ems.klineRequests = 0;
+    MarketData md(ems, 1000);
+    ASSERT_TRUE(md.openKlineStore(storeDirectory()));
+    md.subscribe("BTCUSDT");
+    Klines loaded = md.getKlines("BTCUSDT", "3m");
+    ASSERT_EQ(loaded.times.size(), 500);
+    ASSERT_EQ(loaded.times.back(), HistoryExchangeManager::T0 + 180 * 699);
+    ASSERT_EQ(ems.klineRequests, 0);
+
+    md.refresh();
+    // pages of 1000 from the last stored kline: 699..1698, 1698..2697, 2697..3199
+    ASSERT_EQ(ems.pagedRequests, 3);
+    Klines history = md.getKlineHistory("BTCUSDT", "3m", 0, HistoryExchangeManager::T0 + 180 * 3200);
+    ASSERT_EQ(history.times.size(), 3000);
+    for (size_t i = 1; i < history.times.size(); i++)
+        ASSERT_EQ(history.times[i] - history.times[i - 1], 180);
+    ASSERT_DOUBLE_EQ(history.opens.back(), 3199);
+    Klines recent = md.getKlines("BTCUSDT", "3m");
+    ASSERT_LE(recent.times.size(), 1000);
+    ASSERT_EQ(recent.times.back(), HistoryExchangeManager::T0 + 180 * 3199);
+
+    ems.klineRequests = 0;
+    md.refresh();
+    ASSERT_EQ(ems.klineRequests, 1);
+    ASSERT_EQ(ems.pagedRequests, 3);
+    md.closeKlineStore();
+    std::remove(path.c_str());
+    rmdir(storeDirectory().c_str());
+}
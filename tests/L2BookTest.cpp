@@ -0,0 +1,71 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "L2Book.h"
+#include <gtest/gtest.h>
+
+using namespace ats;
+
+static OrderBook makeSnapshot(uint64_t lastUpdateId) {
+    OrderBook snapshot({100, 99, 98}, {1, 2, 3}, {101, 102}, {1, 2});
+    snapshot.lastUpdateId = lastUpdateId;
+    return snapshot;
+}
+
+static DepthUpdate makeUpdate(uint64_t first, uint64_t last, std::vector<std::pair<double, double>> bids,
+                              std::vector<std::pair<double, double>> asks = {}) {
+    return {first, last, std::move(bids), std::move(asks)};
+}
+
+TEST(L2BookTest, AppliesDiffsOnTopOfTheSnapshot) {
+    L2Book book;
+    ASSERT_TRUE(book.applySnapshot(makeSnapshot(10)));
+    ASSERT_EQ(book.applyUpdate(makeUpdate(5, 10, {{100, 5}})), DEPTH_STALE);
+    ASSERT_EQ(book.applyUpdate(makeUpdate(9, 12, {{100, 0}, {99.5, 4}}, {{101, 3}})), DEPTH_APPLIED);
+    ASSERT_EQ(book.applyUpdate(makeUpdate(13, 13, {}, {{100.5, 1}})), DEPTH_APPLIED);
+    ASSERT_EQ(book.getLastUpdateId(), 13);
+
+    OrderBook view = book.getOrderBook();
+    ASSERT_EQ(view.bid, (std::vector<double>{99.5, 99, 98}));
+    ASSERT_EQ(view.bidVol, (std::vector<double>{4, 2, 3}));
+    ASSERT_EQ(view.ask, (std::vector<double>{100.5, 101, 102}));
+    ASSERT_EQ(view.askVol, (std::vector<double>{1, 3, 2}));
+    ASSERT_EQ(view.lastUpdateId, 13);
+    OrderBook top = book.getOrderBook(1);
+    ASSERT_EQ(top.bid.size(), 1);
+    ASSERT_EQ(top.ask.size(), 1);
+}
+
+TEST(L2BookTest, BuffersDiffsUntilTheSnapshot) {
+    L2Book book;
+    ASSERT_FALSE(book.isSynced());
+    ASSERT_EQ(book.applyUpdate(makeUpdate(8, 9, {{100, 7}})), DEPTH_BUFFERED);
+    ASSERT_EQ(book.applyUpdate(makeUpdate(10, 11, {{97, 1}})), DEPTH_BUFFERED);
+    ASSERT_EQ(book.applyUpdate(makeUpdate(12, 12, {{100, 0}})), DEPTH_BUFFERED);
+    ASSERT_TRUE(book.applySnapshot(makeSnapshot(10)));
+    ASSERT_TRUE(book.isSynced());
+    ASSERT_EQ(book.getLastUpdateId(), 12);
+    ASSERT_EQ(book.getOrderBook().bid, (std::vector<double>{99, 98, 97}));
+}
+
+TEST(L2BookTest, GapsRequireANewSnapshot) {
+    L2Book book;
+    book.applySnapshot(makeSnapshot(10));
+    ASSERT_EQ(book.applyUpdate(makeUpdate(13, 14, {{100, 9}})), DEPTH_GAP);
+    ASSERT_FALSE(book.isSynced());
+    ASSERT_EQ(book.applyUpdate(makeUpdate(15, 15, {{99, 8}})), DEPTH_BUFFERED);
+
+    // still older than the buffered diffs
+    ASSERT_FALSE(book.applySnapshot(makeSnapshot(11)));
+    ASSERT_EQ(book.applyUpdate(makeUpdate(16, 16, {{98, 0}})), DEPTH_BUFFERED);
+
+    ASSERT_TRUE(book.applySnapshot(makeSnapshot(14)));
+    ASSERT_EQ(book.getLastUpdateId(), 16);
+    OrderBook view = book.getOrderBook();
+    ASSERT_EQ(view.bid, (std::vector<double>{100, 99}));
+    ASSERT_EQ(view.bidVol, (std::vector<double>{1, 8}));
+
+    book.reset();
+    ASSERT_FALSE(book.isSynced());
+    ASSERT_TRUE(book.getOrderBook().bid.empty());
+}
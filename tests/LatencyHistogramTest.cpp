@@ -0,0 +1,50 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "LatencyHistogram.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace ats;
+
+TEST(LatencyHistogramTest, BucketsBoundTheRelativeError) {
+    for (uint64_t value: {0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 1000ULL, 123456789ULL, 1ULL << 40}) {
+        int bucket = LatencyHistogram::bucketFor(value);
+        ASSERT_LT(bucket, LatencyHistogram::BUCKETS);
+        int64_t upper = LatencyHistogram::bucketUpperBound(bucket);
+        ASSERT_GE(upper, int64_t(value));
+        ASSERT_LE(double(upper - int64_t(value)), double(value) / LatencyHistogram::SUB_BUCKETS);
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesAndStats) {
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.getStats().count, 0);
+    for (int64_t i = 1; i <= 10000; i++)
+        histogram.record(i * 1000);
+    LatencyStats stats = histogram.getStats();
+    ASSERT_EQ(stats.count, 10000);
+    ASSERT_EQ(stats.min, 1000);
+    ASSERT_EQ(stats.max, 10000000);
+    ASSERT_NEAR(stats.mean, 5000500, 1);
+    ASSERT_NEAR(double(stats.p50), 5e6, 5e6 / LatencyHistogram::SUB_BUCKETS);
+    ASSERT_NEAR(double(stats.p99), 9.9e6, 9.9e6 / LatencyHistogram::SUB_BUCKETS);
+    ASSERT_LE(stats.p999, stats.max);
+    histogram.reset();
+    ASSERT_EQ(histogram.getStats().count, 0);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecording) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([&histogram]() {
+            for (int i = 0; i < 10000; i++)
+                histogram.record(i);
+        });
+    for (auto &thread: threads)
+        thread.join();
+    ASSERT_EQ(histogram.getStats().count, 40000);
+    ASSERT_EQ(histogram.getStats().max, 9999);
+}
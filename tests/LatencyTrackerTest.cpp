@@ -0,0 +1,55 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "LatencyTracker.h"
+#include "OrderManager.h"
+#include <gtest/gtest.h>
+
+using namespace ats;
+
+TEST(LatencyTrackerTest, RecordsStagesOnAck) {
+    LatencyTracker tracker;
+    Order order(42, LIMIT, BUY, "BTCUSDT", 1, 100);
+    tracker.mark(order, HOP_CREATED);
+    tracker.mark(order, HOP_PROCESSING);
+    tracker.mark(order, HOP_EMS_QUEUED);
+    tracker.mark(order, HOP_SENDING);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    ASSERT_EQ(tracker.getStats(STAGE_TOTAL).count, 0);
+    tracker.mark(order, HOP_ACKED);
+    for (int stage = 0; stage < LSCOUNT; stage++)
+        ASSERT_EQ(tracker.getStats(LatencyStage(stage)).count, 1);
+    ASSERT_GE(tracker.getStats(STAGE_EXCHANGE).min, 2000000);
+    ASSERT_GE(tracker.getStats(STAGE_TOTAL).max, tracker.getStats(STAGE_EXCHANGE).max);
+    ASSERT_EQ(tracker.getStats(STAGE_TOTAL, order.symbol).count, 1);
+    ASSERT_EQ(tracker.getStats(STAGE_TOTAL, stringToSymbol("ETHUSDT")).count, 0);
+
+    // Acking twice or acking an order that was never created records nothing
+    tracker.mark(order, HOP_ACKED);
+    tracker.mark(Order(43, LIMIT, BUY, "BTCUSDT", 1, 100), HOP_ACKED);
+    ASSERT_EQ(tracker.getStats(STAGE_TOTAL).count, 1);
+    ASSERT_NE(tracker.dump().find("BTCUSDT"), std::string::npos);
+    tracker.reset();
+    ASSERT_EQ(tracker.getStats(STAGE_TOTAL, order.symbol).count, 0);
+}
+
+TEST(LatencyTrackerTest, OrderManagerTimestampsEveryHop) {
+    OrderManager orderManager;
+    std::atomic<int> dumps{0};
+    orderManager.getLatencyTracker().startDump(std::chrono::milliseconds(5),
+                                               [&dumps](const std::string &) { dumps++; });
+    orderManager.createOrder(LIMIT, BUY, "BTCUSDT", 1, 100);
+    for (int i = 0; i < 500 && !orderManager.hasOrders(); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    Order order = orderManager.getOldestOrder();
+    ExecutionReport report;
+    report.acked = true;
+    orderManager.reportExecution(order, report);
+    LatencyTracker &tracker = orderManager.getLatencyTracker();
+    for (int stage = 0; stage < LSCOUNT; stage++)
+        ASSERT_EQ(tracker.getStats(LatencyStage(stage), order.symbol).count, 1) << LatencyStageToString(LatencyStage(stage));
+    for (int i = 0; i < 500 && !dumps; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    tracker.stopDump();
+    ASSERT_GT(dumps, 0);
+}
@@ -0,0 +1,76 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "LockFreeQueue.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(LockFreeQueueTest, SPSCFifoAndBackPressure) {
+    ats::SPSCQueue<int> queue(3);
+    ASSERT_EQ(queue.capacity(), 4);
+    ASSERT_TRUE(queue.empty());
+    for (int i = 0; i < 4; i++)
+        ASSERT_TRUE(queue.tryPush(i));
+    ASSERT_FALSE(queue.tryPush(4));
+    ASSERT_EQ(queue.size(), 4);
+    int value;
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.tryPop(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(queue.tryPop(value));
+}
+
+TEST(LockFreeQueueTest, SPSCAcrossThreads) {
+    ats::SPSCQueue<long> queue(64);
+    const long n = 10000;
+    std::thread producer([&]() {
+        for (long i = 0; i < n; i++)
+            while (!queue.tryPush(i))
+                std::this_thread::yield();
+    });
+    long value, expected = 0;
+    while (expected < n) {
+        if (queue.tryPop(value)) {
+            ASSERT_EQ(value, expected++);
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(LockFreeQueueTest, MPSCBackPressure) {
+    ats::MPSCQueue<std::string> queue(2);
+    ASSERT_TRUE(queue.tryPush("a"));
+    ASSERT_TRUE(queue.tryPush("b"));
+    ASSERT_FALSE(queue.tryPush("c"));
+    std::string value;
+    ASSERT_TRUE(queue.tryPop(value));
+    ASSERT_EQ(value, "a");
+    ASSERT_TRUE(queue.tryPush("c"));
+    ASSERT_EQ(queue.size(), 2);
+}
+
+TEST(LockFreeQueueTest, MPSCKeepsPerProducerOrder) {
+    const int producers = 4, perProducer = 5000;
+    ats::MPSCQueue<std::pair<int, int>> queue(256);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < perProducer; i++)
+                while (!queue.tryPush({p, i}))
+                    std::this_thread::yield();
+        });
+    std::vector<int> next(producers, 0);
+    std::pair<int, int> value;
+    int received = 0;
+    while (received < producers * perProducer)
+        if (queue.tryPop(value)) {
+            ASSERT_EQ(value.second, next[value.first]++);
+            received++;
+        }
+    for (auto &t: threads)
+        t.join();
+    ASSERT_TRUE(queue.empty());
+}
@@ -0,0 +1,268 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "MarketData.h"
+#include "OrderManager.h"
+#include "StubExchangeManager.h"
+
+using namespace ats;
+
+namespace {
+    class SlowExchangeManager : public StubExchangeManager {
+    public:
+        explicit SlowExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        std::map<std::string, double> getBalances() override {
+            balanceRequests++;
+            return {{"USDT", 100}};
+        }
+
+        void getKlines(Json::Value &result, std::string, std::string, time_t, time_t, int) override {
+            request();
+            Json::Value kline;
+            for (const char *field: {"1700000000000", "1", "2", "0.5", "1.5", "10"})
+                kline.append(field);
+            result.append(kline);
+        }
+
+        double getPrice(std::string) override {
+            request();
+            return 1;
+        }
+
+        std::map<std::string, double> getPrices(const std::vector<std::string> &symbols) override {
+            request();
+            priceRequests++;
+            std::map<std::string, double> prices;
+            for (const std::string &symbol: symbols)
+                prices[symbol] = 100 + symbol.size();
+            return prices;
+        }
+
+        OrderBook getOrderBook(std::string symbol) override {
+            request();
+            OrderBook book({99}, {1}, {101}, {2});
+            std::lock_guard<std::mutex> lock(mMutex);
+            int count = ++books[symbol];
+            // the hot book changes on every request, the others never do
+            book.lastUpdateId = symbol == hot ? count : 1;
+            return book;
+        }
+
+        int bookRequests(const std::string &symbol) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return books[symbol];
+        }
+
+        std::string hot;
+        std::map<std::string, int> books;
+        std::atomic<int> balanceRequests{0};
+        std::atomic<int> priceRequests{0};
+        std::atomic<int> requests{0};
+        std::atomic<int> peak{0};
+
+    private:
+        std::mutex mMutex;
+        std::atomic<int> mInFlight{0};
+
+        void request() {
+            requests++;
+            int now = ++mInFlight;
+            int seen = peak;
+            while (now > seen && !peak.compare_exchange_weak(seen, now));
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            mInFlight--;
+        }
+    };
+
+    /**
+     * @brief Answers the depth of one symbol with a payload that fails to decode.
+     */
+    class MalformedBookExchangeManager : public StubExchangeManager {
+    public:
+        explicit MalformedBookExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        OrderBook getOrderBook(std::string symbol) override {
+            if (symbol == "BADUSDT")
+                throw std::invalid_argument("jsonDoubleStrict");
+            OrderBook book({99}, {1}, {101}, {2});
+            book.lastUpdateId = 1;
+            return book;
+        }
+    };
+
+    /**
+     * @brief Answers klines whose last one changes on every request, a new one opening when asked.
+     */
+    class OpenKlineExchangeManager : public StubExchangeManager {
+    public:
+        explicit OpenKlineExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        void getKlines(Json::Value &result, std::string, std::string, time_t, time_t, int) override {
+            requests++;
+            for (int i = 0; i < count; i++) {
+                Json::Value kline;
+                kline.append(std::to_string((1700000000 + 180 * int64_t(i)) * 1000));
+                for (int field = 0; field < 4; field++)
+                    kline.append(std::to_string(i + 1 == count ? requests.load() : 1));
+                kline.append("10");
+                result.append(kline);
+            }
+        }
+
+        std::atomic<int> count{3};
+        std::atomic<int> requests{0};
+    };
+}
+
+TEST(MarketDataRefreshTest, FetchesPricesInOneRequestAndTheRestConcurrently) {
+    OrderManager oms;
+    SlowExchangeManager ems(oms);
+    std::vector<std::string> symbols;
+    for (int i = 0; i < 20; i++)
+        symbols.push_back("SYM" + std::to_string(i) + "USDT");
+    MarketData md(symbols, ems, 1000);
+    md.stop();
+    md.setFetchParallelism(4);
+    ASSERT_EQ(md.getFetchParallelism(), 4);
+    ems.requests = 0;
+    ems.priceRequests = 0;
+    ems.peak = 0;
+
+    md.refresh();
+    ASSERT_EQ(ems.priceRequests, 1);
+    // one price request, then a kline and a depth request per symbol
+    ASSERT_EQ(ems.requests, 1 + 2 * 20);
+    ASSERT_EQ(ems.peak, 4);
+    ASSERT_DOUBLE_EQ(md.getPrice("SYM7USDT"), 108);
+    ASSERT_EQ(md.getKlines("SYM7USDT", "3m").times.size(), 1);
+    ASSERT_EQ(md.getOrderBook("SYM7USDT").bid, std::vector<double>{99});
+
+    md.setFetchParallelism(1);
+    ems.peak = 0;
+    md.refresh();
+    ASSERT_EQ(ems.peak, 1);
+}
+
+TEST(MarketDataRefreshTest, SchedulesEachStreamAndBacksOffWhenIdle) {
+    OrderManager oms;
+    SlowExchangeManager ems(oms);
+    ems.hot = "HOTUSDT";
+    MarketData md(ems, 1000);
+    md.subscribe("HOTUSDT");
+    md.subscribe("IDLEUSDT");
+    md.setRefreshSchedule(REFRESH_BOOK, {20, 3});
+    md.setRefreshSchedule("HOTUSDT", REFRESH_BOOK, {10, 4});
+    ASSERT_EQ(md.getRefreshPeriod("HOTUSDT", REFRESH_BOOK), 10);
+    ASSERT_EQ(md.getRefreshPeriod("IDLEUSDT", REFRESH_BOOK), 20);
+    ASSERT_EQ(md.getRefreshPeriod("IDLEUSDT", REFRESH_PRICE), 1000000);
+    ASSERT_EQ(md.getRefreshPeriod("", REFRESH_BALANCES), 30000);
+    ASSERT_EQ(md.getRefreshPeriod("OTHERUSDT", REFRESH_BOOK), -1);
+    md.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    md.stop();
+
+    // the idle book is refreshed less and less often, the hot one keeps its period
+    ASSERT_EQ(md.getRefreshPeriod("IDLEUSDT", REFRESH_BOOK), 20 * 16);
+    ASSERT_EQ(md.getRefreshPeriod("HOTUSDT", REFRESH_BOOK), 10);
+    ASSERT_GT(ems.bookRequests("HOTUSDT"), 3 * ems.bookRequests("IDLEUSDT"));
+    ASSERT_LE(ems.bookRequests("IDLEUSDT"), 8);
+    ASSERT_EQ(ems.priceRequests, 1);
+    ASSERT_EQ(ems.balanceRequests, 1);
+    ASSERT_DOUBLE_EQ(md.getBalances()["USDT"], 100);
+
+    md.unsubscribe("IDLEUSDT");
+    ASSERT_EQ(md.getRefreshPeriod("IDLEUSDT", REFRESH_BOOK), -1);
+}
+
+TEST(MarketDataRefreshTest, SleepsUntilTheNextRefresh) {
+    OrderManager oms;
+    SlowExchangeManager ems(oms);
+    MarketData md(ems, 1000);
+    md.subscribe("BTCUSDT");
+    md.start();
+    ASSERT_TRUE(md.isRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    int requests = ems.requests;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(ems.requests, requests);
+    // a new subscription wakes the thread up
+    md.subscribe("ETHUSDT");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(ems.requests, requests + 3);
+    auto start = std::chrono::steady_clock::now();
+    md.stop();
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+}
+
+TEST(MarketDataRefreshTest, RefreshesOnASimulatedClock) {
+    OrderManager oms;
+    SlowExchangeManager ems(oms);
+    ems.hot = "BTCUSDT";
+    SimulatedClock clock(NANOS_PER_SECOND);
+    MarketData md(ems, 1000, "", clock);
+    ASSERT_EQ(&md.getClock(), &clock);
+    md.setRefreshSchedule(REFRESH_BOOK, {100, 3});
+    md.subscribe("BTCUSDT");
+    md.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    int books = ems.bookRequests("BTCUSDT");
+    ASSERT_GE(books, 1);
+    // the refreshes wait for the simulated time, however long the real one
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(ems.bookRequests("BTCUSDT"), books);
+    for (int i = 1; i <= 3; i++) {
+        clock.advance(100 * NANOS_PER_MILLI);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        ASSERT_EQ(ems.bookRequests("BTCUSDT"), books + i);
+    }
+    md.stop();
+}
+
+TEST(MarketDataRefreshTest, AFailedFetchOnlySkipsItsSymbol) {
+    OrderManager oms;
+    MalformedBookExchangeManager ems(oms);
+    MarketData md({"BADUSDT", "GOODUSDT", "FINEUSDT"}, ems, 1000);
+    md.stop();
+    md.setFetchParallelism(3);
+    md.refresh();
+    ASSERT_TRUE(md.getOrderBook("BADUSDT").bid.empty());
+    ASSERT_EQ(md.getOrderBook("GOODUSDT").bid, std::vector<double>{99});
+    ASSERT_EQ(md.getOrderBook("FINEUSDT").bid, std::vector<double>{99});
+}
+
+TEST(MarketDataRefreshTest, KlineUpdatesShareTheClosedKlines) {
+    OrderManager oms;
+    OpenKlineExchangeManager ems(oms);
+    MarketData md({"BTCUSDT"}, ems, 1000);
+    md.stop();
+    md.refresh();
+    std::shared_ptr<const KlinesSnapshot> first = md.getKlinesSnapshot("BTCUSDT", "3m");
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(first->size(), 3);
+
+    md.refresh();
+    std::shared_ptr<const KlinesSnapshot> updated = md.getKlinesSnapshot("BTCUSDT", "3m");
+    ASSERT_NE(updated, first);
+    ASSERT_EQ(updated->closed, first->closed);
+    ASSERT_DOUBLE_EQ(updated->last.close, ems.requests);
+    ASSERT_DOUBLE_EQ(md.getKlines("BTCUSDT", "3m").closes.back(), ems.requests);
+
+    ems.count = 4;
+    md.refresh();
+    std::shared_ptr<const KlinesSnapshot> opened = md.getKlinesSnapshot("BTCUSDT", "3m");
+    ASSERT_NE(opened->closed, updated->closed);
+    ASSERT_EQ(opened->size(), 4);
+    ASSERT_EQ(opened->closed->times.size(), 3);
+    ASSERT_DOUBLE_EQ(opened->at(2).close, 1);
+    Klines klines = md.getKlines("BTCUSDT", "3m");
+    ASSERT_EQ(klines.times.size(), 4);
+    ASSERT_EQ(klines.times.back(), 1700000000 + 180 * 3);
+    ASSERT_DOUBLE_EQ(klines.closes.back(), ems.requests);
+}
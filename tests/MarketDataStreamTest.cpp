@@ -0,0 +1,431 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include "MarketData.h"
+#include "StubExchangeManager.h"
+#include "WebSocketClient.h"
+
+using namespace ats;
+
+namespace {
+    /**
+     * Single-connection WebSocket server on the loopback interface.
+     */
+    class TestServer {
+    public:
+        int listener{-1};
+        int client{-1};
+        int port{0};
+
+        TestServer() {
+            listener = socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            bind(listener, (sockaddr *) &addr, sizeof(addr));
+            listen(listener, 1);
+            socklen_t len = sizeof(addr);
+            getsockname(listener, (sockaddr *) &addr, &len);
+            port = ntohs(addr.sin_port);
+        }
+
+        ~TestServer() {
+            if (client >= 0)
+                ::close(client);
+            ::close(listener);
+        }
+
+        std::string url() const {
+            return "ws://127.0.0.1:" + std::to_string(port);
+        }
+
+        bool accept() {
+            client = ::accept(listener, nullptr, nullptr);
+            std::string request;
+            char c;
+            while (request.find("\r\n\r\n") == std::string::npos && ::recv(client, &c, 1, 0) == 1)
+                request += c;
+            size_t pos = request.find("Sec-WebSocket-Key: ");
+            if (pos == std::string::npos)
+                return false;
+            pos += 19;
+            std::string key = request.substr(pos, request.find("\r\n", pos) - pos);
+            std::string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                   "Sec-WebSocket-Accept: " + WebSocketClient::acceptKey(key) + "\r\n\r\n";
+            return ::send(client, response.data(), response.size(), 0) == ssize_t(response.size());
+        }
+
+        void sendFrame(const std::string &payload, uint8_t opcode = 0x1, bool fin = true) {
+            std::string frame;
+            frame += char((fin ? 0x80 : 0) | opcode);
+            if (payload.size() < 126)
+                frame += char(payload.size());
+            else {
+                frame += char(126);
+                frame += char(payload.size() >> 8);
+                frame += char(payload.size() & 0xff);
+            }
+            frame += payload;
+            ::send(client, frame.data(), frame.size(), 0);
+        }
+
+        bool receiveFrame(std::string &payload, uint8_t &opcode) {
+            uint8_t header[2];
+            if (!readAll(header, 2))
+                return false;
+            opcode = header[0] & 0x0f;
+            uint64_t length = header[1] & 0x7f;
+            if (length == 126) {
+                uint8_t ext[2];
+                if (!readAll(ext, 2))
+                    return false;
+                length = (ext[0] << 8) | ext[1];
+            }
+            uint8_t mask[4];
+            if (!(header[1] & 0x80) || !readAll(mask, 4))
+                return false;
+            payload.resize(length);
+            if (!readAll((uint8_t *) payload.data(), length))
+                return false;
+            for (size_t i = 0; i < length; i++)
+                payload[i] ^= char(mask[i % 4]);
+            return true;
+        }
+
+    private:
+        bool readAll(uint8_t *data, size_t size) {
+            while (size) {
+                ssize_t n = ::recv(client, data, size, 0);
+                if (n <= 0)
+                    return false;
+                data += n;
+                size -= n;
+            }
+            return true;
+        }
+    };
+
+    class MockExchangeManager : public StubExchangeManager {
+    public:
+        explicit MockExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        OrderBook getOrderBook(std::string) override {
+            OrderBook book({41999, 41998}, {1.5, 2}, {42001}, {0.5});
+            book.lastUpdateId = 100;
+            snapshots++;
+            return book;
+        }
+
+        std::atomic<int> snapshots{0};
+    };
+
+    template<typename F>
+    bool waitUntil(F f) {
+        for (int i = 0; i < 300 && !f(); i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return f();
+    }
+
+    /**
+     * @brief Serves 3m klines 0..count-1, kline i opening at T0 + 180 * i, holding the pages from a start time
+     * until they are released.
+     */
+    class HistoryExchangeManager : public StubExchangeManager {
+    public:
+        static constexpr time_t T0 = 1700000000;
+
+        explicit HistoryExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        void getKlines(Json::Value &result, std::string, std::string, time_t start_date, time_t, int limit) override {
+            if (start_date)
+                waitUntil([&]() { return bool(pagesReleased); });
+            int first = start_date ? int((start_date / 1000 - T0) / 180) : std::max(0, count - limit);
+            for (int i = first; i < count && i < first + limit; i++) {
+                Json::Value kline;
+                kline.append(Json::Int64((T0 + 180 * i) * 1000));
+                for (double value: {double(i), i + 1.0, i - 1.0, i + 0.5, 10.0})
+                    kline.append(std::to_string(value));
+                result.append(kline);
+            }
+        }
+
+        std::atomic<int> count{0};
+        std::atomic<bool> pagesReleased{true};
+    };
+
+    /**
+     * @brief Serves the 1m klines of the second half of an hour, and that hour with a settable close.
+     */
+    class HalfHourExchangeManager : public StubExchangeManager {
+    public:
+        static constexpr time_t T0 = 1699999200; // on an hour
+
+        explicit HalfHourExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        void getKlines(Json::Value &result, std::string, std::string interval, time_t, time_t, int) override {
+            for (int i = 30; i < 60; i++) {
+                Json::Value kline;
+                kline.append(Json::Int64((interval == "1m" ? T0 + 60 * i : T0) * 1000));
+                for (double value: {double(i), i + 1.0, i - 1.0, interval == "1m" ? i + 0.5 : hourClose.load(), 1.0})
+                    kline.append(std::to_string(value));
+                result.append(kline);
+                if (interval != "1m")
+                    break;
+            }
+        }
+
+        std::atomic<double> hourClose{59.5};
+    };
+
+    std::string klineFrame(int i, double close) {
+        return R"({"stream":"btcusdt@kline_3m","data":{"e":"kline","s":"BTCUSDT","k":{"t":)" +
+               std::to_string((HistoryExchangeManager::T0 + 180 * i) * 1000) + R"(,"i":"3m","o":"1","h":"5000",)"
+               R"("l":"0.5","c":")" + std::to_string(close) + R"(","v":"10"}}})";
+    }
+}
+
+TEST(WebSocketClientTest, ExchangesFragmentedMessagesAndAnswersPings) {
+    TestServer server;
+    std::thread serverThread([&]() {
+        ASSERT_TRUE(server.accept());
+        std::string payload;
+        uint8_t opcode;
+        ASSERT_TRUE(server.receiveFrame(payload, opcode));
+        ASSERT_EQ(opcode, 0x1);
+        ASSERT_EQ(payload, "hello");
+        server.sendFrame("hel", 0x1, false);
+        server.sendFrame("ping", 0x9);
+        server.sendFrame("lo world", 0x0, true);
+        ASSERT_TRUE(server.receiveFrame(payload, opcode));
+        ASSERT_EQ(opcode, 0xA);
+        ASSERT_EQ(payload, "ping");
+        server.sendFrame(std::string(300, 'x'));
+    });
+    WebSocketClient client;
+    ASSERT_TRUE(client.connect(server.url()));
+    ASSERT_TRUE(client.send("hello"));
+    std::string message;
+    ASSERT_TRUE(client.receive(message, 2000));
+    ASSERT_EQ(message, "hello world");
+    ASSERT_TRUE(client.receive(message, 2000));
+    ASSERT_EQ(message, std::string(300, 'x'));
+    serverThread.join();
+    client.close();
+    ASSERT_FALSE(client.isConnected());
+}
+
+TEST(WebSocketClientTest, ConnectGivesUpAtTheTimeout) {
+    TestServer server; // accepted by the kernel, never answered
+    WebSocketClient client;
+    for (const std::string &url: {server.url(), "wss://127.0.0.1:" + std::to_string(server.port)}) {
+        auto start = std::chrono::steady_clock::now();
+        ASSERT_FALSE(client.connect(url, 200));
+        ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+        ASSERT_FALSE(client.isConnected());
+    }
+}
+
+TEST(WebSocketClientTest, OversizedFramesCloseTheConnection) {
+    TestServer server;
+    std::thread serverThread([&]() {
+        ASSERT_TRUE(server.accept());
+        // a 64-bit length that would wrap the frame end
+        std::string frame = "\x81\x7f";
+        frame.append(8, '\xff');
+        ::send(server.client, frame.data(), frame.size(), 0);
+        std::string payload;
+        uint8_t opcode;
+        ASSERT_TRUE(server.receiveFrame(payload, opcode));
+        ASSERT_EQ(opcode, 0x8);
+        ASSERT_EQ(payload, std::string("\x03\xf1", 2)); // 1009, message too big
+    });
+    WebSocketClient client;
+    ASSERT_TRUE(client.connect(server.url()));
+    std::string message;
+    ASSERT_FALSE(client.receive(message, 2000));
+    ASSERT_FALSE(client.isConnected());
+    serverThread.join();
+}
+
+TEST(WebSocketClientTest, AcceptKeyMatchesRfcExample) {
+    ASSERT_EQ(WebSocketClient::acceptKey("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST(MarketDataStreamTest, StreamUpdatesPricesBooksAndKlines) {
+    TestServer server;
+    std::string subscription;
+    std::thread serverThread([&]() {
+        ASSERT_TRUE(server.accept());
+        uint8_t opcode;
+        ASSERT_TRUE(server.receiveFrame(subscription, opcode));
+        server.sendFrame(R"({"result":null,"id":1})");
+        server.sendFrame(R"({"stream":"btcusdt@trade","data":{"e":"trade","s":"BTCUSDT","p":"42000.50","q":"0.1","T":1700000000123}})");
+        server.sendFrame(R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","U":95,"u":99,)"
+                         R"("b":[["41990.00","9.0"]],"a":[]}})");
+        server.sendFrame(R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","U":100,"u":102,)"
+                         R"("b":[["42000.00","3.0"],["41999.00","0"]],"a":[["42000.75","0.25"]]}})");
+        server.sendFrame(R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","U":103,"u":104,)"
+                         R"("b":[],"a":[["42001.00","0.75"]]}})");
+        server.sendFrame(R"({"stream":"btcusdt@kline_3m","data":{"e":"kline","s":"BTCUSDT","k":{"t":1700000000000,)"
+                         R"("i":"3m","o":"1","h":"3","l":"0.5","c":"2","v":"10"}}})");
+        server.sendFrame(R"({"stream":"btcusdt@kline_3m","data":{"e":"kline","s":"BTCUSDT","k":{"t":1700000000000,)"
+                         R"("i":"3m","o":"1","h":"4","l":"0.5","c":"3.5","v":"12"}}})");
+        // keep the connection open until the client is done
+        std::string payload;
+        server.receiveFrame(payload, opcode);
+    });
+    OrderManager oms;
+    MockExchangeManager ems(oms);
+    MarketData md({"BTCUSDT"}, ems, 1, server.url());
+    ASSERT_TRUE(waitUntil([&]() { return md.getPrice("BTCUSDT") == 42000.5; }));
+    ASSERT_TRUE(waitUntil([&]() { return md.getKlines("BTCUSDT", "3m").closes == std::vector<double>{3.5}; }));
+    ASSERT_TRUE(md.isStreaming());
+    ASSERT_TRUE(md.readPrices("BTCUSDT", 1, [](const PriceWindow &window) {
+        ASSERT_EQ(window.size, 1);
+        ASSERT_DOUBLE_EQ(window.back(), 42000.5);
+        ASSERT_EQ(window.time(0), 1700000000123);
+    }));
+    ASSERT_NE(subscription.find("\"SUBSCRIBE\""), std::string::npos);
+    ASSERT_NE(subscription.find("btcusdt@trade"), std::string::npos);
+    ASSERT_NE(subscription.find("btcusdt@kline_3m"), std::string::npos);
+    ASSERT_NE(subscription.find("btcusdt@depth@100ms"), std::string::npos);
+
+    ASSERT_TRUE(waitUntil([&]() { return md.getOrderBook("BTCUSDT").lastUpdateId == 104; }));
+    OrderBook book = md.getOrderBook("BTCUSDT");
+    ASSERT_EQ(book.bid.size(), 2);
+    ASSERT_DOUBLE_EQ(book.bid[0], 42000);
+    ASSERT_DOUBLE_EQ(book.bidVol[0], 3);
+    ASSERT_DOUBLE_EQ(book.bid[1], 41998);
+    ASSERT_EQ(book.ask.size(), 2);
+    ASSERT_DOUBLE_EQ(book.ask[0], 42000.75);
+    ASSERT_DOUBLE_EQ(book.askVol[0], 0.25);
+    ASSERT_DOUBLE_EQ(book.askVol[1], 0.75);
+    ASSERT_EQ(ems.snapshots, 1);
+    std::shared_ptr<const OrderBook> shared = md.getOrderBookSnapshot("BTCUSDT");
+    ASSERT_EQ(shared, md.getOrderBookSnapshot("BTCUSDT"));
+    ASSERT_EQ(shared->bid, book.bid);
+    BBO bbo;
+    ASSERT_TRUE(md.getBBO("BTCUSDT", bbo));
+    ASSERT_DOUBLE_EQ(bbo.bidPrice, 42000);
+    ASSERT_DOUBLE_EQ(bbo.bidQty, 3);
+    ASSERT_DOUBLE_EQ(bbo.askPrice, 42000.75);
+    ASSERT_DOUBLE_EQ(bbo.askQty, 0.25);
+    ASSERT_EQ(bbo.updateId, 104);
+    ASSERT_GT(bbo.time, 0);
+    ASSERT_FALSE(md.getBBO("ETHUSDT", bbo));
+    size_t symbols = symbolCount();
+    ASSERT_FALSE(md.getBBO("NEVERSEENUSDT", bbo));
+    ASSERT_EQ(symbolCount(), symbols);
+    ASSERT_EQ(findSymbol("NEVERSEENUSDT"), NO_SYMBOL);
+
+    Klines klines = md.getKlines("BTCUSDT", "3m");
+    ASSERT_EQ(klines.times.size(), 1);
+    ASSERT_EQ(klines.times[0], 1700000000);
+    ASSERT_DOUBLE_EQ(klines.highs[0], 4);
+    ASSERT_DOUBLE_EQ(klines.volumes[0], 12);
+
+    md.stop();
+    serverThread.join();
+}
+
+TEST(MarketDataStreamTest, StoredKlinesAreCompletedWhileStreaming) {
+    std::string directory = "/tmp/ats_stream_klines_" + std::to_string(getpid());
+    mkdir(directory.c_str(), 0755);
+    std::string path = directory + "/BTCUSDT_3m.klines";
+    std::remove(path.c_str());
+    OrderManager oms;
+    HistoryExchangeManager ems(oms);
+    ems.count = 700;
+    {
+        MarketData md(ems, 1000);
+        ASSERT_TRUE(md.openKlineStore(directory));
+        md.subscribe("BTCUSDT", "3m");
+        md.refresh();
+    }
+    // 800 klines opened while stopped
+    ems.count = 1500;
+
+    TestServer server;
+    std::atomic<int> step{0};
+    std::thread serverThread([&]() {
+        ASSERT_TRUE(server.accept());
+        std::string payload;
+        uint8_t opcode;
+        ASSERT_TRUE(server.receiveFrame(payload, opcode));
+        waitUntil([&]() { return step == 1; });
+        server.sendFrame(klineFrame(1499, 4000));
+        server.sendFrame(R"({"stream":"btcusdt@trade","data":{"e":"trade","s":"BTCUSDT","p":"4000","q":"1","T":1}})");
+        waitUntil([&]() { return step == 2; });
+        server.sendFrame(klineFrame(1499, 4242));
+        server.receiveFrame(payload, opcode);
+    });
+    MarketData md(ems, 1, server.url());
+    md.subscribe("BTCUSDT", "3m");
+    md.start();
+    ASSERT_TRUE(waitUntil([&]() { return md.isStreaming(); }));
+    ASSERT_TRUE(waitUntil([&]() { return md.getKlines("BTCUSDT", "3m").times.size() == 500; }));
+
+    // the store is opened while streaming, its gap is only filled once released
+    ems.pagesReleased = false;
+    ASSERT_TRUE(md.openKlineStore(directory));
+    ASSERT_EQ(md.getKlines("BTCUSDT", "3m").times.back(), HistoryExchangeManager::T0 + 180 * 699);
+    step = 1;
+    ASSERT_TRUE(waitUntil([&]() { return md.getPrice("BTCUSDT") == 4000; }));
+    // the current candle is not stored ahead of the gap
+    ASSERT_EQ(md.getKlines("BTCUSDT", "3m").times.back(), HistoryExchangeManager::T0 + 180 * 699);
+
+    ems.pagesReleased = true;
+    ASSERT_TRUE(waitUntil([&]() {
+        return md.getKlines("BTCUSDT", "3m").times.back() == HistoryExchangeManager::T0 + 180 * 1499;
+    }));
+    step = 2;
+    ASSERT_TRUE(waitUntil([&]() { return md.getKlines("BTCUSDT", "3m").closes.back() == 4242; }));
+    Klines history = md.getKlineHistory("BTCUSDT", "3m", 0, HistoryExchangeManager::T0 + 180 * 1500);
+    // the first run stored the 500 klines before 700
+    ASSERT_EQ(history.times.size(), 1300);
+    for (size_t i = 0; i < history.times.size(); i++)
+        ASSERT_EQ(history.times[i], HistoryExchangeManager::T0 + 180 * time_t(200 + i));
+    ASSERT_DOUBLE_EQ(history.closes.back(), 4242);
+
+    md.stop();
+    serverThread.join();
+    std::remove(path.c_str());
+    rmdir(directory.c_str());
+}
+
+TEST(MarketDataStreamTest, UnalignedAggregatesAreRefreshedWhileStreaming) {
+    TestServer server;
+    std::string subscription;
+    std::thread serverThread([&]() {
+        ASSERT_TRUE(server.accept());
+        uint8_t opcode;
+        ASSERT_TRUE(server.receiveFrame(subscription, opcode));
+        std::string payload;
+        server.receiveFrame(payload, opcode);
+    });
+    OrderManager oms;
+    HalfHourExchangeManager ems(oms);
+    MarketData md(ems, 1, server.url());
+    md.subscribe("BTCUSDT", "1m");
+    md.subscribe("BTCUSDT", "1h");
+    md.start();
+    ASSERT_TRUE(waitUntil([&]() { return md.isStreaming() && md.getKlines("BTCUSDT", "1h").times.size() == 1; }));
+    ASSERT_NE(subscription.find("btcusdt@kline_1m"), std::string::npos);
+    ASSERT_EQ(subscription.find("btcusdt@kline_1h"), std::string::npos);
+
+    // the hour was seen from its middle, it cannot be aggregated before the next one
+    ems.hourClose = 77;
+    ASSERT_TRUE(waitUntil([&]() { return md.getKlines("BTCUSDT", "1h").closes.back() == 77; }));
+    md.stop();
+    serverThread.join();
+}
@@ -0,0 +1,238 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "MarketData.h"
+#include "MarketEvents.h"
+#include "OrderManager.h"
+#include "Strategy.h"
+#include "StubExchangeManager.h"
+
+using namespace ats;
+
+namespace {
+    class MockExchangeManager : public StubExchangeManager {
+    public:
+        explicit MockExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        std::map<std::string, double> getBalances() override { return {{"USDT", usdt}}; }
+
+        void getKlines(Json::Value &result, std::string, std::string, time_t, time_t, int) override {
+            for (int i = 0; i < klines; i++) {
+                Json::Value kline;
+                for (double field: {1700000000000.0 + 180000.0 * i, 1.0, 2.0, 0.5, 1.0 + i, 10.0})
+                    kline.append(std::to_string(field));
+                result.append(kline);
+            }
+        }
+
+        double getPrice(std::string) override { return price; }
+
+        OrderBook getOrderBook(std::string) override {
+            OrderBook book({price - 1}, {1}, {price + 1}, {1});
+            book.lastUpdateId = ++updates;
+            return book;
+        }
+
+        std::atomic<double> price{100};
+        std::atomic<double> usdt{1000};
+        std::atomic<int> klines{1};
+        std::atomic<uint64_t> updates{0};
+    };
+
+    class EventStrategy : public Strategy {
+    public:
+        EventStrategy(const std::string &symbol, MarketData &data, OrderManager &orderManager)
+                : Strategy(symbol, data, orderManager) {
+            mEvents->onTick(mSymbol, [this](const std::string &, double price, int64_t) {
+                last = price;
+                ticks++;
+            });
+        }
+
+        ~EventStrategy() override {
+            stop();
+        }
+
+        std::atomic<double> last{0};
+        std::atomic<int> ticks{0};
+        std::atomic<int> signals{0};
+        std::atomic<int> polls{0};
+
+    protected:
+        void updatePrice() override { polls++; }
+
+        double getSignal() override {
+            signals++;
+            return 0;
+        }
+
+        void buy() override {}
+
+        void sell() override {}
+    };
+}
+
+TEST(MarketEventsTest, CoalescesEventsOfASlowConsumer) {
+    EventSubscription events;
+    ASSERT_FALSE(events.hasHandlers());
+    std::vector<double> prices;
+    std::vector<std::string> symbols;
+    events.onTick("BTCUSDT", [&](const std::string &symbol, double price, int64_t) {
+        symbols.push_back(symbol);
+        prices.push_back(price);
+    });
+    int books = 0;
+    events.onBook("", [&](const std::string &, const std::shared_ptr<const OrderBook> &book) {
+        ASSERT_EQ(book->bid[0], 99);
+        books++;
+    });
+    ASSERT_TRUE(events.hasHandlers());
+
+    events.postTick("ETHUSDT", 5, 0); // nobody listens
+    for (int i = 1; i <= 10; i++)
+        events.postTick("BTCUSDT", i, i);
+    events.postBook("ETHUSDT", std::make_shared<const OrderBook>(
+            std::vector<double>{99}, std::vector<double>{1}, std::vector<double>{101}, std::vector<double>{1}));
+    ASSERT_EQ(events.getPostedCount(), 11);
+    ASSERT_EQ(events.getCoalescedCount(), 9);
+
+    ASSERT_EQ(events.dispatch(0), 2);
+    ASSERT_EQ(prices, std::vector<double>{10});
+    ASSERT_EQ(symbols, std::vector<std::string>{"BTCUSDT"});
+    ASSERT_EQ(books, 1);
+    ASSERT_EQ(events.dispatch(0), 0);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(events.dispatch(50), 0);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    std::thread poster([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        events.postTick("BTCUSDT", 11, 11);
+    });
+    ASSERT_EQ(events.dispatch(5000), 1);
+    ASSERT_EQ(prices.back(), 11);
+    poster.join();
+
+    events.close();
+    events.postTick("BTCUSDT", 12, 12);
+    ASSERT_EQ(events.dispatch(10), 0);
+}
+
+TEST(MarketEventsTest, KeepsEveryClosedKline) {
+    EventSubscription events;
+    std::vector<time_t> times;
+    events.onKline("BTCUSDT", "3m", [&](const std::string &, const std::string &, const Kline &kline) {
+        times.push_back(kline.time);
+    });
+    events.postKlineClose("BTCUSDT", "3m", {1700000000, 1, 2, 0.5, 1.5, 10});
+    events.postKlineClose("BTCUSDT", "3m", {1700000180, 1.5, 2, 1, 1.8, 12});
+    ASSERT_EQ(events.getCoalescedCount(), 0);
+    ASSERT_EQ(events.dispatch(0), 2);
+    ASSERT_EQ(times, (std::vector<time_t>{1700000000, 1700000180}));
+}
+
+TEST(MarketEventsTest, MarketDataPostsChanges) {
+    OrderManager oms;
+    MockExchangeManager ems(oms);
+    MarketData md(ems, 1000);
+    md.subscribe("BTCUSDT");
+    std::shared_ptr<EventSubscription> events = md.subscribeEvents();
+    std::vector<double> prices, balances;
+    std::vector<Kline> closed;
+    int books = 0;
+    events->onTick("BTCUSDT", [&](const std::string &, double price, int64_t) { prices.push_back(price); });
+    events->onBook("BTCUSDT", [&](const std::string &, const std::shared_ptr<const OrderBook> &) { books++; });
+    events->onKline("BTCUSDT", "3m", [&](const std::string &, const std::string &, const Kline &k) {
+        closed.push_back(k);
+    });
+    events->onBalance([&](const std::shared_ptr<const std::map<std::string, double>> &b) {
+        balances.push_back(b->at("USDT"));
+    });
+
+    md.start();
+    for (int i = 0; i < 100 && (prices.empty() || !books || balances.empty()); i++)
+        events->dispatch(20);
+    md.stop();
+    ASSERT_EQ(prices, std::vector<double>{100});
+    ASSERT_EQ(books, 1);
+    ASSERT_EQ(balances, std::vector<double>{1000});
+    ASSERT_TRUE(closed.empty()); // the history is loaded, nothing closed yet
+
+    ems.price = 101;
+    ems.klines = 2;
+    md.refresh();
+    events->dispatch(0);
+    ASSERT_EQ(prices.back(), 101);
+    ASSERT_EQ(books, 2);
+    ASSERT_EQ(closed.size(), 1);
+    ASSERT_EQ(closed[0].time, 1700000000);
+    ASSERT_DOUBLE_EQ(closed[0].close, 1);
+
+    md.unsubscribeEvents(events);
+    md.refresh();
+    ASSERT_EQ(events->dispatch(0), 0);
+}
+
+TEST(MarketEventsTest, EventDrivenStrategyOnlyWakesOnEvents) {
+    OrderManager oms;
+    MockExchangeManager ems(oms);
+    MarketData md(ems, 1000);
+    md.subscribe("BTCUSDT");
+    md.subscribe("ETHUSDT");
+    EventStrategy strategy("BTCUSDT", md, oms);
+    strategy.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(strategy.signals, 0);
+    int polls = strategy.polls;
+
+    md.refresh();
+    for (int i = 0; i < 200 && strategy.signals == 0; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_EQ(strategy.ticks, 1);
+    ASSERT_EQ(strategy.last, 100);
+    ASSERT_EQ(strategy.signals, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    ASSERT_EQ(strategy.signals, 1);
+    ASSERT_EQ(strategy.polls, polls);
+}
+
+TEST(MarketEventsTest, StrategyOnlyReceivesEventsBetweenStartAndStop) {
+    OrderManager oms;
+    MockExchangeManager ems(oms);
+    MarketData md(ems, 1000);
+    md.subscribe("BTCUSDT");
+    EventStrategy strategy("BTCUSDT", md, oms);
+    md.refresh();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(strategy.isRunning());
+    ASSERT_EQ(strategy.ticks, 0);
+
+    strategy.start();
+    ASSERT_TRUE(strategy.isRunning());
+    md.refresh();
+    for (int i = 0; i < 200 && strategy.ticks == 0; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_EQ(strategy.ticks, 1);
+
+    // stopping does not wait for the next event
+    auto start = std::chrono::steady_clock::now();
+    strategy.stop();
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(Strategy::EVENT_WAIT_MS));
+    ASSERT_FALSE(strategy.isRunning());
+    md.refresh();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(strategy.ticks, 1);
+
+    // the handlers are kept across a restart
+    ems.price = 101;
+    strategy.start();
+    md.refresh();
+    for (int i = 0; i < 200 && strategy.ticks == 1; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_EQ(strategy.ticks, 2);
+    ASSERT_EQ(strategy.last, 101);
+}
@@ -0,0 +1,92 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "OrderIndex.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace ats;
+
+static OrderState makeState(long id, const std::string &symbol, Side side, double executedQty = 0) {
+    return {Order(id, LIMIT, side, symbol, 1, 100, 0, 0, 0, id + 1000, GTC), executedQty};
+}
+
+TEST(OrderIndexTest, ReconcileEmitsOnlyDifferences) {
+    OrderIndex index;
+    std::vector<OrderEvent> events;
+    auto onEvent = [&](const OrderEvent &event) { events.push_back(event); };
+
+    index.reconcile({makeState(1, "BTCUSDT", BUY), makeState(2, "BTCUSDT", SELL), makeState(3, "ETHUSDT", BUY)},
+                    onEvent);
+    ASSERT_EQ(events.size(), 3);
+    ASSERT_EQ(index.size(), 3);
+    for (auto &event: events)
+        ASSERT_EQ(event.type, ORDER_NEW);
+
+    events.clear();
+    index.reconcile({makeState(1, "BTCUSDT", BUY), makeState(2, "BTCUSDT", SELL, 0.5)}, onEvent);
+    ASSERT_EQ(events.size(), 2);
+    ASSERT_EQ(events[0].type, ORDER_FILL);
+    ASSERT_EQ(events[0].state.order.id, 2);
+    ASSERT_DOUBLE_EQ(events[0].filledQty, 0.5);
+    ASSERT_EQ(events[1].type, ORDER_REMOVED);
+    ASSERT_EQ(events[1].state.order.id, 3);
+
+    events.clear();
+    index.reconcile({makeState(1, "BTCUSDT", BUY), makeState(2, "BTCUSDT", SELL, 0.5)}, onEvent);
+    ASSERT_TRUE(events.empty());
+}
+
+TEST(OrderIndexTest, LookupsByIdSymbolAndSide) {
+    OrderIndex index;
+    index.upsert(makeState(1, "BTCUSDT", BUY));
+    index.upsert(makeState(2, "BTCUSDT", BUY));
+    index.upsert(makeState(3, "BTCUSDT", SELL));
+    OrderState state;
+    ASSERT_TRUE(index.find(2, state));
+    ASSERT_EQ(state.order.emsId, 1002);
+    ASSERT_FALSE(index.find(4, state));
+    ASSERT_EQ(index.getOrders(stringToSymbol("BTCUSDT"), BUY).size(), 2);
+    ASSERT_EQ(index.getOrders(stringToSymbol("BTCUSDT"), SELL).size(), 1);
+    ASSERT_TRUE(index.getOrders(stringToSymbol("ETHUSDT"), BUY).empty());
+    ASSERT_TRUE(index.erase(1));
+    ASSERT_FALSE(index.find(1, state));
+    ASSERT_EQ(index.getOrders(stringToSymbol("BTCUSDT"), BUY).size(), 1);
+}
+
+TEST(OrderIndexTest, ReusesSlotsAndRejectsWhenFull) {
+    OrderIndex index(16);
+    for (long id = 0; id < 1000; id++) {
+        ASSERT_TRUE(index.upsert(makeState(id, "BTCUSDT", BUY)));
+        ASSERT_TRUE(index.erase(id));
+    }
+    ASSERT_EQ(index.size(), 0);
+    for (long id = 0; id < 12; id++)
+        ASSERT_TRUE(index.upsert(makeState(id, "BTCUSDT", BUY)));
+    ASSERT_FALSE(index.upsert(makeState(12, "BTCUSDT", BUY)));
+    OrderState state;
+    for (long id = 0; id < 12; id++)
+        ASSERT_TRUE(index.find(id, state));
+}
+
+TEST(OrderIndexTest, ReadersDoNotBlockOnWriter) {
+    OrderIndex index;
+    index.upsert(makeState(0, "BTCUSDT", BUY));
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (long id = 1; id < 2000; id++) {
+            index.upsert(makeState(id, "BTCUSDT", BUY));
+            if (id > 1)
+                index.erase(id - 1);
+        }
+        done = true;
+    });
+    OrderState state;
+    while (!done) {
+        ASSERT_TRUE(index.find(0, state));
+        ASSERT_EQ(state.order.emsId, 1000);
+    }
+    writer.join();
+    ASSERT_EQ(index.size(), 2);
+}
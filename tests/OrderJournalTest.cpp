@@ -0,0 +1,186 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "OrderJournal.h"
+#include "OrderManager.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ats;
+
+static std::string journalPath(const std::string &name) {
+    return "/tmp/ats_" + name + "_" + std::to_string(getpid()) + ".journal";
+}
+
+TEST(OrderJournalTest, RecordsAreReplayedInOrder) {
+    std::string path = journalPath("replay");
+    std::remove(path.c_str());
+    const int count = 20000; // more than the initial file size, forces the mapping to grow
+    // every record is for another order that is still open, so opening the journal compacts none of them
+    const int events = JOURNAL_REJECTED;
+    {
+        OrderJournal journal;
+        ASSERT_TRUE(journal.open(path));
+        for (int i = 0; i < count; i++)
+            journal.append(JournalEvent(i % events), Order(i, LIMIT, BUY, "BTCUSDT", 1, 100), i * 0.5);
+    }
+    OrderJournal journal;
+    int replayed = 0;
+    ASSERT_TRUE(journal.open(path, [&](const JournalRecord &record) {
+        ASSERT_EQ(record.sequence, uint64_t(replayed + 1));
+        ASSERT_EQ(record.order.id, replayed);
+        ASSERT_EQ(record.event, JournalEvent(replayed % events));
+        ASSERT_DOUBLE_EQ(record.executedQty, replayed * 0.5);
+        ASSERT_EQ(record.order.symbolName(), "BTCUSDT");
+        replayed++;
+    }));
+    ASSERT_EQ(replayed, count);
+    journal.append(JOURNAL_CREATED, Order(count));
+    journal.close();
+    ASSERT_EQ(journal.getRecordCount(), uint64_t(count + 1));
+    ASSERT_EQ(JournalEventToString(JOURNAL_ACKED), "ACKED");
+    std::remove(path.c_str());
+}
+
+TEST(OrderJournalTest, RecordsAreStampedOnTheJournalClock) {
+    std::string path = journalPath("clock");
+    std::remove(path.c_str());
+    SimulatedClock clock(42, 1700000000 * NANOS_PER_SECOND);
+    {
+        OrderJournal journal(OrderJournal::DEFAULT_QUEUE_CAPACITY, std::chrono::milliseconds(100), clock);
+        ASSERT_TRUE(journal.open(path));
+        journal.append(JOURNAL_CREATED, Order(1, LIMIT, BUY, "BTCUSDT", 1, 100));
+    }
+    OrderJournal journal;
+    std::vector<int64_t> times;
+    ASSERT_TRUE(journal.open(path, [&](const JournalRecord &record) { times.push_back(record.time); }));
+    ASSERT_EQ(times, std::vector<int64_t>{1700000000 * NANOS_PER_SECOND + 42});
+    journal.close();
+    std::remove(path.c_str());
+}
+
+TEST(OrderJournalTest, RejectsFilesThatAreNotJournals) {
+    std::string path = journalPath("invalid");
+    FILE *file = fopen(path.c_str(), "w");
+    for (int i = 0; i < 100; i++)
+        fputs("not a journal ", file);
+    fclose(file);
+    OrderJournal journal;
+    ASSERT_FALSE(journal.open(path));
+    ASSERT_FALSE(journal.isOpen());
+    std::remove(path.c_str());
+}
+
+TEST(OrderJournalTest, OrderManagerRecoversOpenOrders) {
+    std::string path = journalPath("recovery");
+    std::remove(path.c_str());
+    long cancelledId;
+    {
+        OrderManager orderManager;
+        ASSERT_TRUE(orderManager.openJournal(path));
+        long openId = orderManager.createOrder(LIMIT, BUY, "BTCUSDT", 2, 100);
+        cancelledId = orderManager.createOrder(LIMIT, SELL, "ETHUSDT", 1, 2000);
+        for (int i = 0; i < 500 && orderManager.getQueueDepths().orders < 2; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // Play the EMS: both orders are acknowledged, the first one is partially filled, the second cancelled
+        for (int i = 0; i < 2; i++) {
+            Order order = orderManager.getOldestOrder();
+            order.emsId = order.id + 1000;
+            orderManager.updateSentOrder(order, 0);
+            ExecutionReport report;
+            report.acked = true;
+            report.emsId = order.emsId;
+            report.status = NEW;
+            orderManager.reportExecution(order, report);
+        }
+        Order open = orderManager.getOrderById(openId);
+        orderManager.updateOpenOrders({{open, 0.5}});
+        ASSERT_EQ(orderManager.getOrderById(cancelledId).id, -1);
+    }
+    OrderManager orderManager;
+    ASSERT_TRUE(orderManager.openJournal(path));
+    std::vector<OrderState> orders = orderManager.getOpenOrders();
+    ASSERT_EQ(orders.size(), 1);
+    ASSERT_EQ(orders[0].order.symbolName(), "BTCUSDT");
+    ASSERT_EQ(orders[0].order.emsId, orders[0].order.id + 1000);
+    ASSERT_DOUBLE_EQ(orders[0].executedQty, 0.5);
+    ASSERT_EQ(orderManager.getOrderById(cancelledId).id, -1);
+    ASSERT_GT(orderManager.createOrder(LIMIT, BUY, "BTCUSDT", 1, 100).id(), cancelledId);
+    std::remove(path.c_str());
+}
+
+TEST(OrderJournalTest, OpeningCompactsClosedOrders) {
+    std::string path = journalPath("compaction");
+    std::remove(path.c_str());
+    {
+        OrderJournal journal;
+        ASSERT_TRUE(journal.open(path));
+        for (long id = 0; id < 100; id++) {
+            Order order(id, LIMIT, BUY, "BTCUSDT", 1, 100);
+            journal.append(JOURNAL_CREATED, order);
+            journal.append(JOURNAL_ACKED, order, 0);
+            journal.append(JOURNAL_CLOSED, order, 1);
+        }
+        Order open(100, LIMIT, SELL, "ETHUSDT", 2, 2000);
+        journal.append(JOURNAL_ACKED, open, 0);
+        journal.append(JOURNAL_FILLED, open, 0.5);
+        journal.append(JOURNAL_CANCELLED, open);
+        journal.append(JOURNAL_REJECTED, Order(150, LIMIT, BUY, "BTCUSDT", 1, 100));
+    }
+    {
+        OrderJournal journal;
+        std::vector<JournalEvent> events;
+        ASSERT_TRUE(journal.open(path, [&](const JournalRecord &record) { events.push_back(record.event); }));
+        ASSERT_EQ(events, (std::vector<JournalEvent>{JOURNAL_FILLED, JOURNAL_CANCELLED, JOURNAL_REJECTED}));
+        ASSERT_EQ(journal.getRecordCount(), 3);
+    }
+    std::ifstream compacted(path + ".compact");
+    ASSERT_FALSE(compacted.good());
+    OrderManager orderManager;
+    ASSERT_TRUE(orderManager.openJournal(path));
+    std::vector<OrderState> orders = orderManager.getOpenOrders();
+    ASSERT_EQ(orders.size(), 1);
+    ASSERT_EQ(orders[0].order.id, 100);
+    ASSERT_DOUBLE_EQ(orders[0].executedQty, 0.5);
+    ASSERT_GT(orderManager.createOrder(LIMIT, BUY, "BTCUSDT", 1, 100).id(), 150);
+    orderManager.closeJournal();
+    std::remove(path.c_str());
+}
+
+TEST(OrderJournalTest, SymbolsAreReplayedByName) {
+    std::string path = journalPath("symbols");
+    std::remove(path.c_str());
+    // the journal is written by another process, which interned other symbols first
+    pid_t writer = fork();
+    ASSERT_GE(writer, 0);
+    if (writer == 0) {
+        stringToSymbol("WRITERONLY1USDT");
+        stringToSymbol("WRITERONLY2USDT");
+        OrderJournal journal;
+        if (!journal.open(path))
+            _exit(1);
+        journal.append(JOURNAL_ACKED, Order(1, LIMIT, BUY, "JOURNALUSDT", 1, 100), 0);
+        journal.close();
+        _exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(writer, &status, 0), writer);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // here, the ids of the writer belong to other symbols
+    SymbolId first = stringToSymbol("READERONLY1USDT");
+    stringToSymbol("READERONLY2USDT");
+    stringToSymbol("READERONLY3USDT");
+    OrderJournal journal;
+    std::vector<std::string> symbols;
+    ASSERT_TRUE(journal.open(path, [&](const JournalRecord &record) {
+        symbols.push_back(record.order.symbolName());
+    }));
+    ASSERT_EQ(symbols, std::vector<std::string>{"JOURNALUSDT"});
+    ASSERT_GT(stringToSymbol("JOURNALUSDT"), first + 2);
+    journal.close();
+    std::remove(path.c_str());
+}
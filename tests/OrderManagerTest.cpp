@@ -3,6 +3,7 @@
 //
 #include "OrderManager.h"
 #include <gtest/gtest.h>
+#include <ctime>
 
 TEST(OrderManagerTest, CreateAndProcessOrder) {
     ats::OrderManager orderManager;
@@ -35,3 +36,240 @@ TEST(OrderManagerTest, StopAndRestart) {
 }
 
 
+TEST(OrderManagerTest, WaitPoliciesWakeUpOnNewOrders) {
+    for (ats::WaitPolicy policy : {ats::BUSY_SPIN, ats::SPIN_YIELD, ats::PARK}) {
+        ats::OrderManager orderManager(ats::OrderManager::DEFAULT_QUEUE_CAPACITY, policy);
+        ASSERT_EQ(orderManager.getWaitPolicy(), policy);
+        for (int i = 0; i < 3; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Let the order manager go idle
+            orderManager.createOrder(ats::MARKET, ats::BUY, "BTCUSDT", 1, 0);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Wait for orders to be processed
+        ASSERT_EQ(orderManager.getQueueDepths().pending, 0);
+        ASSERT_EQ(orderManager.getQueueDepths().orders, 3);
+        ats::WakeupStats stats = orderManager.getWakeupStats();
+        ASSERT_GT(stats.wakeups, 0);
+        ASSERT_GE(stats.maxNs, stats.meanNs);
+    }
+}
+
+TEST(OrderManagerTest, OrderIsCompactAndInternsSymbols) {
+    ASSERT_EQ(sizeof(ats::Order), 64);
+    ats::Order order(1, ats::LIMIT, ats::SELL, "ETHUSDT", 1, 2000, 0, 0, 0, 0, ats::IOC);
+    ats::Order copy = order;
+    ASSERT_EQ(copy.symbol, ats::stringToSymbol("ETHUSDT"));
+    ASSERT_EQ(copy.symbolName(), "ETHUSDT");
+    ASSERT_NE(ats::stringToSymbol("BTCUSDT"), copy.symbol);
+    ASSERT_EQ(ats::SymbolToString(ats::NO_SYMBOL), "");
+    ASSERT_EQ(ats::TimeInForceToString(copy.timeInForce), "IOC");
+    ASSERT_EQ(ats::stringToTimeInForce("GTC"), ats::GTC);
+}
+
+TEST(OrderManagerTest, ShardsPreservePerSymbolOrdering) {
+    const size_t shards = 4;
+    ats::OrderManager orderManager(ats::OrderManager::DEFAULT_QUEUE_CAPACITY, ats::SPIN_YIELD, shards);
+    ASSERT_EQ(orderManager.getShardCount(), shards);
+    std::vector<std::string> symbols = {"BTCUSDT", "ETHUSDT", "BNBUSDT", "XRPUSDT", "ADAUSDT", "SOLUSDT"};
+    std::vector<std::thread> producers;
+    for (const std::string &symbol: symbols)
+        producers.emplace_back([&orderManager, symbol]() {
+            for (int i = 0; i < 100; i++)
+                orderManager.createOrder(ats::LIMIT, ats::BUY, symbol, 1, i + 1);
+        });
+    for (std::thread &producer: producers)
+        producer.join();
+    std::map<ats::SymbolId, double> lastPrice;
+    size_t received = 0;
+    for (int attempt = 0; received < symbols.size() * 100 && attempt < 1000; attempt++) {
+        for (size_t shard = 0; shard < shards; shard++)
+            while (orderManager.hasOrders(shard)) {
+                ats::Order order = orderManager.getOldestOrder(shard);
+                ASSERT_EQ(orderManager.getShard(order.symbol), shard);
+                if (lastPrice.count(order.symbol)) {
+                    ASSERT_GT(order.price, lastPrice[order.symbol]);
+                }
+                lastPrice[order.symbol] = order.price;
+                received++;
+            }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(received, symbols.size() * 100);
+    ASSERT_EQ(orderManager.getSymbols().size(), symbols.size());
+
+    ats::SymbolId btc = ats::stringToSymbol("BTCUSDT");
+    ASSERT_TRUE(orderManager.cancelOrder(7, btc));
+    ASSERT_TRUE(orderManager.hasCancelOrders(orderManager.getShard(btc)));
+    ASSERT_EQ(orderManager.getCancelOrder(orderManager.getShard(btc)).first, 7);
+}
+
+TEST(OrderManagerTest, ExecutionReportsCompleteHandles) {
+    ats::OrderManager orderManager;
+    std::atomic<double> callbackQty{-1};
+    ats::OrderHandle first = orderManager.createOrder(ats::LIMIT, ats::SELL, "BTCUSDT", 1, 100, nullptr);
+    ats::OrderHandle second = orderManager.createOrder(ats::LIMIT, ats::BUY, "BTCUSDT", 2, 100,
+                                                       [&](const ats::ExecutionReport &report) {
+                                                           callbackQty = report.executedQty;
+                                                       });
+    ASSERT_TRUE(first.valid());
+    ASSERT_NE(first.id(), second.id());
+    ASSERT_FALSE(first.ready());
+
+    // Play the EMS: acknowledge the orders in sending order
+    for (int reported = 0; reported < 2;) {
+        if (!orderManager.hasOrders()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        ats::Order order = orderManager.getOldestOrder();
+        ats::ExecutionReport report;
+        report.acked = order.side == ats::BUY;
+        report.status = report.acked ? ats::PARTIALLY_FILLED : ats::REJECTED;
+        report.executedQty = report.acked ? order.quantity / 2 : 0;
+        orderManager.reportExecution(order, report);
+        reported++;
+    }
+
+    ASSERT_TRUE(first.waitFor(std::chrono::milliseconds(100)));
+    ats::ExecutionReport report = first.get();
+    ASSERT_EQ(report.orderId, first.id());
+    ASSERT_FALSE(report.acked);
+    ASSERT_EQ(report.status, ats::REJECTED);
+    report = second.get();
+    ASSERT_TRUE(report.acked);
+    ASSERT_EQ(report.status, ats::PARTIALLY_FILLED);
+    ASSERT_DOUBLE_EQ(report.executedQty, 1);
+    ASSERT_DOUBLE_EQ(callbackQty, 1);
+    ASSERT_EQ(ats::stringToOrderStatus("FILLED"), ats::FILLED);
+}
+
+TEST(OrderManagerTest, FullQueueReturnsInvalidHandle) {
+    ats::OrderManager orderManager(2);
+    orderManager.stop();
+    ASSERT_TRUE(orderManager.createOrder(ats::MARKET, ats::BUY, "BTCUSDT", 1).valid());
+    ASSERT_TRUE(orderManager.createOrder(ats::MARKET, ats::BUY, "BTCUSDT", 1).valid());
+    ats::OrderHandle rejected = orderManager.createOrder(ats::MARKET, ats::BUY, "BTCUSDT", 1);
+    ASSERT_EQ(long(rejected), -1);
+    ASSERT_FALSE(rejected.valid());
+    ASSERT_FALSE(rejected.get().acked);
+}
+
+TEST(OrderManagerTest, InvalidOrdersAreRejectedBeforeTheEMS) {
+    ats::OrderManager orderManager;
+    ats::SymbolFilters filters;
+    filters.tickSize = 0.01;
+    filters.stepSize = 0.001;
+    filters.minQty = 0.001;
+    filters.minNotional = 10;
+    orderManager.getValidator().load({{ats::stringToSymbol("BTCUSDT"), filters}});
+
+    ats::OrderHandle rejected = orderManager.createOrder(ats::LIMIT, ats::BUY, "BTCUSDT", 0.0005, 20000);
+    ats::OrderHandle accepted = orderManager.createOrder(ats::LIMIT, ats::BUY, "BTCUSDT", 0.001, 20000);
+    ASSERT_TRUE(rejected.waitFor(std::chrono::milliseconds(500)));
+    ASSERT_FALSE(rejected.get().acked);
+    ASSERT_EQ(rejected.get().rejectReason, ats::LOT_SIZE);
+    for (int i = 0; i < 500 && !orderManager.hasOrders(); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_EQ(orderManager.getOldestOrder().id, accepted.id());
+    ASSERT_FALSE(orderManager.hasOrders());
+}
+
+TEST(OrderManagerTest, OrderIdsAreUniqueAndRoundTripThroughClientOrderIds) {
+    ats::OrderManager orderManager(4096);
+    orderManager.stop();
+    std::vector<std::vector<long>> ids(4);
+    std::vector<std::thread> producers;
+    for (auto &producerIds: ids)
+        producers.emplace_back([&orderManager, &producerIds]() {
+            for (int i = 0; i < 500; i++)
+                producerIds.push_back(orderManager.createOrder(ats::MARKET, ats::BUY, "BTCUSDT", 1));
+        });
+    for (std::thread &producer: producers)
+        producer.join();
+    std::set<long> unique;
+    for (auto &producerIds: ids)
+        for (long id: producerIds) {
+            ASSERT_GT(id, INT32_MAX); // 64-bit ids, seeded from the clock
+            unique.insert(id);
+            ASSERT_EQ(ats::parseClientOrderId(ats::clientOrderId(id)), id);
+        }
+    ASSERT_EQ(unique.size(), 2000);
+    ASSERT_LE(ats::clientOrderId(*unique.rbegin()).size(), 36); // Binance limit
+    ASSERT_EQ(ats::parseClientOrderId("web_1234"), -1);
+    ASSERT_EQ(ats::parseClientOrderId("ats-"), -1);
+    ASSERT_EQ(ats::parseClientOrderId("ats-12x"), -1);
+}
+
+TEST(OrderManagerTest, StopRejectsOrdersNotProcessedYet) {
+    ats::OrderManager orderManager;
+    orderManager.stop();
+    ats::OrderHandle handle = orderManager.createOrder(ats::LIMIT, ats::BUY, "BTCUSDT", 1, 100);
+    std::atomic<long> reported{0};
+    ats::Order order(0, ats::LIMIT, ats::SELL, "BTCUSDT", 1, 100);
+    long id = orderManager.submitOrder(order, [&](const ats::ExecutionReport &report) { reported = report.orderId; });
+    ats::Order untracked(0, ats::LIMIT, ats::SELL, "BTCUSDT", 1, 100);
+    ASSERT_GE(orderManager.submitOrder(untracked), 0);
+    ASSERT_FALSE(handle.ready());
+
+    orderManager.stop();
+    ASSERT_EQ(orderManager.getQueueDepths().pending, 0);
+    ASSERT_TRUE(handle.ready());
+    ASSERT_FALSE(handle.get().acked);
+    ASSERT_EQ(handle.get().status, ats::REJECTED);
+    ASSERT_EQ(reported, id);
+}
+
+TEST(OrderManagerTest, SubmittedOrdersWithoutHandleReachTheEMS) {
+    ats::OrderManager orderManager;
+    ats::Order order(0, ats::LIMIT, ats::BUY, "BTCUSDT", 1, 100);
+    long id = orderManager.submitOrder(order);
+    for (int i = 0; i < 500 && !orderManager.hasOrders(); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ats::Order sent = orderManager.getOldestOrder();
+    ASSERT_EQ(sent.id, id);
+    ats::ExecutionReport report;
+    report.acked = true;
+    orderManager.reportExecution(sent, report);
+}
+
+TEST(OrderManagerTest, ExchangeThreadsWaitForOrdersWithoutSpinning) {
+    ats::OrderManager orderManager;
+    ats::SimulatedClock clock(0);
+    std::atomic<int> woken{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<long> cpuNs{0};
+    std::thread ems([&]() {
+        timespec start{}, end{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+        // the deadline is on the simulated clock, whatever the real time
+        orderManager.waitForOrders(0, clock, 100, [&]() { return bool(stopping); });
+        woken++;
+        orderManager.waitForOrders(0, clock, -1, [&]() { return bool(stopping); });
+        woken++;
+        orderManager.getOldestOrder();
+        orderManager.waitForOrders(0, clock, -1, [&]() { return bool(stopping); });
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+        cpuNs = (end.tv_sec - start.tv_sec) * 1000000000L + end.tv_nsec - start.tv_nsec;
+        woken++;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(woken, 0);
+    clock.advance(100);
+    for (int i = 0; i < 500 && woken < 1; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_EQ(woken, 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(woken, 1);
+    orderManager.createOrder(ats::MARKET, ats::BUY, "BTCUSDT", 1, 0);
+    for (int i = 0; i < 500 && woken < 2; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_EQ(woken, 2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    stopping = true;
+    orderManager.wakeExchange();
+    ems.join();
+    ASSERT_EQ(woken, 3);
+    // about 300 ms of waiting, parked rather than polling
+    ASSERT_LT(cpuNs, 50000000);
+}
@@ -0,0 +1,135 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "OrderValidator.h"
+#include "MarketData.h"
+#include "StubExchangeManager.h"
+#include <gtest/gtest.h>
+
+using namespace ats;
+
+static SymbolFilters btcFilters() {
+    SymbolFilters filters;
+    filters.minPrice = 0.01;
+    filters.maxPrice = 1000000;
+    filters.tickSize = 0.01;
+    filters.minQty = 0.00001;
+    filters.maxQty = 9000;
+    filters.stepSize = 0.00001;
+    filters.minNotional = 5;
+    filters.multiplierUp = 5;
+    filters.multiplierDown = 0.2;
+    return filters;
+}
+
+TEST(OrderValidatorTest, ChecksEachFilter) {
+    OrderValidator validator;
+    SymbolId btc = stringToSymbol("BTCUSDT");
+    validator.load({{btc, btcFilters()}});
+    ASSERT_TRUE(validator.getFilters(btc).loaded);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.001, 30000.01)), VALID);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0, 30000)), INVALID_QUANTITY);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.001, 0)), INVALID_PRICE);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.000015, 30000)), LOT_SIZE);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 10000, 30000)), LOT_SIZE);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.001, 2000000)), PRICE_RANGE);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.001, 30000.005)), TICK_SIZE);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.0001, 30000)), MIN_NOTIONAL);
+    ASSERT_EQ(validator.validate(Order(1, MARKET, BUY, btc, 0.0001, 0)), VALID);
+
+    validator.setReferencePrice(btc, 30000);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.001, 200000)), PRICE_BAND);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.01, 5000)), PRICE_BAND);
+    ASSERT_EQ(validator.validate(Order(1, MARKET, BUY, btc, 0.0001, 0)), MIN_NOTIONAL);
+    ASSERT_EQ(ValidationResultToString(TICK_SIZE), "TICK_SIZE");
+}
+
+TEST(OrderValidatorTest, UnknownSymbolsOnlyGetBasicChecks) {
+    OrderValidator validator;
+    SymbolId eth = stringToSymbol("ETHUSDT");
+    ASSERT_FALSE(validator.getFilters(eth).loaded);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, SELL, eth, 0.123456789, 1234.56789)), VALID);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, SELL, eth, -1, 1234)), INVALID_QUANTITY);
+}
+
+TEST(OrderValidatorTest, BatchValidationAndReload) {
+    OrderValidator validator;
+    SymbolId btc = stringToSymbol("BTCUSDT");
+    validator.load({{btc, btcFilters()}});
+    validator.setReferencePrice(btc, 30000);
+    std::vector<Order> orders;
+    for (int i = 0; i < 100; i++)
+        orders.emplace_back(i, LIMIT, BUY, btc, 0.001, i % 2 ? 30000 : 30000.001);
+    std::vector<ValidationResult> results(orders.size());
+    ASSERT_EQ(validator.validate(orders.data(), orders.size(), results.data()), 50);
+    ASSERT_EQ(results[0], TICK_SIZE);
+    ASSERT_EQ(results[1], VALID);
+
+    SymbolFilters coarse = btcFilters();
+    coarse.tickSize = 1;
+    validator.load({{btc, coarse}});
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.001, 30000.5)), TICK_SIZE);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, btc, 0.001, 200000.01)), PRICE_BAND);
+}
+
+TEST(OrderValidatorTest, PriceBandsDependOnTheSide) {
+    OrderValidator validator;
+    SymbolId sym = stringToSymbol("SIDEUSDT");
+    SymbolFilters filters = btcFilters();
+    filters.multiplierUp = 0;
+    filters.multiplierDown = 0;
+    filters.bidMultiplierUp = 1.1;
+    filters.bidMultiplierDown = 0.5;
+    filters.askMultiplierUp = 2;
+    filters.askMultiplierDown = 0.9;
+    validator.load({{sym, filters}});
+    validator.setReferencePrice(sym, 100);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, sym, 1, 60)), VALID);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, SELL, sym, 1, 60)), PRICE_BAND);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, sym, 1, 150)), PRICE_BAND);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, SELL, sym, 1, 150)), VALID);
+}
+
+TEST(OrderValidatorTest, MarketOrdersUseTheMarketLotSize) {
+    OrderValidator validator;
+    SymbolId sym = stringToSymbol("MLOTUSDT");
+    SymbolFilters filters = btcFilters();
+    filters.marketMinQty = 0.001;
+    filters.marketMaxQty = 100;
+    filters.marketStepSize = 0.001;
+    validator.load({{sym, filters}});
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, sym, 1000, 100)), VALID);
+    ASSERT_EQ(validator.validate(Order(1, MARKET, BUY, sym, 1000, 0)), LOT_SIZE);
+    ASSERT_EQ(validator.validate(Order(1, MARKET, BUY, sym, 0.0015, 0)), LOT_SIZE);
+    ASSERT_EQ(validator.validate(Order(1, MARKET, BUY, sym, 0.002, 0)), VALID);
+    ASSERT_EQ(validator.validate(Order(1, LIMIT, BUY, sym, 0.00002, 1000000)), VALID);
+    ASSERT_EQ(validator.validate(Order(1, MARKET, BUY, sym, 0.00002, 0)), LOT_SIZE);
+}
+
+namespace {
+    class PricedExchangeManager : public StubExchangeManager {
+    public:
+        using StubExchangeManager::StubExchangeManager;
+
+        double getPrice(std::string) override { return 100; }
+    };
+}
+
+TEST(OrderValidatorTest, MarketPricesBoundOrderPrices) {
+    OrderManager oms;
+    PricedExchangeManager ems(oms);
+    SymbolId sym = stringToSymbol("BANDUSDT");
+    SymbolFilters filters = btcFilters();
+    filters.multiplierUp = 1.2;
+    filters.multiplierDown = 0.8;
+    oms.getValidator().load({{sym, filters}});
+    MarketData md(ems, 1000);
+    md.subscribe("BANDUSDT");
+    md.refresh();
+    OrderHandle outside = oms.createOrder(LIMIT, BUY, "BANDUSDT", 1, 130);
+    ASSERT_TRUE(outside.waitFor(std::chrono::seconds(1)));
+    ASSERT_FALSE(outside.get().acked);
+    ASSERT_EQ(outside.get().rejectReason, PRICE_BAND);
+    ASSERT_EQ(oms.getValidator().validate(Order(1, LIMIT, BUY, sym, 1, 110)), VALID);
+    ASSERT_EQ(oms.getValidator().validate(Order(1, LIMIT, SELL, sym, 1, 70)), PRICE_BAND);
+}
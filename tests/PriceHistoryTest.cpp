@@ -0,0 +1,65 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "PriceHistory.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+using namespace ats;
+
+TEST(PriceHistoryTest, KeepsTheMostRecentPricesContiguous) {
+    PriceHistory history(8);
+    ASSERT_TRUE(history.empty());
+    ASSERT_DOUBLE_EQ(history.back(), -1);
+    for (int i = 1; i <= 20; i++) {
+        history.push(i, 1000 * i);
+        PriceWindow window = history.window();
+        ASSERT_EQ(window.size, std::min(i, 8));
+        for (size_t j = 0; j < window.size; j++) {
+            ASSERT_DOUBLE_EQ(window[j], i - int(window.size) + 1 + int(j));
+            ASSERT_EQ(window.time(j), 1000 * int64_t(window[j]));
+        }
+    }
+    ASSERT_EQ(history.size(), 8);
+    ASSERT_DOUBLE_EQ(history.back(), 20);
+    ASSERT_EQ(history.backTime(), 20000);
+
+    PriceWindow last = history.window(3);
+    ASSERT_DOUBLE_EQ(std::accumulate(last.begin(), last.end(), 0.0), 18 + 19 + 20);
+    ASSERT_EQ(history.getPrices(2), (std::vector<double>{19, 20}));
+    ASSERT_EQ(history.getPrices(100).size(), 8);
+
+    history.clear();
+    ASSERT_TRUE(history.window().empty());
+}
+
+TEST(PriceHistoryTest, RoundsCapacityUpToAPowerOfTwo) {
+    PriceHistory history(1000);
+    ASSERT_EQ(history.capacity(), 1024);
+    for (int i = 0; i < 5000; i++)
+        history.push(i, i);
+    ASSERT_EQ(history.size(), 1024);
+    ASSERT_DOUBLE_EQ(history.window()[0], 5000 - 1024);
+}
+
+TEST(PriceHistoryTest, ReadersSeeConsistentPricesWhileWriting) {
+    PriceHistory history(64);
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 1; i <= 200000; i++)
+            history.push(i, i);
+        done = true;
+    });
+    while (!done) {
+        std::vector<double> prices = history.getPrices();
+        for (size_t i = 1; i < prices.size(); i++)
+            ASSERT_DOUBLE_EQ(prices[i], prices[i - 1] + 1);
+        if (!prices.empty()) {
+            ASSERT_GE(history.back(), prices.back());
+        }
+    }
+    writer.join();
+    ASSERT_DOUBLE_EQ(history.back(), 200000);
+}
@@ -0,0 +1,78 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "PriceLadder.h"
+#include "L2Book.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace ats;
+
+TEST(PriceLadderTest, TracksBestLevelsOnBothSides) {
+    PriceLadder bids(0.01, true, 64), asks(0.01, false, 64);
+    bids.set(100.00, 1);
+    bids.set(99.98, 2);
+    bids.set(100.01, 3);
+    asks.set(100.03, 1);
+    asks.set(100.02, 4);
+    ASSERT_DOUBLE_EQ(bids.getBestPrice(), 100.01);
+    ASSERT_DOUBLE_EQ(bids.getBestQuantity(), 3);
+    ASSERT_DOUBLE_EQ(asks.getBestPrice(), 100.02);
+    bids.set(100.01, 0);
+    ASSERT_EQ(bids.getBestPrice(), 100.00);
+    ASSERT_DOUBLE_EQ(bids.getQuantity(99.98), 2);
+    ASSERT_DOUBLE_EQ(bids.getCumulativeQuantity(99.98), 3);
+    ASSERT_DOUBLE_EQ(bids.getCumulativeQuantity(100.5), 0);
+    ASSERT_DOUBLE_EQ(asks.getCumulativeQuantity(200), 5);
+
+    std::vector<double> prices, quantities;
+    bids.getLevels(prices, quantities);
+    ASSERT_EQ(prices, (std::vector<double>{100.00, 99.98}));
+    ASSERT_EQ(quantities, (std::vector<double>{1, 2}));
+}
+
+TEST(PriceLadderTest, KeepsLevelsOutsideTheWindow) {
+    PriceLadder bids(0.5, true, 64);
+    bids.set(100, 1);
+    bids.set(50, 2); // far below the window
+    bids.set(200, 3); // recentres on the new best
+    ASSERT_EQ(bids.size(), 3);
+    ASSERT_DOUBLE_EQ(bids.getBestPrice(), 200);
+    ASSERT_DOUBLE_EQ(bids.getCumulativeQuantity(0.5), 6);
+    bids.set(200, 0);
+    ASSERT_DOUBLE_EQ(bids.getBestPrice(), 100);
+    bids.set(100, 0);
+    ASSERT_DOUBLE_EQ(bids.getBestPrice(), 50);
+    ASSERT_DOUBLE_EQ(bids.getBestQuantity(), 2);
+    bids.set(50, 0);
+    ASSERT_TRUE(bids.empty());
+    ASSERT_DOUBLE_EQ(bids.getBestPrice(), 0);
+}
+
+TEST(PriceLadderTest, MatchesMapBook) {
+    std::mt19937 random(42);
+    L2Book ladder(0.01, 128), map;
+    OrderBook snapshot({100}, {1}, {100.01}, {1});
+    snapshot.lastUpdateId = 1;
+    ladder.applySnapshot(snapshot);
+    map.applySnapshot(snapshot);
+    for (uint64_t id = 2; id < 5000; id++) {
+        DepthUpdate update{id, id, {}, {}};
+        for (int i = 0; i < 4; i++) {
+            double quantity = random() % 3 == 0 ? 0 : double(random() % 100) / 10;
+            long tick = long(10000 + int(random() % 400) - 200 + (id / 50) % 300);
+            if (random() % 2)
+                update.bids.emplace_back(double(tick) / 100, quantity);
+            else update.asks.emplace_back(double(tick + 1) / 100, quantity);
+        }
+        ASSERT_EQ(ladder.applyUpdate(update), DEPTH_APPLIED);
+        map.applyUpdate(update);
+        OrderBook a = ladder.getOrderBook(), b = map.getOrderBook();
+        ASSERT_EQ(a.bid, b.bid);
+        ASSERT_EQ(a.bidVol, b.bidVol);
+        ASSERT_EQ(a.ask, b.ask);
+        ASSERT_EQ(a.askVol, b.askVol);
+    }
+    ASSERT_TRUE(ladder.hasLadder());
+    ASSERT_FALSE(map.hasLadder());
+}
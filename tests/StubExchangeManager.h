@@ -0,0 +1,46 @@
+/**
+ * @file StubExchangeManager.h
+ * @author Anouar Achghaf
+ * @date 17/10/2026
+ * @brief Contains the StubExchangeManager class, an ExchangeManager doing nothing, for tests and benchmarks.
+ * A test derives from it and overrides only the calls it exercises.
+*/
+
+#ifndef ATS_STUBEXCHANGEMANAGER_H
+#define ATS_STUBEXCHANGEMANAGER_H
+
+#include "ExchangeManager.h"
+
+namespace ats {
+
+    /**
+     * @brief ExchangeManager answering every call with an empty result, and every price with 1.
+     */
+    class StubExchangeManager : public ExchangeManager {
+    public:
+        explicit StubExchangeManager(OrderManager &oms) : ExchangeManager(oms) {}
+
+        double sendOrder(Order &) override { return 0; }
+
+        void modifyOrder(Order &, Order &) override {}
+
+        void cancelOrder(Order &) override {}
+
+        void getOrderStatus(Order &, Json::Value &) override {}
+
+        std::vector<Order> getOpenOrders(std::string) override { return {}; }
+
+        std::vector<Trade> getTradeHistory(std::string) override { return {}; }
+
+        std::map<std::string, double> getBalances() override { return {}; }
+
+        void getKlines(Json::Value &, std::string, std::string, time_t, time_t, int) override {}
+
+        double getPrice(std::string) override { return 1; }
+
+        OrderBook getOrderBook(std::string) override { return {}; }
+    };
+
+} // ats
+
+#endif //ATS_STUBEXCHANGEMANAGER_H
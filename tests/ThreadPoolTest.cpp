@@ -0,0 +1,64 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "ThreadPool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace ats;
+
+TEST(ThreadPoolTest, RunsEveryTaskOncePerBatch) {
+    ThreadPool pool(4);
+    ASSERT_EQ(pool.getParallelism(), 4);
+    for (size_t count: {0, 1, 3, 100}) {
+        std::vector<std::atomic<int>> runs(count);
+        pool.run(count, [&](size_t i) { runs[i]++; });
+        for (auto &r: runs)
+            ASSERT_EQ(r, 1);
+    }
+}
+
+TEST(ThreadPoolTest, BoundsTheTasksInFlight) {
+    ThreadPool pool(3);
+    std::atomic<int> running{0}, peak{0};
+    auto start = std::chrono::steady_clock::now();
+    pool.run(12, [&](size_t) {
+        int now = ++running;
+        int seen = peak;
+        while (now > seen && !peak.compare_exchange_weak(seen, now));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        running--;
+    });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(peak, 3);
+    // 12 tasks of 20ms three at a time
+    ASSERT_GE(elapsed, std::chrono::milliseconds(80));
+    ASSERT_LT(elapsed, std::chrono::milliseconds(200));
+}
+
+TEST(ThreadPoolTest, SingleThreadRunsInline) {
+    ThreadPool pool(1);
+    std::thread::id caller = std::this_thread::get_id();
+    pool.run(5, [&](size_t) { ASSERT_EQ(std::this_thread::get_id(), caller); });
+}
+
+TEST(ThreadPoolTest, RethrowsTheFirstExceptionOnceTheBatchIsDone) {
+    for (size_t parallelism: {1, 4}) {
+        ThreadPool pool(parallelism);
+        std::vector<std::atomic<int>> runs(20);
+        ASSERT_THROW(pool.run(runs.size(), [&](size_t i) {
+            runs[i]++;
+            if (i % 7 == 3)
+                throw std::invalid_argument("task");
+        }), std::invalid_argument);
+        for (auto &r: runs)
+            ASSERT_EQ(r, 1);
+        // the pool is still usable
+        std::atomic<int> count{0};
+        pool.run(10, [&](size_t) { count++; });
+        ASSERT_EQ(count, 10);
+    }
+}
@@ -0,0 +1,72 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "TimerWheel.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+using namespace ats;
+
+TEST(TimerWheelTest, ExpiresDeadlinesInTime) {
+    TimerWheel wheel(10, 8, 1000);
+    ASSERT_EQ(wheel.nextDeadline(), -1);
+    wheel.schedule(1, 1050);
+    wheel.schedule(2, 1020);
+    wheel.schedule(3, 1000 + 8 * 10 * 3 + 5); // several revolutions away
+    ASSERT_EQ(wheel.size(), 3);
+    ASSERT_EQ(wheel.nextDeadline(), 1020);
+
+    std::vector<uint64_t> expired;
+    ASSERT_EQ(wheel.expire(1019, expired), 0);
+    ASSERT_EQ(wheel.expire(1020, expired), 1);
+    ASSERT_EQ(expired, std::vector<uint64_t>{2});
+    ASSERT_EQ(wheel.nextDeadline(), 1050);
+    expired.clear();
+    ASSERT_EQ(wheel.expire(1100, expired), 1);
+    ASSERT_EQ(expired, std::vector<uint64_t>{1});
+    ASSERT_EQ(wheel.nextDeadline(), 1245);
+    expired.clear();
+    ASSERT_EQ(wheel.expire(1244, expired), 0);
+    ASSERT_EQ(wheel.expire(5000, expired), 1);
+    ASSERT_EQ(expired, std::vector<uint64_t>{3});
+    ASSERT_EQ(wheel.size(), 0);
+}
+
+TEST(TimerWheelTest, ReschedulesAndCancels) {
+    TimerWheel wheel(10, 16, 0);
+    wheel.schedule(7, 100);
+    wheel.schedule(7, 300);
+    wheel.schedule(8, 150);
+    ASSERT_TRUE(wheel.cancel(8));
+    ASSERT_FALSE(wheel.cancel(8));
+    ASSERT_FALSE(wheel.contains(8));
+    ASSERT_EQ(wheel.nextDeadline(), 300);
+
+    std::vector<uint64_t> expired;
+    ASSERT_EQ(wheel.expire(200, expired), 0);
+    // a deadline already passed expires on the next call
+    wheel.schedule(9, 50);
+    ASSERT_EQ(wheel.nextDeadline(), 50);
+    ASSERT_EQ(wheel.expire(200, expired), 1);
+    ASSERT_EQ(wheel.expire(300, expired), 1);
+    ASSERT_EQ(expired, (std::vector<uint64_t>{9, 7}));
+}
+
+TEST(TimerWheelTest, ManyTimersExpireOnce) {
+    TimerWheel wheel(1, 64, 0);
+    for (uint64_t id = 0; id < 1000; id++)
+        wheel.schedule(id, int64_t(id * 7 % 500));
+    std::vector<uint64_t> expired;
+    for (int64_t now = 0; now <= 501; now += 3) {
+        size_t before = expired.size();
+        wheel.expire(now, expired);
+        for (size_t i = before; i < expired.size(); i++)
+            ASSERT_LE(int64_t(expired[i] * 7 % 500), now);
+        if (wheel.size()) {
+            ASSERT_GT(wheel.nextDeadline(), now);
+        }
+    }
+    std::sort(expired.begin(), expired.end());
+    ASSERT_EQ(expired.size(), 1000);
+    ASSERT_EQ(std::unique(expired.begin(), expired.end()), expired.end());
+}
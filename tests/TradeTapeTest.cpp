@@ -0,0 +1,144 @@
+//
+// Created by Anouar Achghaf on 17/10/2026.
+//
+#include "TradeTape.h"
+#include "MarketData.h"
+#include "OrderManager.h"
+#include "StubExchangeManager.h"
+#include <gtest/gtest.h>
+
+using namespace ats;
+
+namespace {
+    /**
+     * @brief Serves a trade history of ids 1..count, trade i at T0 + 100 * i with price 100 + i % 7 and quantity 1.
+     */
+    class TapeExchangeManager : public StubExchangeManager {
+    public:
+        static constexpr long T0 = 1700000000000;
+
+        explicit TapeExchangeManager(OrderManager &oms) : StubExchangeManager(oms) {}
+
+        std::vector<Trade> getTradeHistory(std::string) override {
+            std::vector<Trade> trades;
+            for (long i = 1; i <= count; i++)
+                trades.emplace_back(i, 100.0 + i % 7, 1.0, 100.0 + i % 7, T0 + 100 * i, i % 2 == 0, true);
+            return trades;
+        }
+
+        std::vector<Trade> getTradesFrom(std::string symbol, long fromId, int limit) override {
+            fromIds.push_back(fromId);
+            return ExchangeManager::getTradesFrom(symbol, fromId, limit);
+        }
+
+        long count = 0;
+        std::vector<long> fromIds;
+    };
+}
+
+TEST(TradeTapeTest, ScansTimeRanges) {
+    TradeTape tape;
+    const int64_t t0 = 1700000000000;
+    for (int64_t i = 0; i < 3000; i++)
+        ASSERT_TRUE(tape.append(1000 + i, 10 + i % 5, 1 + i % 2, t0 + 10 * i, i % 3 == 0));
+    // a gap longer than 32-bit milliseconds opens a new block
+    ASSERT_TRUE(tape.append(5000, 20, 4, t0 + 10000000000, false));
+    ASSERT_FALSE(tape.append(5000, 20, 4, t0 + 10000000000, false));
+    ASSERT_FALSE(tape.append(5001, 20, 4, t0, false));
+    ASSERT_EQ(tape.size(), 3001);
+    ASSERT_EQ(tape.lastId(), 5000);
+
+    for (size_t i: {size_t(0), size_t(1023), size_t(1024), size_t(2999)}) {
+        ASSERT_EQ(tape.id(i), int64_t(1000 + i));
+        ASSERT_EQ(tape.time(i), int64_t(t0 + 10 * i));
+        ASSERT_EQ(tape.isBuyerMaker(i), i % 3 == 0);
+        Trade trade = tape.at(i);
+        ASSERT_EQ(trade.getId(), long(1000 + i));
+        ASSERT_DOUBLE_EQ(trade.getQuoteQty(), trade.getPrice() * trade.getQuantity());
+    }
+    ASSERT_EQ(tape.time(3000), t0 + 10000000000);
+
+    ASSERT_EQ(tape.lowerBound(t0 - 1), 0);
+    ASSERT_EQ(tape.lowerBound(t0 + 10235), 1024);
+    ASSERT_EQ(tape.lowerBound(t0 + 10240), 1024);
+    ASSERT_EQ(tape.lowerBound(t0 + 30000), 3000);
+    ASSERT_EQ(tape.lowerBound(t0 + 10000000001), 3001);
+
+    // trades 0..9: prices 10..14 twice, quantities alternating 1 and 2
+    ASSERT_DOUBLE_EQ(tape.volume(t0, t0 + 100), 15);
+    ASSERT_DOUBLE_EQ(tape.vwap(t0, t0 + 100), (10 + 22 + 12 + 26 + 14 + 20 + 11 + 24 + 13 + 28) / 15.0);
+    ASSERT_DOUBLE_EQ(tape.vwap(t0 + 50000, t0 + 60000), 0);
+    auto profile = tape.volumeProfile(t0, t0 + 100, 2);
+    ASSERT_EQ(profile.size(), 3);
+    ASSERT_DOUBLE_EQ(profile[0].first, 10);
+    ASSERT_DOUBLE_EQ(profile[0].second, 6);  // 10, 11 twice
+    ASSERT_DOUBLE_EQ(profile[1].second, 6);  // 12, 13 twice
+    ASSERT_DOUBLE_EQ(profile[2].first, 14);
+    ASSERT_DOUBLE_EQ(profile[2].second, 3);
+
+    tape.clear();
+    ASSERT_TRUE(tape.empty());
+    ASSERT_EQ(tape.lastId(), -1);
+}
+
+TEST(TradeTapeTest, HistoryIsFetchedFromTheLastTrade) {
+    OrderManager oms;
+    TapeExchangeManager ems(oms);
+    MarketData md(ems, 1000);
+    ems.count = 1200;
+    ASSERT_EQ(md.updateTradeTape("BTCUSDT"), 1000);
+    ASSERT_EQ(ems.fromIds, std::vector<long>({-1}));
+
+    // full pages are followed by the next one
+    ems.count = 2700;
+    ASSERT_EQ(md.updateTradeTape("BTCUSDT"), 1500);
+    ASSERT_EQ(ems.fromIds, std::vector<long>({-1, 1201, 2201}));
+
+    ems.count = 2705;
+    std::vector<Trade> trades = md.getTradeHistory("BTCUSDT", 5000);
+    ASSERT_EQ(trades.size(), 2505);
+    ASSERT_EQ(trades.front().getId(), 201);
+    ASSERT_EQ(trades.back().getId(), 2705);
+    ASSERT_EQ(trades.back().getTime(), TapeExchangeManager::T0 + 270500);
+    ASSERT_EQ(ems.fromIds.back(), 2701);
+
+    trades = md.getTradeHistory("BTCUSDT");
+    ASSERT_EQ(trades.size(), 1000);
+    ASSERT_EQ(trades.front().getId(), 1706);
+    ASSERT_EQ(trades.back().getId(), 2705);
+
+    md.readTradeTape("BTCUSDT", [](const TradeTape &tape) {
+        ASSERT_DOUBLE_EQ(tape.volume(TapeExchangeManager::T0, TapeExchangeManager::T0 + 80100), 600);
+    });
+
+    // an outage is caught up 10 pages at a time
+    ems.count = 2705 + 12000;
+    ems.fromIds.clear();
+    ASSERT_EQ(md.updateTradeTape("BTCUSDT"), 10000);
+    ASSERT_EQ(ems.fromIds.size(), 10);
+    ASSERT_EQ(md.updateTradeTape("BTCUSDT"), 2000);
+}
+
+TEST(TradeTapeTest, TrimKeepsTheMostRecentTrades) {
+    TradeTape tape;
+    const int64_t t0 = 1700000000000;
+    for (int64_t i = 0; i < 3000; i++)
+        ASSERT_TRUE(tape.append(1000 + i, 10 + i % 5, 1, t0 + 10 * i, i % 3 == 0));
+    ASSERT_EQ(tape.trim(5000), 0);
+    ASSERT_EQ(tape.trim(1500), 1500);
+    ASSERT_EQ(tape.size(), 1500);
+    ASSERT_EQ(tape.lastId(), 3999);
+    for (size_t i: {size_t(0), size_t(47), size_t(547), size_t(548), size_t(1499)}) {
+        ASSERT_EQ(tape.id(i), int64_t(2500 + i));
+        ASSERT_EQ(tape.time(i), int64_t(t0 + 10 * (1500 + i)));
+        ASSERT_EQ(tape.isBuyerMaker(i), (1500 + i) % 3 == 0);
+        ASSERT_DOUBLE_EQ(tape.price(i), 10 + (1500 + i) % 5);
+    }
+    ASSERT_EQ(tape.lowerBound(t0), 0);
+    ASSERT_EQ(tape.lowerBound(t0 + 20000), 500);
+    ASSERT_DOUBLE_EQ(tape.volume(t0, t0 + 30000), 1500);
+    ASSERT_FALSE(tape.append(3999, 10, 1, t0 + 30000, false));
+    ASSERT_TRUE(tape.append(4000, 10, 1, t0 + 30000, true));
+    ASSERT_EQ(tape.id(1500), 4000);
+    ASSERT_TRUE(tape.isBuyerMaker(1500));
+}